@@ -29,7 +29,9 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -110,6 +112,12 @@ void PrintHelp()
     std::cout << "           -m[ark-includes] : mark variables that represent include files with "
                  "'_INCLUDE'. Default: off"
               << std::endl;
+    std::cout << "           -d[ependencies] : write the table of the headers included by each "
+                 "HIP source instead of the sources. Default: off"
+              << std::endl;
+    std::cout << "           -f[ile-list] <path>: file with more files to be processed, one per "
+                 "line."
+              << std::endl;
 }
 
 [[noreturn]] void WrongUsage(std::string_view error)
@@ -203,6 +211,85 @@ void Process(const fs::path& sourcePath,
     Bin2Hex(*source, target, variable, true, bufferSize, lineSize);
 }
 
+bool IsHeader(const fs::path& path)
+{
+    return path.extension() == ".hpp" || path.extension() == ".h";
+}
+
+// The table is the body of an initializer list of {name, {headers}} pairs, where the headers
+// are all the given headers included by the named HIP source or header directly or indirectly.
+// The names are the file names only, as the library exports the headers into a flat directory.
+// Includes which are not among the given files (e.g. the HIP runtime) are left to the compiler.
+void WriteIncludeDependencies(const std::vector<fs::path>& sourceFiles, std::ostream& target)
+{
+    std::set<std::string> headers;
+    for(const auto& path : sourceFiles)
+    {
+        if(IsHeader(path))
+            headers.insert(path.filename().string());
+    }
+
+    std::map<std::string, std::set<std::string>> direct_includes;
+    for(const auto& path : sourceFiles)
+    {
+        // The includes of OpenCL and assembly sources are inlined by the build.
+        if(path.extension() != ".cpp" && !IsHeader(path))
+            continue;
+
+        std::ifstream sourceFile{path, std::ios::in | std::ios::binary};
+        if(!sourceFile.is_open())
+        {
+            std::cerr << "Error opening file: " << path << std::endl;
+            // NOLINTNEXTLINE (concurrency-mt-unsafe)
+            std::exit(1);
+        }
+
+        // Files with the same name are indistinguishable in the library, so are merged.
+        auto& includes = direct_includes[path.filename().string()];
+        try
+        {
+            IncludeInliner inliner;
+            for(const auto& include : inliner.ScanIncludes(sourceFile, path, "#include", true))
+            {
+                auto name = fs::path{include}.filename().string();
+                if(headers.count(name) != 0)
+                    includes.insert(std::move(name));
+            }
+        }
+        catch(const InlineException& ex)
+        {
+            std::cerr << ex.What() << '\n' << ex.GetTrace() << std::endl;
+            // NOLINTNEXTLINE (concurrency-mt-unsafe)
+            std::exit(1);
+        }
+    }
+
+    for(const auto& [name, includes] : direct_includes)
+    {
+        // The set of visited headers also breaks the include cycles.
+        std::set<std::string> closure;
+        std::vector<std::string> pending{includes.begin(), includes.end()};
+        while(!pending.empty())
+        {
+            auto include = std::move(pending.back());
+            pending.pop_back();
+            if(!closure.insert(include).second)
+                continue;
+            const auto& next = direct_includes.at(include);
+            pending.insert(pending.end(), next.begin(), next.end());
+        }
+
+        target << "{\"" << name << "\", {";
+        auto separator = "";
+        for(const auto& include : closure)
+        {
+            target << separator << '"' << include << '"';
+            separator = ", ";
+        }
+        target << "}}," << std::endl;
+    }
+}
+
 int main(int argc, char* argv[])
 {
     if(argc == 1)
@@ -224,6 +311,7 @@ int main(int argc, char* argv[])
     bool recurse       = true;
     bool as_extern     = false;
     bool mark_includes = false;
+    bool dependencies  = false;
 
     // Parse command line options to establish configuration
 
@@ -266,6 +354,25 @@ int main(int argc, char* argv[])
         {
             mark_includes = true;
         }
+        else if(arg == "-d" || arg == "-dependencies")
+        {
+            dependencies = true;
+        }
+        else if(arg == "-f" || arg == "-file-list")
+        {
+            const fs::path listFile{argv[++i]};
+            std::ifstream list{listFile};
+            if(!list.is_open())
+            {
+                std::cerr << "Error opening file: " << listFile << std::endl;
+                return 1;
+            }
+            for(std::string line; std::getline(list, line);)
+            {
+                if(!line.empty())
+                    sourceFiles.emplace_back(line);
+            }
+        }
         else if(arg == "-e" || arg == "-extern")
         {
             as_extern = true;
@@ -287,15 +394,22 @@ int main(int argc, char* argv[])
         ss << "#ifndef " << guard << "\n#define " << guard << "\n";
     }
 
-    ss << "#ifndef MIOPEN_USE_CLANG_TIDY\n"
-          "#include <cstddef>\n";
-
-    for(const auto& file : sourceFiles)
+    if(dependencies)
     {
-        Process(file, ss, bufferSize, lineSize, recurse, as_extern, mark_includes);
+        WriteIncludeDependencies(sourceFiles, ss);
     }
+    else
+    {
+        ss << "#ifndef MIOPEN_USE_CLANG_TIDY\n"
+              "#include <cstddef>\n";
+
+        for(const auto& file : sourceFiles)
+        {
+            Process(file, ss, bufferSize, lineSize, recurse, as_extern, mark_includes);
+        }
 
-    ss << "#endif\n";
+        ss << "#endif\n";
+    }
 
     if(guard.length() > 0)
     {
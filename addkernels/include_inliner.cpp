@@ -89,31 +89,8 @@ void IncludeInliner::ProcessCore(std::istream& input,
 
         if(!word.empty() && word == directive && recurse)
         {
-            auto first_quote_pos = line.find('"', static_cast<int>(line_parser.tellg()) + 1);
-            std::string::size_type second_quote_pos;
-
-            if(first_quote_pos != std::string::npos)
-            {
-                second_quote_pos = line.find('"', first_quote_pos + 1);
-                if(second_quote_pos == std::string::npos)
-                    throw WrongInlineDirectiveException(GetIncludeStackTrace(current_line));
-            }
-            else
-            {
-                if(!allow_angle_brackets)
-                    throw WrongInlineDirectiveException(GetIncludeStackTrace(current_line));
-
-                first_quote_pos = line.find('<', static_cast<int>(line_parser.tellg()) + 1);
-                if(first_quote_pos == std::string::npos)
-                    throw WrongInlineDirectiveException(GetIncludeStackTrace(current_line));
-
-                second_quote_pos = line.find('>', first_quote_pos + 1);
-                if(second_quote_pos == std::string::npos)
-                    throw WrongInlineDirectiveException(GetIncludeStackTrace(current_line));
-            }
-
-            const std::string include_file_path =
-                line.substr(first_quote_pos + 1, second_quote_pos - first_quote_pos - 1);
+            const std::string include_file_path = GetIncludePath(
+                line, line_parser.tellg(), allow_angle_brackets, current_line);
 
             const auto abs_include_file_path{miopen::weakly_canonical(root / include_file_path)};
 
@@ -158,6 +135,65 @@ void IncludeInliner::ProcessCore(std::istream& input,
     _include_depth--;
 }
 
+std::vector<std::string> IncludeInliner::ScanIncludes(std::istream& input,
+                                                     const fs::path& file_name,
+                                                     const std::string& directive,
+                                                     bool allow_angle_brackets)
+{
+    _included_stack_head   = std::make_shared<SourceFileDesc>(file_name, nullptr, 0);
+    auto current_line      = 0;
+    auto include_file_list = std::vector<std::string>{};
+
+    while(!input.eof())
+    {
+        std::string line;
+        std::string word;
+        std::getline(input, line);
+        std::istringstream line_parser(line);
+        line_parser >> word;
+        current_line++;
+        std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+
+        if(!word.empty() && word == directive)
+            include_file_list.push_back(
+                GetIncludePath(line, line_parser.tellg(), allow_angle_brackets, current_line));
+    }
+
+    _included_stack_head = nullptr;
+    return include_file_list;
+}
+
+std::string IncludeInliner::GetIncludePath(const std::string& line,
+                                           std::streamoff directive_end,
+                                           bool allow_angle_brackets,
+                                           int line_number)
+{
+    auto first_quote_pos = line.find('"', static_cast<int>(directive_end) + 1);
+    std::string::size_type second_quote_pos;
+
+    if(first_quote_pos != std::string::npos)
+    {
+        second_quote_pos = line.find('"', first_quote_pos + 1);
+        if(second_quote_pos == std::string::npos)
+            throw WrongInlineDirectiveException(GetIncludeStackTrace(line_number));
+    }
+    else
+    {
+        if(!allow_angle_brackets)
+            throw WrongInlineDirectiveException(GetIncludeStackTrace(line_number));
+
+        first_quote_pos = line.find('<', static_cast<int>(directive_end) + 1);
+        if(first_quote_pos == std::string::npos)
+            throw WrongInlineDirectiveException(GetIncludeStackTrace(line_number));
+
+        second_quote_pos = line.find('>', first_quote_pos + 1);
+        if(second_quote_pos == std::string::npos)
+            throw WrongInlineDirectiveException(GetIncludeStackTrace(line_number));
+    }
+
+    return line.substr(first_quote_pos + 1, second_quote_pos - first_quote_pos - 1);
+}
+
 std::string IncludeInliner::GetIncludeStackTrace(int line)
 {
     std::ostringstream ss;
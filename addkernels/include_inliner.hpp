@@ -31,6 +31,8 @@
 #include <memory>
 #include <ostream>
 #include <stack>
+#include <string>
+#include <vector>
 
 class InlineException : public std::exception
 {
@@ -124,6 +126,12 @@ public:
                  const std::string& directive,
                  bool allow_angle_brackets,
                  bool recurse);
+    /// Returns the paths named by the include directives of the input in the order of
+    /// appearance. The included files are neither opened nor expanded.
+    std::vector<std::string> ScanIncludes(std::istream& input,
+                                          const fs::path& file_name,
+                                          const std::string& directive,
+                                          bool allow_angle_brackets);
     std::string GetIncludeStackTrace(int line);
 
 private:
@@ -138,6 +146,10 @@ private:
                      const std::string& directive,
                      bool allow_angle_brackets,
                      bool recurse);
+    std::string GetIncludePath(const std::string& line,
+                               std::streamoff directive_end,
+                               bool allow_angle_brackets,
+                               int line_number);
 };
 
 #endif // !SOURCE_INLINER_HPP
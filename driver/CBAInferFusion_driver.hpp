@@ -97,8 +97,7 @@ public:
         workspace_fwd_dev = nullptr;
 
         data_type = (sizeof(Tgpu) == 4) ? miopenFloat : miopenHalf;
-        initTiming();
-        iters = 0;
+        iters     = 0;
     }
 
     int AddCmdLineArgs() override;
@@ -144,18 +143,12 @@ public:
     int VerifyForward() override;
 
     Timer t;
-    double fulltime;
-    float lowtime;
-    float avgtime;
-    float time;
+    TimingRecord* timing = nullptr;
     int iters;
 
     void initTiming()
     {
-        fulltime = 0.;
-        lowtime  = 100000000.0;
-        avgtime  = 0.;
-        time     = 0.0;
+        timing = &AddTiming("Forward Fusion");
         return;
     }
 
@@ -165,28 +158,16 @@ public:
         return;
     }
 
-    void finishTiming(int i)
+    void finishTiming()
     {
         if(inflags.GetValueStr("time") == "1")
-        {
-            time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            lowtime = (time < lowtime) ? time : lowtime;
-            if(iters > 1 && i > 0)
-                avgtime += time;
-        }
+            timing->AddKernelTime(GetHandle());
 
         miopen::deref(GetHandle()).Finish();
         STOP_TIME
 
         if(WALL_CLOCK)
-        {
-            if(iters > 1 && i > 0)
-                fulltime += t.gettime_ms();
-            else if(iters == 1)
-                fulltime = t.gettime_ms();
-            // else do nothing, drop the first iteration
-        }
+            timing->AddWallTime(t.gettime_ms());
         return;
     }
 
@@ -741,7 +722,7 @@ void CBAInferFusionDriver<Tgpu, Tref>::runGPUBatchNormActivInference()
                                 outputTensor,
                                 out_dev->GetMem(),
                                 fusionArgs);
-        finishTiming(it);
+        finishTiming();
     }
 }
 
@@ -824,7 +805,7 @@ void CBAInferFusionDriver<Tgpu, Tref>::runGPUConvBatchNormActivInference()
                                 outputTensor,
                                 out_dev->GetMem(),
                                 fusionArgs);
-        finishTiming(it);
+        finishTiming();
     }
 }
 
@@ -881,7 +862,7 @@ void CBAInferFusionDriver<Tgpu, Tref>::runGPUConvActivInference()
                                 outputTensor,
                                 out_dev->GetMem(),
                                 fusionArgs);
-        finishTiming(it);
+        finishTiming();
     }
 }
 
@@ -993,7 +974,7 @@ void CBAInferFusionDriver<Tgpu, Tref>::runGPUFusedConvBiasInference()
                                 outputTensor,
                                 out_dev->GetMem(),
                                 fusionArgs);
-        finishTiming(it);
+        finishTiming();
     }
 }
 
@@ -1028,19 +1009,19 @@ int CBAInferFusionDriver<Tgpu, Tref>::RunForwardGPU()
 
     if(WALL_CLOCK)
     {
-        printf("Wall-clock Time Elapsed: %f ms, for %d iterations.\n",
-               (iters == 1) ? t.gettime_ms() : (fulltime / float(iters - 1)),
-               (iters > 1) ? iters - 1 : 1);
+        const auto wall = timing->WallStatistics();
+        printf("Wall-clock Time Elapsed: %f ms, for %zu iterations.\n", wall.mean, wall.count);
     }
 
     if(inflags.GetValueStr("time") == "1")
     {
-        printf("GPU Fused Kernel Min Time Elapsed: %f ms\n", lowtime);
+        const auto kernel = timing->KernelStatistics();
+        printf("GPU Fused Kernel Min Time Elapsed: %f ms\n", kernel.min);
         if(iters > 1)
-            printf("GPU Fused Kernel Avg Time Elapsed: %f ms, for %d "
+            printf("GPU Fused Kernel Avg Time Elapsed: %f ms, for %zu "
                    "iterations.\n",
-                   avgtime / (iters - 1),
-                   iters - 1);
+                   kernel.mean,
+                   kernel.count);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -295,10 +295,8 @@ int ActivationDriver<Tgpu, Tref>::RunForwardGPU()
 {
 
     float alpha = 1, beta = 0;
-    double fulltime = 0.;
-    float avgtime   = 0.0f;
-    float lowtime   = 100000000.0f;
-    int iters       = inflags.GetValueInt("iter");
+    int iters    = inflags.GetValueInt("iter");
+    auto& timing = AddTiming("Forward Activation");
     Timer t;
 
     for(int i = 0; i < iters; i++)
@@ -317,50 +315,42 @@ int ActivationDriver<Tgpu, Tref>::RunForwardGPU()
         miopen::deref(GetHandle()).Finish();
         STOP_TIME
         if(WALL_CLOCK)
-        {
-            if(iters > 1 && i > 0)
-                fulltime += t.gettime_ms();
-            else if(iters == 1)
-                fulltime = t.gettime_ms();
-            // else do nothing, drop the first iteration
-        }
+            timing.AddWallTime(t.gettime_ms());
 
         if(inflags.GetValueInt("time") == 1)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            lowtime = (time < lowtime) ? time : lowtime;
-            if(iters > 1 && i > 0)
-                avgtime += time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(WALL_CLOCK)
     {
-        printf("Wall-clock Time Forward GPU Activation Elapsed: %f ms, for %d iterations.\n",
-               (iters == 1) ? t.gettime_ms() : (fulltime / float(iters - 1)),
-               (iters > 1) ? iters - 1 : 1);
+        const auto wall = timing.WallStatistics();
+        printf("Wall-clock Time Forward GPU Activation Elapsed: %f ms, for %zu iterations.\n",
+               wall.mean,
+               wall.count);
     }
 
     if(inflags.GetValueInt("time") == 1)
     {
-        printf("GPU Kernel Min Time Forward Activation Elapsed: %f ms\n", lowtime);
+        const auto kernel = timing.KernelStatistics();
+        printf("GPU Kernel Min Time Forward Activation Elapsed: %f ms\n", kernel.min);
         if(iters > 1)
-            printf("GPU Kernel Avg Time Forward Activation Elapsed: %f ms, for %d iterations.\n",
-                   avgtime / (iters - 1),
-                   iters - 1);
+            printf("GPU Kernel Avg Time Forward Activation Elapsed: %f ms, for %zu iterations.\n",
+                   kernel.mean,
+                   kernel.count);
         int in_n, in_c, in_h, in_w;
         std::tie(in_n, in_c, in_h, in_w) = miopen::tien<4>(miopen::deref(inputTensor).GetLengths());
         size_t dataSz =
             in_n * in_c * in_h * in_w * miopen::GetTypeSize(miopen::deref(inputTensor).GetType());
 
+        timing.byte_count = 2 * dataSz;
+
         // layer, readbytes, writebytes, BG/s, timeMS
         printf("stats: name, bytesRead, bytesWritten, GB/s, timeMs\n");
         printf("stats: fwd-activ, %zu, %zu, %f, %f\n",
                dataSz,
                dataSz,
-               2 * dataSz / lowtime / 1e6,
-               avgtime / (iters - 1));
+               2 * dataSz / kernel.min / 1e6,
+               kernel.mean);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -377,10 +367,8 @@ template <typename Tgpu, typename Tref>
 int ActivationDriver<Tgpu, Tref>::RunBackwardGPU()
 {
     float alpha = 1, beta = 0;
-    double fulltime = 0.;
-    float avgtime   = 0.0f;
-    float lowtime   = 100000000.0f;
-    int iters       = inflags.GetValueInt("iter");
+    int iters    = inflags.GetValueInt("iter");
+    auto& timing = AddTiming("Backward Activation");
     Timer t;
 
     for(int i = 0; i < iters; i++)
@@ -403,50 +391,42 @@ int ActivationDriver<Tgpu, Tref>::RunBackwardGPU()
         miopen::deref(GetHandle()).Finish();
         STOP_TIME
         if(WALL_CLOCK)
-        {
-            if(iters > 1 && i > 0)
-                fulltime += t.gettime_ms();
-            else if(iters == 1)
-                fulltime = t.gettime_ms();
-            // else do nothing, drop the first iteration
-        }
+            timing.AddWallTime(t.gettime_ms());
 
         if(inflags.GetValueInt("time") == 1)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            lowtime = (time < lowtime) ? time : lowtime;
-            if(iters > 1 && i > 0)
-                avgtime += time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(WALL_CLOCK)
     {
-        printf("Wall-clock Time Backward GPU Activation Elapsed: %f ms, for %d iterations.\n",
-               (iters == 1) ? t.gettime_ms() : (fulltime / float(iters - 1)),
-               (iters > 1) ? iters - 1 : 1);
+        const auto wall = timing.WallStatistics();
+        printf("Wall-clock Time Backward GPU Activation Elapsed: %f ms, for %zu iterations.\n",
+               wall.mean,
+               wall.count);
     }
 
     if(inflags.GetValueInt("time") == 1)
     {
-        printf("GPU Kernel Min Time Backward Activation Elapsed: %f ms\n", lowtime);
+        const auto kernel = timing.KernelStatistics();
+        printf("GPU Kernel Min Time Backward Activation Elapsed: %f ms\n", kernel.min);
         if(iters > 1)
-            printf("GPU Kernel Avg Time Backward Activation Elapsed: %f ms, for %d iterations.\n",
-                   avgtime / (iters - 1),
-                   iters - 1);
+            printf("GPU Kernel Avg Time Backward Activation Elapsed: %f ms, for %zu iterations.\n",
+                   kernel.mean,
+                   kernel.count);
         int in_n, in_c, in_h, in_w;
         std::tie(in_n, in_c, in_h, in_w) = miopen::tien<4>(miopen::deref(inputTensor).GetLengths());
         size_t dataSz =
             in_n * in_c * in_h * in_w * miopen::GetTypeSize(miopen::deref(inputTensor).GetType());
 
+        timing.byte_count = 2 * dataSz;
+
         // layer, readbytes, writebytes, BG/s, timeMS
         printf("stats: name, bytesRead, bytesWritten, GB/s, timeMs\n");
         printf("stats: bwd-activ, %zu, %zu, %f, %f\n",
                dataSz,
                dataSz,
-               2 * dataSz / lowtime / 1e6,
-               avgtime / (iters - 1));
+               2 * dataSz / kernel.min / 1e6,
+               kernel.mean);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
@@ -436,8 +436,7 @@ int AdamDriver<Tgpu, Tref, Tgrad>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref, typename Tgrad>
 int AdamDriver<Tgpu, Tref, Tgrad>::RunForwardGPU()
 {
-    float kernel_total_time = 0;
-    float kernel_first_time = 0;
+    auto& timing = AddTiming("Forward Adam");
 
     void* max_exp_avg_sq_ptr = amsgrad ? max_exp_avg_sq_dev->GetMem() : nullptr;
     void* grad_scale_ptr     = is_amp ? scale_dev->GetMem() : nullptr;
@@ -488,11 +487,8 @@ int AdamDriver<Tgpu, Tref, Tgrad>::RunForwardGPU()
                                   foundInfDesc,
                                   found_inf_ptr);
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -501,8 +497,7 @@ int AdamDriver<Tgpu, Tref, Tgrad>::RunForwardGPU()
         if(WALL_CLOCK)
             printf("Wall-clock Time Forward Adam Elapsed: %f ms\n", t.gettime_ms() / iter);
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         printf("GPU Kernel Time Forward Adam Elapsed: %f ms\n", kernel_average_time);
     }
 
@@ -26,6 +26,7 @@
 #ifndef GUARD_MIOPEN_ADDLAYERNORM_DRIVER_HPP
 #define GUARD_MIOPEN_ADDLAYERNORM_DRIVER_HPP
 
+#include <../test/cpu_norm.hpp>
 #include <../test/tensor_holder.hpp>
 #include <../test/verify.hpp>
 #include "InputFlags.hpp"
@@ -67,41 +68,18 @@ int32_t mloAddLayerNormForwardRunHost(miopenTensorDescriptor_t inputDesc,
             inner_size *= dims[i];
     }
 
-    int32_t ret = 0;
-
-    for(int32_t o = 0; o < outer_size; o++)
-    {
-        Tcheck pmean = 0.0f;
-        Tcheck pvar  = 0.0f;
-        for(int32_t i = 0; i < inner_size; i++)
-        {
-            Tcheck tmp = static_cast<Tcheck>(input[o * inner_size + i]) +
-                         static_cast<Tcheck>(input2[o * inner_size + i]);
-            pmean += tmp;
-            pvar += tmp * tmp;
-        }
-
-        pmean        = pmean / inner_size;
-        pvar         = pvar / inner_size - pmean * pmean;
-        Tcheck prstd = 1.0f / sqrt(pvar + eps);
-
-        meanhost[o] = pmean;
-        rstdhost[o] = prstd;
-
-        for(int32_t i = 0; i < inner_size; i++)
-        {
-            Tcheck pweight =
-                (mode == MIOPEN_ELEMENTWISE_AFFINE_FUSED_ADD) ? 1 : static_cast<Tcheck>(weight[i]);
-            Tcheck pbias =
-                (mode == MIOPEN_ELEMENTWISE_AFFINE_FUSED_ADD) ? 0 : static_cast<Tcheck>(bias[i]);
-            outputhost[o * inner_size + i] =
-                (static_cast<Tcheck>(input[o * inner_size + i]) +
-                 static_cast<Tcheck>(input2[o * inner_size + i]) - pmean) *
-                    prstd * pweight +
-                pbias;
-        }
-    }
-    return ret;
+    bool affine = mode != MIOPEN_ELEMENTWISE_AFFINE_FUSED_ADD;
+    cpu_norm::add_layernorm_forward<Tcheck>(outer_size,
+                                            inner_size,
+                                            input,
+                                            input2,
+                                            affine ? weight : nullptr,
+                                            affine ? bias : nullptr,
+                                            outputhost,
+                                            meanhost,
+                                            rstdhost,
+                                            eps);
+    return 0;
 }
 
 template <typename Tgpu, typename Tref>
@@ -356,8 +334,7 @@ int AddLayerNormDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 int AddLayerNormDriver<Tgpu, Tref>::RunForwardGPU()
 {
-    float kernel_total_time = 0.0;
-    float kernel_first_time = 0.0;
+    auto& timing = AddTiming("Forward AddLayerNorm");
 
     Timer t;
     START_TIME
@@ -383,11 +360,8 @@ int AddLayerNormDriver<Tgpu, Tref>::RunForwardGPU()
                                   rstdDesc,
                                   rstd_dev->GetMem());
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -398,8 +372,7 @@ int AddLayerNormDriver<Tgpu, Tref>::RunForwardGPU()
             std::cout << "Wall-clock Time Forward AddLayerNorm Elapsed: " << t.gettime_ms() / iter
                       << " ms\n";
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         std::cout << "GPU Kernel Time Forward AddLayerNorm Elapsed: " << kernel_average_time
                   << " ms\n";
     }
@@ -0,0 +1,347 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "batch.hpp"
+#include "InputFlags.hpp"
+#include "registry_driver_maker.hpp"
+
+#include <miopen/stringutils.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double MillisecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct BatchCommand
+{
+    std::vector<std::string> args;
+    /// Number of the occurrences of the command in the input.
+    std::size_t count = 0;
+    int rc            = 0;
+    CommandTimes times;
+    std::vector<TimingRecord> timings;
+
+    std::string Line() const { return miopen::JoinStrings(args, " "); }
+};
+
+/// Arguments of a line of the input, the base argument first. The lines logged with
+/// MIOPEN_ENABLE_LOGGING_CMD are accepted as is: everything up to the driver executable is
+/// skipped. Empty lines and comments (starting with #) have no arguments.
+std::vector<std::string> ParseLine(const std::string& line)
+{
+    auto ss     = std::istringstream{line};
+    auto tokens = std::vector<std::string>{std::istream_iterator<std::string>{ss}, {}};
+    if(tokens.empty() || miopen::StartsWith(tokens.front(), "#"))
+        return {};
+
+    const auto exe = std::find_if(tokens.begin(), tokens.end(), [](const auto& token) {
+        return miopen::EndsWith(token, "MIOpenDriver") ||
+               miopen::EndsWith(token, "MIOpenDriver.exe");
+    });
+    if(exe != tokens.end())
+        tokens.erase(tokens.begin(), std::next(exe));
+    return tokens;
+}
+
+std::vector<BatchCommand> ReadCommands(std::istream& in, bool dedup)
+{
+    auto commands = std::vector<BatchCommand>{};
+    auto index    = std::map<std::vector<std::string>, std::size_t>{};
+
+    std::string line;
+    while(std::getline(in, line))
+    {
+        auto args = ParseLine(line);
+        if(args.empty())
+            continue;
+
+        if(dedup)
+        {
+            const auto found = index.find(args);
+            if(found != index.end())
+            {
+                ++commands[found->second].count;
+                continue;
+            }
+            index.emplace(args, commands.size());
+        }
+
+        auto command  = BatchCommand{};
+        command.args  = std::move(args);
+        command.count = 1;
+        commands.push_back(std::move(command));
+    }
+    return commands;
+}
+
+void WriteCsv(std::ostream& out, const std::vector<BatchCommand>& commands)
+{
+    out << "command,count,rc,setup_ms,forward_ms,backward_ms,verify_ms,total_ms" << std::endl;
+    out << std::fixed << std::setprecision(3);
+    for(const auto& command : commands)
+    {
+        // The arguments never contain quotes, thus quoting the field is enough.
+        out << '"' << command.Line() << "\"," << command.count << ',' << command.rc << ','
+            << command.times.setup << ',' << command.times.forward << ','
+            << command.times.backward << ',' << command.times.verify << ','
+            << command.times.total << std::endl;
+    }
+}
+
+void WriteJson(std::ostream& out, const std::vector<BatchCommand>& commands)
+{
+    auto table = nlohmann::json::array();
+    for(const auto& command : commands)
+    {
+        table.push_back({
+            {"command", command.Line()},
+            {"count", command.count},
+            {"rc", command.rc},
+            {"setup_ms", command.times.setup},
+            {"forward_ms", command.times.forward},
+            {"backward_ms", command.times.backward},
+            {"verify_ms", command.times.verify},
+            {"total_ms", command.times.total},
+            {"timings", command.timings},
+        });
+    }
+    out << table.dump(2) << std::endl;
+}
+
+int RunBatchCommand(BatchCommand& command)
+{
+    auto argv_storage = std::vector<std::string>{"MIOpenDriver"};
+    argv_storage.insert(argv_storage.end(), command.args.begin(), command.args.end());
+    auto argv = std::vector<char*>{};
+    for(auto& arg : argv_storage)
+        argv.push_back(&arg[0]);
+    argv.push_back(nullptr);
+
+    std::cout << "MIOpenDriver " << command.Line() << std::endl;
+
+    const auto& base_arg = command.args.front();
+    auto drv             = rdm::MakeDriver(base_arg);
+    if(drv == nullptr)
+    {
+        std::cout << "Incorrect BaseArg: " << base_arg << std::endl;
+        return miopenStatusBadParm;
+    }
+
+    // The profiling may have been enabled by the timing (-t 1) of a previous command.
+    miopenEnableProfiling(drv->GetHandle(), false);
+
+    try
+    {
+        const auto rc = RunDriver(
+            *drv, base_arg, static_cast<int>(argv_storage.size()), argv.data(), &command.times);
+        command.timings = drv->GetTimings();
+        return rc;
+    }
+    catch(const std::exception& ex)
+    {
+        std::cout << "FAILED: " << ex.what() << std::endl;
+        return miopenStatusUnknownError;
+    }
+}
+
+/// Prints the operations timed since the previous call.
+void PrintTimings(const Driver& drv, std::size_t& printed)
+{
+    const auto timings = drv.GetTimings();
+    for(; printed < timings.size(); ++printed)
+        PrintTiming(timings[printed]);
+}
+
+} // namespace
+
+int RunDriver(Driver& drv, const std::string& base_arg, int argc, char* argv[], CommandTimes* times)
+{
+    auto local_times = CommandTimes{};
+    if(times == nullptr)
+        times = &local_times;
+    const auto start = Clock::now();
+
+    drv.AddCmdLineArgs();
+    int rc = drv.ParseCmdLineArgs(argc, argv);
+    if(rc != 0)
+    {
+        std::cout << "ParseCmdLineArgs() FAILED, rc = " << rc << std::endl;
+        return rc;
+    }
+    drv.GetandSetData();
+    rc = drv.AllocateBuffersAndCopy();
+    times->setup = MillisecondsSince(start);
+    if(rc != 0)
+    {
+        std::cout << "AllocateBuffersAndCopy() FAILED, rc = " << rc << std::endl;
+        return rc;
+    }
+
+    int fargval =
+        !miopen::StartsWith(base_arg, "CBAInfer") ? drv.GetInputFlags().GetValueInt("forw") : 1;
+    bool bnFwdInVer   = (fargval == 2 && miopen::StartsWith(base_arg, "bnorm"));
+    bool verifyarg    = (drv.GetInputFlags().GetValueInt("verify") == 1);
+    int cumulative_rc = 0; // Do not stop running tests in case of errors.
+    std::size_t timed = 0;
+
+    if(fargval & 1 || fargval == 0 || bnFwdInVer)
+    {
+        auto stage     = Clock::now();
+        rc             = drv.RunForwardGPU();
+        times->forward = MillisecondsSince(stage);
+        PrintTimings(drv, timed);
+        cumulative_rc |= rc;
+        if(rc != 0)
+            std::cout << "RunForwardGPU() FAILED, rc = "
+                      << "0x" << std::hex << rc << std::dec << std::endl;
+        if(verifyarg) // Verify even if Run() failed.
+        {
+            stage = Clock::now();
+            cumulative_rc |= drv.VerifyForward();
+            times->verify += MillisecondsSince(stage);
+        }
+    }
+
+    if(fargval != 1)
+    {
+        auto stage      = Clock::now();
+        rc              = drv.RunBackwardGPU();
+        times->backward = MillisecondsSince(stage);
+        PrintTimings(drv, timed);
+        cumulative_rc |= rc;
+        if(rc != 0)
+            std::cout << "RunBackwardGPU() FAILED, rc = "
+                      << "0x" << std::hex << rc << std::dec << std::endl;
+        if(verifyarg) // Verify even if Run() failed.
+        {
+            stage = Clock::now();
+            cumulative_rc |= drv.VerifyBackward();
+            times->verify += MillisecondsSince(stage);
+        }
+    }
+
+    times->total = MillisecondsSince(start);
+    return cumulative_rc;
+}
+
+int RunBatch(int argc, char* argv[])
+{
+    auto flags = InputFlags{};
+    flags.AddInputFlag(
+        "input", 'i', "-", "File of driver commands, one per line (Default=- for stdin)", "string");
+    flags.AddInputFlag("output",
+                       'o',
+                       "",
+                       "File to write the timings of the commands to, - for stdout "
+                       "(Default=batch_timings.csv or batch_timings.json by the format)",
+                       "string");
+    flags.AddInputFlag("format", 'f', "csv", "Format of the timings: csv or json", "string");
+    flags.AddInputFlag("dedup",
+                       'd',
+                       "1",
+                       "Run identical commands once and count their occurrences (Default=1)",
+                       "int");
+    flags.Parse(argc, argv);
+
+    const auto format = flags.GetValueStr("format");
+    if(format != "csv" && format != "json")
+    {
+        std::cout << "Unknown format of the timings: " << format << std::endl;
+        return miopenStatusBadParm;
+    }
+
+    auto commands    = std::vector<BatchCommand>{};
+    const auto input = flags.GetValueStr("input");
+    const auto dedup = flags.GetValueInt("dedup") != 0;
+    if(input == "-")
+    {
+        commands = ReadCommands(std::cin, dedup);
+    }
+    else
+    {
+        auto file = std::ifstream{input};
+        if(!file)
+        {
+            std::cout << "Unable to open the commands file: " << input << std::endl;
+            return miopenStatusBadParm;
+        }
+        commands = ReadCommands(file, dedup);
+    }
+
+    // The handle, and with it the compiled kernels and the loaded databases, outlive the drivers.
+    Driver::SharedHandle() = Driver::CreateHandle();
+
+    int cumulative_rc = 0;
+    for(auto& command : commands)
+    {
+        command.rc = RunBatchCommand(command);
+        cumulative_rc |= command.rc;
+    }
+
+    miopenDestroy(Driver::SharedHandle());
+    Driver::SharedHandle() = nullptr;
+
+    // The standard output mixes the table with the output of the commands, hence a file.
+    auto output = flags.GetValueStr("output");
+    if(output.empty())
+        output = "batch_timings." + format;
+    auto file = std::ofstream{};
+    if(output != "-")
+    {
+        file.open(output);
+        if(!file)
+        {
+            std::cout << "Unable to open the timings file: " << output << std::endl;
+            return cumulative_rc | miopenStatusBadParm;
+        }
+    }
+    auto& out = output == "-" ? std::cout : file;
+
+    if(format == "json")
+        WriteJson(out, commands);
+    else
+        WriteCsv(out, commands);
+    if(output != "-")
+        std::cout << "Timings written to " << output << std::endl;
+
+    return cumulative_rc;
+}
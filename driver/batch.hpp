@@ -0,0 +1,57 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DRIVER_BATCH_HPP
+#define GUARD_MIOPEN_DRIVER_BATCH_HPP
+
+#include "driver.hpp"
+
+#include <string>
+
+/// Wall-clock durations of the stages of a command, in milliseconds.
+struct CommandTimes
+{
+    /// Parsing of the arguments, creation of the descriptors and initialization of the buffers.
+    double setup    = 0;
+    double forward  = 0;
+    double backward = 0;
+    /// Verification of both directions.
+    double verify = 0;
+    double total  = 0;
+};
+
+/// Runs the command of argv (argv[1] is the base argument) with the driver made for it.
+/// Returns the status codes of all the stages ORed together.
+int RunDriver(Driver& drv,
+              const std::string& base_arg,
+              int argc,
+              char* argv[],
+              CommandTimes* times = nullptr);
+
+/// "MIOpenDriver batch": runs the commands read from a file or stdin one after another in this
+/// process, with a single handle, and writes a table of the timings of every command.
+int RunBatch(int argc, char* argv[]);
+
+#endif // GUARD_MIOPEN_DRIVER_BATCH_HPP
@@ -798,10 +798,8 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunForwardGPU()
     Tref eAF     = static_cast<Tref>(1.0);
 
     Timer t;
-    double fulltime = 0.;
-    auto iters      = inflags.GetValueInt("iter");
-    float lowtime   = 100000000.0;
-    float avgtime   = 0.;
+    auto iters   = inflags.GetValueInt("iter");
+    auto& timing = AddTiming("Forward Batch Normalization");
 
     for(int i = 0; i < iters; i++)
     {
@@ -832,39 +830,29 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunForwardGPU()
         miopen::deref(GetHandle()).Finish();
         STOP_TIME
         if(WALL_CLOCK)
-        {
-            if(iters > 1 && i > 0)
-                fulltime += t.gettime_ms();
-            else if(iters == 1)
-                fulltime = t.gettime_ms();
-            // else do nothing, drop the first iteration
-        }
+            timing.AddWallTime(t.gettime_ms());
 
         if(inflags.GetValueStr("time") == "1")
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            lowtime = (time < lowtime) ? time : lowtime;
-            if(iters > 1 && i > 0)
-                avgtime += time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(WALL_CLOCK)
     {
-        printf("Wall-clock Time Forward GPU Batch Norm Elapsed: %f ms, for %d iterations.\n",
-               (iters == 1) ? t.gettime_ms() : (fulltime / float(iters - 1)),
-               (iters > 1) ? iters - 1 : 1);
+        const auto wall = timing.WallStatistics();
+        printf("Wall-clock Time Forward GPU Batch Norm Elapsed: %f ms, for %zu iterations.\n",
+               wall.mean,
+               wall.count);
     }
 
     if(inflags.GetValueStr("time") == "1")
     {
-        printf("GPU Kernel Min Time Forward Batch Normalization Elapsed: %f ms\n", lowtime);
+        const auto kernel = timing.KernelStatistics();
+        printf("GPU Kernel Min Time Forward Batch Normalization Elapsed: %f ms\n", kernel.min);
         if(iters > 1)
-            printf("GPU Kernel Avg Time Forward Batch Normalization Elapsed: %f ms, for %d "
+            printf("GPU Kernel Avg Time Forward Batch Normalization Elapsed: %f ms, for %zu "
                    "iterations.\n",
-                   avgtime / (iters - 1),
-                   iters - 1);
+                   kernel.mean,
+                   kernel.count);
         int in_n, in_c, in_h, in_w;
         std::tie(in_n, in_c, in_h, in_w) = miopen::tien<4>(miopen::deref(inputTensor).GetLengths());
         size_t M                         = in_n * in_c * in_h * in_w;
@@ -879,12 +867,14 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunForwardGPU()
         {
             rdCnt = 1;
         }
+        timing.byte_count = rdCnt * dataSz + wrCnt * dataSz;
+
         // layer, flopCnt, reads, writes, GFLOPS, GB/s, timeMs
         printf("stats: bnormf, 0, %zu, %zu, 0, %f, %f\n",
                dataSz,
                dataSz,
-               (rdCnt * dataSz + wrCnt * dataSz) / lowtime / 1e6,
-               lowtime);
+               (rdCnt * dataSz + wrCnt * dataSz) / kernel.min / 1e6,
+               kernel.min);
     }
     return miopenStatusSuccess;
 }
@@ -1047,10 +1037,8 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunBackwardGPU()
     Tref epsilon = static_cast<Tref>(EPSILON);
 
     Timer t;
-    double fulltime = 0.;
-    auto iters      = inflags.GetValueInt("iter");
-    float lowtime   = 100000000.0;
-    float avgtime   = 0.;
+    auto iters   = inflags.GetValueInt("iter");
+    auto& timing = AddTiming("Backward Batch Normalization");
 
     for(int i = 0; i < iters; i++)
     {
@@ -1104,49 +1092,39 @@ int BatchNormDriver<Tgpu, Tref, Tmix>::RunBackwardGPU()
         miopen::deref(GetHandle()).Finish();
         STOP_TIME
         if(WALL_CLOCK)
-        {
-            if(iters > 1 && i > 0)
-                fulltime += t.gettime_ms();
-            else if(iters == 1)
-                fulltime = t.gettime_ms();
-        }
+            timing.AddWallTime(t.gettime_ms());
 
         if(inflags.GetValueStr("time") == "1")
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            lowtime = (time < lowtime) ? time : lowtime;
-            if(iters > 1 && i > 0)
-                avgtime += time;
-
-            int in_n, in_c, in_h, in_w;
-            std::tie(in_n, in_c, in_h, in_w) =
-                miopen::tien<4>(miopen::deref(inputTensor).GetLengths());
-            size_t M = in_n * in_c * in_h * in_w;
-            size_t dataSz =
-                (M + 2 * in_c) * miopen::GetTypeSize(miopen::deref(inputTensor).GetType());
-            float rdCnt = 2.0;
-            float wrCnt = 1.0;
-            // layer, flopCnt, reads, writes, GFLOPS, GB/s, timeMs
-            printf("stats: bnormb, 0, %zu, %zu, 0, %f, %f\n",
-                   dataSz,
-                   dataSz,
-                   (rdCnt * dataSz + wrCnt * dataSz) / lowtime / 1e6,
-                   lowtime);
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(WALL_CLOCK)
-    {
         printf("Wall-clock Time Backward GPU Batch Norm Elapsed: %f ms\n",
-               (iters == 1) ? t.gettime_ms() : (fulltime / float(iters - 1)));
-    }
+               timing.WallStatistics().mean);
     if(inflags.GetValueStr("time") == "1")
     {
-        printf("GPU Kernel Min Time Backwards Batch Normalization Elapsed: %f ms\n", lowtime);
+        const auto kernel = timing.KernelStatistics();
+
+        int in_n, in_c, in_h, in_w;
+        std::tie(in_n, in_c, in_h, in_w) = miopen::tien<4>(miopen::deref(inputTensor).GetLengths());
+        size_t M      = in_n * in_c * in_h * in_w;
+        size_t dataSz = (M + 2 * in_c) * miopen::GetTypeSize(miopen::deref(inputTensor).GetType());
+        float rdCnt   = 2.0;
+        float wrCnt   = 1.0;
+
+        timing.byte_count = rdCnt * dataSz + wrCnt * dataSz;
+
+        // layer, flopCnt, reads, writes, GFLOPS, GB/s, timeMs
+        printf("stats: bnormb, 0, %zu, %zu, 0, %f, %f\n",
+               dataSz,
+               dataSz,
+               (rdCnt * dataSz + wrCnt * dataSz) / kernel.min / 1e6,
+               kernel.min);
+
+        printf("GPU Kernel Min Time Backwards Batch Normalization Elapsed: %f ms\n", kernel.min);
         if(iters > 1)
             printf("GPU Kernel Avg Time Backward Batch Normalization Elapsed: %f ms\n",
-                   avgtime / (iters - 1));
+                   kernel.mean);
     }
 
     return miopenStatusSuccess;
@@ -254,8 +254,7 @@ int CatDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 int CatDriver<Tgpu, Tref>::RunForwardGPU()
 {
-    float kernel_total_time = 0;
-    float kernel_first_time = 0;
+    auto& timing = AddTiming("Forward Cat");
 
     Timer t;
     START_TIME
@@ -270,11 +269,8 @@ int CatDriver<Tgpu, Tref>::RunForwardGPU()
                          out_dev->GetMem(),
                          dim);
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -284,8 +280,7 @@ int CatDriver<Tgpu, Tref>::RunForwardGPU()
         if(WALL_CLOCK)
             printf("Wall-clock Time Forward Cat Elapsed: %f ms\n", t.gettime_ms() / iter);
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         printf("GPU Kernel Time Forward Cat Elapsed: %f ms\n", kernel_average_time);
     }
 
@@ -52,6 +52,7 @@
 
 #include <../test/cpu_bias.hpp>
 #include <../test/cpu_conv.hpp>
+#include <../test/reference_cache.hpp>
 #include <../test/serialize.hpp>
 #include <../test/tensor_holder.hpp>
 #include <../test/verify.hpp>
@@ -190,6 +191,7 @@ class GpumemTensor
 public:
     void SetGpuallocMode(bool v) { is_gpualloc = v; }
     tensor<Tgpu>& GetTensor() { return host; }
+    const tensor<Tgpu>& GetTensor() const { return host; }
 
     void AllocOnHost(miopenTensorDescriptor_t t)
     {
@@ -228,17 +230,19 @@ public:
             return;
         }
 
-        for(size_t i = 0; i < sz; ++i)
-        {
-            /// \anchor move_rand
-            /// Generate random value, even if buffer is unused. This provides the same
-            /// initialization of input buffers regardless of which kinds of
-            /// convolutions are currently selectedfor testing (see the "-F" option).
-            /// Verification cache would be broken otherwise.
-            auto val = generator();
-            if(do_write)
-                GetVector()[i] = val;
-        }
+        /// \anchor move_rand
+        /// Draw the seed of the buffer, even if buffer is unused. This provides the same
+        /// initialization of input buffers regardless of which kinds of
+        /// convolutions are currently selected for testing (see the "-F" option).
+        /// The values depend only on the seed and the index (see prng::par_generate),
+        /// so the buffer is filled in parallel and the result does not depend on the number
+        /// of threads.
+        const auto seed = prng::details::get_prng()();
+        if(!do_write)
+            return;
+
+        auto& data = GetVector();
+        prng::par_generate(sz, seed, [&](std::size_t i) { data[i] = generator(); });
     }
 
     status_t AllocOnDevice(stream, context_t ctx, const size_t sz)
@@ -554,13 +558,13 @@ private:
         return total_time;
     }
 
-    void PrintForwardTime(float kernel_total_time, float kernel_first_time) const;
+    void PrintForwardTime(TimingRecord& timing) const;
     int RunForwardGpuImmed(bool is_transform);
     int RunForwardGpuFind(bool is_transform);
-    void PrintBackwardDataTime(float kernel_total_time, float kernel_first_time);
+    void PrintBackwardDataTime(TimingRecord& timing);
     int RunBackwardDataGpuImmed();
     int RunBackwardDataGpuFind();
-    void PrintBackwardWrwTime(float kernel_total_time, float kernel_first_time);
+    void PrintBackwardWrwTime(TimingRecord& timing);
     int RunBackwardWrwGpuImmed();
     int RunBackwardWrwGpuFind();
 
@@ -588,12 +592,11 @@ private:
         BwdBias
     };
 
-    std::string GetVerificationCacheFileName(const Direction& direction) const;
+    std::string GetVerificationCacheProblem(const Direction& direction) const;
+    reference_cache::Key GetVerificationCacheKey(const Direction& direction) const;
     bool IsInputTensorTransform() const;
 
-    bool TryReadVerificationCache(const Direction& direction,
-                                  miopenTensorDescriptor_t& tensorDesc,
-                                  Tref* data) const;
+    bool TryReadVerificationCache(const Direction& direction, std::vector<Tref>& data) const;
     void TrySaveVerificationCache(const Direction& direction, std::vector<Tref>& data) const;
 
     void DebugPrintWorkspaceDev() const
@@ -1790,10 +1793,9 @@ int ConvDriver<Tgpu, Tref>::FindForward(int& ret_algo_count,
 }
 
 template <typename Tgpu, typename Tref>
-void ConvDriver<Tgpu, Tref>::PrintForwardTime(const float kernel_total_time,
-                                              const float kernel_first_time) const
+void ConvDriver<Tgpu, Tref>::PrintForwardTime(TimingRecord& timing) const
 {
-    float kernel_average_time = ComputeAverageTime(kernel_total_time, kernel_first_time);
+    const auto kernel_average_time = timing.KernelStatistics().mean;
     printf("GPU Kernel Time Forward Conv. Elapsed: %f ms (average)\n", kernel_average_time);
 
     const auto num_dim = miopen::deref(inputTensor).GetNumDims() - 2;
@@ -1827,6 +1829,9 @@ void ConvDriver<Tgpu, Tref>::PrintForwardTime(const float kernel_total_time,
         size_t outputBytes = 1.0 * out_n * out_c * out_h * out_w *
                              miopen::GetTypeSize(miopen::deref(outputTensor).GetType());
 
+        timing.flop_count = flopCnt;
+        timing.byte_count = readBytes + outputBytes;
+
         printf("stats: name, n, c, ho, wo, x, y, k, flopCnt, bytesRead, bytesWritten, GFLOPs, "
                "GB/s, timeMs\n");
         printf("stats: %s%dx%du%d, %u, %u, %u, %u, %u, %u, %u,  %zu, %zu, %zu, %.0f, %.0f, %f\n",
@@ -1871,6 +1876,9 @@ void ConvDriver<Tgpu, Tref>::PrintForwardTime(const float kernel_total_time,
         size_t outputBytes = 1.0 * out_n * out_c * out_d * out_h * out_w *
                              miopen::GetTypeSize(miopen::deref(outputTensor).GetType());
 
+        timing.flop_count = flopCnt;
+        timing.byte_count = readBytes + outputBytes;
+
         printf("stats: name  , n, c, do, ho, wo, z, y, x, k, flopCnt, bytesRead, bytesWritten, "
                "GFLOPs, "
                "GB/s, timeMs\n");
@@ -2052,10 +2060,10 @@ int ConvDriver<Tgpu, Tref>::RunForwardGPU()
 
         if(time_enabled)
         {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
+            auto& timing = AddTiming("Forward Conv. Bias");
+            timing.AddKernelTime(GetHandle());
 
-            printf("GPU Kernel Time Forward Conv. Bias Elapsed: %f ms\n", time);
+            printf("GPU Kernel Time Forward Conv. Bias Elapsed: %f ms\n", timing.kernel_ms.back());
         }
     }
 
@@ -2154,9 +2162,8 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuFind(const bool is_transform)
 
     float alpha = static_cast<float>(1), beta = static_cast<float>(0);
 
-    float kernel_total_time = 0.f;
-    float kernel_first_time = 0.f;
-    float wall_first_time   = 0.f;
+    auto& timing          = AddTiming("Forward Conv.");
+    float wall_first_time = 0.f;
 
     const auto algo    = perf_results[0].fwd_algo; // use the fastest algo
     const auto ws_size = perf_results[0].memory;
@@ -2200,13 +2207,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuFind(const bool is_transform)
             wall_first_time = wall.interim_time_ms();
 
         if(time_enabled)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            kernel_total_time += time;
-            if(i == 0)
-                kernel_first_time = time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(wall_enabled)
@@ -2225,7 +2226,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuFind(const bool is_transform)
         GetSolutionAfterFind(
             perf_results[0], Direction::Fwd, in_tens, wei_tens, outputTensor, solution);
         std::cout << "MIOpen Forward Conv. " << AlgorithmSolutionToString(solution) << std::endl;
-        PrintForwardTime(kernel_total_time, kernel_first_time);
+        PrintForwardTime(timing);
     }
 
     return rc;
@@ -2327,9 +2328,8 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuImmed(const bool is_transform)
     if(rc != miopenStatusSuccess)
         return rc;
 
-    float kernel_total_time = 0.f;
-    float kernel_first_time = 0.f;
-    float wall_first_time   = 0.f;
+    auto& timing          = AddTiming("Forward Conv.");
+    float wall_first_time = 0.f;
 
     wall.start(wall_enabled);
 
@@ -2354,13 +2354,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuImmed(const bool is_transform)
             wall_first_time = wall.interim_time_ms();
 
         if(time_enabled)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            kernel_total_time += time;
-            if(i == 0)
-                kernel_first_time = time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(wall_enabled)
@@ -2376,7 +2370,7 @@ int ConvDriver<Tgpu, Tref>::RunForwardGpuImmed(const bool is_transform)
     if(time_enabled)
     {
         std::cout << "MIOpen Forward Conv. " << AlgorithmSolutionToString(*selected) << std::endl;
-        PrintForwardTime(kernel_total_time, kernel_first_time);
+        PrintForwardTime(timing);
     }
 
     is_fwd_igemm = (selected->algorithm == miopenConvolutionAlgoImplicitGEMM);
@@ -2595,9 +2589,10 @@ int ConvDriver<Tgpu, Tref>::RunBackwardGPU()
 
         if(time_enabled)
         {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            printf("GPU Kernel Time Backward Bias Conv. Elapsed: %f ms\n", time);
+            auto& timing = AddTiming("Backward Bias Conv.");
+            timing.AddKernelTime(GetHandle());
+
+            printf("GPU Kernel Time Backward Bias Conv. Elapsed: %f ms\n", timing.kernel_ms.back());
         }
 
         db.CopyFromDeviceToHost(GetStream());
@@ -2628,9 +2623,8 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuFind()
     if(ret_algo_count == 0)
         throw std::runtime_error("Find Backward Data Conv. ret_algo_count == 0");
 
-    float kernel_total_time = 0.f;
-    float kernel_first_time = 0.f;
-    float wall_first_time   = 0.f;
+    auto& timing          = AddTiming("Backward Data Conv.");
+    float wall_first_time = 0.f;
     float alpha = static_cast<float>(1), beta = static_cast<float>(0);
 
     const auto algo    = perf_results_data[0].bwd_data_algo;
@@ -2671,13 +2665,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuFind()
             wall_first_time = wall.interim_time_ms();
 
         if(time_enabled)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            kernel_total_time += time;
-            if(i == 0)
-                kernel_first_time = time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(wall_enabled)
@@ -2701,7 +2689,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuFind()
                              solution);
         std::cout << "MIOpen Backward Data Conv. " << AlgorithmSolutionToString(solution)
                   << std::endl;
-        PrintBackwardDataTime(kernel_total_time, kernel_first_time);
+        PrintBackwardDataTime(timing);
     }
 
     din.CopyFromDeviceToHost(GetStream());
@@ -2709,9 +2697,9 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuFind()
 }
 
 template <typename Tgpu, typename Tref>
-void ConvDriver<Tgpu, Tref>::PrintBackwardDataTime(float kernel_total_time, float kernel_first_time)
+void ConvDriver<Tgpu, Tref>::PrintBackwardDataTime(TimingRecord& timing)
 {
-    float kernel_average_time = ComputeAverageTime(kernel_total_time, kernel_first_time);
+    const auto kernel_average_time = timing.KernelStatistics().mean;
     printf("GPU Kernel Time Backward Data Conv. Elapsed: %f ms (average)\n", kernel_average_time);
 
     const auto num_dim = miopen::deref(inputTensor).GetNumDims() - 2;
@@ -2745,6 +2733,9 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardDataTime(float kernel_total_time, floa
         size_t outputBytes = 1.0 * out_n * out_c * out_h * out_w *
                              miopen::GetTypeSize(miopen::deref(outputTensor).GetType());
 
+        timing.flop_count = flopCnt;
+        timing.byte_count = readBytes + outputBytes;
+
         printf("stats: name, n, c, ho, wo, x, y, k, flopCnt, bytesRead, bytesWritten, GFLOPs, "
                "GB/s, timeMs\n");
         printf("stats: %s%dx%du%d, %u, %u, %u, %u, %u, %u, %u,  %zu, %zu, %zu, %.0f, %.0f, %f\n",
@@ -2789,6 +2780,9 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardDataTime(float kernel_total_time, floa
         size_t outputBytes = 1.0 * out_n * out_c * out_d * out_h * out_w *
                              miopen::GetTypeSize(miopen::deref(outputTensor).GetType());
 
+        timing.flop_count = flopCnt;
+        timing.byte_count = readBytes + outputBytes;
+
         printf(
             "stats: name, n, c, do, ho, wo, z, x, y, k, flopCnt, bytesRead, bytesWritten, GFLOPs, "
             "GB/s, timeMs\n");
@@ -2823,9 +2817,8 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuFind()
     int ret_algo_count;
     int request_algo_count = 2;
 
-    float kernel_total_time = 0.f;
-    float kernel_first_time = 0.f;
-    float wall_first_time   = 0.f;
+    auto& timing          = AddTiming("Backward Weights Conv.");
+    float wall_first_time = 0.f;
 
     float alpha = static_cast<float>(1), beta = static_cast<float>(0);
     std::vector<miopenConvAlgoPerf_t> perf_results_weights(request_algo_count);
@@ -2881,13 +2874,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuFind()
             wall_first_time = wall.interim_time_ms();
 
         if(time_enabled)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            kernel_total_time += time;
-            if(i == 0)
-                kernel_first_time = time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(wall_enabled)
@@ -2911,7 +2898,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuFind()
                              solution);
         std::cout << "MIOpen Backward Weights Conv. " << AlgorithmSolutionToString(solution)
                   << std::endl;
-        PrintBackwardWrwTime(kernel_total_time, kernel_first_time);
+        PrintBackwardWrwTime(timing);
     }
 
     dwei.CopyFromDeviceToHost(GetStream());
@@ -2919,9 +2906,9 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuFind()
 }
 
 template <typename Tgpu, typename Tref>
-void ConvDriver<Tgpu, Tref>::PrintBackwardWrwTime(float kernel_total_time, float kernel_first_time)
+void ConvDriver<Tgpu, Tref>::PrintBackwardWrwTime(TimingRecord& timing)
 {
-    float kernel_average_time = ComputeAverageTime(kernel_total_time, kernel_first_time);
+    const auto kernel_average_time = timing.KernelStatistics().mean;
     printf("GPU Kernel Time Backward Weights Conv. Elapsed: %f ms (average)\n",
            kernel_average_time);
 
@@ -2950,6 +2937,9 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardWrwTime(float kernel_total_time, float
         size_t readBytes   = 0;
         size_t outputBytes = 0;
 
+        timing.flop_count = flopCnt;
+        timing.byte_count = readBytes + outputBytes;
+
         printf("stats: name, n, c, ho, wo, x, y, k, flopCnt, bytesRead, bytesWritten, GFLOPs, "
                "GB/s, timeMs\n");
         printf("stats: %s%dx%du%d, %u, %u, %u, %u, %u, %u, %u,  %zu, %zu, %zu, %.0f, %.0f, %f\n",
@@ -2988,6 +2978,9 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardWrwTime(float kernel_total_time, float
         size_t readBytes   = 0;
         size_t outputBytes = 0;
 
+        timing.flop_count = flopCnt;
+        timing.byte_count = readBytes + outputBytes;
+
         printf(
             "stats: name, n, c, do, ho, wo, z, x, y, k, flopCnt, bytesRead, bytesWritten, GFLOPs, "
             "GB/s, timeMs\n");
@@ -3089,9 +3082,8 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuImmed()
         handle, outputTensor, weightTensor, convDesc, inputTensor, selected->solution_id);
     bwd_auxiliary.pause(wall_enabled);
 
-    float kernel_total_time = 0.f;
-    float kernel_first_time = 0.f;
-    float wall_first_time   = 0.f;
+    auto& timing          = AddTiming("Backward Data Conv.");
+    float wall_first_time = 0.f;
 
     wall.start(wall_enabled);
 
@@ -3115,13 +3107,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuImmed()
             wall_first_time = wall.interim_time_ms();
 
         if(time_enabled)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            kernel_total_time += time;
-            if(i == 0)
-                kernel_first_time = time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(wall_enabled)
@@ -3138,7 +3124,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGpuImmed()
     {
         std::cout << "MIOpen Backward Data Conv. " << AlgorithmSolutionToString(*selected)
                   << std::endl;
-        PrintBackwardDataTime(kernel_total_time, kernel_first_time);
+        PrintBackwardDataTime(timing);
     }
 
     is_bwd_igemm = (selected->algorithm == miopenConvolutionAlgoImplicitGEMM);
@@ -3218,9 +3204,8 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuImmed()
         handle, outputTensor, inputTensor, convDesc, weightTensor, selected->solution_id);
     wrw_auxiliary.pause(wall_enabled);
 
-    float kernel_total_time = 0.f;
-    float kernel_first_time = 0.f;
-    float wall_first_time   = 0.f;
+    auto& timing          = AddTiming("Backward Weights Conv.");
+    float wall_first_time = 0.f;
 
     wall.start(wall_enabled);
 
@@ -3244,13 +3229,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuImmed()
             wall_first_time = wall.interim_time_ms();
 
         if(time_enabled)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            kernel_total_time += time;
-            if(i == 0)
-                kernel_first_time = time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(wall_enabled)
@@ -3267,7 +3246,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardWrwGpuImmed()
     {
         std::cout << "MIOpen Backward Weights Conv. " << AlgorithmSolutionToString(*selected)
                   << std::endl;
-        PrintBackwardWrwTime(kernel_total_time, kernel_first_time);
+        PrintBackwardWrwTime(timing);
     }
 
     is_wrw_winograd = (selected->algorithm == miopenConvolutionAlgoWinograd);
@@ -3462,7 +3441,7 @@ int ConvDriver<Tgpu, Tref>::RunBackwardDataGPUReference()
 }
 
 template <typename Tgpu, typename Tref>
-std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheFileName(
+std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheProblem(
     const ConvDriver<Tgpu, Tref>::Direction& direction) const
 {
     std::ostringstream ss;
@@ -3547,26 +3526,37 @@ std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheFileName(
     return ss.str();
 }
 
+// The cache is content-addressed: besides the problem, the key includes the contents of the
+// inputs of the reference, so the entries stay valid when the inputs are generated differently.
+template <typename Tgpu, typename Tref>
+reference_cache::Key ConvDriver<Tgpu, Tref>::GetVerificationCacheKey(
+    const ConvDriver<Tgpu, Tref>::Direction& direction) const
+{
+    auto key = reference_cache::Key{GetVerificationCacheProblem(direction)};
+    switch(direction)
+    {
+    case Direction::Fwd:
+        key.Input(in.GetTensor()).Input(wei.GetTensor());
+        if(inflags.GetValueInt("bias") != 0)
+            key.Input(b.GetTensor());
+        break;
+    case Direction::Bwd: key.Input(dout.GetTensor()).Input(wei.GetTensor()); break;
+    case Direction::WrW: key.Input(in.GetTensor()).Input(dout.GetTensor()); break;
+    case Direction::BwdBias: key.Input(dout.GetTensor()); break;
+    }
+    return key;
+}
+
 template <typename Tgpu, typename Tref>
 bool ConvDriver<Tgpu, Tref>::TryReadVerificationCache(
-    const ConvDriver<Tgpu, Tref>::Direction& direction,
-    miopenTensorDescriptor_t& tensorDesc,
-    Tref* data) const
+    const ConvDriver<Tgpu, Tref>::Direction& direction, std::vector<Tref>& data) const
 {
     const auto verification_cache_path = inflags.GetValueStr("verification_cache");
 
     if(!verification_cache_path.empty())
     {
-        const auto file_path =
-            verification_cache_path + "/" + GetVerificationCacheFileName(direction);
-
-        if(std::ifstream(file_path).good())
-        {
-            if(readBufferFromFile<Tref>(data, GetTensorSize(tensorDesc), file_path.c_str()))
-            {
-                return true;
-            }
-        }
+        return reference_cache::Store{verification_cache_path}.Load(
+            GetVerificationCacheKey(direction), {reference_cache::Output(data)});
     }
 
     return false;
@@ -3579,9 +3569,8 @@ void ConvDriver<Tgpu, Tref>::TrySaveVerificationCache(
     const auto verification_cache_path = inflags.GetValueStr("verification_cache");
     if(!verification_cache_path.empty())
     {
-        const auto file_path =
-            verification_cache_path + "/" + GetVerificationCacheFileName(direction);
-        dumpBufferToFile<Tref>(file_path.c_str(), data.data(), data.size());
+        reference_cache::Store{verification_cache_path}.Save(GetVerificationCacheKey(direction),
+                                                             {reference_cache::Output(data)});
     }
 }
 
@@ -3594,7 +3583,7 @@ int ConvDriver<Tgpu, Tref>::VerifyForward()
     MIOPEN_THROW_IF(is_gpualloc, "'-G 1' and '-V 1' are incompatible");
 
     if(!is_fwd_run_failed)
-        if(!TryReadVerificationCache(Direction::Fwd, outputTensor, outhost.data.data()))
+        if(!TryReadVerificationCache(Direction::Fwd, outhost.data))
         {
             if(UseGPUReference())
                 RunForwardGPUReference();
@@ -3643,7 +3632,7 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
     if(is_bwd)
     {
         if(!is_bwd_run_failed)
-            if(!TryReadVerificationCache(Direction::Bwd, inputTensor, din_host.data.data()))
+            if(!TryReadVerificationCache(Direction::Bwd, din_host.data))
             {
                 if(UseGPUReference())
                     RunBackwardDataGPUReference();
@@ -3677,7 +3666,7 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
     if(is_wrw)
     {
         if(!is_wrw_run_failed)
-            if(!TryReadVerificationCache(Direction::WrW, weightTensor, dwei_host.data.data()))
+            if(!TryReadVerificationCache(Direction::WrW, dwei_host.data))
             {
                 if(UseGPUReference())
                     RunBackwardWeightsGPUReference();
@@ -3733,7 +3722,7 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
 
     if(inflags.GetValueInt("bias") != 0)
     {
-        if(!TryReadVerificationCache(Direction::BwdBias, biasTensor, db_host.data.data()))
+        if(!TryReadVerificationCache(Direction::BwdBias, db_host.data))
         {
             RunBackwardBiasCPU();
         }
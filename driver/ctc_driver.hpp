@@ -347,8 +347,7 @@ int CTCDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 int CTCDriver<Tgpu, Tref>::RunForwardGPU()
 {
-    float kernel_total_time = 0.0;
-    float kernel_first_time = 0.0;
+    auto& timing = AddTiming("Forward CTC Loss");
 
     Timer t;
     START_TIME
@@ -368,11 +367,8 @@ int CTCDriver<Tgpu, Tref>::RunForwardGPU()
                       workspace_dev->GetMem(),
                       workspace_dev->GetSize());
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -382,10 +378,8 @@ int CTCDriver<Tgpu, Tref>::RunForwardGPU()
             printf("Wall-clock Time CTC Loss Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
 
-        int iter = inflags.GetValueInt("iter");
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
-        printf("GPU Kernel Time Forward Conv. Elapsed: %f ms (average)\n", kernel_average_time);
+        float kernel_average_time = timing.KernelStatistics().mean;
+        printf("GPU Kernel Time Forward CTC Loss Elapsed: %f ms (average)\n", kernel_average_time);
     }
 
     losses_dev->FromGPU(GetStream(), losses.data());
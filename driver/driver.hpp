@@ -30,10 +30,12 @@
 #include "random.hpp"
 
 #include "InputFlags.hpp"
+#include "timing.hpp"
 #include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cfloat>
+#include <iterator>
 #include <memory>
 #include <miopen/logger.hpp>
 #include <miopen/miopen.h>
@@ -176,6 +178,7 @@ inline void PadBufferSize(size_t& sz, int datatype_sz)
            "t5layernorm[bfp16|fp16], adam[fp16], ampadam, reduceextreme[bfp16|fp16], "
            "adamw[fp16], ampadamw, transformersadamw[fp16], transformersampadamw, "
            "getitem[bfp16|fp16], reducecalculation[bfp16|fp16]\n");
+    printf("Run a file of commands in a single process: ./driver batch -i *file* (see batch -?)\n");
     exit(0); // NOLINT (concurrency-mt-unsafe)
 }
 
@@ -206,7 +209,8 @@ inline std::string ParseBaseArg(int argc, char* argv[])
        arg != "adamwfp16" && arg != "ampadamw" && arg != "transformersadamw" &&
        arg != "transformersadamwfp16" && arg != "transformersampadamw" && arg != "getitem" &&
        arg != "getitemfp16" && arg != "getitembfp16" && arg != "reducecalculation" &&
-       arg != "reducecalculationfp16" && arg != "reducecalculationbfp16" && arg != "--version")
+       arg != "reducecalculationfp16" && arg != "reducecalculationbfp16" && arg != "batch" &&
+       arg != "--version")
     {
         printf("FAILED: Invalid Base Input Argument\n");
         Usage();
@@ -223,15 +227,35 @@ public:
     Driver()
     {
         data_type = miopenFloat;
+        if(SharedHandle() != nullptr)
+            handle = SharedHandle();
+        else
+            handle = CreateHandle();
+
+        miopenGetStream(handle, &q);
+    }
+
+    /// Creates a handle with its own stream, as every driver does by default.
+    static miopenHandle_t CreateHandle()
+    {
+        miopenHandle_t h = nullptr;
 #if MIOPEN_BACKEND_OPENCL
-        miopenCreate(&handle);
+        miopenCreate(&h);
 #elif MIOPEN_BACKEND_HIP
         hipStream_t s;
         hipStreamCreate(&s);
-        miopenCreateWithStream(&handle, s);
+        miopenCreateWithStream(&h, s);
 #endif
+        return h;
+    }
 
-        miopenGetStream(handle, &q);
+    /// While not null, the drivers use this handle instead of creating their own, so that the
+    /// commands run by the batch mode share the compiled kernels and the loaded databases.
+    /// The handle is owned by the code which sets it.
+    static miopenHandle_t& SharedHandle()
+    {
+        static miopenHandle_t shared = nullptr;
+        return shared;
     }
 
     miopenHandle_t GetHandle() { return handle; }
@@ -242,9 +266,23 @@ public:
 #elif MIOPEN_BACKEND_HIP
     hipStream_t& GetStream() { return q; }
 #endif
-    virtual ~Driver() { miopenDestroy(handle); }
+    virtual ~Driver()
+    {
+        if(handle != SharedHandle())
+            miopenDestroy(handle);
+    }
+
+    /// Operations timed so far, in the order they were run. The operations the drivers started
+    /// to record without --time 1 have no samples and are skipped.
+    std::vector<TimingRecord> GetTimings() const
+    {
+        auto timed = std::vector<TimingRecord>{};
+        std::copy_if(timings.begin(), timings.end(), std::back_inserter(timed), [](auto& t) {
+            return !t.kernel_ms.empty() || !t.wall_ms.empty();
+        });
+        return timed;
+    }
 
-    // TODO: add timing APIs
     virtual int AddCmdLineArgs()                         = 0;
     virtual int ParseCmdLineArgs(int argc, char* argv[]) = 0;
     virtual InputFlags& GetInputFlags()                  = 0;
@@ -258,6 +296,15 @@ public:
 protected:
     template <typename Tgpu>
     void InitDataType();
+
+    /// Starts the record of the iterations of a timed operation. The reference is valid until
+    /// the next call.
+    TimingRecord& AddTiming(const std::string& name, double flop_count = 0, double byte_count = 0)
+    {
+        timings.push_back({name, {}, {}, flop_count, byte_count});
+        return timings.back();
+    }
+
     miopenHandle_t handle;
     miopenDataType_t data_type;
 
@@ -266,6 +313,7 @@ protected:
 #elif MIOPEN_BACKEND_HIP
     hipStream_t q;
 #endif
+    std::vector<TimingRecord> timings;
 };
 
 template <>
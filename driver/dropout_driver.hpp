@@ -314,8 +314,7 @@ int DropoutDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 int DropoutDriver<Tgpu, Tref>::RunForwardGPU()
 {
-    float kernel_total_time = 0.0;
-    float kernel_first_time = 0.0;
+    auto& timing = AddTiming("Forward Dropout");
 
     Timer t;
     START_TIME
@@ -331,11 +330,8 @@ int DropoutDriver<Tgpu, Tref>::RunForwardGPU()
                              reservespace_dev->GetMem(),
                              reservespace_dev->GetSize());
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -345,9 +341,7 @@ int DropoutDriver<Tgpu, Tref>::RunForwardGPU()
             printf("Wall-clock Time Dropout Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
 
-        int iter = inflags.GetValueInt("iter");
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         printf("GPU Kernel Time Forward Dropout. Elapsed: %f ms (average)\n", kernel_average_time);
     }
 
@@ -382,8 +376,7 @@ int DropoutDriver<Tgpu, Tref>::RunForwardCPU()
 template <typename Tgpu, typename Tref>
 int DropoutDriver<Tgpu, Tref>::RunBackwardGPU()
 {
-    float kernel_total_time = 0.0;
-    float kernel_first_time = 0.0;
+    auto& timing = AddTiming("Backward Dropout");
 
     Timer t;
     START_TIME
@@ -399,11 +392,8 @@ int DropoutDriver<Tgpu, Tref>::RunBackwardGPU()
                               reservespace_dev->GetMem(),
                               reservespace_dev->GetSize());
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -413,9 +403,7 @@ int DropoutDriver<Tgpu, Tref>::RunBackwardGPU()
             printf("Wall-clock Time Backward Dropout Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
 
-        int iter = inflags.GetValueInt("iter");
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         printf("GPU Kernel Time Backward Dropout. Elapsed: %f ms (average)\n", kernel_average_time);
     }
 
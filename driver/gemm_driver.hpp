@@ -302,6 +302,8 @@ int GemmDriver<T>::AllocateBuffersAndCopy()
 template <typename T>
 int GemmDriver<T>::RunForwardGPU()
 {
+    auto& timing = AddTiming("Gemm");
+
     for(int i = 0; i < inflags.GetValueInt("iter"); i++)
     {
 #if GEMM_DRIVER_DEBUG
@@ -358,13 +360,22 @@ int GemmDriver<T>::RunForwardGPU()
             std::cout << __func__ << ": after_GEMM, c_tmp: " << c_tmp << std::endl;
         }
 #endif
+
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
     {
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        printf("GPU Kernel Time Gemm Elapsed: %f ms\n", time);
+        printf("GPU Kernel Time Gemm Elapsed: %f ms\n", timing.KernelStatistics().mean);
+
+        const double batch = std::max<double>(gemm_desc.batch_count, 1);
+        const double m     = gemm_desc.m;
+        const double n     = gemm_desc.n;
+        const double k     = gemm_desc.k;
+
+        timing.flop_count = 2 * batch * m * n * k;
+        timing.byte_count = batch * (m * k + k * n + m * n) * sizeof(T);
     }
 
     c_dev->FromGPU(GetStream(), c.data());
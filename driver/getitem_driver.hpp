@@ -402,8 +402,7 @@ int GetitemDriver<Tgpu, Tref>::RunForwardGPU()
 template <typename Tgpu, typename Tref>
 int GetitemDriver<Tgpu, Tref>::RunBackwardGPU()
 {
-    float kernel_total_time = 0;
-    float kernel_first_time = 0;
+    auto& timing = AddTiming("Backward Getitem");
 
     Timer t;
     START_TIME
@@ -432,11 +431,8 @@ int GetitemDriver<Tgpu, Tref>::RunBackwardGPU()
                               slices_flat.data(),
                               offset);
 
-        float time = 0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -447,8 +443,7 @@ int GetitemDriver<Tgpu, Tref>::RunBackwardGPU()
             std::cout << "Wall-clock Time Backward Getitem Elapsed: " << t.gettime_ms() / iter
                       << " ms" << std::endl;
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         std::cout << "GPU Kernel Time Backward Getitem Elapsed: " << kernel_average_time << " ms"
                   << std::endl;
     }
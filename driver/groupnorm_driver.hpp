@@ -270,8 +270,7 @@ int GroupNormDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 int GroupNormDriver<Tgpu, Tref>::RunForwardGPU()
 {
-    float kernel_total_time = 0.0;
-    float kernel_first_time = 0.0;
+    auto& timing = AddTiming("Forward GroupNorm");
 
     Timer t;
     START_TIME
@@ -295,11 +294,8 @@ int GroupNormDriver<Tgpu, Tref>::RunForwardGPU()
                                rstdDesc,
                                rstd_dev->GetMem());
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -309,8 +305,7 @@ int GroupNormDriver<Tgpu, Tref>::RunForwardGPU()
         if(WALL_CLOCK)
             printf("Wall-clock Time Forward GroupNorm Elapsed: %f ms\n", t.gettime_ms() / iter);
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         printf("GPU Kernel Time Forward GroupNorm Elapsed: %f ms\n", kernel_average_time);
     }
 
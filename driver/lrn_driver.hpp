@@ -310,6 +310,7 @@ int LRNDriver<Tgpu, Tref>::RunForwardGPU()
                      do_backward,
                      do_backward ? scale_dev->GetMem() : nullptr);
 
+    auto& timing = AddTiming("Forward LRN");
     Timer t;
     START_TIME
 
@@ -325,18 +326,18 @@ int LRNDriver<Tgpu, Tref>::RunForwardGPU()
                          out_dev->GetMem(),
                          do_backward,
                          do_backward ? scale_dev->GetMem() : nullptr);
+
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
     {
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-
         STOP_TIME
         if(WALL_CLOCK)
             printf("Wall-clock Time Forward LRN Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
-        printf("GPU Kernel Time Forward LRN Elapsed: %f ms\n", time);
+        printf("GPU Kernel Time Forward LRN Elapsed: %f ms\n", timing.KernelStatistics().mean);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -374,6 +375,7 @@ int LRNDriver<Tgpu, Tref>::RunBackwardGPU()
                       din_dev->GetMem(),
                       scale_dev->GetMem());
 
+    auto& timing = AddTiming("Backward LRN");
     Timer t;
     START_TIME
 
@@ -392,18 +394,18 @@ int LRNDriver<Tgpu, Tref>::RunBackwardGPU()
                           dInputTensor,
                           din_dev->GetMem(),
                           scale_dev->GetMem());
+
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
     {
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-
         STOP_TIME
         if(WALL_CLOCK)
             printf("Wall-clock Time Backward LRN Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
-        printf("GPU Kernel Time Backward LRN Elapsed: %f ms\n", time);
+        printf("GPU Kernel Time Backward LRN Elapsed: %f ms\n", timing.KernelStatistics().mean);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
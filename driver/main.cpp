@@ -23,6 +23,7 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include "batch.hpp"
 #include "driver.hpp"
 #include "registry_driver_maker.hpp"
 
@@ -46,67 +47,23 @@ int main(int argc, char* argv[])
         exit(0); // NOLINT (concurrency-mt-unsafe)
     }
 
+    if(base_arg == "batch")
+        return RunBatch(argc, argv);
+
     // show command
-    std::cout << "MIOpenDriver";
+    std::string command = "MIOpenDriver";
     for(int i = 1; i < argc; i++)
-        std::cout << " " << argv[i];
-    std::cout << std::endl;
+        command.append(" ").append(argv[i]);
+    std::cout << command << std::endl;
 
-    Driver* drv = nullptr;
-    for(auto f : rdm::GetRegistry())
-    {
-        drv = f(base_arg);
-        if(drv != nullptr)
-            break;
-    }
+    auto drv = rdm::MakeDriver(base_arg);
     if(drv == nullptr)
     {
         printf("Incorrect BaseArg\n");
         exit(0); // NOLINT (concurrency-mt-unsafe)
     }
 
-    drv->AddCmdLineArgs();
-    int rc = drv->ParseCmdLineArgs(argc, argv);
-    if(rc != 0)
-    {
-        std::cout << "ParseCmdLineArgs() FAILED, rc = " << rc << std::endl;
-        return rc;
-    }
-    drv->GetandSetData();
-    rc = drv->AllocateBuffersAndCopy();
-    if(rc != 0)
-    {
-        std::cout << "AllocateBuffersAndCopy() FAILED, rc = " << rc << std::endl;
-        return rc;
-    }
-
-    int fargval =
-        !miopen::StartsWith(base_arg, "CBAInfer") ? drv->GetInputFlags().GetValueInt("forw") : 1;
-    bool bnFwdInVer   = (fargval == 2 && miopen::StartsWith(base_arg, "bnorm"));
-    bool verifyarg    = (drv->GetInputFlags().GetValueInt("verify") == 1);
-    int cumulative_rc = 0; // Do not stop running tests in case of errors.
-
-    if(fargval & 1 || fargval == 0 || bnFwdInVer)
-    {
-        rc = drv->RunForwardGPU();
-        cumulative_rc |= rc;
-        if(rc != 0)
-            std::cout << "RunForwardGPU() FAILED, rc = "
-                      << "0x" << std::hex << rc << std::dec << std::endl;
-        if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyForward();
-    }
-
-    if(fargval != 1)
-    {
-        rc = drv->RunBackwardGPU();
-        cumulative_rc |= rc;
-        if(rc != 0)
-            std::cout << "RunBackwardGPU() FAILED, rc = "
-                      << "0x" << std::hex << rc << std::dec << std::endl;
-        if(verifyarg) // Verify even if Run() failed.
-            cumulative_rc |= drv->VerifyBackward();
-    }
-
-    return cumulative_rc;
+    const int rc = RunDriver(*drv, base_arg, argc, argv);
+    WriteTimingJson(command, drv->GetTimings());
+    return rc;
 }
@@ -27,6 +27,7 @@
 #ifndef MLO_CONVHOST_H_
 #define MLO_CONVHOST_H_
 
+#include <miopen/host_gemm.hpp>
 #include <miopen/tensor.hpp>
 
 #include <cmath>
@@ -65,8 +66,6 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
     // mB
 
     // mC
-    Dtype alpha = Dtype(d_alpha);
-    Dtype beta  = Dtype(d_beta);
     if((!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE) &&
         ((a_cols != b_rows) || (a_rows != c_rows) || (b_cols != c_cols))) ||
        ((a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE) &&
@@ -88,90 +87,19 @@ void ADNN_mm_cpu(const Dtype* a_ptr,
 
     size_t inner_loop = (!(a_flags & ADNN_MM_TRANSPOSE)) ? a_cols : a_rows;
 
-    if(!(a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[m * b_stride + k];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if((a_flags & ADNN_MM_TRANSPOSE) && !(b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[m * a_stride + n] * b_ptr[m * b_stride + k];
-#if 0
-                    if (
-                        (n == 0 && k == 33
-                        || n == 1 && k == 32
-                        || n == 3 && k == 1
-                        || n == 4 && k == 0
-
-                        )
-                        && a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-                        )
-                    {
-                        printf("C:mm:%d %d %d   %11.9f %11.9f %11.9f %11.9f\n",
-                            n, k, m,
-                            mm_e, a_ptr[m*a_stride + n], b_ptr[m*b_stride + k], a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if(!(a_flags & ADNN_MM_TRANSPOSE) && (b_flags & ADNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[k * b_stride + m];
-#if 0
-                    if (n == 0 && k == 6 && a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-                    {
-                        printf("%4d  %11.9f %11.9f %11.9f\n", m, mm_e, a_ptr[n*a_stride + m], b_ptr[k*b_stride + m]);
-                    }
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                Dtype mm_e = static_cast<Dtype>(0);
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] += a_ptr[m * a_stride + n] * b_ptr[k * b_stride + m];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
+    miopen::host_gemm::Gemm((a_flags & ADNN_MM_TRANSPOSE) != 0,
+                            (b_flags & ADNN_MM_TRANSPOSE) != 0,
+                            c_rows,
+                            c_cols,
+                            inner_loop,
+                            d_alpha,
+                            a_ptr,
+                            a_stride,
+                            b_ptr,
+                            b_stride,
+                            d_beta,
+                            c_ptr,
+                            c_stride);
 }
 
 template <typename Dtype>
@@ -452,6 +452,7 @@ int PoolDriver_impl<Tgpu, Tref, Index>::RunForwardGPU()
                          mask_dev->GetMem(),
                          0);
 
+    auto& timing = AddTiming("Forward Pooling");
     Timer t;
     START_TIME
     int rc = 0;
@@ -469,19 +470,18 @@ int PoolDriver_impl<Tgpu, Tref, Index>::RunForwardGPU()
                                    do_backward,
                                    mask_dev->GetMem(),
                                    0);
+
+        if(inflags.GetValueInt("time") == 1 && rc == 0)
+            timing.AddKernelTime(GetHandle());
     }
     if(inflags.GetValueInt("time") == 1)
     {
-        float time = 0.0;
-        if(rc == 0)
-            miopenGetKernelTime(GetHandle(), &time);
-
         STOP_TIME
         if(WALL_CLOCK)
             printf("Wall-clock Time Forward Pooling Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
 
-        printf("GPU Kernel Time Forward Pooling Elapsed: %f ms\n", time);
+        printf("GPU Kernel Time Forward Pooling Elapsed: %f ms\n", timing.KernelStatistics().mean);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -522,6 +522,7 @@ int PoolDriver_impl<Tgpu, Tref, Index>::RunBackwardGPU()
                           din_dev->GetMem(),
                           mask_dev->GetMem());
 
+    auto& timing = AddTiming("Backward Pooling");
     Timer t;
     START_TIME
     int rc = 0;
@@ -541,18 +542,17 @@ int PoolDriver_impl<Tgpu, Tref, Index>::RunBackwardGPU()
                                     dInputTensor,
                                     din_dev->GetMem(),
                                     mask_dev->GetMem());
+
+        if(inflags.GetValueInt("time") == 1 && rc == 0)
+            timing.AddKernelTime(GetHandle());
     }
     if(inflags.GetValueInt("time") == 1)
     {
-        float time = 0.0;
-        if(rc == 0)
-            miopenGetKernelTime(GetHandle(), &time);
-
         STOP_TIME
         if(WALL_CLOCK)
             printf("Wall-clock Time Backward Pooling Elapsed: %f ms\n",
                    t.gettime_ms() / inflags.GetValueInt("iter"));
-        printf("GPU Kernel Time Backward Pooling Elapsed: %f ms\n", time);
+        printf("GPU Kernel Time Backward Pooling Elapsed: %f ms\n", timing.KernelStatistics().mean);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
@@ -2,8 +2,11 @@
 #define GUARD_RANDOM_GEN_
 
 #include <miopen/env.hpp>
+#include <miopen/par_for.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <random>
 
@@ -45,6 +48,22 @@ struct has_digits<T, std::void_t<decltype(std::numeric_limits<T>::digits)>> : st
 {
 };
 
+/// Counter-based SplitMix64 generator (Steele et al., "Fast Splittable Pseudorandom Number
+/// Generators"): the result is a pseudo-random function of the seed and the counter, so any
+/// element of a sequence can be computed independently of the others.
+inline std::uint64_t splitmix64(std::uint64_t seed, std::uint64_t counter)
+{
+    auto z = seed + (counter + 1) * 0x9E3779B97F4A7C15ULL;
+    z      = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z      = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline void seed_at(std::uint64_t seed, std::uint64_t counter)
+{
+    get_prng().seed(static_cast<std::uint32_t>(splitmix64(seed, counter) >> 32));
+}
+
 } // namespace details
 
 inline void reset_seed(std::random_device::result_type seed = 0)
@@ -52,6 +71,26 @@ inline void reset_seed(std::random_device::result_type seed = 0)
     details::get_prng().seed(seed + details::get_default_seed());
 }
 
+/// Runs f(i) for every i in [0, n) on the shared thread pool. Before each call the generator of
+/// the running thread is reseeded with splitmix64(seed, i), so the numbers drawn by f(i) depend
+/// on the seed and i only and the result is the same for any number of threads. Afterwards the
+/// generator of the calling thread is reseeded with splitmix64(seed, n), which keeps the numbers
+/// drawn next reproducible as well.
+template <class F>
+void par_generate(std::size_t n, std::uint64_t seed, F f)
+{
+    constexpr std::size_t block_size = 4096;
+    miopen::par_for((n + block_size - 1) / block_size, miopen::min_grain{1}, [&](std::size_t b) {
+        const auto last = std::min(n, (b + 1) * block_size);
+        for(auto i = b * block_size; i < last; ++i)
+        {
+            details::seed_at(seed, i);
+            f(i);
+        }
+    });
+    details::seed_at(seed, n);
+}
+
 // similar to std::generate_canonical, but simpler and faster
 template <typename T>
 inline T gen_canonical()
@@ -266,8 +266,7 @@ int ReduceCalculationDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 int ReduceCalculationDriver<Tgpu, Tref>::RunForwardGPU()
 {
-    float kernel_total_time = 0;
-    float kernel_first_time = 0;
+    auto& timing = AddTiming("Forward Reduce Calculation");
 
     Timer t;
     START_TIME
@@ -285,11 +284,8 @@ int ReduceCalculationDriver<Tgpu, Tref>::RunForwardGPU()
                                        outputDesc,
                                        out_dev->GetMem());
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -300,8 +296,7 @@ int ReduceCalculationDriver<Tgpu, Tref>::RunForwardGPU()
             std::cout << "Wall-clock Time Forward Reduce Calculation Elapsed: "
                       << t.gettime_ms() / iter << " ms" << std::endl;
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         std::cout << "GPU Kernel Time Forward Reduce Calculation Elapsed: " << kernel_average_time
                   << " ms" << std::endl;
     }
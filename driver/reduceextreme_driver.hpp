@@ -293,8 +293,7 @@ int ReduceExtremeDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 int ReduceExtremeDriver<Tgpu, Tref>::RunForwardGPU()
 {
-    float kernel_total_time = 0;
-    float kernel_first_time = 0;
+    auto& timing = AddTiming("Forward ReduceExtreme");
 
     Timer t;
     START_TIME
@@ -327,11 +326,8 @@ int ReduceExtremeDriver<Tgpu, Tref>::RunForwardGPU()
                                        indice_dev->GetMem());
         }
 
-        float time = 0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -342,8 +338,7 @@ int ReduceExtremeDriver<Tgpu, Tref>::RunForwardGPU()
             std::cout << "Wall-clock Time Forward ReduceExtreme Elapsed: " << t.gettime_ms() / iter
                       << " ms" << std::endl;
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         std::cout << "GPU Kernel Time Forward ReduceExtreme Elapsed: " << kernel_average_time
                   << " ms" << std::endl;
     }
@@ -43,6 +43,16 @@ const std::vector<DriverMaker>& GetRegistry()
     return const_cast<const std::vector<DriverMaker>&>(get_registry());
 }
 
+std::unique_ptr<Driver> MakeDriver(const std::string& base_arg)
+{
+    for(auto f : GetRegistry())
+    {
+        if(auto* drv = f(base_arg))
+            return std::unique_ptr<Driver>{drv};
+    }
+    return nullptr;
+}
+
 namespace impl {
 bool Register(DriverMaker f)
 {
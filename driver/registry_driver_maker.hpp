@@ -28,6 +28,7 @@
 
 #include "driver.hpp"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -41,6 +42,10 @@ using DriverMaker = Driver* (*)(const std::string& base_arg);
 
 const std::vector<DriverMaker>& GetRegistry();
 
+/// Instantiates the driver for \p base_arg with the first maker which recognizes it.
+/// Returns nullptr if there is none.
+std::unique_ptr<Driver> MakeDriver(const std::string& base_arg);
+
 namespace impl {
 bool Register(DriverMaker f);
 } // namespace impl
@@ -1074,8 +1074,7 @@ int RNNSeqDriver<Tgpu, Tref>::RunForwardGPU()
         return miopenStatusSuccess;
 
     Timer t;
-    float wl_time_forward = 0.0;
-    float kl_time_forward = 0.0;
+    auto& timing = AddTiming("Forward RNN");
 
     from_gpu_out = std::vector<Tgpu>(out_dev->GetSize() / sizeof(Tgpu), static_cast<Tgpu>(0));
 
@@ -1109,29 +1108,20 @@ int RNNSeqDriver<Tgpu, Tref>::RunForwardGPU()
         miopen::deref(GetHandle()).Finish();
         STOP_TIME
 
-        // TODO chage timing system
-        if(i > 0 || inflags.GetValueInt("iter") == 1)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            // printf("wall time: %f\n", t.gettime_ms());
-            wl_time_forward += t.gettime_ms();
-            kl_time_forward += time;
-        }
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
+        if(WALL_CLOCK)
+            timing.AddWallTime(t.gettime_ms());
     }
 
     if(inflags.GetValueInt("time") == 1)
     {
-        int n_iter = inflags.GetValueInt("iter") > 1 ? inflags.GetValueInt("iter") - 1
-                                                     : inflags.GetValueInt("iter");
-        printf("GPU Kernel Time Forward RNN Elapsed: %f ms\n", kl_time_forward / n_iter);
+        printf("GPU Kernel Time Forward RNN Elapsed: %f ms\n", timing.KernelStatistics().mean);
     }
 
     if(WALL_CLOCK)
     {
-        int n_iter = inflags.GetValueInt("iter") > 1 ? inflags.GetValueInt("iter") - 1
-                                                     : inflags.GetValueInt("iter");
-        printf("Wall-clock Time Forward RNN Elapsed: %f ms\n", wl_time_forward / n_iter);
+        printf("Wall-clock Time Forward RNN Elapsed: %f ms\n", timing.WallStatistics().mean);
     }
 
     if(io_layout != miopenRNNDataSeqMajorNotPadded)
@@ -1185,8 +1175,7 @@ int RNNSeqDriver<Tgpu, Tref>::RunBackwardGPU()
     if((inflags.GetValueInt("forw") & 2) || (inflags.GetValueInt("forw") == 0))
     {
         Timer t;
-        float wl_time_backward_data = 0.0;
-        float kl_time_backward_data = 0.0;
+        auto& timing = AddTiming("Backward Data RNN");
 
         workspace_dev->ToGPU(q, workspace.data());
         if(inflags.GetValueInt("inputmode") == 1)
@@ -1224,29 +1213,22 @@ int RNNSeqDriver<Tgpu, Tref>::RunBackwardGPU()
 
             miopen::deref(GetHandle()).Finish();
             STOP_TIME
-            if(i > 0 || inflags.GetValueInt("iter") == 1)
-            {
-                float time = 0.0;
-                miopenGetKernelTime(GetHandle(), &time);
-                wl_time_backward_data += t.gettime_ms();
-                kl_time_backward_data += time;
-            }
+            if(inflags.GetValueInt("time") == 1)
+                timing.AddKernelTime(GetHandle());
+            if(WALL_CLOCK)
+                timing.AddWallTime(t.gettime_ms());
         }
 
         if(inflags.GetValueInt("time") == 1)
         {
-            int n_iter = inflags.GetValueInt("iter") > 1 ? inflags.GetValueInt("iter") - 1
-                                                         : inflags.GetValueInt("iter");
             printf("GPU Kernel Time Backward Data RNN Elapsed: %f ms\n",
-                   kl_time_backward_data / n_iter);
+                   timing.KernelStatistics().mean);
         }
 
         if(WALL_CLOCK)
         {
-            int n_iter = inflags.GetValueInt("iter") > 1 ? inflags.GetValueInt("iter") - 1
-                                                         : inflags.GetValueInt("iter");
             printf("Wall-clock Time Backward Data RNN Elapsed: %f ms\n",
-                   wl_time_backward_data / n_iter);
+                   timing.WallStatistics().mean);
         }
         if(io_layout != miopenRNNDataSeqMajorNotPadded)
         {
@@ -1289,8 +1271,7 @@ int RNNSeqDriver<Tgpu, Tref>::RunBackwardGPU()
     if((inflags.GetValueInt("forw") & 4) || (inflags.GetValueInt("forw") == 0))
     {
         Timer t;
-        float wl_time_backward_weight = 0.0;
-        float kl_time_backward_weight = 0.0;
+        auto& timing = AddTiming("Backward Weights RNN");
 
         for(int i = 0; i < inflags.GetValueInt("iter"); i++)
         {
@@ -1311,29 +1292,22 @@ int RNNSeqDriver<Tgpu, Tref>::RunBackwardGPU()
                                                     reservespace_dev->GetSize());
             miopen::deref(GetHandle()).Finish();
             STOP_TIME
-            if(i > 0 || inflags.GetValueInt("iter") == 1)
-            {
-                float time = 0.0;
-                miopenGetKernelTime(GetHandle(), &time);
-                wl_time_backward_weight += t.gettime_ms();
-                kl_time_backward_weight += time;
-            }
+            if(inflags.GetValueInt("time") == 1)
+                timing.AddKernelTime(GetHandle());
+            if(WALL_CLOCK)
+                timing.AddWallTime(t.gettime_ms());
         }
 
         if(inflags.GetValueInt("time") == 1)
         {
-            int n_iter = inflags.GetValueInt("iter") > 1 ? inflags.GetValueInt("iter") - 1
-                                                         : inflags.GetValueInt("iter");
             printf("GPU Kernel Time Backward Weights RNN Elapsed: %f ms\n",
-                   kl_time_backward_weight / n_iter);
+                   timing.KernelStatistics().mean);
         }
 
         if(WALL_CLOCK)
         {
-            int n_iter = inflags.GetValueInt("iter") > 1 ? inflags.GetValueInt("iter") - 1
-                                                         : inflags.GetValueInt("iter");
             printf("Wall-clock Time Backward Weights RNN Elapsed: %f ms\n",
-                   wl_time_backward_weight / n_iter);
+                   timing.WallStatistics().mean);
         }
         dwei_dev->FromGPU(GetStream(), dwei.data());
     }
@@ -236,9 +236,8 @@ int SoftmaxDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 int SoftmaxDriver<Tgpu, Tref>::RunForwardGPU()
 {
-    float kernel_total_time = 0.0;
-    float kernel_first_time = 0.0;
-    float wall_first_time   = 0.0;
+    auto& timing          = AddTiming("Forward Softmax");
+    float wall_first_time = 0.0;
 
     Timer t;
     START_TIME
@@ -255,12 +254,10 @@ int SoftmaxDriver<Tgpu, Tref>::RunForwardGPU()
                                 algo,
                                 mode);
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
         if(i == 0)
         {
-            kernel_first_time = time;
             STOP_TIME
             wall_first_time = t.gettime_ms();
             START_TIME
@@ -271,12 +268,11 @@ int SoftmaxDriver<Tgpu, Tref>::RunForwardGPU()
     {
         STOP_TIME
         int iter           = inflags.GetValueInt("iter");
-        auto gpu_time      = kernel_first_time;
+        auto gpu_time      = timing.KernelStatistics().mean;
         auto wall_time     = wall_first_time;
         auto aux_wall_time = 0.0f;
         if(iter > 1)
         {
-            gpu_time      = (kernel_total_time - kernel_first_time) / (iter - 1);
             wall_time     = t.gettime_ms() / (iter - 1);
             aux_wall_time = wall_first_time - wall_time;
         }
@@ -289,6 +285,8 @@ int SoftmaxDriver<Tgpu, Tref>::RunForwardGPU()
             printf("\n");
         }
         printf("GPU Kernel Time Forward Softmax Elapsed: %f ms\n", gpu_time);
+
+        timing.byte_count = (in.size() + out.size()) * sizeof(Tgpu);
     }
 
     out_dev->FromGPU(GetStream(), out.data());
@@ -305,9 +303,8 @@ int SoftmaxDriver<Tgpu, Tref>::RunForwardCPU()
 template <typename Tgpu, typename Tref>
 int SoftmaxDriver<Tgpu, Tref>::RunBackwardGPU()
 {
-    float kernel_total_time = 0.0;
-    float kernel_first_time = 0.0;
-    float wall_first_time   = 0.0;
+    auto& timing          = AddTiming("Backward Softmax");
+    float wall_first_time = 0.0;
 
     Timer t;
     START_TIME
@@ -326,12 +323,10 @@ int SoftmaxDriver<Tgpu, Tref>::RunBackwardGPU()
                                  algo,
                                  mode);
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
         if(i == 0)
         {
-            kernel_first_time = time;
             STOP_TIME
             wall_first_time = t.gettime_ms();
             START_TIME
@@ -342,12 +337,11 @@ int SoftmaxDriver<Tgpu, Tref>::RunBackwardGPU()
     {
         STOP_TIME
         int iter           = inflags.GetValueInt("iter");
-        auto gpu_time      = kernel_first_time;
+        auto gpu_time      = timing.KernelStatistics().mean;
         auto wall_time     = wall_first_time;
         auto aux_wall_time = 0.0f;
         if(iter > 1)
         {
-            gpu_time      = (kernel_total_time - kernel_first_time) / (iter - 1);
             wall_time     = t.gettime_ms() / (iter - 1);
             aux_wall_time = wall_first_time - wall_time;
         }
@@ -360,6 +354,8 @@ int SoftmaxDriver<Tgpu, Tref>::RunBackwardGPU()
             printf("\n");
         }
         printf("GPU Kernel Time Backward Softmax Elapsed: %f ms\n", gpu_time);
+
+        timing.byte_count = (out.size() + dout.size() + din.size()) * sizeof(Tgpu);
     }
 
     din_dev->FromGPU(GetStream(), din.data());
@@ -26,6 +26,7 @@
 #ifndef GUARD_MIOPEN_T5LAYERNORM_DRIVER_HPP
 #define GUARD_MIOPEN_T5LAYERNORM_DRIVER_HPP
 
+#include <../test/cpu_norm.hpp>
 #include <../test/tensor_holder.hpp>
 #include <../test/verify.hpp>
 #include "InputFlags.hpp"
@@ -59,32 +60,14 @@ int32_t mloT5LayerNormForwardRunHost(miopenTensorDescriptor_t xDesc,
         outer_size *= dims[i];
     }
 
-    int32_t ret = 0;
-
-    for(int32_t o = 0; o < outer_size; o++)
-    {
-        Tcheck pvar = static_cast<Tcheck>(0);
-        for(int32_t i = 0; i < inner_size; i++)
-        {
-            Tcheck tmp = static_cast<Tcheck>(x[o * inner_size + i]);
-            pvar += tmp * tmp;
-        }
-
-        pvar         = pvar / inner_size;
-        Tcheck prstd = static_cast<Tcheck>(1.0) / sqrt(pvar + eps);
-
-        rstdhost[o] = prstd;
-
-        for(int32_t i = 0; i < inner_size; i++)
-        {
-            Tcheck pweight = (mode == MIOPEN_ELEMENTWISE_AFFINE_T5)
-                                 ? static_cast<Tcheck>(1)
-                                 : static_cast<Tcheck>(weight[i]);
-            yhost[o * inner_size + i] =
-                (static_cast<Tcheck>(x[o * inner_size + i])) * prstd * pweight;
-        }
-    }
-    return ret;
+    cpu_norm::rmsnorm_forward<Tcheck>(outer_size,
+                                      inner_size,
+                                      x,
+                                      mode == MIOPEN_ELEMENTWISE_AFFINE_T5 ? nullptr : weight,
+                                      yhost,
+                                      rstdhost,
+                                      eps);
+    return 0;
 }
 
 template <typename Tgpu, typename Tcheck>
@@ -105,38 +88,14 @@ int32_t mloT5LayerNormBackwardRunHost(miopenTensorDescriptor_t dyDesc,
         outer_size *= dims[i];
     }
 
-    int32_t ret = 0;
-
-    for(int32_t o = 0; o < outer_size; o++)
-    {
-        Tcheck sum = static_cast<Tcheck>(0);
-        for(int32_t i = 0; i < inner_size; i++)
-        {
-            Tcheck pweight = (mode == MIOPEN_ELEMENTWISE_AFFINE_T5)
-                                 ? static_cast<Tcheck>(1)
-                                 : static_cast<Tcheck>(weight[i]);
-            Tcheck pdy = dy ? static_cast<Tcheck>(dy[o * inner_size + i]) : static_cast<Tcheck>(0);
-            Tcheck px  = static_cast<Tcheck>(x[o * inner_size + i]);
-            sum += pdy * px * pweight;
-        }
-
-        Tcheck ds    = sum;
-        Tcheck s     = static_cast<Tcheck>(1) / inner_size;
-        Tcheck prstd = rstdhost[o];
-        Tcheck a     = ds * prstd * prstd * prstd * s;
-
-        for(int32_t i = 0; i < inner_size; i++)
-        {
-            Tcheck pweight = (mode == MIOPEN_ELEMENTWISE_AFFINE_T5)
-                                 ? static_cast<Tcheck>(1)
-                                 : static_cast<Tcheck>(weight[i]);
-            Tcheck pdy = dy ? static_cast<Tcheck>(dy[o * inner_size + i]) : static_cast<Tcheck>(0);
-
-            Tcheck val = prstd * pdy * pweight - a * static_cast<Tcheck>(x[o * inner_size + i]);
-            dxhost[o * inner_size + i] = static_cast<Tcheck>(val);
-        }
-    }
-    return ret;
+    cpu_norm::rmsnorm_backward<Tcheck>(outer_size,
+                                       inner_size,
+                                       dy,
+                                       x,
+                                       mode == MIOPEN_ELEMENTWISE_AFFINE_T5 ? nullptr : weight,
+                                       rstdhost,
+                                       dxhost);
+    return 0;
 }
 
 template <typename Tgpu, typename Tcheck>
@@ -152,23 +111,8 @@ int32_t mloT5LayerNormBackckwardweightRunHost(
         outer_size *= dims[i];
     }
 
-    int32_t ret = 0;
-
-    for(int32_t o = 0; o < inner_size; o++)
-    {
-        Tcheck sum = static_cast<Tcheck>(0);
-        for(uint64_t i = 0; i < outer_size; ++i)
-        {
-            Tcheck prstd = static_cast<Tcheck>(rstdhost[i]);
-            Tcheck pdy   = dy ? static_cast<Tcheck>(dy[i * inner_size + o]) : 0;
-            Tcheck px    = static_cast<Tcheck>(x[i * inner_size + o]);
-
-            sum += pdy * px * prstd;
-        }
-
-        dwhost[o] = sum;
-    }
-    return ret;
+    cpu_norm::rmsnorm_backward_weight<Tcheck>(outer_size, inner_size, dy, x, rstdhost, dwhost);
+    return 0;
 }
 
 template <typename Tgpu, typename Tref>
@@ -417,8 +361,7 @@ int T5LayerNormDriver<Tgpu, Tref>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref>
 int T5LayerNormDriver<Tgpu, Tref>::RunForwardGPU()
 {
-    float kernel_total_time = 0.0;
-    float kernel_first_time = 0.0;
+    auto& timing = AddTiming("Forward T5LayerNorm");
 
     Timer t;
     START_TIME
@@ -437,11 +380,8 @@ int T5LayerNormDriver<Tgpu, Tref>::RunForwardGPU()
                                  rstdDesc,
                                  rstd_dev->GetMem());
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -452,8 +392,7 @@ int T5LayerNormDriver<Tgpu, Tref>::RunForwardGPU()
             std::cout << "Wall-clock Time Forward T5LayerNorm Elapsed: " << t.gettime_ms() / iter
                       << " ms\n";
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         std::cout << "GPU Kernel Time Forward T5LayerNorm Elapsed: " << kernel_average_time
                   << " ms\n";
     }
@@ -480,8 +419,7 @@ int T5LayerNormDriver<Tgpu, Tref>::RunForwardCPU()
 template <typename Tgpu, typename Tref>
 int T5LayerNormDriver<Tgpu, Tref>::RunBackwardGPU()
 {
-    float kernel_total_time = 0.0;
-    float kernel_first_time = 0.0;
+    auto& timing = AddTiming("Backward T5LayerNorm");
 
     Timer t;
     START_TIME
@@ -505,11 +443,8 @@ int T5LayerNormDriver<Tgpu, Tref>::RunBackwardGPU()
                                   dwDesc,
                                   dw_dev->GetMem());
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -520,8 +455,7 @@ int T5LayerNormDriver<Tgpu, Tref>::RunBackwardGPU()
             std::cout << "Wall-clock Time Backward T5LayerNorm Elapsed: " << t.gettime_ms() / iter
                       << " ms\n";
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         std::cout << "GPU Kernel Time Backward T5LayerNorm Elapsed: " << kernel_average_time
                   << " ms\n";
     }
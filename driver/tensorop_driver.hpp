@@ -253,10 +253,8 @@ int TensorOpDriver<Tgpu, Tref>::RunForwardGPU()
     float fbeta       = static_cast<float>(beta);
     float ftensor_val = static_cast<float>(tensor_val);
 
-    int iters       = inflags.GetValueInt("iter");
-    double fulltime = 0;
-    float avgtime   = 0.0f;
-    float min_time  = 100000000.0f;
+    int iters    = inflags.GetValueInt("iter");
+    auto& timing = AddTiming("Tensor Op");
 
     Timer t;
 
@@ -285,44 +283,36 @@ int TensorOpDriver<Tgpu, Tref>::RunForwardGPU()
 
         STOP_TIME
         if(WALL_CLOCK)
-        {
-            if(iters > 1)
-                fulltime += t.gettime_ms();
-            else if(iters == 1)
-                fulltime = t.gettime_ms();
-        }
+            timing.AddWallTime(t.gettime_ms());
         if(inflags.GetValueInt("time") == 1)
-        {
-            float time = 0.0;
-            miopenGetKernelTime(GetHandle(), &time);
-            min_time = (time < min_time) ? time : min_time;
-            if(iters > 1)
-                avgtime += time;
-        }
+            timing.AddKernelTime(GetHandle());
     }
 
     if(WALL_CLOCK)
-        printf("Wall-clock Time Tensor Ops Elapsed: %f ms, for %d iterations.\n",
-               (iters == 1) ? t.gettime_ms() : (fulltime / float(iters - 1)),
-               (iters > 1) ? iters - 1 : 1);
+        printf("Wall-clock Time Tensor Ops Elapsed: %f ms, for %zu iterations.\n",
+               timing.WallStatistics().mean,
+               timing.WallStatistics().count);
     if(inflags.GetValueInt("time") == 1)
     {
-        printf("GPU Kernel Min Time Tensor Op Elapsed: %f ms\n", min_time);
+        const auto kernel = timing.KernelStatistics();
+        printf("GPU Kernel Min Time Tensor Op Elapsed: %f ms\n", kernel.min);
         if(iters > 1)
-            printf("GPU Kernel Avg Time Tensor Op Elapsed: %f ms, for %d iterations.\n",
-                   avgtime / (iters - 1),
-                   iters - 1);
+            printf("GPU Kernel Avg Time Tensor Op Elapsed: %f ms, for %zu iterations.\n",
+                   kernel.mean,
+                   kernel.count);
         int in_n, in_c, in_h, in_w;
         std::tie(in_n, in_c, in_h, in_w) = miopen::tien<4>(miopen::deref(aTensor).GetLengths());
         size_t dataSz =
             in_n * in_c * in_h * in_w * miopen::GetTypeSize(miopen::deref(aTensor).GetType());
 
+        timing.byte_count = 4 * dataSz;
+
         printf("stats: name, bytesRead, bytesWritten, GB/s, timeMs\n");
         printf("stats: tensor op, %zu, %zu, %f, %f\n",
                3 * dataSz,
                dataSz,
-               4 * dataSz / min_time / 1e6,
-               avgtime / (iters - 1));
+               4 * dataSz / kernel.min / 1e6,
+               kernel.mean);
     }
     if(!is_set && !is_scale)
         c_dev->FromGPU(GetStream(), c.data());
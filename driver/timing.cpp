@@ -0,0 +1,219 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "timing.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+namespace {
+
+/// The samples left after the warmup iterations.
+std::vector<float> Measured(const std::vector<float>& samples)
+{
+    if(samples.empty())
+        return {};
+    const auto warmup = std::min(WarmupIterations(), samples.size() - 1);
+    return {samples.begin() + warmup, samples.end()};
+}
+
+double Percentile(const std::vector<float>& sorted, double p)
+{
+    const auto rank  = p * static_cast<double>(sorted.size() - 1);
+    const auto lower = static_cast<std::size_t>(rank);
+    const auto upper = std::min(lower + 1, sorted.size() - 1);
+    const auto frac  = rank - static_cast<double>(lower);
+    return sorted[lower] + frac * (static_cast<double>(sorted[upper]) - sorted[lower]);
+}
+
+nlohmann::json OrNull(double value)
+{
+    return value > 0 ? nlohmann::json(value) : nlohmann::json(nullptr);
+}
+
+} // namespace
+
+TimingStatistics TimingStatistics::Compute(std::vector<float> samples)
+{
+    auto stats = TimingStatistics{};
+    if(samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+    const auto n = static_cast<double>(samples.size());
+
+    stats.count  = samples.size();
+    stats.min    = samples.front();
+    stats.max    = samples.back();
+    stats.mean   = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+    stats.median = Percentile(samples, 0.5);
+    stats.p95    = Percentile(samples, 0.95);
+    stats.p99    = Percentile(samples, 0.99);
+
+    if(samples.size() > 1)
+    {
+        auto sum_sq = 0.0;
+        for(const auto sample : samples)
+            sum_sq += (sample - stats.mean) * (sample - stats.mean);
+        stats.stddev = std::sqrt(sum_sq / (n - 1));
+    }
+    return stats;
+}
+
+void TimingRecord::AddKernelTime(miopenHandle_t handle)
+{
+    float time = 0.0f;
+    miopenGetKernelTime(handle, &time);
+    kernel_ms.push_back(time);
+}
+
+TimingStatistics TimingRecord::KernelStatistics() const
+{
+    return TimingStatistics::Compute(Measured(kernel_ms));
+}
+
+TimingStatistics TimingRecord::WallStatistics() const
+{
+    return TimingStatistics::Compute(Measured(wall_ms));
+}
+
+double TimingRecord::FlopsPerSecond() const
+{
+    const auto median = KernelStatistics().median;
+    return median > 0 ? flop_count / median * 1e3 : 0;
+}
+
+double TimingRecord::BytesPerSecond() const
+{
+    const auto median = KernelStatistics().median;
+    return median > 0 ? byte_count / median * 1e3 : 0;
+}
+
+std::size_t WarmupIterations()
+{
+    return miopen::env::value(MIOPEN_DRIVER_WARMUP_ITERATIONS);
+}
+
+void PrintTiming(const TimingRecord& record)
+{
+    printf("timing: %s", record.name.c_str());
+
+    if(!record.kernel_ms.empty())
+    {
+        const auto kernel = record.KernelStatistics();
+        printf(", kernel min %f, median %f, p95 %f, p99 %f, mean %f, stddev %f ms over %zu "
+               "iterations (%zu warmup)",
+               kernel.min,
+               kernel.median,
+               kernel.p95,
+               kernel.p99,
+               kernel.mean,
+               kernel.stddev,
+               kernel.count,
+               record.kernel_ms.size() - kernel.count);
+        if(record.flop_count > 0)
+            printf(", %.1f GFLOP/s", record.FlopsPerSecond() / 1e9);
+        if(record.byte_count > 0)
+            printf(", %.1f GB/s", record.BytesPerSecond() / 1e9);
+    }
+
+    if(!record.wall_ms.empty())
+    {
+        const auto wall = record.WallStatistics();
+        printf(", wall-clock median %f, p95 %f ms", wall.median, wall.p95);
+    }
+
+    printf("\n");
+}
+
+void to_json(nlohmann::json& json, const TimingStatistics& stats)
+{
+    json = {
+        {"count", stats.count},
+        {"min", stats.min},
+        {"max", stats.max},
+        {"mean", stats.mean},
+        {"median", stats.median},
+        {"p95", stats.p95},
+        {"p99", stats.p99},
+        {"stddev", stats.stddev},
+    };
+}
+
+void to_json(nlohmann::json& json, const TimingRecord& record)
+{
+    json = {
+        {"name", record.name},
+        {"flop_count", OrNull(record.flop_count)},
+        {"byte_count", OrNull(record.byte_count)},
+    };
+
+    // The samples are kept, so that the runs of two versions can be compared with a test of
+    // their own choosing rather than by their summaries only.
+    if(!record.kernel_ms.empty())
+    {
+        const auto samples = Measured(record.kernel_ms);
+        json["warmup"]     = record.kernel_ms.size() - samples.size();
+        json["kernel_ms"]  = TimingStatistics::Compute(samples);
+        json["kernel_ms"]["samples"] = samples;
+        json["flop_per_s"]           = OrNull(record.FlopsPerSecond());
+        json["byte_per_s"]           = OrNull(record.BytesPerSecond());
+    }
+
+    if(!record.wall_ms.empty())
+    {
+        const auto samples         = Measured(record.wall_ms);
+        json["wall_ms"]            = TimingStatistics::Compute(samples);
+        json["wall_ms"]["samples"] = samples;
+    }
+}
+
+void WriteTimingJson(const std::string& command, const std::vector<TimingRecord>& records)
+{
+    const auto path = miopen::env::value(MIOPEN_DRIVER_TIMING_JSON);
+    if(path.empty())
+        return;
+
+    const auto json = nlohmann::json{{"command", command}, {"timings", records}}.dump(2);
+    if(path == "-")
+    {
+        std::cout << json << std::endl;
+        return;
+    }
+
+    auto file = std::ofstream{path};
+    if(!file)
+    {
+        std::cout << "Unable to open the timings file: " << path << std::endl;
+        return;
+    }
+    file << json << std::endl;
+}
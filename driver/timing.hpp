@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DRIVER_TIMING_HPP
+#define GUARD_MIOPEN_DRIVER_TIMING_HPP
+
+#include <miopen/env.hpp>
+#include <miopen/miopen.h>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// Number of the first iterations of every timed operation which are excluded from the
+/// statistics. One iteration is always kept, so that "-i 1" still reports a time.
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DRIVER_WARMUP_ITERATIONS, 1)
+/// File the timings of the command are written to as JSON, "-" for stdout.
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DRIVER_TIMING_JSON)
+
+/// Order statistics and moments of a set of times, in milliseconds.
+struct TimingStatistics
+{
+    std::size_t count = 0;
+    double min        = 0;
+    double max        = 0;
+    double mean       = 0;
+    double median     = 0;
+    double p95        = 0;
+    double p99        = 0;
+    /// Sample standard deviation, 0 for less than two samples.
+    double stddev = 0;
+
+    /// The percentiles are linearly interpolated between the closest ranks.
+    static TimingStatistics Compute(std::vector<float> samples);
+};
+
+/// Times of all the iterations of an operation timed by a driver (e.g. "Forward Conv.") and
+/// the amount of work done by one iteration.
+struct TimingRecord
+{
+    std::string name;
+    /// Times reported by miopenGetKernelTime(), the warmup iterations included.
+    std::vector<float> kernel_ms;
+    /// Wall-clock times (--wall 1), the warmup iterations included.
+    std::vector<float> wall_ms;
+    /// Floating point operations and bytes moved by one iteration, 0 if unknown.
+    double flop_count = 0;
+    double byte_count = 0;
+
+    /// Appends the time of the last kernel(s) launched with the handle.
+    void AddKernelTime(miopenHandle_t handle);
+    void AddWallTime(float ms) { wall_ms.push_back(ms); }
+
+    TimingStatistics KernelStatistics() const;
+    TimingStatistics WallStatistics() const;
+
+    /// Throughputs achieved at the median kernel time, 0 if unknown.
+    double FlopsPerSecond() const;
+    double BytesPerSecond() const;
+};
+
+/// See MIOPEN_DRIVER_WARMUP_ITERATIONS.
+std::size_t WarmupIterations();
+
+/// Prints the statistics of the record in a single line starting with "timing:".
+void PrintTiming(const TimingRecord& record);
+
+void to_json(nlohmann::json& json, const TimingStatistics& stats);
+void to_json(nlohmann::json& json, const TimingRecord& record);
+
+/// Writes the timings of a command to MIOPEN_DRIVER_TIMING_JSON, if it is set.
+void WriteTimingJson(const std::string& command, const std::vector<TimingRecord>& records);
+
+#endif // GUARD_MIOPEN_DRIVER_TIMING_HPP
@@ -321,8 +321,7 @@ int TransformersAdamWDriver<Tgpu, Tref, Tgrad>::AllocateBuffersAndCopy()
 template <typename Tgpu, typename Tref, typename Tgrad>
 int TransformersAdamWDriver<Tgpu, Tref, Tgrad>::RunForwardGPU()
 {
-    float kernel_total_time = 0;
-    float kernel_first_time = 0;
+    auto& timing = AddTiming("Forward TransformersAdamW");
 
     void* grad_scale_ptr = is_amp ? scale_dev->GetMem() : nullptr;
     void* found_inf_ptr  = is_amp ? found_inf_dev->GetMem() : nullptr;
@@ -367,11 +366,8 @@ int TransformersAdamWDriver<Tgpu, Tref, Tgrad>::RunForwardGPU()
                                           foundInfDesc,
                                           found_inf_ptr);
 
-        float time = 0.0;
-        miopenGetKernelTime(GetHandle(), &time);
-        kernel_total_time += time;
-        if(i == 0)
-            kernel_first_time = time;
+        if(inflags.GetValueInt("time") == 1)
+            timing.AddKernelTime(GetHandle());
     }
 
     if(inflags.GetValueInt("time") == 1)
@@ -380,8 +376,7 @@ int TransformersAdamWDriver<Tgpu, Tref, Tgrad>::RunForwardGPU()
         if(WALL_CLOCK)
             printf("Wall-clock Time Forward Adam Elapsed: %f ms\n", t.gettime_ms() / iter);
 
-        float kernel_average_time =
-            iter > 1 ? (kernel_total_time - kernel_first_time) / (iter - 1) : kernel_first_time;
+        float kernel_average_time = timing.KernelStatistics().mean;
         printf("GPU Kernel Time Forward Adam Elapsed: %f ms\n", kernel_average_time);
     }
 
@@ -5665,6 +5665,33 @@ MIOPEN_EXPORT miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
                                                  size_t* numSolutions,
                                                  size_t maxSolutions);
 
+#ifdef MIOPEN_BETA_API
+/*! @brief Finds solutions to several problems, e.g. all the convolutions of a model, at once.
+ * Memory is automatically allocated.
+ *
+ * Problems with the same configuration are searched only once. Unless the exhaustive search is
+ * requested, the kernels of the following problems are compiled while the preceding ones are
+ * benchmarked. Preallocated buffers from the options are shared by all the problems.
+ *
+ * @param handle       Handle to execute the kernels
+ * @param problems     Array of the problems to solve
+ * @param numProblems  Amount of the problems
+ * @param options      Find options. When null default values would be used
+ * @param solutions    Pointer to the array of numProblems * maxSolutions results, the results of
+ *                     the i-th problem start at solutions[i * maxSolutions]. Must not be null
+ * @param numSolutions Pointer to the array of numProblems amounts of results. Ignored if null
+ * @param maxSolutions Limits the amount of results per problem
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                                      const miopenProblem_t* problems,
+                                                      size_t numProblems,
+                                                      miopenFindOptions_t options,
+                                                      miopenSolution_t* solutions,
+                                                      size_t* numSolutions,
+                                                      size_t maxSolutions);
+#endif
+
 /*! @brief Values of a tensor or scalar argument for the miopenRunSolution function.
  */
 struct miopenTensorArgument_t
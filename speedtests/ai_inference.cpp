@@ -0,0 +1,184 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+
+#include <driver.hpp>
+
+#include <iostream>
+
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK || MIOPEN_ENABLE_AI_KERNEL_TUNING
+#include <miopen/conv/heuristics/ai_inference.hpp>
+#include <miopen/db_path.hpp>
+
+#if MIOPEN_SPEEDTEST_FDEEP
+#include <fdeep/fdeep.hpp>
+#endif
+
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Measures the first-call load time and the latency per prediction of the AI heuristic models
+// with the native inference code, against frugally-deep when it is available.
+
+namespace miopen {
+namespace ai {
+namespace nn {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(model, "model");
+        add(iterations, "iterations");
+        add(batch, "batch");
+    }
+
+    void run()
+    {
+        const auto path = GetSystemDbPath() / model;
+
+        const auto load = Measure(1, [&] {
+            return Network::FromJson(nlohmann::json::parse(std::ifstream{path}));
+        });
+        std::cout << "Load\tms" << std::endl;
+        std::cout << "Native, from JSON\t" << load.ms << std::endl;
+        std::cout << "Native, compiled\t"
+                  << Measure(1, [&] { return Network::Load(path); }).ms << std::endl;
+        std::cout << "Native, compiled (cached)\t"
+                  << Measure(1, [&] { return Network::Load(path); }).ms << std::endl;
+
+        const auto& network = load.result;
+        const auto inputs   = RandomInputs(network, batch);
+        const auto single   = Slice(network, inputs, 0);
+
+        std::cout << "Prediction\tus/problem" << std::endl;
+        std::cout << "Native\t"
+                  << Measure(iterations, [&] { return network.Predict(single, 1); }).ms * 1000 /
+                         iterations
+                  << std::endl;
+        std::cout << "Native, batch of " << batch << "\t"
+                  << Measure(iterations, [&] { return network.Predict(inputs, batch); }).ms *
+                         1000 / iterations / batch
+                  << std::endl;
+
+#if MIOPEN_SPEEDTEST_FDEEP
+        const auto fdeep_load = Measure(1, [&] {
+            return fdeep::load_model(path.string(), true, fdeep::dev_null_logger);
+        });
+        std::cout << "frugally-deep load\t" << fdeep_load.ms << " ms" << std::endl;
+
+        fdeep::tensors tensors;
+        for(std::size_t i = 0; i < network.GetInputCount(); ++i)
+        {
+            const auto shape = network.GetInputShape(i);
+            tensors.emplace_back(shape.steps == 1 ? fdeep::tensor_shape(shape.width)
+                                                  : fdeep::tensor_shape(shape.steps, shape.width),
+                                 single[i]);
+        }
+        std::cout << "frugally-deep\t"
+                  << Measure(iterations, [&] { return fdeep_load.result.predict(tensors); }).ms *
+                         1000 / iterations
+                  << " us/problem" << std::endl;
+#endif
+    }
+
+private:
+    std::string model = "gfx90a.tn.model";
+    int iterations    = 1000;
+    int batch         = 64;
+
+    template <class T>
+    struct Timed
+    {
+        T result;
+        double ms;
+    };
+
+    template <class F>
+    Timed<std::invoke_result_t<F>> Measure(int n, F f) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 1; i < n; ++i)
+            static_cast<void>(f());
+        auto result        = f();
+        const auto elapsed = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+        return {std::move(result), elapsed};
+    }
+
+    static std::vector<std::vector<float>> RandomInputs(const Network& network, std::size_t n)
+    {
+        std::mt19937 gen;
+        std::uniform_real_distribution<float> values(-1.0f, 1.0f);
+        std::vector<std::vector<float>> inputs(network.GetInputCount());
+        for(std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            inputs[i].resize(n * network.GetInputShape(i).Size());
+            // A single input value is the token fed to a decoder.
+            for(auto& v : inputs[i])
+                v = network.GetInputShape(i).Size() == 1 ? 0.0f : values(gen);
+        }
+        return inputs;
+    }
+
+    static std::vector<std::vector<float>>
+    Slice(const Network& network, const std::vector<std::vector<float>>& inputs, std::size_t n)
+    {
+        std::vector<std::vector<float>> slice;
+        for(std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            const auto size = network.GetInputShape(i).Size();
+            slice.emplace_back(inputs[i].begin() + n * size, inputs[i].begin() + (n + 1) * size);
+        }
+        return slice;
+    }
+};
+
+} // namespace nn
+} // namespace ai
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::ai::nn::SpeedTestDriver>(argc, argv);
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::cout << "AI heuristics are disabled" << std::endl;
+    return 0;
+}
+
+#endif
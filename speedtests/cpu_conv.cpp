@@ -0,0 +1,188 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <cpu_conv.hpp>
+#include <driver.hpp>
+#include <network_data.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Measures the blocked CPU convolution engine against the element-wise reference on the shapes
+// of network_data.hpp. The batch is divided by batch-factor and the problems above max-gflop
+// are skipped, so that the element-wise reference completes in a reasonable time.
+
+namespace cpu_conv {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(batch_factor, "batch-factor");
+        add(max_gflop, "max-gflop");
+        add(layout, "layout");
+    }
+
+    void run()
+    {
+        std::cout << "Problem\tDirection\tElement-wise, ms\tBlocked, ms\tSpeedup\tBitwise"
+                  << std::endl;
+        for(const auto& in_dims : get_inputs(batch_factor))
+            for(const auto& wei_dims : get_weights(batch_factor))
+                Run<2>(in_dims, wei_dims);
+        for(const auto& in_dims : get_3d_conv_input_shapes(batch_factor))
+            for(const auto& wei_dims : get_3d_conv_weight_shapes(batch_factor))
+                Run<3>(in_dims, wei_dims);
+    }
+
+private:
+    int batch_factor   = 32;
+    double max_gflop   = 2.0;
+    std::string layout = "NCHW";
+
+    template <std::size_t ConvDim>
+    void Run(const std::vector<int>& in_dims, const std::vector<int>& wei_dims) const
+    {
+        if(in_dims[1] != wei_dims[1])
+            return;
+
+        auto in_len  = std::vector<std::size_t>(in_dims.begin(), in_dims.end());
+        auto wei_len = std::vector<std::size_t>(wei_dims.begin(), wei_dims.end());
+        auto out_len = std::vector<std::size_t>{in_len[0], wei_len[0]};
+        auto pads    = std::vector<int>{};
+        auto strides = std::vector<int>(ConvDim, 1);
+        auto macs    = static_cast<double>(in_len[0] * wei_len[0] * wei_len[1]);
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            if(wei_len[i + 2] > in_len[i + 2])
+                return;
+            pads.push_back(static_cast<int>(wei_len[i + 2] / 2));
+            out_len.push_back(in_len[i + 2] + 2 * pads[i] - wei_len[i + 2] + 1);
+            macs *= static_cast<double>(out_len[i + 2] * wei_len[i + 2]);
+        }
+        if(2 * macs * 1e-9 > max_gflop)
+            return;
+
+        const auto tensor_layout = ConvDim == 3 ? (layout == "NHWC" ? miopenTensorNDHWC
+                                                                    : miopenTensorNCDHW)
+                                                : (layout == "NHWC" ? miopenTensorNHWC
+                                                                    : miopenTensorNCHW);
+        const auto in  = Random(tensor_layout, in_len);
+        const auto wei = Random(tensor_layout, wei_len);
+        const auto out = Random(tensor_layout, out_len);
+        const auto fi  = PassThru<float>{};
+
+        std::ostringstream problem;
+        for(std::size_t i = 0; i < in_len.size(); ++i)
+            problem << (i == 0 ? "" : "x") << in_len[i];
+        problem << " * ";
+        for(std::size_t i = 0; i < wei_len.size(); ++i)
+            problem << (i == 0 ? "" : "x") << wei_len[i];
+
+        auto out_ref = out;
+        auto out_new = out;
+        Report(
+            problem.str(),
+            "Forward",
+            Measure([&] {
+                cpu_convolution_forward_impl<ConvDim, double>(
+                    in, wei, out_ref, pads, pads, strides, 1, fi, fi);
+            }),
+            Measure([&] {
+                cpu_convolution_forward(ConvDim, in, wei, out_new, pads, strides, strides, 1);
+            }),
+            out_ref.data == out_new.data);
+
+        auto in_ref = in;
+        auto in_new = in;
+        Report(
+            problem.str(),
+            "BackwardData",
+            Measure([&] {
+                cpu_convolution_backward_data_impl<ConvDim, double>(
+                    in_ref, wei, out, pads, strides, strides, 1, fi, fi);
+            }),
+            Measure([&] {
+                cpu_convolution_backward_data(ConvDim, in_new, wei, out, pads, strides, strides, 1);
+            }),
+            in_ref.data == in_new.data);
+
+        auto wei_ref = wei;
+        auto wei_new = wei;
+        Report(
+            problem.str(),
+            "BackwardWeights",
+            Measure([&] {
+                cpu_convolution_backward_weight_impl<ConvDim, double>(
+                    in, wei_ref, out, pads, strides, strides, 1, fi, fi);
+            }),
+            Measure([&] {
+                cpu_convolution_backward_weight(
+                    ConvDim, in, wei_new, out, pads, strides, strides, 1);
+            }),
+            wei_ref.data == wei_new.data);
+    }
+
+    static tensor<float> Random(miopenTensorLayout_t layout, const std::vector<std::size_t>& dims)
+    {
+        auto result = tensor<float>{layout, dims};
+        auto gen    = std::mt19937{};
+        auto dist   = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+        for(auto& value : result.data)
+            value = dist(gen);
+        return result;
+    }
+
+    template <class F>
+    static double Measure(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    static void
+    Report(const std::string& problem, const char* direction, double ref, double blocked, bool same)
+    {
+        std::cout << problem << "\t" << direction << "\t" << std::fixed << std::setprecision(2)
+                  << ref << "\t" << blocked << "\t" << ref / blocked << "\t"
+                  << (same ? "yes" : "no") << std::endl;
+    }
+};
+
+} // namespace cpu_conv
+
+int main(int argc, const char* argv[])
+{
+    test_drive<cpu_conv::SpeedTestDriver>(argc, argv);
+    return 0;
+}
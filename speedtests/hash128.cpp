@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fnv1a.hpp>
+#include <miopen/hash128.hpp>
+#include <miopen/md5.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Measures the hashes of the internal keys on the inputs of the typical sizes: a network config,
+// a db key, the compiler options of a kernel and a code object.
+
+namespace miopen {
+namespace hash128 {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(megabytes, "megabytes"); }
+
+    void run()
+    {
+        std::cout << "Bytes\tHash\tns/call\tGB/s" << std::endl;
+        for(const auto size : {64, 256, 4096, 1024 * 1024})
+        {
+            auto data = std::string(size, ' ');
+            for(auto i = 0; i < size; ++i)
+                data[i] = static_cast<char>('0' + i * 7 % 75);
+            const auto calls = std::max<std::int64_t>(
+                1, static_cast<std::int64_t>(megabytes) * 1024 * 1024 / size);
+
+            Report(size, "md5", calls, [&] { return md5(data).size(); });
+            Report(size, "Fnv1a64", calls, [&] { return Fnv1a64(data); });
+            Report(size, "Hash128", calls, [&] { return Hash128(data).lo; });
+        }
+    }
+
+private:
+    int megabytes = 256;
+
+    template <class F>
+    static void Report(int size, const std::string& name, std::int64_t calls, F f)
+    {
+        // Accumulated to keep the compiler from optimizing the calls out.
+        std::uint64_t sink = 0;
+        const auto start   = std::chrono::steady_clock::now();
+        for(std::int64_t i = 0; i < calls; ++i)
+            sink += f();
+        const auto elapsed = std::chrono::duration<double, std::nano>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+        if(sink == 1)
+            std::cerr << sink << std::endl;
+        std::cout << size << '\t' << name << '\t' << elapsed / calls << '\t'
+                  << size * static_cast<double>(calls) / elapsed << std::endl;
+    }
+};
+
+} // namespace hash128
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::hash128::SpeedTestDriver>(argc, argv);
+    return 0;
+}
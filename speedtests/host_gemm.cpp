@@ -0,0 +1,156 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/host_gemm.hpp>
+
+#include <driver.hpp>
+
+#include <half/half.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Measures the host GEMM used by the reference implementations against the naive loop it
+// replaced in ADNN_mm_cpu. The default size is a typical LSTM step: the batch times the hidden
+// state against the four gates of a 512 wide layer.
+
+namespace miopen {
+namespace host_gemm {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(m, "m");
+        add(n, "n");
+        add(k, "k");
+        add(trans_a, "trans-a");
+        add(trans_b, "trans-b");
+        add(iterations, "iterations");
+    }
+
+    void run()
+    {
+        std::cout << "GEMM " << m << "x" << n << "x" << k << ", trans_a " << trans_a
+                  << ", trans_b " << trans_b << "\tGFLOP/s" << std::endl;
+        Run<float>("float");
+        Run<double>("double");
+        Run<half_float::half>("half");
+    }
+
+private:
+    int m          = 64;
+    int n          = 2048;
+    int k          = 512;
+    int trans_a    = 0;
+    int trans_b    = 1;
+    int iterations = 10;
+
+    template <class T>
+    void Run(const std::string& type) const
+    {
+        const auto rows  = static_cast<std::size_t>(m);
+        const auto cols  = static_cast<std::size_t>(n);
+        const auto inner = static_cast<std::size_t>(k);
+        const auto lda   = trans_a != 0 ? rows : inner;
+        const auto ldb   = trans_b != 0 ? inner : cols;
+        const auto a     = Random<T>(rows * inner);
+        const auto b     = Random<T>(inner * cols);
+        auto c           = std::vector<T>(rows * cols);
+
+        const auto naive = Measure([&] { Naive(a.data(), lda, b.data(), ldb, c.data()); });
+        const auto fast  = Measure([&] {
+            Gemm(trans_a != 0,
+                 trans_b != 0,
+                 rows,
+                 cols,
+                 inner,
+                 1.0,
+                 a.data(),
+                 lda,
+                 b.data(),
+                 ldb,
+                 0.0,
+                 c.data(),
+                 cols);
+        });
+
+        std::cout << "Naive loop, " << type << "\t" << naive << std::endl;
+        std::cout << "Host GEMM, " << type << "\t" << fast << std::endl;
+    }
+
+    template <class F>
+    double Measure(F f) const
+    {
+        f();
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+            f();
+        const auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return 2.0 * m * n * k * iterations / seconds * 1e-9;
+    }
+
+    template <class T>
+    static std::vector<T> Random(std::size_t size)
+    {
+        std::mt19937 gen;
+        std::uniform_real_distribution<float> values(-1.0f, 1.0f);
+        std::vector<T> result(size);
+        for(auto& value : result)
+            value = static_cast<T>(values(gen));
+        return result;
+    }
+
+    /// The loop of the former ADNN_mm_cpu, accumulating in T.
+    template <class T>
+    void Naive(const T* a, std::size_t lda, const T* b, std::size_t ldb, T* c) const
+    {
+        for(auto i = 0; i < m; ++i)
+        {
+            for(auto j = 0; j < n; ++j)
+            {
+                auto x = static_cast<T>(0);
+                for(auto p = 0; p < k; ++p)
+                    x = static_cast<T>(x + (trans_a != 0 ? a[p * lda + i] : a[i * lda + p]) *
+                                               (trans_b != 0 ? b[j * ldb + p] : b[p * ldb + j]));
+                c[i * n + j] = x;
+            }
+        }
+    }
+};
+
+} // namespace host_gemm
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::host_gemm::SpeedTestDriver>(argc, argv);
+    return 0;
+}
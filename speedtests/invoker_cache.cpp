@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/invoker_cache.hpp>
+#include <miopen/names.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Measures the per-call overhead of the invoker lookup done by every immediate mode call,
+// against the previous two-level std::map layout (guarded by a mutex to be thread-safe).
+
+namespace miopen {
+namespace invoker_cache {
+
+class LegacyCache
+{
+public:
+    void Register(const std::string& config, const std::string& solver, const Invoker& invoker)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        invokers[config].insert({solver, invoker});
+    }
+
+    std::optional<Invoker> Get(const std::string& config, const std::string& solver) const
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        const auto item = invokers.find(config);
+        if(item == invokers.end())
+            return std::nullopt;
+        const auto invoker = item->second.find(solver);
+        if(invoker == item->second.end())
+            return std::nullopt;
+        return invoker->second;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::map<std::string, std::map<std::string, Invoker>> invokers;
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(problems, "problems");
+        add(solvers, "solvers");
+        add(lookups, "lookups");
+    }
+
+    void run()
+    {
+        std::vector<NetworkConfig> configs;
+        std::vector<std::string> solver_ids;
+        for(auto i = 0; i < problems; ++i)
+        {
+            // Typical length and shape of a convolution network config.
+            configs.emplace_back("64x" + std::to_string(i) +
+                                 "x56x56x3x3x64x56x56x32xNCHWxFP32x1x1x1x1x1x1x1xF");
+        }
+        for(auto i = 0; i < solvers; ++i)
+            solver_ids.emplace_back("ConvSolverWithATypicallyLongName" + std::to_string(i));
+
+        const Invoker invoker = [](const Handle&, const AnyInvokeParams&) {};
+        InvokerCache cache;
+        LegacyCache legacy;
+        for(const auto& config : configs)
+        {
+            for(const auto& solver : solver_ids)
+            {
+                cache.Register(config, solver, invoker);
+                legacy.Register(config.ToString(), solver, invoker);
+            }
+        }
+
+        std::cout << "Threads\tInvokerCache, ns/call\tLegacy, ns/call" << std::endl;
+        const auto max_threads = std::max(1U, std::thread::hardware_concurrency());
+        for(auto threads = 1U; threads <= max_threads; threads *= 2)
+        {
+            const auto sharded = Measure(threads, configs, solver_ids, [&](auto& c, auto& s) {
+                return cache.GetInvoker(c, s).has_value();
+            });
+            const auto baseline = Measure(threads, configs, solver_ids, [&](auto& c, auto& s) {
+                return legacy.Get(c.ToString(), s).has_value();
+            });
+            std::cout << threads << '\t' << sharded << '\t' << baseline << std::endl;
+        }
+    }
+
+private:
+    int problems = 1000;
+    int solvers  = 20;
+    int lookups  = 1000000;
+
+    template <class F>
+    double Measure(unsigned threads,
+                   const std::vector<NetworkConfig>& configs,
+                   const std::vector<std::string>& solver_ids,
+                   F lookup) const
+    {
+        std::atomic<std::size_t> found{0};
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+        for(auto t = 0U; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                std::size_t local = 0;
+                for(auto i = 0; i < lookups; ++i)
+                {
+                    const auto n = i * 7919 + t;
+                    local += lookup(configs[n % configs.size()], solver_ids[n % solver_ids.size()])
+                                 ? 1
+                                 : 0;
+                }
+                found += local;
+            });
+        }
+        for(auto& worker : workers)
+            worker.join();
+        const auto elapsed = std::chrono::duration<double, std::nano>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+
+        if(found != static_cast<std::size_t>(lookups) * threads)
+            std::cerr << "Lookup failed" << std::endl;
+        // Wall time per call of a single thread.
+        return elapsed / lookups;
+    }
+};
+
+} // namespace invoker_cache
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::invoker_cache::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/kern_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <driver.hpp>
+#include <random.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Measures the time to load every kernel of a kernel cache, like the first run of an application
+// using the installed kernels does, with the records recompressed with each available codec.
+// Uses the given kdb if any, otherwise synthetic records. The records are loaded one by one as
+// on the first use of each kernel, and all at once as by the warm-up of the handle.
+
+namespace miopen {
+namespace kern_db_load {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(kdb, "kdb");
+        add(records, "records");
+        add(dictionary_size, "dictionary-size");
+    }
+
+    void run()
+    {
+#if MIOPEN_ENABLE_SQLITE && MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        const auto configs = kdb.empty() ? MakeRecords() : ReadConfigs(kdb);
+        const std::vector<KernDbCodec> codecs = {
+            KernDbCodec::Bz2, KernDbCodec::Zstd, KernDbCodec::Lz4};
+
+        std::cout << "Codec\tRecords\tMiB\tLoad, ms\tBulk load, ms" << std::endl;
+        for(const auto codec : codecs)
+        {
+            if(!kern_db_codec::IsSupported(codec))
+                continue;
+
+            const TempFile file{"kern-db-codec"};
+            if(kdb.empty())
+            {
+                auto db = KernDb{DbKinds::KernelDb, file, false};
+                db.SetCodec(KernDbCodec::Bz2);
+                for(const auto& cfg : configs)
+                    db.StoreRecordUnsafe(cfg);
+            }
+            else
+            {
+                fs::copy_file(kdb, file.Path(), fs::copy_options::overwrite_existing);
+            }
+
+            {
+                auto db = KernDb{DbKinds::KernelDb, file, false};
+                db.Recompress(codec, codec == KernDbCodec::Zstd ? dictionary_size : 0);
+            }
+
+            auto loaded       = std::size_t{0};
+            const auto single = Measure([&]() {
+                auto db = KernDb{DbKinds::KernelDb, file, false};
+                for(const auto& cfg : configs)
+                    loaded += db.FindRecordUnsafe(cfg) ? 1 : 0;
+            });
+            const auto bulk = Measure([&]() {
+                auto db = KernDb{DbKinds::KernelDb, file, false};
+                db.FindRecordsUnsafe(configs);
+            });
+
+            std::cout << kern_db_codec::ToString(codec) << '\t' << loaded << '\t'
+                      << fs::file_size(file.Path()) / (1024.0 * 1024.0) << '\t' << single
+                      << '\t' << bulk << std::endl;
+        }
+#endif
+    }
+
+private:
+    std::string kdb;
+    int records         = 1000;
+    int dictionary_size = 64 * 1024;
+
+    // The database is opened within, so the dictionary is loaded as part of the measurement.
+    template <class F>
+    static double Measure(F f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+#if MIOPEN_ENABLE_SQLITE && MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    static std::vector<KernelConfig> ReadConfigs(const fs::path& path)
+    {
+        auto sql     = SQLite{path, true};
+        auto rows    = sql.Exec("SELECT kernel_name, kernel_args FROM kern_db;");
+        auto configs = std::vector<KernelConfig>{};
+        for(auto& row : rows)
+        {
+            configs.emplace_back();
+            configs.back().kernel_name = row["kernel_name"];
+            configs.back().kernel_args = row["kernel_args"];
+        }
+        return configs;
+    }
+
+    // Code objects of a family share most of their contents: the ELF layout, the metadata and
+    // a good part of the instructions. Each record combines a few of the shared chunks.
+    std::vector<KernelConfig> MakeRecords() const
+    {
+        auto chunks = std::vector<std::vector<char>>(16);
+        for(auto& chunk : chunks)
+        {
+            chunk.resize(4096);
+            for(auto& c : chunk)
+                c = static_cast<char>(prng::gen_0_to_B(256) < 64 ? prng::gen_0_to_B(256)
+                                                                    : prng::gen_0_to_B(16));
+        }
+
+        auto configs = std::vector<KernelConfig>(records);
+        for(auto i = 0; i < records; ++i)
+        {
+            auto& cfg       = configs[i];
+            cfg.kernel_name = "kernel" + std::to_string(i % 50) + ".s";
+            cfg.kernel_args = "-DINDEX=" + std::to_string(i);
+            for(auto j = 0; j < 8; ++j)
+            {
+                const auto& chunk = chunks[prng::gen_0_to_B(chunks.size())];
+                cfg.kernel_blob.insert(cfg.kernel_blob.end(), chunk.begin(), chunk.end());
+            }
+        }
+        return configs;
+    }
+#endif
+};
+
+} // namespace kern_db_load
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kern_db_load::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/write_file.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Measures the per-compile overhead of exporting the kernel headers to the build directory,
+// as done by HipBuild, for all the embedded headers against the include closure of the kernel.
+// The hiprtc path registers the same headers with the program, which scales alike.
+
+namespace miopen {
+namespace kernel_includes {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(iterations, "iterations"); }
+
+    void run()
+    {
+        const std::vector<fs::path> kernels = {
+            "MIOpenLayerNorm.cpp",
+            "MIOpenReduceExtreme.cpp",
+            "naive_conv.cpp",
+            "batched_transpose.cpp",
+            "static_kernel_gridwise_convolution_implicit_gemm_v4r4_nchw_kcyx_nkhw.cpp",
+        };
+
+        std::cout << "Kernel\tHeaders\tKiB\tAll headers, ms\tClosure, ms" << std::endl;
+        for(const auto& name : kernels)
+        {
+            const auto src      = GetKernelSrc(name);
+            const auto& closure = GetKernelIncList(name, src);
+            auto bytes          = std::size_t{0};
+            for(const auto& header : closure)
+                bytes += GetKernelInc(header).size();
+
+            const auto all = Measure(name, [&]() -> const auto& { return GetKernelIncList(); });
+            const auto minimal =
+                Measure(name, [&]() -> const auto& { return GetKernelIncList(name, src); });
+            std::cout << name << '\t' << closure.size() << '\t' << bytes / 1024 << '\t' << all
+                      << '\t' << minimal << std::endl;
+        }
+    }
+
+private:
+    int iterations = 20;
+
+    template <class F>
+    double Measure(const fs::path& name, F get_list) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+        {
+            // Like HipBuild: a new directory per compile, the headers and the source.
+            const TmpDir tmp_dir{name.stem().string()};
+            for(const auto& header : get_list())
+                WriteFile(GetKernelInc(header), tmp_dir / header.get().string());
+            WriteFile(GetKernelSrc(name), tmp_dir / name.string());
+        }
+        const auto elapsed = std::chrono::duration<double, std::milli>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+        return elapsed / iterations;
+    }
+};
+
+} // namespace kernel_includes
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kernel_includes::SpeedTestDriver>(argc, argv);
+    return 0;
+}
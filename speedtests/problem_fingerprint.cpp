@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/problem_fingerprint.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Measures the host overhead of computing the problem keys used by the find db, the perf db
+// and the invoker cache lookups, against the previous ostringstream-based formatting.
+
+namespace miopen {
+namespace conv {
+
+// The previous implementation of ProblemDescription::MakeNetworkConfig().
+NetworkConfig LegacyNetworkConfig(const ProblemDescription& problem)
+{
+    const auto dhw = [&](std::ostream& ss, int64_t d, int64_t h, int64_t w) -> std::ostream& {
+        if(problem.GetSpatialDims() > 2)
+            ss << d << 'x';
+        return ss << h << 'x' << w;
+    };
+
+    std::ostringstream ss;
+    ss << problem.GetInChannels() << 'x';
+    dhw(ss, problem.GetInDepth(), problem.GetInHeight(), problem.GetInWidth()) << 'x';
+    dhw(ss, problem.GetWeightsDepth(), problem.GetWeightsHeight(), problem.GetWeightsWidth());
+    ss << 'x' << problem.GetOutChannels() << 'x';
+    dhw(ss, problem.GetOutDepth(), problem.GetOutHeight(), problem.GetOutWidth());
+    ss << 'x' << problem.GetInBatchSize();
+    if((problem.GetInLayout() == "NCHW" && problem.GetWeightsLayout() == "NCHW" &&
+        problem.GetOutLayout() == "NCHW") ||
+       (problem.GetInLayout() == "NCDHW" && problem.GetWeightsLayout() == "NCDHW" &&
+        problem.GetOutLayout() == "NCDHW"))
+    {
+        ss << 'x' << problem.GetInLayout();
+    }
+    else
+    {
+        ss << 'x' << problem.GetInLayout();
+        ss << 'x' << problem.GetWeightsLayout();
+        ss << 'x' << problem.GetOutLayout();
+    }
+    ss << 'x'
+       << EncodeDataTypesForKey(
+              problem.GetInDataType(), problem.GetWeightsDataType(), problem.GetOutDataType());
+
+    std::ostringstream optional;
+    if(const auto ct = problem.GetInCastType())
+        optional << "ci" << GetDataTypeName(*ct);
+    if(const auto ct = problem.GetWeightsCastType())
+        optional << "cw" << GetDataTypeName(*ct);
+    if(const auto ct = problem.GetOutCastType())
+        optional << "co" << GetDataTypeName(*ct);
+    if(!optional.str().empty())
+        ss << 'x' << optional.str();
+
+    ss << 'x';
+    dhw(ss, problem.GetPadD(), problem.GetPadH(), problem.GetPadW()) << 'x';
+    dhw(ss,
+        problem.GetKernelStrideD(),
+        problem.GetKernelStrideH(),
+        problem.GetKernelStrideW())
+        << 'x';
+    dhw(ss, problem.GetDilationD(), problem.GetDilationH(), problem.GetDilationW());
+    ss << 'x' << problem.GetGroupCount();
+    ss << 'x' << problem.GetDirectionStr();
+    ss << 'x' << problem.GetAlphaBetaCaseStr();
+
+    return NetworkConfig{ss.str()};
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(iterations, "iterations"); }
+
+    void run()
+    {
+        const auto in      = TensorDescriptor{miopenHalf, miopenTensorNHWC, {64, 256, 28, 28}};
+        const auto weights = TensorDescriptor{miopenHalf, miopenTensorNHWC, {512, 256, 3, 3}};
+        const auto out     = TensorDescriptor{miopenHalf, miopenTensorNHWC, {64, 512, 14, 14}};
+        const auto conv    = ConvolutionDescriptor{{1, 1}, {2, 2}, {1, 1}};
+        const auto problem = ProblemDescription{in, weights, out, conv, Direction::Forward};
+
+        if(LegacyNetworkConfig(problem).ToString() != problem.MakeNetworkConfig().ToString())
+            std::cerr << "Network config mismatch" << std::endl;
+
+        std::cout << "Key\tns/call" << std::endl;
+        std::cout << "Legacy network config\t"
+                  << Measure([&] { return LegacyNetworkConfig(problem).Fingerprint(); })
+                  << std::endl;
+        std::cout << "Network config\t"
+                  << Measure([&] { return problem.MakeNetworkConfig().Fingerprint(); })
+                  << std::endl;
+        std::cout << "Legacy db key\t" << Measure([&] {
+            std::ostringstream ss;
+            problem.Serialize(ss);
+            return static_cast<std::uint64_t>(ss.str().size());
+        }) << std::endl;
+        std::cout << "Db key\t" << Measure([&] {
+            std::string key;
+            problem.MakeDbKey(key);
+            return static_cast<std::uint64_t>(key.size());
+        }) << std::endl;
+        std::cout << "Fingerprint\t" << Measure([&] { return problem.MakeFingerprint().lo; })
+                  << std::endl;
+        std::cout << "Construction with fingerprint\t" << Measure([&] {
+            return ProblemDescription{in, weights, out, conv, Direction::Forward}
+                .MakeFingerprint()
+                .lo;
+        }) << std::endl;
+    }
+
+private:
+    int iterations = 1000000;
+
+    template <class F>
+    double Measure(F f) const
+    {
+        // Accumulated to keep the compiler from optimizing the calls out.
+        std::uint64_t sink = 0;
+        const auto start   = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+            sink += f();
+        const auto elapsed = std::chrono::duration<double, std::nano>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+        if(sink == 1)
+            std::cerr << sink << std::endl;
+        return elapsed / iterations;
+    }
+};
+
+} // namespace conv
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::conv::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_strategy.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// Compares the tuning search strategies on a synthetic cost model resembling an implicit GEMM
+// tuning space: four power-of-two tile parameters and a categorical layout, with a resource
+// limit making a part of the space fail. No kernels are run, so this works with any backend.
+
+namespace miopen {
+namespace search_strategy {
+
+struct SyntheticSpace
+{
+    std::vector<std::vector<float>> features;
+    std::vector<std::optional<float>> costs;
+    float best = std::numeric_limits<float>::max();
+
+    explicit SyntheticSpace(unsigned seed)
+    {
+        std::mt19937 rng{seed};
+        std::normal_distribution<float> noise{0.0f, 0.03f};
+        std::uniform_real_distribution<float> optimum{1.0f, 6.0f};
+        const float opt[4] = {optimum(rng), optimum(rng), optimum(rng), optimum(rng)};
+
+        for(auto layout : {"NCHW", "NHWC"})
+        {
+            for(auto a = 0; a < 8; ++a)
+            {
+                for(auto b = 0; b < 8; ++b)
+                {
+                    for(auto c = 0; c < 8; ++c)
+                    {
+                        for(auto d = 0; d < 8; ++d)
+                        {
+                            const auto config = std::to_string(1 << a) + "," +
+                                                std::to_string(1 << b) + "," +
+                                                std::to_string(1 << c) + "," +
+                                                std::to_string(1 << d) + "," + layout;
+                            features.emplace_back(solver::GetSearchFeatures(config));
+
+                            if(a + b > 11)
+                            {
+                                costs.emplace_back(std::nullopt);
+                                continue;
+                            }
+
+                            const auto sq = [](float x) { return x * x; };
+                            auto cost = 1.0f + 0.3f * sq(a - opt[0]) + 0.2f * sq(b - opt[1]) +
+                                        0.1f * sq(c - opt[2]) + 0.05f * sq(d - opt[3]) +
+                                        0.05f * (a - opt[0]) * (b - opt[1]) +
+                                        0.2f * std::abs(std::sin(1.7f * (a + 2 * c + d)));
+                            if(layout == std::string{"NHWC"})
+                                cost *= 1.15f;
+                            cost *= 1.0f + noise(rng);
+                            costs.emplace_back(cost);
+                            best = std::min(best, cost);
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(budget, "budget");
+        add(trials, "trials");
+        add(seed, "seed");
+    }
+
+    void run()
+    {
+        std::cout << "Strategy\tbest/optimum\tmeasurements to 5%\tfound 5%" << std::endl;
+        Run("random", solver::SearchStrategyKind::Random);
+        Run("surrogate", solver::SearchStrategyKind::Surrogate);
+    }
+
+private:
+    int budget = 200;
+    int trials = 20;
+    int seed   = 1;
+
+    void Run(const std::string& name, solver::SearchStrategyKind kind) const
+    {
+        auto ratio_sum  = 0.0;
+        auto steps_sum  = 0.0;
+        auto n_found_5p = 0;
+
+        for(auto trial = 0; trial < trials; ++trial)
+        {
+            const SyntheticSpace space(seed + trial);
+            auto strategy =
+                solver::MakeSearchStrategy(kind, space.features, budget, seed * 1000 + trial);
+
+            auto best  = std::numeric_limits<float>::max();
+            auto steps = 0;
+            auto hit   = std::optional<int>{};
+
+            while(const auto index = strategy->Next())
+            {
+                ++steps;
+                const auto& cost = space.costs[*index];
+                strategy->Report(*index, cost);
+                if(!cost)
+                    continue;
+                best = std::min(best, *cost);
+                if(!hit && best <= space.best * 1.05f)
+                    hit = steps;
+            }
+
+            ratio_sum += best / space.best;
+            if(hit)
+            {
+                steps_sum += *hit;
+                ++n_found_5p;
+            }
+        }
+
+        std::cout << name << '\t' << ratio_sum / trials << '\t'
+                  << (n_found_5p > 0 ? steps_sum / n_found_5p : 0.0) << '\t' << n_found_5p << '/'
+                  << trials << std::endl;
+    }
+};
+
+} // namespace search_strategy
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::search_strategy::SpeedTestDriver>(argc, argv);
+    return 0;
+}
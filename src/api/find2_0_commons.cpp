@@ -303,6 +303,49 @@ miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
     });
 }
 
+miopenStatus_t miopenFindSolutionsBatch(miopenHandle_t handle,
+                                        const miopenProblem_t* problems,
+                                        size_t numProblems,
+                                        miopenFindOptions_t options,
+                                        miopenSolution_t* solutions,
+                                        size_t* numSolutions,
+                                        size_t maxSolutions)
+{
+    MIOPEN_LOG_FUNCTION(
+        handle, problems, numProblems, options, solutions, numSolutions, maxSolutions);
+
+    return miopen::try_([&] {
+        auto& handle_deref = miopen::deref(handle);
+
+        auto problems_deref = std::vector<const miopen::ProblemContainer*>{};
+        problems_deref.reserve(numProblems);
+        for(std::size_t i = 0; i < numProblems; ++i)
+        {
+            const auto& problem_deref = miopen::deref(problems[i]);
+            std::visit([](auto&& problem) { problem.LogDriverCommand(); }, problem_deref.item);
+            problems_deref.push_back(&problem_deref);
+        }
+
+        const auto& options_deref =
+            options == nullptr ? miopen::FindOptions{} : miopen::deref(options);
+
+        auto solutions_deref =
+            miopen::FindSolutions(handle_deref, problems_deref, options_deref, maxSolutions);
+
+        for(std::size_t i = 0; i < numProblems; ++i)
+        {
+            for(std::size_t j = 0; j < solutions_deref[i].size(); ++j)
+            {
+                auto& theSolution = miopen::deref(solutions + i * maxSolutions + j);
+                theSolution       = new miopen::Solution{std::move(solutions_deref[i][j])};
+            }
+
+            if(numSolutions != nullptr)
+                numSolutions[i] = solutions_deref[i].size();
+        }
+    });
+}
+
 inline std::ostream& operator<<(std::ostream& stream, const miopenTensorArgument_t& tensor)
 {
     switch(tensor.id)
@@ -37,15 +37,18 @@
 #include <miopen/sqlite_db.hpp>
 #endif
 #include <miopen/kern_db.hpp>
+#include <miopen/kern_file_cache.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/filesystem.hpp>
 #include <fstream>
 #include <iostream>
+#include <system_error>
 
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DISABLE_CACHE)
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_CUSTOM_CACHE_DIR)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_KERN_CACHE_MAX_SIZE, 4096) // MiB, 0 for no limit
 
 namespace miopen {
 
@@ -123,6 +126,11 @@ bool IsCacheDisabled()
 #endif
 }
 
+std::uint64_t GetKernFileCacheMaxSize()
+{
+    return env::value(MIOPEN_KERN_CACHE_MAX_SIZE) * 1024 * 1024;
+}
+
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
 KDb GetDb(const TargetProperties& target, size_t num_cu)
@@ -149,6 +157,31 @@ fs::path GetCacheFile(const std::string& device, const fs::path& name, const std
     return GetCachePath(false) / miopen::md5(device + ":" + args) / filename;
 }
 
+std::vector<ProgramKey> ReadProgramList(const fs::path& path)
+{
+    std::ifstream file{path};
+    if(!file)
+        MIOPEN_THROW(miopenStatusBadParm, "Unable to open the program list: " + path.string());
+
+    std::vector<ProgramKey> programs;
+    std::string line;
+    for(auto line_num = 1; std::getline(file, line); ++line_num)
+    {
+        // The other entries of a kernel manifest start with '@'.
+        if(line.empty() || line.front() == '#' || line.front() == '@')
+            continue;
+        const auto tab = line.find('\t');
+        if(tab == std::string::npos || tab == 0)
+        {
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Invalid program list entry at " + path.string() + ":" +
+                             std::to_string(line_num));
+        }
+        programs.emplace_back(line.substr(0, tab), line.substr(tab + 1));
+    }
+    return programs;
+}
+
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
 std::vector<char> LoadBinary(const TargetProperties& target,
                              const size_t num_cu,
@@ -177,6 +210,35 @@ std::vector<char> LoadBinary(const TargetProperties& target,
     }
 }
 
+std::vector<std::vector<char>> LoadBinaries(const TargetProperties& target,
+                                            const size_t num_cu,
+                                            const std::vector<ProgramKey>& programs)
+{
+    auto binaries = std::vector<std::vector<char>>(programs.size());
+    if(miopen::IsCacheDisabled() || programs.empty())
+        return binaries;
+
+    auto db = GetDb(target, num_cu);
+
+    std::vector<KernelConfig> cfgs;
+    cfgs.reserve(programs.size());
+    for(const auto& program : programs)
+        cfgs.push_back({make_object_file_name(program.first), program.second, {}});
+
+    auto records = db.FindRecords(cfgs);
+    auto loaded  = std::size_t{0};
+    for(std::size_t i = 0; i < records.size(); ++i)
+    {
+        if(!records[i])
+            continue;
+        binaries[i] = std::move(*records[i]);
+        ++loaded;
+    }
+
+    MIOPEN_LOG_I2("Loaded " << loaded << " of " << programs.size() << " binaries");
+    return binaries;
+}
+
 void SaveBinary(const std::vector<char>& hsaco,
                 const TargetProperties& target,
                 const std::size_t num_cu,
@@ -195,24 +257,42 @@ void SaveBinary(const std::vector<char>& hsaco,
     db.StoreRecord(cfg);
 }
 #else
+KernFileCache& GetKernFileCache()
+{
+    static auto cache =
+        KernFileCache{GetCachePath(false) / KernFileCache::DirName, GetKernFileCacheMaxSize()};
+    return cache;
+}
+
+static std::string
+GetKernFileCacheKey(const std::string& device, const fs::path& name, const std::string& args)
+{
+    return device + ":" + args + ":" + make_object_file_name(name).string();
+}
+
 fs::path LoadBinary(const TargetProperties& target,
                     const size_t num_cu,
                     const fs::path& name,
                     const std::string& args)
 {
-    if(miopen::IsCacheDisabled())
+    if(miopen::IsCacheDisabled() || GetCachePath(false).empty())
         return {};
 
     (void)num_cu;
-    auto f = GetCacheFile(target.DbId(), name, args);
-    if(fs::exists(f))
-    {
+    const auto key = GetKernFileCacheKey(target.DbId(), name, args);
+    auto f         = GetKernFileCache().Find(key);
+    if(!f.empty())
         return f;
-    }
-    else
-    {
+
+    // Moves the binaries of the previous layout over on the first use.
+    const auto legacy = GetCacheFile(target.DbId(), name, args);
+    if(!fs::exists(legacy))
         return {};
-    }
+    MIOPEN_LOG_I2("Moving " << legacy << " to the kernel cache");
+    f          = GetKernFileCache().Store(legacy, key);
+    auto error = std::error_code{};
+    fs::remove(legacy.parent_path(), error);
+    return f;
 }
 
 fs::path SaveBinary(const fs::path& binary_path,
@@ -225,12 +305,15 @@ fs::path SaveBinary(const fs::path& binary_path,
         fs::remove(binary_path);
         return {};
     }
+    else if(GetCachePath(false).empty())
+    {
+        fs::remove(binary_path);
+        return {};
+    }
     else
     {
-        auto p = GetCacheFile(target.DbId(), name, args);
-        fs::create_directories(p.parent_path());
-        fs::rename(binary_path, p);
-        return p;
+        return GetKernFileCache().Store(binary_path,
+                                        GetKernFileCacheKey(target.DbId(), name, args));
     }
 }
 #endif
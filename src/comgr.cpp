@@ -858,7 +858,8 @@ public:
         // of the addkernels tool. We don't do that for HIP sources, and, therefore
         // have to export include files prior compilation.
         // Note that we do not need any "subdirs" in the include "pathnames" so far.
-        const auto inc_names = miopen::GetKernelIncList();
+        // Only the headers the source actually includes are exported.
+        const auto inc_names = miopen::GetKernelIncList(src_name, src_text);
         include_names.reserve(inc_names.size());
         for(const auto& inc_name : inc_names)
         {
@@ -0,0 +1,564 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_server.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/hash128.hpp>
+#include <miopen/kern_file_cache.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/process.hpp>
+#include <miopen/thread_pool.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/write_file.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_COMPILE_SERVER)
+
+namespace miopen {
+namespace compile_server {
+
+fs::path GetSocketPath() { return env::value(MIOPEN_COMPILE_SERVER); }
+
+#ifndef _WIN32
+
+namespace {
+
+constexpr std::string_view Magic = "miopen-compile-server 1";
+// Bounds the allocations made for a malformed message.
+constexpr std::uint64_t MaxMessageSize = 64 * 1024 * 1024;
+
+class Socket
+{
+public:
+    explicit Socket(int fd_ = -1) : fd(fd_) {}
+    Socket(Socket&& other) noexcept : fd(std::exchange(other.fd, -1)) {}
+    Socket& operator=(Socket&& other) noexcept
+    {
+        std::swap(fd, other.fd);
+        return *this;
+    }
+    ~Socket()
+    {
+        if(fd >= 0)
+            ::close(fd);
+    }
+
+    int Get() const { return fd; }
+    explicit operator bool() const { return fd >= 0; }
+
+private:
+    int fd;
+};
+
+bool SendAll(int fd, const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const char*>(data);
+    while(size > 0)
+    {
+        // The peer may be gone, which shall not kill the process with SIGPIPE.
+        const auto sent = ::send(fd, bytes, size, MSG_NOSIGNAL);
+        if(sent < 0 && errno == EINTR)
+            continue;
+        if(sent <= 0)
+            return false;
+        bytes += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+bool ReceiveAll(int fd, void* data, std::size_t size)
+{
+    auto* bytes = static_cast<char*>(data);
+    while(size > 0)
+    {
+        const auto received = ::recv(fd, bytes, size, 0);
+        if(received < 0 && errno == EINTR)
+            continue;
+        if(received <= 0)
+            return false;
+        bytes += received;
+        size -= static_cast<std::size_t>(received);
+    }
+    return true;
+}
+
+// The messages are strings prefixed with their size, both ends are on the same host.
+bool Send(int fd, std::string_view message)
+{
+    const auto size = static_cast<std::uint64_t>(message.size());
+    return SendAll(fd, &size, sizeof(size)) && SendAll(fd, message.data(), message.size());
+}
+
+bool Receive(int fd, std::string& message)
+{
+    auto size = std::uint64_t{0};
+    if(!ReceiveAll(fd, &size, sizeof(size)) || size > MaxMessageSize)
+        return false;
+    message.resize(size);
+    return ReceiveAll(fd, message.data(), message.size());
+}
+
+bool MakeAddress(const fs::path& socket, sockaddr_un& address)
+{
+    const auto& name = socket.native();
+    address          = sockaddr_un{};
+    if(name.empty() || name.size() >= sizeof(address.sun_path))
+        return false;
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, name.c_str(), name.size() + 1);
+    return true;
+}
+
+Socket Connect(const fs::path& socket)
+{
+    auto address = sockaddr_un{};
+    if(!MakeAddress(socket, address))
+        return Socket{};
+    auto connection = Socket{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+    const auto* to  = reinterpret_cast<const sockaddr*>(&address);
+    if(!connection || ::connect(connection.Get(), to, sizeof(address)) != 0)
+        return Socket{};
+    return connection;
+}
+
+/// The files of a directory and the digests of their contents.
+using Snapshot = std::map<fs::path, Digest128>;
+
+Snapshot TakeSnapshot(const fs::path& dir)
+{
+    auto snapshot = Snapshot{};
+    for(const auto& entry : fs::recursive_directory_iterator{dir})
+    {
+        if(entry.is_regular_file())
+            snapshot.emplace(fs::relative(entry.path(), dir), Hash128(LoadFile(entry.path())));
+    }
+    return snapshot;
+}
+
+struct Request
+{
+    fs::path cwd;
+    std::string cmd;
+    std::string args;
+};
+
+std::string MakeKey(const Request& request, const Snapshot& inputs)
+{
+    // The arguments usually refer to the files of the build by their absolute paths.
+    auto args       = request.args;
+    const auto& cwd = request.cwd.native();
+    for(auto pos = args.find(cwd); pos != std::string::npos; pos = args.find(cwd, pos + 5))
+        args.replace(pos, cwd.size(), "<cwd>");
+
+    auto stream = Hash128Stream{};
+    stream.Update(request.cmd).Update("\n").Update(args).Update("\n");
+    for(const auto& [path, digest] : inputs)
+        stream.Update(path.generic_string()).Update("\n").Update(&digest, sizeof(digest));
+    return "compile-server:" + stream.Final().ToString();
+}
+
+/// Relative paths and contents of the files a command created or changed.
+using Outputs = std::vector<std::pair<fs::path, std::vector<char>>>;
+
+void WriteOutputs(const fs::path& dir, const Outputs& outputs)
+{
+    for(const auto& [path, contents] : outputs)
+    {
+        fs::create_directories((dir / path).parent_path());
+        WriteFile(contents, dir / path);
+    }
+}
+
+struct Build
+{
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done  = false;
+    int status = -1;
+    Outputs outputs;
+    /// Where the command was run, empty if the outputs came from the cache.
+    fs::path cwd;
+};
+
+} // namespace
+
+boost::optional<int>
+Execute(const fs::path& socket, std::string_view cmd, std::string_view args, const fs::path& cwd)
+{
+    const auto connection = Connect(socket);
+    if(!connection)
+        return boost::none;
+
+    auto status = std::string{};
+    if(!Send(connection.Get(), Magic) || !Send(connection.Get(), fs::absolute(cwd).native()) ||
+       !Send(connection.Get(), cmd) || !Send(connection.Get(), args) ||
+       !Receive(connection.Get(), status))
+        return boost::none;
+
+    // Anything but a number is a broken server, the caller can still run the command itself.
+    auto result            = 0;
+    const auto* const last = status.data() + status.size();
+    const auto parsed      = std::from_chars(status.data(), last, result);
+    if(parsed.ec != std::errc{} || parsed.ptr != last)
+    {
+        MIOPEN_LOG_W("Malformed reply from the compile server: " << status);
+        return boost::none;
+    }
+    return result;
+}
+
+struct Server::Impl
+{
+    fs::path socket;
+    ThreadPool pool;
+    std::unique_ptr<KernFileCache> cache;
+    Socket listener;
+    std::atomic<bool> stopping{false};
+
+    std::mutex mutex;
+    std::condition_variable connections_closed;
+    std::size_t connections = 0;
+    std::unordered_map<std::string, std::shared_ptr<Build>> builds;
+    Stats stats;
+
+    Impl(const fs::path& socket_,
+         std::size_t jobs,
+         const fs::path& cache_root,
+         std::uint64_t cache_max_size)
+        : socket(socket_), pool(jobs != 0 ? jobs : std::thread::hardware_concurrency())
+    {
+        if(!cache_root.empty())
+            cache = std::make_unique<KernFileCache>(cache_root, cache_max_size);
+
+        auto address = sockaddr_un{};
+        if(!MakeAddress(socket, address))
+            MIOPEN_THROW("Invalid compile server socket path: " + socket.string());
+        if(socket.has_parent_path())
+            fs::create_directories(socket.parent_path());
+        if(fs::exists(socket))
+        {
+            if(Connect(socket))
+                MIOPEN_THROW("A compile server is already listening on " + socket.string());
+            // Left by a server which did not exit cleanly.
+            fs::remove(socket);
+        }
+
+        listener       = Socket{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+        const auto* at = reinterpret_cast<const sockaddr*>(&address);
+        if(!listener || ::bind(listener.Get(), at, sizeof(address)) != 0 ||
+           ::chmod(socket.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+           ::listen(listener.Get(), SOMAXCONN) != 0)
+        {
+            MIOPEN_THROW("Unable to listen on " + socket.string() + ": " + std::strerror(errno));
+        }
+    }
+
+    void Serve(int fd)
+    {
+#ifdef SO_PEERCRED
+        // The commands run with the rights of the server.
+        auto peer   = ucred{};
+        auto length = static_cast<socklen_t>(sizeof(peer));
+        if(::getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &peer, &length) != 0 || peer.uid != ::getuid())
+        {
+            MIOPEN_LOG_W("Rejected a client of another user");
+            return;
+        }
+#endif
+        auto magic   = std::string{};
+        auto cwd     = std::string{};
+        auto request = Request{};
+        if(!Receive(fd, magic) || magic != Magic || !Receive(fd, cwd) ||
+           !Receive(fd, request.cmd) || !Receive(fd, request.args))
+        {
+            MIOPEN_LOG_W("Ill-formed compile server request");
+            return;
+        }
+        request.cwd = cwd;
+        if(!request.cwd.is_absolute() || !fs::is_directory(request.cwd))
+        {
+            MIOPEN_LOG_W("Invalid working directory of a compile server request: " << cwd);
+            return;
+        }
+
+        const auto status = Handle(request);
+        Send(fd, std::to_string(status));
+    }
+
+    int Handle(const Request& request)
+    {
+        const auto inputs = TakeSnapshot(request.cwd);
+        const auto key    = MakeKey(request, inputs);
+
+        auto build  = std::shared_ptr<Build>{};
+        auto leader = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++stats.requests;
+            auto& in_flight = builds[key];
+            if(in_flight == nullptr)
+            {
+                in_flight = std::make_shared<Build>();
+                leader    = true;
+            }
+            else
+            {
+                ++stats.deduplicated;
+            }
+            build = in_flight;
+        }
+
+        if(leader)
+            pool.Submit([this, request, inputs, key, build] { Run(request, inputs, key, *build); });
+
+        std::unique_lock<std::mutex> lock(build->mutex);
+        build->finished.wait(lock, [&] { return build->done; });
+        if(build->cwd != request.cwd)
+            WriteOutputs(request.cwd, build->outputs);
+        return build->status;
+    }
+
+    void Run(const Request& request, const Snapshot& inputs, const std::string& key, Build& build)
+    {
+        auto status  = -1;
+        auto outputs = Outputs{};
+        auto cwd     = fs::path{};
+        try
+        {
+            if(LoadCached(key, outputs))
+            {
+                status = 0;
+                std::lock_guard<std::mutex> lock(mutex);
+                ++stats.cache_hits;
+            }
+            else
+            {
+                MIOPEN_LOG_I2(request.cmd << " " << request.args);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ++stats.builds;
+                }
+                cwd    = request.cwd;
+                status = Process{request.cmd}(request.args, cwd);
+                for(const auto& [path, digest] : TakeSnapshot(cwd))
+                {
+                    const auto input = inputs.find(path);
+                    if(input == inputs.end() || input->second != digest)
+                        outputs.emplace_back(path, LoadFile(cwd / path));
+                }
+                if(status == 0)
+                    StoreCached(key, outputs);
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_E("Compile server build failed: " << ex.what());
+            status = -1;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            builds.erase(key);
+        }
+        {
+            std::lock_guard<std::mutex> lock(build.mutex);
+            build.status  = status;
+            build.outputs = std::move(outputs);
+            build.cwd     = std::move(cwd);
+            build.done    = true;
+        }
+        build.finished.notify_all();
+    }
+
+    // A build is cached as a list of its outputs under the KEY and each output under the KEY
+    // and the relative path of the output.
+    bool LoadCached(const std::string& key, Outputs& outputs)
+    {
+        if(cache == nullptr)
+            return false;
+        const auto list = cache->Find(key);
+        if(list.empty())
+            return false;
+        const auto names = LoadFile(list);
+        auto stream      = std::istringstream{std::string{names.begin(), names.end()}};
+        auto name        = std::string{};
+        auto cached      = Outputs{};
+        while(std::getline(stream, name))
+        {
+            const auto path = cache->Find(key + ":" + name);
+            if(path.empty())
+                return false;
+            cached.emplace_back(name, LoadFile(path));
+        }
+        outputs = std::move(cached);
+        return true;
+    }
+
+    void StoreCached(const std::string& key, const Outputs& outputs)
+    {
+        if(cache == nullptr || outputs.empty())
+            return;
+        const auto dir = TmpDir{"compile-server"};
+        auto names     = std::string{};
+        for(std::size_t i = 0; i < outputs.size(); ++i)
+        {
+            const auto name = outputs[i].first.generic_string();
+            const auto file = dir / std::to_string(i);
+            WriteFile(outputs[i].second, file);
+            cache->Store(file, key + ":" + name);
+            names += name + "\n";
+        }
+        // Stored last, so that a found list refers to the complete set of the outputs.
+        WriteFile(names, dir / "list");
+        cache->Store(dir / "list", key);
+    }
+};
+
+Server::Server(const fs::path& socket,
+               std::size_t jobs,
+               const fs::path& cache_root,
+               std::uint64_t cache_max_size)
+    : impl{std::make_unique<Impl>(socket, jobs, cache_root, cache_max_size)}
+{
+}
+
+Server::~Server()
+{
+    Stop();
+    {
+        std::unique_lock<std::mutex> lock(impl->mutex);
+        impl->connections_closed.wait(lock, [&] { return impl->connections == 0; });
+    }
+    std::error_code error;
+    fs::remove(impl->socket, error);
+}
+
+void Server::Run()
+{
+    MIOPEN_LOG_I2("Compile server is listening on " << impl->socket);
+    auto failures = 0;
+    while(!impl->stopping)
+    {
+        auto connection = Socket{::accept4(impl->listener.Get(), nullptr, nullptr, SOCK_CLOEXEC)};
+        if(!connection)
+        {
+            const auto error = errno;
+            if(impl->stopping || error == EINTR)
+                continue;
+            MIOPEN_LOG_W("accept() failed: " << std::strerror(error));
+            // Errors like EMFILE persist until some connections are closed, so retrying at once
+            // would spin. The delay grows up to a second.
+            std::this_thread::sleep_for(std::chrono::milliseconds{1 << std::min(failures++, 10)});
+            continue;
+        }
+        failures = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            ++impl->connections;
+        }
+        std::thread{[impl = impl.get(), connection = std::move(connection)] {
+            try
+            {
+                impl->Serve(connection.Get());
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_E("Compile server request failed: " << ex.what());
+            }
+            std::lock_guard<std::mutex> lock(impl->mutex);
+            --impl->connections;
+            impl->connections_closed.notify_all();
+        }}.detach();
+    }
+}
+
+void Server::Stop()
+{
+    impl->stopping = true;
+    // Wakes up the accept() of Run().
+    ::shutdown(impl->listener.Get(), SHUT_RDWR);
+}
+
+Stats Server::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return impl->stats;
+}
+
+#else
+
+boost::optional<int> Execute(const fs::path&, std::string_view, std::string_view, const fs::path&)
+{
+    return boost::none;
+}
+
+struct Server::Impl
+{
+};
+
+Server::Server(const fs::path&, std::size_t, const fs::path&, std::uint64_t)
+{
+    MIOPEN_THROW(miopenStatusNotImplemented, "The compile server requires Unix sockets");
+}
+
+Server::~Server() = default;
+
+void Server::Run() {}
+
+void Server::Stop() {}
+
+Stats Server::GetStats() const { return {}; }
+
+#endif
+
+} // namespace compile_server
+} // namespace miopen
@@ -26,7 +26,7 @@
 
 #include <miopen/conv/heuristics/ai_heuristics.hpp>
 #if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK || MIOPEN_ENABLE_AI_KERNEL_TUNING
-#include <fdeep/fdeep.hpp>
+#include <miopen/conv/heuristics/ai_inference.hpp>
 #include <miopen/filesystem.hpp>
 
 namespace miopen {
@@ -118,34 +118,40 @@ public:
     Metadata metadata;
     Model(const std::string& arch)
         : metadata(Metadata(arch)),
-          model(fdeep::load_model(ModelPath(arch), true, fdeep::dev_null_logger)),
-          input_shape(fdeep::tensor_shape(metadata.num_inputs)),
+          network(nn::Network::Load(GetSystemDbPath() / (arch + ".tn.model"))),
           offset(metadata.num_outputs - metadata.num_solvers)
     {
     }
     virtual ~Model()                                                   = default;
     virtual bool IsProblemSupported(const conv::ProblemDescription& problem,
                                     const ExecutionContext& ctx) const = 0;
-    std::vector<float> Forward(const conv::ProblemDescription& problem) const
+    /// Evaluates the model for all the problems at once, returns the solver scores of each.
+    std::vector<std::vector<float>>
+    Forward(const std::vector<const conv::ProblemDescription*>& problems) const
     {
-        std::vector<float> features       = ToFeatures(problem);
-        std::vector<fdeep::tensor> output = model.predict({fdeep::tensor(input_shape, features)});
-        std::vector<float> output_vector  = output.front().to_vector();
-        std::vector<float> res(output_vector.begin() + offset, output_vector.end());
+        std::vector<float> features;
+        features.reserve(problems.size() * metadata.num_inputs);
+        for(const auto* problem : problems)
+        {
+            const auto problem_features = ToFeatures(*problem);
+            features.insert(features.end(), problem_features.begin(), problem_features.end());
+        }
+
+        const auto output      = network.Predict({features}, problems.size()).front();
+        const auto output_size = network.GetOutputShape(0).Size();
+        std::vector<std::vector<float>> res;
+        res.reserve(problems.size());
+        for(std::size_t i = 0; i < problems.size(); ++i)
+        {
+            const auto begin = output.begin() + i * output_size;
+            res.emplace_back(begin + offset, begin + output_size);
+        }
         return res;
     }
 
 protected:
-    const fdeep::model model;
-    const fdeep::tensor_shape input_shape;
+    const nn::Network network;
     const size_t offset;
-    static std::string ModelPath(const std::string& arch)
-    {
-        const auto file_path = GetSystemDbPath() / (arch + ".tn.model");
-        if(!fs::exists(file_path))
-            MIOPEN_THROW(miopenStatusInternalError, "Unable to load AI model file:" + file_path);
-        return file_path.string();
-    }
     virtual std::vector<float> ToFeatures(const conv::ProblemDescription& problem) const = 0;
 };
 
@@ -456,74 +462,115 @@ std::unique_ptr<Model> GetModel(const std::string& device)
     return std::make_unique<Gfx908Model>();
 }
 
-std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
-                                    const ExecutionContext& ctx,
-                                    const std::string& device)
+namespace {
+
+const Model* GetCachedModel(const std::string& device)
 {
     const static std::unique_ptr<Model> model = GetModel(device);
-    if(!model || !model->IsProblemSupported(problem, ctx))
-        return {};
+    return model.get();
+}
+
+void LogSolvers(const char* title, const std::vector<uint64_t>& solvers)
+{
+    if(miopen::IsLogging(LoggingLevel::Info2))
+    {
+        std::stringstream ss;
+        for(auto& id : solvers)
+            ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
+        MIOPEN_LOG_I2(title << ss.str());
+    }
+}
+
+} // namespace
+
+std::vector<std::vector<uint64_t>>
+PredictSolvers(const std::vector<const conv::ProblemDescription*>& problems,
+               const ExecutionContext& ctx,
+               const std::string& device)
+{
+    std::vector<std::vector<uint64_t>> results(problems.size());
+    const auto* const model = GetCachedModel(device);
+    if(model == nullptr)
+        return results;
 
     std::string est_name = ":memory:" + device;
     auto& db             = AnyRamDb::GetCached(est_name);
-    auto db_res          = db.FindRecord(problem);
-    if(db_res)
+
+    // The problems missing from the cache are evaluated in one batch.
+    std::vector<std::size_t> pending;
+    std::vector<const conv::ProblemDescription*> pending_problems;
+    for(std::size_t i = 0; i < problems.size(); ++i)
     {
-        MIOPEN_LOG_I2("Cached heuristic (TunaNet) result found");
-        std::vector<uint64_t> db_sol(db_res->size());
-        // cast returned record to solver ids
-        std::transform(db_res->begin(), db_res->end(), db_sol.begin(), [](boost::any id) {
-            return boost::any_cast<uint64_t>(id);
-        });
-        if(miopen::IsLogging(LoggingLevel::Info2))
+        const auto& problem = *problems[i];
+        if(!model->IsProblemSupported(problem, ctx))
+            continue;
+
+        const auto db_res = db.FindRecord(problem);
+        if(db_res)
         {
-            std::stringstream ss;
-            for(auto& id : db_sol)
-                ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
-            MIOPEN_LOG_I2("Cached solvers: " << ss.str());
+            MIOPEN_LOG_I2("Cached heuristic (TunaNet) result found");
+            auto& db_sol = results[i];
+            db_sol.resize(db_res->size());
+            // cast returned record to solver ids
+            std::transform(db_res->begin(), db_res->end(), db_sol.begin(), [](boost::any id) {
+                return boost::any_cast<uint64_t>(id);
+            });
+            LogSolvers("Cached solvers: ", db_sol);
+            continue;
         }
-        return db_sol;
+
+        pending.push_back(i);
+        pending_problems.push_back(&problem);
     }
 
-    MIOPEN_LOG_I2("Evaluating TunaNet");
-
-    std::vector<float> res = model->Forward(problem);
-    std::vector<std::pair<int, float>> sort_res(res.size());
-    // sorts result based upon magnitude of result in vector, returned from Model,
-    // paired with original index (idx). Sort magnitudes in descending order.
-    // Greater magnitude = better solver. Indexes (idx), which will be used to map to solvers,
-    // with greater corresponding magnitude are at front of the vector so they get priority.
-    for(auto idx = 0; idx < res.size(); idx++)
-        sort_res[idx] = {idx, res[idx]};
-    const auto cmp = [](const std::pair<int, float>& a, const std::pair<int, float>& b) -> bool {
-        return a.second > b.second;
-    };
-    std::sort(sort_res.begin(), sort_res.end(), cmp);
-
-    // map idx to solver id and then anysolver
-    std::vector<uint64_t> sol;
-    std::vector<boost::any> any_sol;
-    for(const auto& kinder : sort_res)
+    if(pending.empty())
+        return results;
+
+    MIOPEN_LOG_I2("Evaluating TunaNet for " << pending.size() << " problem(s)");
+    const auto scores = model->Forward(pending_problems);
+
+    for(std::size_t p = 0; p < pending.size(); ++p)
     {
-        const auto id     = kinder.first;
-        const auto sol_id = solver::Id{model->metadata.solver_map.at(id)};
-        if(!sol_id.IsValid())
+        const auto& res = scores[p];
+        std::vector<std::pair<int, float>> sort_res(res.size());
+        // sorts result based upon magnitude of result in vector, returned from Model,
+        // paired with original index (idx). Sort magnitudes in descending order.
+        // Greater magnitude = better solver. Indexes (idx), which will be used to map to
+        // solvers, with greater corresponding magnitude are at front of the vector so they get
+        // priority.
+        for(auto idx = 0; idx < res.size(); idx++)
+            sort_res[idx] = {idx, res[idx]};
+        const auto cmp = [](const std::pair<int, float>& a,
+                            const std::pair<int, float>& b) -> bool { return a.second > b.second; };
+        std::sort(sort_res.begin(), sort_res.end(), cmp);
+
+        // map idx to solver id and then anysolver
+        auto& sol = results[pending[p]];
+        std::vector<boost::any> any_sol;
+        for(const auto& kinder : sort_res)
         {
-            MIOPEN_LOG_I2("Invalid solver " << model->metadata.solver_map.at(id) << " removed");
-            continue;
+            const auto id     = kinder.first;
+            const auto sol_id = solver::Id{model->metadata.solver_map.at(id)};
+            if(!sol_id.IsValid())
+            {
+                MIOPEN_LOG_I2("Invalid solver " << model->metadata.solver_map.at(id)
+                                                << " removed");
+                continue;
+            }
+            sol.push_back(sol_id.Value());
+            any_sol.push_back(sol_id.Value());
         }
-        sol.push_back(sol_id.Value());
-        any_sol.push_back(sol_id.Value());
+        db.StoreRecord(*pending_problems[p], any_sol);
+        LogSolvers("TunaNet Result: ", sol);
     }
-    db.StoreRecord(problem, any_sol);
-    if(miopen::IsLogging(LoggingLevel::Info2))
-    {
-        std::stringstream ss;
-        for(auto& id : sol)
-            ss << solver::Id{id}.ToString() << " ID:" << id << ", ";
-        MIOPEN_LOG_I2("TunaNet Result: " << ss.str());
-    }
-    return sol;
+    return results;
+}
+
+std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
+                                    const ExecutionContext& ctx,
+                                    const std::string& device)
+{
+    return PredictSolvers({&problem}, ctx, device).front();
 }
 } // namespace immed_mode
 #endif // MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
@@ -548,44 +595,30 @@ public:
     Metadata metadata;
     Model(const std::string& arch, const std::string& solver)
         : metadata(Metadata(arch, solver)),
-          encoder(fdeep::load_model(EncoderPath(arch, solver), true, fdeep::dev_null_logger)),
-          decoder(fdeep::load_model(DecoderPath(arch, solver), true, fdeep::dev_null_logger))
+          encoder(nn::Network::Load(ModelPath(arch, solver, "encoder"))),
+          decoder(nn::Network::Load(ModelPath(arch, solver, "decoder")))
     {
     }
     virtual ~Model() = default;
-    fdeep::tensors Encode(const std::vector<float>& features, std::size_t dim, bool transform) const
+    /// The features are a sequence of dim steps of either dim values (transformed features)
+    /// or one value, as the encoder input shape tells.
+    std::vector<std::vector<float>> Encode(const std::vector<float>& features) const
     {
-        const auto tensor_shape_depth = transform ? dim : 1;
-        fdeep::tensor input_tensor =
-            fdeep::tensor(fdeep::tensor_shape(dim, tensor_shape_depth), features);
-        return encoder.predict({input_tensor});
+        return encoder.Predict({features}, 1);
     }
-    fdeep::tensors Decode(const float prev_token, const fdeep::tensors& context) const
+    /// Returns the token scores followed by the updated context.
+    std::vector<std::vector<float>> Decode(const float prev_token,
+                                           const std::vector<std::vector<float>>& context) const
     {
-        return decoder.predict(
-            {{fdeep::tensor(fdeep::tensor_shape(1), std::vector<float>(1, prev_token)),
-              context[0],
-              context[1],
-              context[2],
-              context[3]}});
+        return decoder.Predict({{prev_token}, context[0], context[1], context[2], context[3]}, 1);
     }
 
 private:
-    const fdeep::model encoder;
-    const fdeep::model decoder;
-    static std::string EncoderPath(const std::string& arch, const std::string& solver)
+    const nn::Network encoder;
+    const nn::Network decoder;
+    static fs::path ModelPath(const std::string& arch, const std::string& solver, const char* part)
     {
-        const auto path = GetSystemDbPath() / (arch + "_" + solver + "_encoder.ktn.model");
-        if(!fs::exists(path))
-            MIOPEN_THROW(miopenStatusInternalError, "Unable to load file: " + path);
-        return path.string();
-    }
-    static std::string DecoderPath(const std::string& arch, const std::string& solver)
-    {
-        const auto path = GetSystemDbPath() / (arch + "_" + solver + "_decoder.ktn.model");
-        if(!fs::exists(path))
-            MIOPEN_THROW(miopenStatusInternalError, "Unable to load file: " + path);
-        return path.string();
+        return GetSystemDbPath() / (arch + "_" + solver + "_" + part + ".ktn.model");
     }
 };
 
@@ -609,18 +642,12 @@ bool ModelSetParams(const std::string& arch,
                     const std::string& solver,
                     miopen::conv::Direction direction,
                     const std::vector<float>& features,
-                    bool transform_features,
                     std::function<bool(std::size_t, std::string)> validator)
 {
-    auto model = GetModel(arch, solver);
-    int dim    = 0;
-    if(transform_features)
-        dim = std::sqrt(features.size());
-    else
-        dim = features.size();
-    auto start             = std::chrono::high_resolution_clock::now();
-    fdeep::tensors context = model->Encode(features, dim, transform_features);
-    float decoder_input    = 0.0;
+    auto model          = GetModel(arch, solver);
+    auto start          = std::chrono::high_resolution_clock::now();
+    auto context        = model->Encode(features);
+    float decoder_input = 0.0;
     std::string dir;
     switch(direction)
     {
@@ -635,9 +662,9 @@ bool ModelSetParams(const std::string& arch,
 
         if(i == 0 && (model->metadata.predict_type == 0u))
             num_tuning_params = model->metadata.num_tuning_params[dir];
-        fdeep::tensors decoder_output = model->Decode(decoder_input, context);
+        auto decoder_output = model->Decode(decoder_input, context);
 
-        auto token_scores = decoder_output[0].to_vector();
+        const auto& token_scores = decoder_output[0];
         std::priority_queue<std::pair<float, int>> pq;
         for(int j = 0; j < token_scores.size(); j++)
             pq.push(std::make_pair(token_scores[j], j)); // sort by value at index
@@ -0,0 +1,864 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv/heuristics/ai_inference.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <utility>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MIOPEN_AI_INFERENCE_X86_DISPATCH 1
+#else
+#define MIOPEN_AI_INFERENCE_X86_DISPATCH 0
+#endif
+
+namespace miopen {
+namespace ai {
+namespace nn {
+namespace {
+
+// Compiled network format, native byte order:
+//   char[8] magic, uint32 version, uint32 endian marker,
+//   uint64 source size, int64 source mtime,
+//   counted arrays (uint32 count followed by the elements) of the tensor shapes, the input
+//   tensor ids and the output tensor ids,
+//   uint32 number of layers, then for each layer uint32 kind, activation, units and
+//   return_sequences, and the counted arrays inputs, outputs, weights, recurrent_weights, bias.
+constexpr char Magic[8]              = {'M', 'I', 'O', 'A', 'I', 'N', 'N', '\0'};
+constexpr std::uint32_t Version      = 1;
+constexpr std::uint32_t EndianMarker = 0x01020304U;
+
+template <class T>
+void WriteValue(std::ostream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+void WriteArray(std::ostream& out, const std::vector<T>& values)
+{
+    WriteValue(out, static_cast<std::uint32_t>(values.size()));
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <class T>
+bool ReadValue(std::istream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+template <class T>
+bool ReadArray(std::istream& in, std::vector<T>& values)
+{
+    // Bounds the allocation made for a corrupted count, the largest model has ~100k weights.
+    constexpr std::uint32_t max_size = 1U << 26;
+    std::uint32_t size               = 0;
+    if(!ReadValue(in, size) || size > max_size)
+        return false;
+    values.resize(size);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()), size * sizeof(T)));
+}
+
+/// The weights and the test vectors are stored by frugally-deep as arrays of base64 chunks
+/// holding little-endian floats.
+std::vector<float> DecodeFloats(const nlohmann::json& chunks)
+{
+    static const auto table = [] {
+        std::array<int, 256> t{};
+        t.fill(-1);
+        const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for(int i = 0; i < 64; ++i)
+            t[static_cast<unsigned char>(alphabet[i])] = i;
+        return t;
+    }();
+
+    std::string bytes;
+    for(const auto& chunk : chunks)
+    {
+        auto bits  = 0U;
+        auto count = 0;
+        for(const auto c : chunk.get_ref<const std::string&>())
+        {
+            if(c == '=')
+                break;
+            const auto v = table[static_cast<unsigned char>(c)];
+            if(v < 0)
+                MIOPEN_THROW(miopenStatusInternalError, "Invalid base64 data in the AI model");
+            bits = (bits << 6) | static_cast<unsigned>(v);
+            count += 6;
+            if(count >= 8)
+            {
+                count -= 8;
+                bytes.push_back(static_cast<char>((bits >> count) & 0xFFU));
+            }
+        }
+    }
+
+    if(bytes.size() % sizeof(float) != 0)
+        MIOPEN_THROW(miopenStatusInternalError, "Invalid float array in the AI model");
+    std::vector<float> floats(bytes.size() / sizeof(float));
+    std::memcpy(floats.data(), bytes.data(), bytes.size());
+    return floats;
+}
+
+Activation ParseActivation(const std::string& name)
+{
+    if(name == "linear")
+        return Activation::Linear;
+    if(name == "relu")
+        return Activation::ReLU;
+    if(name == "sigmoid")
+        return Activation::Sigmoid;
+    if(name == "tanh")
+        return Activation::Tanh;
+    MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported activation in the AI model: " + name);
+}
+
+// The transcendentals dominate the LSTM cost when computed by the scalar libm, so they are
+// evaluated with the Cephes single precision exp polynomial, which the compiler vectorizes.
+// The relative error is a few ulp, well within the tolerance the models are verified with.
+[[gnu::always_inline]] inline float Exp(float x)
+{
+    // Adding and subtracting 1.5 * 2^23 rounds to the nearest integer without calling
+    // std::round, which is not vectorized for the baseline instruction set.
+    constexpr auto round_magic = 12582912.0f;
+
+    x               = std::min(std::max(x, -87.0f), 88.0f);
+    const auto n    = (x * 1.44269504088896341f + round_magic) - round_magic;
+    auto r          = x - n * 0.693359375f;
+    r               = r + n * 2.12194440e-4f;
+    auto p          = 1.9875691500e-4f;
+    p               = p * r + 1.3981999507e-3f;
+    p               = p * r + 8.3334519073e-3f;
+    p               = p * r + 4.1665795894e-2f;
+    p               = p * r + 1.6666665459e-1f;
+    p               = p * r + 5.0000001201e-1f;
+    p               = p * r * r + r + 1.0f;
+    const auto bits = static_cast<std::int32_t>(n + 127.0f) << 23;
+    auto scale      = 0.0f;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+[[gnu::always_inline]] inline float Sigmoid(float x) { return 1.0f / (1.0f + Exp(-x)); }
+
+[[gnu::always_inline]] inline float Tanh(float x)
+{
+    return 1.0f - 2.0f / (Exp(2.0f * x) + 1.0f);
+}
+
+[[gnu::always_inline]] inline void ActivateImpl(float* values,
+                                               std::size_t size,
+                                               Activation activation)
+{
+    switch(activation)
+    {
+    case Activation::Linear: break;
+    case Activation::ReLU:
+        for(std::size_t i = 0; i < size; ++i)
+            values[i] = std::max(values[i], 0.0f);
+        break;
+    case Activation::Sigmoid:
+        for(std::size_t i = 0; i < size; ++i)
+            values[i] = Sigmoid(values[i]);
+        break;
+    case Activation::Tanh:
+        for(std::size_t i = 0; i < size; ++i)
+            values[i] = Tanh(values[i]);
+        break;
+    }
+}
+
+struct GemmArgs
+{
+    const float* x;
+    const float* w;
+    const float* bias;
+    float* y;
+    std::size_t rows;
+    std::size_t k;
+    std::size_t n;
+    bool accumulate;
+};
+
+/// y[rows, n] (+)= x[rows, k] * w[k, n] + bias[n].
+///
+/// The inner loop runs over contiguous rows of w and y, so it is vectorized by the compiler
+/// for whatever instruction set the caller is compiled for. Four rows of x share each row of
+/// w, which keeps w streaming through the cache once per four problems of the batch.
+/// Zero inputs (most of them behind a ReLU) are skipped.
+[[gnu::always_inline]] inline void GemmImpl(const GemmArgs& args)
+{
+    const auto n = args.n;
+    const auto k = args.k;
+
+    for(std::size_t r = 0; r < args.rows; ++r)
+    {
+        auto* const y = args.y + r * n;
+        if(!args.accumulate)
+        {
+            if(args.bias != nullptr)
+                std::copy_n(args.bias, n, y);
+            else
+                std::fill_n(y, n, 0.0f);
+        }
+    }
+
+    std::size_t r = 0;
+    for(; r + 4 <= args.rows; r += 4)
+    {
+        const auto* const x0      = args.x + r * k;
+        const auto* const x1      = x0 + k;
+        const auto* const x2      = x1 + k;
+        const auto* const x3      = x2 + k;
+        auto* __restrict const y0 = args.y + r * n;
+        auto* __restrict const y1 = y0 + n;
+        auto* __restrict const y2 = y1 + n;
+        auto* __restrict const y3 = y2 + n;
+
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            const auto a0 = x0[i];
+            const auto a1 = x1[i];
+            const auto a2 = x2[i];
+            const auto a3 = x3[i];
+            if(a0 == 0.0f && a1 == 0.0f && a2 == 0.0f && a3 == 0.0f)
+                continue;
+            const auto* __restrict const w = args.w + i * n;
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                const auto wj = w[j];
+                y0[j] += a0 * wj;
+                y1[j] += a1 * wj;
+                y2[j] += a2 * wj;
+                y3[j] += a3 * wj;
+            }
+        }
+    }
+
+    for(; r < args.rows; ++r)
+    {
+        const auto* const x      = args.x + r * k;
+        auto* __restrict const y = args.y + r * n;
+        for(std::size_t i = 0; i < k; ++i)
+        {
+            const auto a = x[i];
+            if(a == 0.0f)
+                continue;
+            const auto* __restrict const w = args.w + i * n;
+            for(std::size_t j = 0; j < n; ++j)
+                y[j] += a * w[j];
+        }
+    }
+}
+
+// The kernels are compiled for several instruction sets and selected at run time, so that
+// the library does not depend on the flags it is built with.
+struct Kernels
+{
+    void (*gemm)(const GemmArgs& args);
+    void (*activate)(float* values, std::size_t size, Activation activation);
+};
+
+void GemmDefault(const GemmArgs& args) { GemmImpl(args); }
+void ActivateDefault(float* values, std::size_t size, Activation activation)
+{
+    ActivateImpl(values, size, activation);
+}
+
+#if MIOPEN_AI_INFERENCE_X86_DISPATCH
+__attribute__((target("avx2,fma"))) void GemmAvx2(const GemmArgs& args) { GemmImpl(args); }
+__attribute__((target("avx2,fma"))) void
+ActivateAvx2(float* values, std::size_t size, Activation activation)
+{
+    ActivateImpl(values, size, activation);
+}
+
+__attribute__((target("avx512f"))) void GemmAvx512(const GemmArgs& args) { GemmImpl(args); }
+__attribute__((target("avx512f"))) void
+ActivateAvx512(float* values, std::size_t size, Activation activation)
+{
+    ActivateImpl(values, size, activation);
+}
+#endif
+
+Kernels SelectKernels()
+{
+#if MIOPEN_AI_INFERENCE_X86_DISPATCH
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+    {
+        MIOPEN_LOG_I2("AI inference: AVX-512");
+        return {&GemmAvx512, &ActivateAvx512};
+    }
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        MIOPEN_LOG_I2("AI inference: AVX2");
+        return {&GemmAvx2, &ActivateAvx2};
+    }
+#endif
+    MIOPEN_LOG_I2("AI inference: generic");
+    return {&GemmDefault, &ActivateDefault};
+}
+
+const Kernels& GetKernels()
+{
+    static const auto kernels = SelectKernels();
+    return kernels;
+}
+
+void Gemm(const GemmArgs& args) { GetKernels().gemm(args); }
+
+void Activate(float* values, std::size_t size, Activation activation)
+{
+    GetKernels().activate(values, size, activation);
+}
+
+void Activate(std::vector<float>& values, Activation activation)
+{
+    Activate(values.data(), values.size(), activation);
+}
+
+void RunLstm(const Layer& layer,
+             const std::vector<TensorShape>& shapes,
+             std::size_t batch,
+             std::vector<std::vector<float>>& values)
+{
+    const auto units = std::size_t{layer.units};
+    const auto gates = 4 * units;
+    const auto shape = shapes[layer.inputs[0]];
+    const auto steps = std::size_t{shape.steps};
+
+    // The input projection does not depend on the state, so it is done for all the steps at
+    // once, leaving only the recurrent part in the sequential loop.
+    std::vector<float> projected(batch * steps * gates);
+    Gemm({values[layer.inputs[0]].data(),
+          layer.weights.data(),
+          layer.bias.empty() ? nullptr : layer.bias.data(),
+          projected.data(),
+          batch * steps,
+          shape.width,
+          gates,
+          false});
+
+    std::vector<float> h(batch * units, 0.0f);
+    std::vector<float> c(batch * units, 0.0f);
+    if(layer.inputs.size() == 3)
+    {
+        h = values[layer.inputs[1]];
+        c = values[layer.inputs[2]];
+    }
+
+    std::vector<float> sequence(layer.return_sequences ? batch * steps * units : 0);
+    std::vector<float> z(batch * gates);
+
+    for(std::size_t t = 0; t < steps; ++t)
+    {
+        for(std::size_t b = 0; b < batch; ++b)
+            std::copy_n(&projected[(b * steps + t) * gates], gates, &z[b * gates]);
+        Gemm({h.data(),
+              layer.recurrent_weights.data(),
+              nullptr,
+              z.data(),
+              batch,
+              units,
+              gates,
+              true});
+
+        for(std::size_t b = 0; b < batch; ++b)
+        {
+            auto* const zb = &z[b * gates];
+            auto* const cb = &c[b * units];
+            auto* const hb = &h[b * units];
+            Activate(zb, 2 * units, Activation::Sigmoid);
+            Activate(zb + 2 * units, units, Activation::Tanh);
+            Activate(zb + 3 * units, units, Activation::Sigmoid);
+            for(std::size_t j = 0; j < units; ++j)
+                cb[j] = zb[units + j] * cb[j] + zb[j] * zb[2 * units + j];
+            std::copy_n(cb, units, hb);
+            Activate(hb, units, Activation::Tanh);
+            for(std::size_t j = 0; j < units; ++j)
+                hb[j] *= zb[3 * units + j];
+            if(layer.return_sequences)
+                std::copy_n(hb, units, &sequence[(b * steps + t) * units]);
+        }
+    }
+
+    values[layer.outputs[0]] = layer.return_sequences ? std::move(sequence) : h;
+    if(layer.outputs.size() == 3)
+    {
+        values[layer.outputs[1]] = std::move(h);
+        values[layer.outputs[2]] = std::move(c);
+    }
+}
+
+/// Guards the executor against a corrupted compiled model: checks the sizes of the
+/// parameters and that the output shapes follow from the input shapes.
+bool IsConsistent(const Layer& layer, const std::vector<TensorShape>& shapes)
+{
+    constexpr std::size_t max_tensor_size = 1U << 24;
+
+    const auto units = std::size_t{layer.units};
+    const auto& in   = shapes[layer.inputs[0]];
+    const auto is    = [&](std::uint32_t id, std::size_t steps, std::size_t width) {
+        return shapes[id].steps == steps && shapes[id].width == width;
+    };
+
+    if(layer.activation > Activation::Tanh || in.Size() == 0 || in.Size() > max_tensor_size)
+        return false;
+
+    switch(layer.kind)
+    {
+    case LayerKind::Dense:
+        return layer.outputs.size() == 1 && is(layer.outputs[0], in.steps, units) &&
+               layer.weights.size() == in.width * units &&
+               (layer.bias.empty() || layer.bias.size() == units);
+    case LayerKind::ReLU:
+        return layer.outputs.size() == 1 && is(layer.outputs[0], in.steps, in.width);
+    case LayerKind::Add:
+        return layer.outputs.size() == 1 && is(layer.outputs[0], in.steps, in.width) &&
+               std::all_of(layer.inputs.begin(), layer.inputs.end(), [&](auto id) {
+                   return is(id, in.steps, in.width);
+               });
+    case LayerKind::Embedding:
+        return layer.outputs.size() == 1 && is(layer.outputs[0], in.Size(), units) &&
+               units != 0 && layer.weights.size() % units == 0;
+    case LayerKind::Lstm: {
+        const auto steps = layer.return_sequences ? in.steps : 1;
+        const auto state = [&](const std::vector<std::uint32_t>& ids) {
+            return ids.size() == 1 ||
+                   (ids.size() == 3 && is(ids[1], 1, units) && is(ids[2], 1, units));
+        };
+        return state(layer.inputs) && state(layer.outputs) &&
+               is(layer.outputs[0], steps, units) &&
+               layer.weights.size() == in.width * 4 * units &&
+               layer.recurrent_weights.size() == units * 4 * units &&
+               (layer.bias.empty() || layer.bias.size() == 4 * units);
+    }
+    }
+    return false;
+}
+
+void Verify(const Network& network, const nlohmann::json& tests)
+{
+    for(const auto& test : tests)
+    {
+        std::vector<std::vector<float>> test_inputs;
+        for(const auto& input : test.at("inputs"))
+            test_inputs.push_back(DecodeFloats(input.at("values")));
+
+        const auto results           = network.Predict(test_inputs, 1);
+        const auto& expected_outputs = test.at("outputs");
+        if(results.size() != expected_outputs.size())
+            MIOPEN_THROW(miopenStatusInternalError, "AI model test has a wrong output count");
+
+        for(std::size_t i = 0; i < results.size(); ++i)
+        {
+            const auto expected = DecodeFloats(expected_outputs[i].at("values"));
+            if(expected.size() != results[i].size())
+                MIOPEN_THROW(miopenStatusInternalError, "AI model test has a wrong output size");
+            for(std::size_t j = 0; j < expected.size(); ++j)
+            {
+                // The test vectors were computed by Keras, which sums in a different order.
+                const auto tolerance = 1e-4f * std::max(1.0f, std::abs(expected[j]));
+                if(!(std::abs(results[i][j] - expected[j]) <= tolerance))
+                {
+                    MIOPEN_THROW(miopenStatusInternalError,
+                                 "AI model verification failed, output " + std::to_string(i) +
+                                     " value " + std::to_string(j) + ": " +
+                                     std::to_string(results[i][j]) + " instead of " +
+                                     std::to_string(expected[j]));
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+Network Network::FromJson(const nlohmann::json& model)
+{
+    Network net;
+    const auto& config = model.at("architecture").at("config");
+    const auto& params = model.at("trainable_params");
+
+    std::map<std::pair<std::string, int>, std::uint32_t> tensor_ids;
+
+    const auto add_tensor = [&](const std::string& layer, int index, TensorShape shape) {
+        const auto id = static_cast<std::uint32_t>(net.shapes.size());
+        net.shapes.push_back(shape);
+        tensor_ids.emplace(std::make_pair(layer, index), id);
+        return id;
+    };
+
+    // A reference is [layer name, node index, tensor index, ...].
+    const auto find_tensor = [&](const nlohmann::json& ref) {
+        if(ref.at(1).get<int>() != 0)
+            MIOPEN_THROW(miopenStatusNotImplemented, "Shared layers are not supported");
+        const auto it = tensor_ids.find({ref.at(0).get<std::string>(), ref.at(2).get<int>()});
+        if(it == tensor_ids.end())
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "AI model layers are not in topological order: " + ref.dump());
+        return it->second;
+    };
+
+    const auto load_params = [&](const std::string& layer, const char* name, std::size_t size) {
+        auto values = DecodeFloats(params.at(layer).at(name));
+        if(values.size() != size)
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "Wrong size of " + layer + "/" + name + " in the AI model");
+        return values;
+    };
+
+    for(const auto& json_layer : config.at("layers"))
+    {
+        const auto class_name = json_layer.at("class_name").get<std::string>();
+        const auto name       = json_layer.at("name").get<std::string>();
+        const auto& cfg       = json_layer.at("config");
+
+        if(class_name == "InputLayer")
+        {
+            // The first dimension is the batch.
+            const auto& dims = cfg.at("batch_input_shape");
+            if(dims.size() == 2)
+                add_tensor(name, 0, {1, dims[1].get<std::uint32_t>()});
+            else if(dims.size() == 3)
+                add_tensor(name, 0, {dims[1].get<std::uint32_t>(), dims[2].get<std::uint32_t>()});
+            else
+                MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported AI model input rank");
+            continue;
+        }
+
+        const auto& inbound = json_layer.at("inbound_nodes");
+        if(inbound.size() != 1)
+            MIOPEN_THROW(miopenStatusNotImplemented, "Shared layers are not supported");
+
+        Layer layer;
+        for(const auto& ref : inbound[0])
+            layer.inputs.push_back(find_tensor(ref));
+        const auto in = net.shapes[layer.inputs.at(0)];
+
+        if(class_name == "Dense")
+        {
+            layer.kind       = LayerKind::Dense;
+            layer.activation = ParseActivation(cfg.at("activation"));
+            layer.units      = cfg.at("units");
+            layer.weights    = load_params(name, "weights", std::size_t{in.width} * layer.units);
+            if(cfg.at("use_bias").get<bool>())
+                layer.bias = load_params(name, "bias", layer.units);
+            layer.outputs.push_back(add_tensor(name, 0, {in.steps, layer.units}));
+        }
+        else if(class_name == "ReLU")
+        {
+            if(!cfg.at("max_value").is_null() || cfg.at("negative_slope").get<float>() != 0.0f ||
+               cfg.at("threshold").get<float>() != 0.0f)
+                MIOPEN_THROW(miopenStatusNotImplemented, "Only the plain ReLU is supported");
+            layer.kind = LayerKind::ReLU;
+            layer.outputs.push_back(add_tensor(name, 0, in));
+        }
+        else if(class_name == "Add")
+        {
+            for(const auto id : layer.inputs)
+            {
+                if(net.shapes[id].Size() != in.Size())
+                    MIOPEN_THROW(miopenStatusInternalError, "Add of tensors of different shapes");
+            }
+            layer.kind = LayerKind::Add;
+            layer.outputs.push_back(add_tensor(name, 0, in));
+        }
+        else if(class_name == "Embedding")
+        {
+            const auto input_dim = cfg.at("input_dim").get<std::uint32_t>();
+            layer.kind           = LayerKind::Embedding;
+            layer.units          = cfg.at("output_dim");
+            // Each input value is a token index, which becomes a step of the output sequence.
+            layer.weights = load_params(name, "weights", std::size_t{input_dim} * layer.units);
+            layer.outputs.push_back(
+                add_tensor(name, 0, {static_cast<std::uint32_t>(in.Size()), layer.units}));
+        }
+        else if(class_name == "LSTM")
+        {
+            if(ParseActivation(cfg.at("activation")) != Activation::Tanh ||
+               ParseActivation(cfg.at("recurrent_activation")) != Activation::Sigmoid ||
+               cfg.value("go_backwards", false) || cfg.value("stateful", false))
+                MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported LSTM configuration");
+            if(layer.inputs.size() != 1 && layer.inputs.size() != 3)
+                MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported LSTM inputs");
+
+            layer.kind              = LayerKind::Lstm;
+            layer.units             = cfg.at("units");
+            layer.return_sequences  = cfg.at("return_sequences");
+            const auto gates        = 4 * std::size_t{layer.units};
+            layer.weights           = load_params(name, "weights", in.width * gates);
+            layer.recurrent_weights = load_params(name, "recurrent_weights", layer.units * gates);
+            if(cfg.at("use_bias").get<bool>())
+                layer.bias = load_params(name, "bias", gates);
+
+            const auto steps = layer.return_sequences ? in.steps : 1;
+            layer.outputs.push_back(add_tensor(name, 0, {steps, layer.units}));
+            if(cfg.at("return_state").get<bool>())
+            {
+                layer.outputs.push_back(add_tensor(name, 1, {1, layer.units}));
+                layer.outputs.push_back(add_tensor(name, 2, {1, layer.units}));
+            }
+        }
+        else
+        {
+            MIOPEN_THROW(miopenStatusNotImplemented, "Unsupported AI model layer: " + class_name);
+        }
+
+        net.layers.push_back(std::move(layer));
+    }
+
+    for(const auto& ref : config.at("input_layers"))
+        net.inputs.push_back(find_tensor(ref));
+    for(const auto& ref : config.at("output_layers"))
+        net.outputs.push_back(find_tensor(ref));
+
+    // Older models were exported without test vectors.
+    if(model.contains("tests"))
+        Verify(net, model.at("tests"));
+    return net;
+}
+
+Network Network::Load(const fs::path& model_path)
+{
+    if(!fs::exists(model_path))
+        MIOPEN_THROW(miopenStatusInternalError, "Unable to load AI model file: " + model_path);
+
+    const auto source_size  = static_cast<std::uint64_t>(fs::file_size(model_path));
+    const auto source_mtime =
+        static_cast<std::int64_t>(fs::last_write_time(model_path).time_since_epoch().count());
+    const auto cache_path   = GetUserDbPath() / (model_path.filename() + FileSuffix);
+
+    if(!DisableUserDbFileIO)
+    {
+        std::ifstream file{cache_path, std::ios::binary};
+        auto net = file ? Read(file) : std::nullopt;
+        if(net && net->source_size == source_size && net->source_mtime == source_mtime)
+        {
+            MIOPEN_LOG_I2("Loaded compiled AI model: " << cache_path);
+            return std::move(*net);
+        }
+    }
+
+    MIOPEN_LOG_I2("Compiling AI model: " << model_path);
+    auto net         = FromJson(nlohmann::json::parse(std::ifstream{model_path}));
+    net.source_size  = source_size;
+    net.source_mtime = source_mtime;
+
+    if(!DisableUserDbFileIO)
+    {
+        // Written aside and renamed, so that concurrent processes never see a partial file.
+        auto tmp_path = cache_path;
+        tmp_path += boost::filesystem::unique_path("-%%%%-%%%%").string();
+        std::error_code error;
+        fs::create_directories(cache_path.parent_path(), error);
+        {
+            std::ofstream file{tmp_path, std::ios::binary};
+            net.Write(file);
+            if(!file)
+                MIOPEN_LOG_W("Unable to write the compiled AI model: " << tmp_path);
+        }
+        fs::rename(tmp_path, cache_path, error);
+        if(error)
+        {
+            MIOPEN_LOG_W("Unable to store the compiled AI model: " << cache_path);
+            fs::remove(tmp_path, error);
+        }
+    }
+
+    return net;
+}
+
+std::optional<Network> Network::Read(std::istream& in)
+{
+    char magic[sizeof(Magic)];
+    std::uint32_t version       = 0;
+    std::uint32_t endian_marker = 0;
+    if(!in.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+       !ReadValue(in, version) || version != Version || !ReadValue(in, endian_marker) ||
+       endian_marker != EndianMarker)
+        return std::nullopt;
+
+    constexpr std::uint32_t max_layers = 4096;
+
+    Network net;
+    std::uint32_t num_layers = 0;
+    if(!ReadValue(in, net.source_size) || !ReadValue(in, net.source_mtime) ||
+       !ReadArray(in, net.shapes) || !ReadArray(in, net.inputs) || !ReadArray(in, net.outputs) ||
+       !ReadValue(in, num_layers) || num_layers > max_layers)
+        return std::nullopt;
+
+    // Every tensor must be an input of the network or produced by a previous layer.
+    std::vector<bool> available(net.shapes.size(), false);
+    const auto valid_ids = [&](const std::vector<std::uint32_t>& ids) {
+        return std::all_of(
+            ids.begin(), ids.end(), [&](auto id) { return id < available.size(); });
+    };
+    const auto all_available = [&](const std::vector<std::uint32_t>& ids) {
+        return std::all_of(ids.begin(), ids.end(), [&](auto id) { return available[id]; });
+    };
+
+    if(!valid_ids(net.inputs) || !valid_ids(net.outputs))
+        return std::nullopt;
+    for(const auto id : net.inputs)
+        available[id] = true;
+
+    net.layers.resize(num_layers);
+    for(auto& layer : net.layers)
+    {
+        std::uint32_t return_sequences = 0;
+        if(!ReadValue(in, layer.kind) || !ReadValue(in, layer.activation) ||
+           !ReadValue(in, layer.units) || !ReadValue(in, return_sequences) ||
+           !ReadArray(in, layer.inputs) || !ReadArray(in, layer.outputs) ||
+           !ReadArray(in, layer.weights) || !ReadArray(in, layer.recurrent_weights) ||
+           !ReadArray(in, layer.bias) || layer.inputs.empty() || layer.outputs.empty() ||
+           !valid_ids(layer.inputs) || !valid_ids(layer.outputs) ||
+           !all_available(layer.inputs))
+            return std::nullopt;
+        layer.return_sequences = return_sequences != 0;
+        if(!IsConsistent(layer, net.shapes))
+            return std::nullopt;
+        for(const auto id : layer.outputs)
+            available[id] = true;
+    }
+
+    if(!all_available(net.outputs))
+        return std::nullopt;
+    return net;
+}
+
+void Network::Write(std::ostream& out) const
+{
+    out.write(Magic, sizeof(Magic));
+    WriteValue(out, Version);
+    WriteValue(out, EndianMarker);
+    WriteValue(out, source_size);
+    WriteValue(out, source_mtime);
+    WriteArray(out, shapes);
+    WriteArray(out, inputs);
+    WriteArray(out, outputs);
+    WriteValue(out, static_cast<std::uint32_t>(layers.size()));
+    for(const auto& layer : layers)
+    {
+        WriteValue(out, layer.kind);
+        WriteValue(out, layer.activation);
+        WriteValue(out, layer.units);
+        WriteValue(out, static_cast<std::uint32_t>(layer.return_sequences));
+        WriteArray(out, layer.inputs);
+        WriteArray(out, layer.outputs);
+        WriteArray(out, layer.weights);
+        WriteArray(out, layer.recurrent_weights);
+        WriteArray(out, layer.bias);
+    }
+}
+
+std::vector<std::vector<float>>
+Network::Predict(const std::vector<std::vector<float>>& batch_inputs, std::size_t batch) const
+{
+    if(batch_inputs.size() != inputs.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Wrong number of AI model inputs");
+
+    std::vector<std::vector<float>> values(shapes.size());
+    for(std::size_t i = 0; i < inputs.size(); ++i)
+    {
+        if(batch_inputs[i].size() != batch * shapes[inputs[i]].Size())
+            MIOPEN_THROW(miopenStatusBadParm, "Wrong size of AI model input " + std::to_string(i));
+        values[inputs[i]] = batch_inputs[i];
+    }
+
+    for(const auto& layer : layers)
+    {
+        const auto& x = values[layer.inputs[0]];
+        const auto in = shapes[layer.inputs[0]];
+        auto& y       = values[layer.outputs[0]];
+
+        switch(layer.kind)
+        {
+        case LayerKind::Dense:
+            y.resize(batch * in.steps * layer.units);
+            Gemm({x.data(),
+                  layer.weights.data(),
+                  layer.bias.empty() ? nullptr : layer.bias.data(),
+                  y.data(),
+                  batch * in.steps,
+                  in.width,
+                  layer.units,
+                  false});
+            Activate(y, layer.activation);
+            break;
+        case LayerKind::ReLU:
+            y = x;
+            Activate(y, Activation::ReLU);
+            break;
+        case LayerKind::Add:
+            y = x;
+            for(std::size_t i = 1; i < layer.inputs.size(); ++i)
+            {
+                const auto& addend = values[layer.inputs[i]];
+                std::transform(y.begin(), y.end(), addend.begin(), y.begin(), std::plus<>{});
+            }
+            break;
+        case LayerKind::Embedding: {
+            const auto input_dim = layer.weights.size() / layer.units;
+            y.resize(x.size() * layer.units);
+            for(std::size_t i = 0; i < x.size(); ++i)
+            {
+                if(!(x[i] >= 0.0f && x[i] < static_cast<float>(input_dim)))
+                    MIOPEN_THROW(miopenStatusBadParm,
+                                 "AI model token out of range: " + std::to_string(x[i]));
+                const auto token = static_cast<std::size_t>(x[i]);
+                std::copy_n(&layer.weights[token * layer.units], layer.units, &y[i * layer.units]);
+            }
+            break;
+        }
+        case LayerKind::Lstm: RunLstm(layer, shapes, batch, values); break;
+        }
+    }
+
+    std::vector<std::vector<float>> results;
+    results.reserve(outputs.size());
+    for(const auto id : outputs)
+        results.push_back(values[id]);
+    return results;
+}
+
+} // namespace nn
+} // namespace ai
+} // namespace miopen
@@ -30,9 +30,10 @@
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/execution_context.hpp>
+#include <miopen/problem_fingerprint.hpp>
 #include <miopen/tensor_layout.hpp>
 
-#include <sstream>
+#include <ostream>
 
 namespace miopen {
 
@@ -47,20 +48,19 @@ EncodeDataTypesForKey(miopenDataType_t in, miopenDataType_t weights, miopenDataT
 namespace conv {
 namespace {
 
-std::function<void(std::ostream&)>
-PrintDHW(char sep, unsigned spatial_dims, int64_t depth, int64_t height, int64_t width)
+auto PrintDHW(char sep, unsigned spatial_dims, int64_t depth, int64_t height, int64_t width)
 {
-    return [=](std::ostream& stream) {
+    return [=](KeyBuilder& key) {
         if(spatial_dims > 2)
-            stream << depth << sep;
-        stream << height << sep << width;
+            key << depth << sep;
+        key << height << sep << width;
     };
 }
 
-std::ostream& operator<<(std::ostream& stream, std::function<void(std::ostream&)>&& manipulator)
+bool IsDefaultLayout(const std::string& in, const std::string& weights, const std::string& out)
 {
-    manipulator(stream);
-    return stream;
+    return (in == "NCHW" && weights == "NCHW" && out == "NCHW") ||
+           (in == "NCDHW" && weights == "NCDHW" && out == "NCDHW");
 }
 
 } // namespace
@@ -142,106 +142,137 @@ void ProblemDescription::HeuristicUpdateLayouts()
     // If we did not find consistent layout, leave them as-is
 }
 
+void ProblemDescription::ComputeFingerprint()
+{
+    const auto cast_type = [](const std::optional<miopenDataType_t>& type) {
+        return type ? static_cast<int>(*type) : -1;
+    };
+
+    auto builder = FingerprintBuilder{};
+    builder.Add(GetSpatialDims());
+    builder.Add(GetInChannels()).Add(GetInDepth()).Add(GetInHeight()).Add(GetInWidth());
+    builder.Add(GetWeightsDepth()).Add(GetWeightsHeight()).Add(GetWeightsWidth());
+    builder.Add(GetOutChannels()).Add(GetOutDepth()).Add(GetOutHeight()).Add(GetOutWidth());
+    builder.Add(GetInBatchSize());
+    builder.Add(in_layout).Add(weights_layout).Add(out_layout);
+    builder.Add(GetInDataType()).Add(GetWeightsDataType()).Add(GetOutDataType());
+    builder.Add(cast_type(GetInCastType()))
+        .Add(cast_type(GetWeightsCastType()))
+        .Add(cast_type(GetOutCastType()));
+    builder.Add(GetPadD()).Add(GetPadH()).Add(GetPadW());
+    builder.Add(GetKernelStrideD()).Add(GetKernelStrideH()).Add(GetKernelStrideW());
+    builder.Add(GetDilationD()).Add(GetDilationH()).Add(GetDilationW());
+    builder.Add(GetGroupCount());
+    builder.Add(direction).Add(alpha_beta_case).Add(bias);
+    fingerprint = builder.Get();
+}
+
 void ProblemDescription::MakeNetworkConfig(std::string& conf_key) const
 {
-    std::ostringstream ss;
-
-    ss << GetInChannels();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetInDepth(), GetInHeight(), GetInWidth());
-    ss << 'x'
-       << PrintDHW('x', GetSpatialDims(), GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
-    ss << 'x' << GetOutChannels();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
-    ss << 'x' << GetInBatchSize();
-    if((GetInLayout() == "NCHW" && GetWeightsLayout() == "NCHW" && GetOutLayout() == "NCHW") ||
-       (GetInLayout() == "NCDHW" && GetWeightsLayout() == "NCDHW" && GetOutLayout() == "NCDHW"))
+    conf_key.clear();
+    conf_key.reserve(128);
+    auto key = KeyBuilder{conf_key};
+
+    key << GetInChannels();
+    key << 'x' << PrintDHW('x', GetSpatialDims(), GetInDepth(), GetInHeight(), GetInWidth());
+    key << 'x'
+        << PrintDHW('x', GetSpatialDims(), GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
+    key << 'x' << GetOutChannels();
+    key << 'x' << PrintDHW('x', GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
+    key << 'x' << GetInBatchSize();
+    if(IsDefaultLayout(in_layout, weights_layout, out_layout))
     {
-        ss << 'x' << GetInLayout();
+        key << 'x' << in_layout;
     }
     else
     {
-        ss << 'x' << GetInLayout();
-        ss << 'x' << GetWeightsLayout();
-        ss << 'x' << GetOutLayout();
+        key << 'x' << in_layout;
+        key << 'x' << weights_layout;
+        key << 'x' << out_layout;
     }
-    ss << 'x' << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
-
-    std::ostringstream optional;
-    if(const auto ct = GetInCastType())
-        optional << "ci" << GetDataTypeName(*ct);
-    if(const auto ct = GetWeightsCastType())
-        optional << "cw" << GetDataTypeName(*ct);
-    if(const auto ct = GetOutCastType())
-        optional << "co" << GetDataTypeName(*ct);
-    if(!optional.str().empty())
+    key << 'x' << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
+
+    const auto in_cast      = GetInCastType();
+    const auto weights_cast = GetWeightsCastType();
+    const auto out_cast     = GetOutCastType();
+    if(in_cast || weights_cast || out_cast)
     {
-        ss << 'x' << optional.str();
+        key << 'x';
+        if(in_cast)
+            key << "ci" << GetDataTypeName(*in_cast);
+        if(weights_cast)
+            key << "cw" << GetDataTypeName(*weights_cast);
+        if(out_cast)
+            key << "co" << GetDataTypeName(*out_cast);
     }
 
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
-    ss << 'x'
-       << PrintDHW(
-              'x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
-    ss << 'x' << GetGroupCount();
-    ss << 'x' << GetDirectionStr();
-    ss << 'x' << GetAlphaBetaCaseStr();
-
-    conf_key = ss.str();
+    key << 'x' << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
+    key << 'x'
+        << PrintDHW(
+               'x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
+    key << 'x' << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
+    key << 'x' << GetGroupCount();
+    key << 'x' << GetDirectionStr();
+    key << 'x' << GetAlphaBetaCaseStr();
 }
 
-void ProblemDescription::Serialize(std::ostream& stream) const
+void ProblemDescription::MakeDbKey(std::string& db_key) const
 {
+    db_key.clear();
+    db_key.reserve(128);
+    auto key = KeyBuilder{db_key};
+
     const auto sep = '-';
     // Problem description with default layout
     // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F
     // Problem description with non-default layout
     // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NHWC-NCHW-NCHW-FP32-F
     // clang-format off
-    stream << GetInChannels();
-    stream << sep << PrintDHW(sep, GetSpatialDims(), GetInDepth(), GetInHeight(), GetInWidth());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
-    stream << sep << GetOutChannels();
-    stream << sep << PrintDHW(sep, GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
-    stream << sep << GetInBatchSize();
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
-    stream << sep << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
-    stream << sep << GetBias();
-    if ((GetInLayout() == "NCHW" && GetWeightsLayout() == "NCHW" && GetOutLayout() == "NCHW")
-        || (GetInLayout() == "NCDHW" && GetWeightsLayout() == "NCDHW" && GetOutLayout() == "NCDHW"))
+    key << GetInChannels();
+    key << sep << PrintDHW(sep, GetSpatialDims(), GetInDepth(), GetInHeight(), GetInWidth());
+    key << sep << PrintDHW('x', GetSpatialDims(), GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
+    key << sep << GetOutChannels();
+    key << sep << PrintDHW(sep, GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
+    key << sep << GetInBatchSize();
+    key << sep << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
+    key << sep << PrintDHW('x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
+    key << sep << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
+    key << sep << GetBias();
+    if (IsDefaultLayout(in_layout, weights_layout, out_layout))
     {
-        stream << sep << GetInLayout();
+        key << sep << in_layout;
     } else {
-        stream << sep << GetInLayout();
-        stream << sep << GetWeightsLayout();
-        stream << sep << GetOutLayout();
+        key << sep << in_layout;
+        key << sep << weights_layout;
+        key << sep << out_layout;
     }
-    stream << sep << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
-    stream << sep << GetDirectionStr();
+    key << sep << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
+    key << sep << GetDirectionStr();
 
     // clang-format on
     // New performance config entries shall come into variable/optional part of db key.
     // This is to support backward compatibility with previous versions of databases.
-    std::ostringstream optional;
     {
         // Group count > 1 identifies Group/Depthwise modes.
         if(GetGroupCount() != 1)
-            optional << "_g" << GetGroupCount();
+            key << "_g" << GetGroupCount();
 
         if(const auto ct = GetInCastType())
-            optional << "_ci" << GetDataTypeName(*ct);
+            key << "_ci" << GetDataTypeName(*ct);
         if(const auto ct = GetWeightsCastType())
-            optional << "_cw" << GetDataTypeName(*ct);
+            key << "_cw" << GetDataTypeName(*ct);
         if(const auto ct = GetOutCastType())
-            optional << "_co" << GetDataTypeName(*ct);
-    }
-    if(!optional.str().empty())
-    {
-        stream << optional.str();
+            key << "_co" << GetDataTypeName(*ct);
     }
 }
 
+void ProblemDescription::Serialize(std::ostream& stream) const
+{
+    std::string db_key;
+    MakeDbKey(db_key);
+    stream << db_key;
+}
+
 bool ProblemDescription::IsLayoutDefault() const
 {
     if(GetSpatialDims() == 2)
@@ -312,49 +312,60 @@ static std::vector<Solution> EvaluateInvokers(Handle& handle,
     return ret;
 }
 
-FindCoreResult FindCore(const AnyInvokeParams& invoke_ctx,
-                        const ExecutionContext& ctx,
-                        const ProblemDescriptionBase& problem,
-                        const PrimitiveFindParameters& parameters,
-                        const std::vector<std::unique_ptr<ISolversFinder>>& finders,
-                        const std::optional<FindOptions>& options,
-                        bool force_attach_binary)
+using FoundSolutions = std::map<AlgorithmName, std::vector<solver::ConvSolution>>;
+
+static FoundSolutions FindAll(const AnyInvokeParams& invoke_ctx,
+                              const ExecutionContext& ctx,
+                              const ProblemDescriptionBase& problem,
+                              const PrimitiveFindParameters& parameters,
+                              const std::vector<std::unique_ptr<ISolversFinder>>& finders,
+                              const std::optional<FindOptions>& options)
 {
-    auto& handle = ctx.GetStream();
-
-    // Find
-    auto solutions = std::map<AlgorithmName, std::vector<solver::ConvSolution>>{};
+    auto solutions = FoundSolutions{};
     std::transform(
         finders.begin(), finders.end(), std::inserter(solutions, solutions.end()), [&](auto&& f) {
             return std::make_pair(f->GetAlgorithmName(problem),
                                   f->Find(ctx, problem, invoke_ctx, parameters, options));
         });
 
-    std::size_t total = 0;
-
     for(auto it = solutions.begin(); it != solutions.end();)
     {
         if(it->second.empty())
-        {
             it = solutions.erase(it);
-            continue;
-        }
-
-        total += it->second.size();
-        ++it;
+        else
+            ++it;
     }
 
+    return solutions;
+}
+
+static std::vector<const solver::ConvSolution*> GetAll(const FoundSolutions& solutions)
+{
+    auto all = std::vector<const solver::ConvSolution*>{};
+    for(const auto& ss : solutions)
+        std::transform(ss.second.begin(),
+                       ss.second.end(),
+                       std::back_inserter(all),
+                       [](auto&& s) { return &s; });
+    return all;
+}
+
+FindCoreResult FindCore(const AnyInvokeParams& invoke_ctx,
+                        const ExecutionContext& ctx,
+                        const ProblemDescriptionBase& problem,
+                        const PrimitiveFindParameters& parameters,
+                        const std::vector<std::unique_ptr<ISolversFinder>>& finders,
+                        const std::optional<FindOptions>& options,
+                        bool force_attach_binary)
+{
+    auto& handle = ctx.GetStream();
+
+    // Find
+    const auto solutions = FindAll(invoke_ctx, ctx, problem, parameters, finders, options);
+    const auto all       = GetAll(solutions);
+
     // Precompile
-    {
-        auto all = std::vector<const miopen::solver::ConvSolution*>{};
-        all.reserve(total);
-        for(const auto& ss : solutions)
-            std::transform(ss.second.begin(),
-                           ss.second.end(),
-                           std::back_inserter(all),
-                           [](auto&& s) { return &s; });
-        PrecompileSolutions(handle, all, force_attach_binary);
-    }
+    PrecompileSolutions(handle, all, force_attach_binary);
 
     if(env::enabled((MIOPEN_DEBUG_COMPILE_ONLY)))
         MIOPEN_THROW(
@@ -367,7 +378,7 @@ FindCoreResult FindCore(const AnyInvokeParams& invoke_ctx,
     auto ret                  = FindCoreResult();
     ret.is_optimal            = true;
 
-    ret.solutions.reserve(total);
+    ret.solutions.reserve(all.size());
 
     for(const auto& ss : solutions)
     {
@@ -387,6 +398,17 @@ FindCoreResult FindCore(const AnyInvokeParams& invoke_ctx,
     return ret;
 }
 
+solver::PrecompiledKernels
+PrecompileFindCore(const AnyInvokeParams& invoke_ctx,
+                   const ExecutionContext& ctx,
+                   const ProblemDescriptionBase& problem,
+                   const PrimitiveFindParameters& parameters,
+                   const std::vector<std::unique_ptr<ISolversFinder>>& finders)
+{
+    const auto solutions = FindAll(invoke_ctx, ctx, problem, parameters, finders, std::nullopt);
+    return solver::PrecompileSolutionsDetached(ctx.GetStream(), GetAll(solutions));
+}
+
 namespace conv {
 
 bool IsAlgorithmDisabled(miopenConvAlgorithm_t algo)
@@ -27,12 +27,14 @@
 #include <miopen/find_db.hpp>
 
 #include <miopen/handle.hpp>
+#include <miopen/kernel_manifest.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/perf_field.hpp>
 #if MIOPEN_EMBED_DB
 #include <miopen_data.hpp>
 #endif
 #include <miopen/filesystem.hpp>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -271,6 +273,22 @@ void FindDbRecord_t<TDb>::LogFindDbItem(const std::pair<std::string, FindDbData>
         MIOPEN_LOG_I2("Find-db record content: " << pair2.first << ':' << pair2.second);
 }
 
+template <class TDb>
+void FindDbRecord_t<TDb>::RecordToManifest(const std::string& path_suffix) const
+{
+    if(!kernel_manifest::IsRecording() || !content.is_initialized())
+        return;
+
+    auto contents = std::ostringstream{};
+    for(const auto& pair : content->As<FindDbData>())
+    {
+        if(contents.tellp() > 0)
+            contents << ';';
+        contents << pair.first << ':' << pair.second;
+    }
+    kernel_manifest::RecordFindRecord(path_suffix, content->GetKey(), contents.str());
+}
+
 template class FindDbRecord_t<FindDb>;
 template class FindDbRecord_t<UserFindDb>;
 
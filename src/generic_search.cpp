@@ -26,9 +26,13 @@
 
 #include <miopen/generic_search.hpp>
 #include <miopen/generic_search_controls.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/stringutils.hpp>
 
 #include <cstddef>
 #include <chrono>
+#include <exception>
+#include <string>
 
 namespace miopen {
 namespace solver {
@@ -61,6 +65,27 @@ std::chrono::milliseconds GetTuningTimeMax()
     return std::chrono::milliseconds{env::value(MIOPEN_TUNING_TIME_MS_MAX)};
 }
 
+std::chrono::milliseconds GetTuningTimeMax(const std::string& solver_id)
+{
+    const auto overrides = env::value(MIOPEN_TUNING_TIME_MS_MAX_PER_SOLVER);
+    for(const auto& item : SplitDelim(overrides, ','))
+    {
+        const auto eq = item.find('=');
+        if(eq == std::string::npos || item.substr(0, eq) != solver_id)
+            continue;
+        try
+        {
+            return std::chrono::milliseconds{std::stoull(item.substr(eq + 1))};
+        }
+        catch(const std::exception&)
+        {
+            MIOPEN_LOG_W("Wrong MIOPEN_TUNING_TIME_MS_MAX_PER_SOLVER value for " << solver_id
+                                                                                 << ", ignored.");
+        }
+    }
+    return GetTuningTimeMax();
+}
+
 std::size_t GetTuningThreadsMax() { return env::value(MIOPEN_COMPILE_PARALLEL_LEVEL); }
 
 } // namespace solver
@@ -66,6 +66,7 @@
 #define WORKAROUND_FAULTY_HIPMEMGETINFO_VEGA_NAVI2X (HIP_PACKAGE_VERSION_FLAT >= 5007000000ULL)
 
 MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEVICE_CU)
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_KERN_CACHE_WARMUP)
 
 namespace miopen {
 
@@ -290,6 +291,50 @@ struct HandleImpl
     TargetProperties target_properties;
 };
 
+namespace {
+
+void WarmUpProgramsFromEnv(const Handle& handle)
+{
+    const auto& program_list = env::value(MIOPEN_KERN_CACHE_WARMUP);
+    if(program_list.empty())
+        return;
+    // The warm-up is an optimization, the handle is usable without it.
+    try
+    {
+        handle.WarmUpPrograms(fs::path{program_list});
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_W("Kernel cache warm-up failed: " << ex.what());
+    }
+}
+
+/// Appends the target to the compilation options the way the kernel cache keys the binaries.
+std::string GetTargetParams(const TargetProperties& target,
+                            const fs::path& program_name,
+                            std::string params)
+{
+#if WORKAROUND_ISSUE_3001
+    if(program_name.extension() != ".mlir")
+        params = params + " -mcpu=" + target.Name();
+#else
+    if(program_name.extension() == ".mlir")
+    { // no -mcpu
+    }
+    else if(program_name.extension() == ".s")
+    {
+        params += " -mcpu=" + LcOptionTargetStrings{target}.targetId;
+    }
+    else
+    {
+        params += " -mcpu=" + target.Name();
+    }
+#endif
+    return params;
+}
+
+} // namespace
+
 Handle::Handle(miopenAcceleratorQueue_t stream) : impl(std::make_unique<HandleImpl>())
 {
     meopenHandle_current_stream_id = 0;
@@ -314,6 +359,7 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(std::make_unique<HandleIm
 #endif
     this->impl->target_properties.Init(this);
     MIOPEN_LOG_NQI(*this);
+    WarmUpProgramsFromEnv(*this);
 }
 
 Handle::Handle() : impl(std::make_unique<HandleImpl>())
@@ -341,6 +387,7 @@ Handle::Handle() : impl(std::make_unique<HandleImpl>())
 #endif
     this->impl->target_properties.Init(this);
     MIOPEN_LOG_NQI(*this);
+    WarmUpProgramsFromEnv(*this);
 }
 
 Handle::~Handle() {}
@@ -543,22 +590,7 @@ Program Handle::LoadProgram(const fs::path& program_name,
 
     std::string orig_params = params; // make a copy for target ID fallback
 
-#if WORKAROUND_ISSUE_3001
-    if(program_name.extension() != ".mlir")
-        params = params + " -mcpu=" + this->GetTargetProperties().Name();
-#else
-    if(program_name.extension() == ".mlir")
-    { // no -mcpu
-    }
-    else if(program_name.extension() == ".s")
-    {
-        params += " -mcpu=" + LcOptionTargetStrings{this->GetTargetProperties()}.targetId;
-    }
-    else
-    {
-        params += " -mcpu=" + this->GetTargetProperties().Name();
-    }
-#endif
+    params = GetTargetParams(this->GetTargetProperties(), program_name, params);
 
     auto hsaco = miopen::LoadBinary(
         this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, params);
@@ -651,6 +683,67 @@ Program Handle::LoadProgram(const fs::path& program_name,
     }
 }
 
+void Handle::WarmUpPrograms(const std::vector<ProgramKey>& programs) const
+{
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    this->impl->set_ctx();
+    const auto& target = this->GetTargetProperties();
+
+    std::vector<ProgramKey> pending;
+    std::vector<ProgramKey> keys;
+    for(const auto& program : programs)
+    {
+        if(this->HasProgram(program.first, program.second))
+            continue;
+        pending.push_back(program);
+        keys.emplace_back(program.first, GetTargetParams(target, program.first, program.second));
+    }
+
+    auto binaries = miopen::LoadBinaries(target, this->GetMaxComputeUnits(), keys);
+
+    // Same target ID fallback as LoadProgram(), for the missing ones only.
+    const auto arch_target_id = miopen::SplitDelim(target.Name(), ':');
+    if(arch_target_id.size() > 1)
+    {
+        std::vector<std::size_t> missing_idx;
+        std::vector<ProgramKey> missing;
+        for(std::size_t i = 0; i < binaries.size(); ++i)
+        {
+            if(!binaries[i].empty())
+                continue;
+            missing_idx.push_back(i);
+            missing.emplace_back(pending[i].first,
+                                 pending[i].second + " -mcpu=" + arch_target_id.at(0));
+        }
+        auto generic = miopen::LoadBinaries(target, this->GetMaxComputeUnits(), missing);
+        for(std::size_t i = 0; i < missing_idx.size(); ++i)
+            binaries[missing_idx[i]] = std::move(generic[i]);
+    }
+
+    auto loaded = std::size_t{0};
+    for(std::size_t i = 0; i < pending.size(); ++i)
+    {
+        if(binaries[i].empty())
+            continue;
+        this->AddProgram(HIPOCProgram{pending[i].first, binaries[i]},
+                         pending[i].first,
+                         pending[i].second);
+        ++loaded;
+    }
+
+    MIOPEN_LOG_I("Warmed up " << loaded << " of " << programs.size() << " programs, "
+                              << programs.size() - pending.size() << " were already loaded");
+#else
+    std::ignore = programs;
+    MIOPEN_LOG_W("Kernel cache warm-up requires the SQLite kernel cache");
+#endif
+}
+
+void Handle::WarmUpPrograms(const fs::path& program_list) const
+{
+    this->WarmUpPrograms(miopen::ReadProgramList(program_list));
+}
+
 bool Handle::HasProgram(const fs::path& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
@@ -118,7 +118,7 @@ static fs::path HipBuildImpl(const TmpDir& tmp_dir,
     // Let's assume includes are overkill for feature tests & optimize'em out.
     if(!testing_mode)
     {
-        auto inc_list = GetKernelIncList();
+        const auto& inc_list = GetKernelIncList(filename, src);
         fs::create_directories(tmp_dir);
         for(const auto& inc_file : inc_list)
         {
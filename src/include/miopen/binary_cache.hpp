@@ -30,18 +30,39 @@
 #include <miopen/config.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/filesystem.hpp>
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
-bool IsCacheDisabled();
+class KernFileCache;
 
+/// A program as keyed by the program cache of the handle: the file name of the kernel
+/// and the compilation options.
+using ProgramKey = std::pair<fs::path, std::string>;
+
+MIOPEN_INTERNALS_EXPORT bool IsCacheDisabled();
+
+/// Reads a list of programs to warm the kernel cache up with. One program per line, the name
+/// and the options separated by a tab. Empty lines and lines starting with '#' are skipped,
+/// as well as the lines starting with '@', so that a kernel manifest can be used as the list.
+MIOPEN_INTERNALS_EXPORT std::vector<ProgramKey> ReadProgramList(const fs::path& path);
+
+/// The path of a binary in the layout preceding KernFileCache. Only the binaries left there are
+/// looked up, to be moved to the new cache.
 MIOPEN_INTERNALS_EXPORT fs::path
 GetCacheFile(const std::string& device, const fs::path& name, const std::string& args);
 
 MIOPEN_INTERNALS_EXPORT fs::path GetCachePath(bool is_system);
 
+/// The MIOPEN_KERN_CACHE_MAX_SIZE limit of a KernFileCache in bytes.
+MIOPEN_INTERNALS_EXPORT std::uint64_t GetKernFileCacheMaxSize();
+
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
+MIOPEN_INTERNALS_EXPORT KernFileCache& GetKernFileCache();
+
 fs::path LoadBinary(const TargetProperties& target,
                     std::size_t num_cu,
                     const fs::path& name,
@@ -62,6 +83,12 @@ void SaveBinary(const std::vector<char>& hsaco,
                 std::size_t num_cu,
                 const fs::path& name,
                 const std::string& args);
+
+/// Loads the binaries of all the programs opening the databases once, the keys are the
+/// same as for LoadBinary(). Returns empty binaries for the programs not found.
+std::vector<std::vector<char>> LoadBinaries(const TargetProperties& target,
+                                            std::size_t num_cu,
+                                            const std::vector<ProgramKey>& programs);
 #endif
 
 } // namespace miopen
@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_SERVER_HPP_
+#define GUARD_MIOPEN_COMPILE_SERVER_HPP_
+
+// Optional local daemon which runs the offline compiler commands of the MIOpen processes of a
+// node, see tools/compile_server.
+//
+// A client sends the command, its arguments and its working directory, a temporary directory
+// holding the inputs of the build, over a Unix socket and gets the exit status back. The server
+// identifies a build by the command, the arguments with the working directory replaced, and the
+// contents of the files in the directory. Identical builds running at the same time are run once
+// and the files the command created or changed are copied to the working directories of the other
+// clients. The successful results are stored in a KernFileCache, so a build is run once per node
+// until it is evicted.
+//
+// The commands run in the environment of the server, not of the client.
+
+#include <miopen/config.hpp>
+#include <miopen/filesystem.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace miopen {
+namespace compile_server {
+
+/// The socket from MIOPEN_COMPILE_SERVER, empty if the builds shall not use a server.
+MIOPEN_INTERNALS_EXPORT fs::path GetSocketPath();
+
+/// Runs CMD with ARGS in CWD on the server listening on the SOCKET. Returns the exit status of
+/// the command, or none if the server is not available, in which case the caller shall run the
+/// command itself.
+MIOPEN_INTERNALS_EXPORT boost::optional<int>
+Execute(const fs::path& socket, std::string_view cmd, std::string_view args, const fs::path& cwd);
+
+struct Stats
+{
+    std::size_t requests = 0;
+    /// The commands run.
+    std::size_t builds = 0;
+    /// The requests which waited for an identical build of another client.
+    std::size_t deduplicated = 0;
+    /// The builds served from the cache.
+    std::size_t cache_hits = 0;
+};
+
+class MIOPEN_INTERNALS_EXPORT Server
+{
+public:
+    /// Listens on the SOCKET, which is only accessible to the current user. Runs up to JOBS
+    /// commands at once, 0 for the number of hardware threads. The results are cached in the
+    /// KernFileCache at CACHE_ROOT, limited to CACHE_MAX_SIZE bytes. An empty root disables the
+    /// cache.
+    Server(const fs::path& socket,
+           std::size_t jobs,
+           const fs::path& cache_root,
+           std::uint64_t cache_max_size);
+    /// Waits for the requests being served and removes the socket.
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /// Serves the clients until Stop() is called.
+    void Run();
+    /// May be called from any thread, including a signal handling one.
+    void Stop();
+
+    Stats GetStats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace compile_server
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_SERVER_HPP_
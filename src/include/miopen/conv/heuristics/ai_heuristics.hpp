@@ -75,6 +75,12 @@ class Model;
 MIOPEN_INTERNALS_EXPORT std::vector<uint64_t> PredictSolver(const conv::ProblemDescription& problem,
                                                             const ExecutionContext& ctx,
                                                             const std::string& device);
+/// Same as PredictSolver for many problems. The problems which are not in the cache of
+/// previous predictions are evaluated in one batch, which is much faster than one by one.
+MIOPEN_INTERNALS_EXPORT std::vector<std::vector<uint64_t>>
+PredictSolvers(const std::vector<const conv::ProblemDescription*>& problems,
+               const ExecutionContext& ctx,
+               const std::string& device);
 } // namespace immed_mode
 
 #endif // MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK
@@ -92,7 +98,6 @@ bool ModelSetParams(const std::string& arch,
                     const std::string& solver,
                     conv::Direction direction,
                     const std::vector<float>& features,
-                    bool transform_features,
                     std::function<bool(std::size_t, std::string)> validator);
 } // namespace tuning
 #endif // MIOPEN_ENABLE_AI_KERNEL_TUNING
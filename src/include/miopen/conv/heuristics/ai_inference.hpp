@@ -0,0 +1,145 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_AI_INFERENCE_HPP_
+#define GUARD_MIOPEN_AI_INFERENCE_HPP_
+
+#include <miopen/config.hpp>
+#include <miopen/filesystem.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace ai {
+namespace nn {
+
+/// Native executor for the Keras models used by the AI heuristics (TunaNet and the kernel
+/// tuning encoder/decoder pairs), replacing frugally-deep at run time.
+///
+/// Only the layers these models consist of are supported: Dense, ReLU, Add, Embedding and
+/// LSTM. Every tensor is a batch of sequences of `steps` vectors of `width` floats; a plain
+/// vector is a sequence of one step. Inference runs over a whole batch at once, so that the
+/// weights are streamed through the cache once per layer rather than once per problem.
+///
+/// The .tn.model/.ktn.model files are JSON (the frugally-deep export format). They are
+/// converted on first use, the result is checked against the test vectors embedded in the
+/// file and cached in the user db directory in a compact binary form, see Network::Load().
+
+enum class LayerKind : std::uint32_t
+{
+    Dense,
+    ReLU,
+    Add,
+    Embedding,
+    Lstm,
+};
+
+enum class Activation : std::uint32_t
+{
+    Linear,
+    ReLU,
+    Sigmoid,
+    Tanh,
+};
+
+struct TensorShape
+{
+    std::uint32_t steps;
+    std::uint32_t width;
+
+    std::size_t Size() const { return std::size_t{steps} * width; }
+};
+
+struct Layer
+{
+    LayerKind kind;
+    Activation activation = Activation::Linear;
+    /// Output width of Dense, Embedding and Lstm.
+    std::uint32_t units = 0;
+    /// Lstm only: return the whole output sequence rather than the last output.
+    bool return_sequences = false;
+    /// Tensor ids. The inputs of an Lstm are the sequence and optionally the initial h and c.
+    /// Its outputs are the output, and the final h and c if the model returns the state.
+    std::vector<std::uint32_t> inputs;
+    std::vector<std::uint32_t> outputs;
+    /// Row-major [in, units] (for an Lstm [in, 4 * units], Keras gate order i, f, c, o).
+    std::vector<float> weights;
+    /// Lstm only, row-major [units, 4 * units].
+    std::vector<float> recurrent_weights;
+    std::vector<float> bias;
+};
+
+class MIOPEN_INTERNALS_EXPORT Network
+{
+public:
+    /// Extension appended to the name of a model file to get the name of its compiled form.
+    static constexpr const char* FileSuffix = ".bin";
+
+    Network() = default;
+
+    /// Builds the network from a model in the frugally-deep JSON format and verifies it
+    /// against the test vectors stored in the model. Throws on unsupported layers or a
+    /// failed verification.
+    static Network FromJson(const nlohmann::json& model);
+
+    /// Loads the compiled form of the model from the user db directory if it is up to date,
+    /// otherwise converts the JSON model and stores the compiled form for the next time.
+    static Network Load(const fs::path& model_path);
+
+    /// Returns std::nullopt if the stream does not contain a network in the current format.
+    static std::optional<Network> Read(std::istream& in);
+    void Write(std::ostream& out) const;
+
+    std::size_t GetInputCount() const { return inputs.size(); }
+    std::size_t GetOutputCount() const { return outputs.size(); }
+    const TensorShape& GetInputShape(std::size_t i) const { return shapes[inputs[i]]; }
+    const TensorShape& GetOutputShape(std::size_t i) const { return shapes[outputs[i]]; }
+
+    /// Runs the network on a batch. `inputs[i]` holds `batch` consecutive tensors of the
+    /// shape GetInputShape(i), the outputs are laid out the same way.
+    std::vector<std::vector<float>> Predict(const std::vector<std::vector<float>>& batch_inputs,
+                                            std::size_t batch) const;
+
+private:
+    std::vector<TensorShape> shapes;
+    std::vector<Layer> layers;
+    std::vector<std::uint32_t> inputs;
+    std::vector<std::uint32_t> outputs;
+    /// Identifies the source model, used to detect a stale compiled form.
+    std::uint64_t source_size = 0;
+    std::int64_t source_mtime = 0;
+};
+
+} // namespace nn
+} // namespace ai
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_AI_INFERENCE_HPP_
@@ -167,6 +167,7 @@ struct MIOPEN_INTERNALS_EXPORT ProblemDescription : ProblemDescriptionBase
           alpha_beta_case(ClassifyAlphaBeta(alpha, beta))
     {
         HeuristicUpdateLayouts();
+        ComputeFingerprint();
     }
 
     // Conv descriptor getters
@@ -377,12 +378,18 @@ struct MIOPEN_INTERNALS_EXPORT ProblemDescription : ProblemDescriptionBase
     {
         std::string ret;
         MakeNetworkConfig(ret);
-        return NetworkConfig{ret};
+        return NetworkConfig{std::move(ret)};
     }
 
+    /// Computed once on construction, O(1).
+    ProblemFingerprint MakeFingerprint() const override { return fingerprint; }
+
     // Todo: remove after fixing fin
     [[deprecated]] NetworkConfig BuildConfKey() const { return MakeNetworkConfig(); }
 
+    /// The perf db key, the same as Serialize() produces but without the stream.
+    void MakeDbKey(std::string& db_key) const;
+
     void Serialize(std::ostream& stream) const;
 
     friend std::ostream& operator<<(std::ostream& os, const ProblemDescription& obj)
@@ -443,6 +450,8 @@ struct MIOPEN_INTERNALS_EXPORT ProblemDescription : ProblemDescriptionBase
     void SetupFloats(ExecutionContext& ctx) const;
 
 private:
+    void ComputeFingerprint();
+
     std::string ComputeInLayout() const
     {
         if(GetSpatialDims() == 2)
@@ -491,6 +500,7 @@ private:
     Scalar alpha                          = Scalar(1.0);
     Scalar beta                           = Scalar(0.0);
     miopenAlphaBetaCase_t alpha_beta_case = DEFAULT;
+    ProblemFingerprint fingerprint;
 };
 
 } // namespace conv
@@ -172,6 +172,16 @@ FindCoreResult FindCore(const AnyInvokeParams& invoke_ctx,
                         const std::optional<FindOptions>& options = std::nullopt,
                         bool force_attach_binary                  = false);
 
+/// Runs the find stage of FindCore() and compiles the kernels of the found solutions without
+/// evaluating them. Does not touch the program cache of the handle so may be called from a
+/// thread other than the one running FindCore(), see PrecompileSolutionsDetached().
+solver::PrecompiledKernels
+PrecompileFindCore(const AnyInvokeParams& invoke_ctx,
+                   const ExecutionContext& ctx,
+                   const ProblemDescriptionBase& problem,
+                   const PrimitiveFindParameters& parameters,
+                   const std::vector<std::unique_ptr<ISolversFinder>>& finders);
+
 namespace conv {
 bool IsAlgorithmDisabled(miopenConvAlgorithm_t algo);
 bool IsEnoughWorkspace(std::string_view where,
@@ -92,6 +92,11 @@ void PrecompileSolutions(const Handle& h,
                          const std::vector<const ConvSolution*>& sols,
                          bool force_attach_binary = false);
 
+/// Compiles the kernels of the solutions without using the program cache of the handle, thus
+/// may run concurrently with the other work on the same handle. See AddPrecompiledKernels().
+PrecompiledKernels PrecompileSolutionsDetached(const Handle& h,
+                                               const std::vector<const ConvSolution*>& sols);
+
 } // namespace solver
 } // namespace miopen
 
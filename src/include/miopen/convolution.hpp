@@ -61,6 +61,7 @@ struct ProblemDescription;
 
 namespace solver {
 struct ConvSolution;
+struct PrecompiledKernels;
 } // namespace solver
 
 struct ExecutionContext;
@@ -151,6 +152,17 @@ std::vector<Solution> FindConvolution(const ExecutionContext& ctx,
                                       int requestAlgoCount,
                                       bool force_attach_binary);
 
+/// Returns false if FindConvolution() would take the results from the find-db or skip the
+/// compilation of the kernels found by the solvers for some other reason.
+bool IsConvolutionFindCoreExpected(const ExecutionContext& ctx,
+                                   const conv::ProblemDescription& problem);
+
+/// Compiles the kernels FindConvolution() is going to evaluate, without using the program cache
+/// of the handle. Used to overlap the compilation with the benchmarking of other problems.
+solver::PrecompiledKernels PrecompileConvolution(const ExecutionContext& ctx,
+                                                 const conv::ProblemDescription& problem,
+                                                 const AnyInvokeParams& invoke_ctx);
+
 struct MIOPEN_INTERNALS_EXPORT ConvolutionDescriptor : miopenConvolutionDescriptor
 {
     ConvolutionDescriptor(std::size_t spatial_dim,
@@ -36,6 +36,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 namespace miopen {
 
@@ -221,6 +222,32 @@ public:
         return users ? users : _installed.FindRecord(args...);
     }
 
+    /// Searches for the records of all the PROBLEMS in the user database first and for the
+    /// missing ones in the installed database.
+    template <class T, bool merge = merge_records, std::enable_if_t<!merge>* = nullptr>
+    auto FindRecords(const std::vector<T>& problems)
+    {
+        auto records = _user.FindRecords(problems);
+
+        std::vector<std::size_t> missing_idx;
+        std::vector<T> missing;
+        for(std::size_t i = 0; i < records.size(); ++i)
+        {
+            if(!records[i])
+            {
+                missing_idx.push_back(i);
+                missing.push_back(problems[i]);
+            }
+        }
+        if(missing.empty())
+            return records;
+
+        auto installed = _installed.FindRecords(missing);
+        for(std::size_t i = 0; i < missing_idx.size(); ++i)
+            records[missing_idx[i]] = std::move(installed[i]);
+        return records;
+    }
+
     template <typename... U>
     auto StoreRecord(const U&... args)
     {
@@ -259,7 +286,30 @@ public:
         return _user.Remove(args...);
     }
 
+    /// Loads the records of all the PROBLEMS in advance where the underlying databases support
+    /// it. The databases keeping the whole file in memory do not need that.
+    template <class T>
+    void Prefetch(const std::vector<T>& problems)
+    {
+        Prefetch(rank<1>{}, _installed, problems);
+#if !MIOPEN_DISABLE_USERDB
+        Prefetch(rank<1>{}, _user, problems);
+#endif
+    }
+
 private:
+    template <class TDb, class T>
+    static auto Prefetch(rank<1>, TDb& db, const std::vector<T>& problems)
+        -> decltype(db.Prefetch(problems), void())
+    {
+        db.Prefetch(problems);
+    }
+
+    template <class TDb, class T>
+    static void Prefetch(rank<0>, TDb&, const std::vector<T>&)
+    {
+    }
+
     template <class TDb, class TRet = decltype(TDb::GetCached(DbKinds::FindDb, "", true))>
     static TRet
     GetDbInstance(rank<1>, DbKinds db_kind, const fs::path& path, bool warn_if_unreadable)
@@ -301,6 +351,12 @@ public:
         return Measure("FindRecord", [&]() { return inner.FindRecord(args...); });
     }
 
+    template <typename... U>
+    auto FindRecords(const U&... args)
+    {
+        return Measure("FindRecords", [&]() { return inner.FindRecords(args...); });
+    }
+
     template <typename... U>
     auto StoreRecord(U&... record)
     {
@@ -337,6 +393,15 @@ public:
         return Measure("Remove", [&]() { return inner.Remove(args...); });
     }
 
+    template <typename... U>
+    void Prefetch(const U&... args)
+    {
+        Measure("Prefetch", [&]() {
+            inner.Prefetch(args...);
+            return true;
+        });
+    }
+
 private:
     TInnerDb inner;
 
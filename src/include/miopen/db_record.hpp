@@ -283,6 +283,7 @@ public:
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
     friend class RamDb;
+    friend class LogDb;
 };
 
 } // namespace miopen
@@ -32,6 +32,7 @@
 #include <miopen/db_path.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
+#include <miopen/log_db.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/ramdb.hpp>
 #include <miopen/readonlyramdb.hpp>
@@ -55,7 +56,11 @@ class FindDbRecord_t;
 
 #if MIOPEN_DEBUG_FIND_DB_CACHING
 using SystemFindDb = ReadonlyRamDb;
-using UserFindDb   = RamDb;
+#if MIOPEN_USE_LOG_USERDB
+using UserFindDb = LogDb;
+#else
+using UserFindDb = RamDb;
+#endif
 #else
 using SystemFindDb = PlainTextDb;
 using UserFindDb   = PlainTextDb;
@@ -160,6 +165,7 @@ public:
         {
             auto solutions = std::vector<Solution>{};
             record.CopyTo(solutions);
+            record.RecordToManifest(path_suffix);
             return solutions;
         }
 
@@ -181,9 +187,12 @@ public:
                 FindDbData{solution.GetTime(), solution.GetWorkspaceSize(), algo});
         }
 
+        record.RecordToManifest(path_suffix);
         return result.solutions;
     }
 
+    static fs::path GetUserPath(Handle& handle, const std::string& path_suffix);
+
 private:
     fs::path path;
     fs::path installed_path;
@@ -195,13 +204,13 @@ private:
     static fs::path GetInstalledPath(Handle& handle, const std::string& path_suffix);
     static fs::path GetInstalledPathEmbed(Handle& handle, const std::string& path_suffix);
     static fs::path GetInstalledPathFile(Handle& handle, const std::string& path_suffix);
-    static fs::path GetUserPath(Handle& handle, const std::string& path_suffix);
 
     // Returns true if rebuild is required
     bool Validate(Handle& handle, const NetworkConfig& config) const;
     void CopyTo(std::vector<Solution>& to) const;
 
     void LogFindDbItem(const std::pair<std::string, FindDbData>& item) const;
+    void RecordToManifest(const std::string& path_suffix) const;
 };
 
 extern template class FindDbRecord_t<FindDb>;
@@ -0,0 +1,58 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_GUARD_MLOPEN_FNV1A_HPP
+#define MIOPEN_GUARD_MLOPEN_FNV1A_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace miopen {
+
+/// 64-bit FNV-1a. Cheap for short keys, intended for in-memory fingerprints only:
+/// it is neither collision resistant nor guaranteed to be stable between releases.
+constexpr std::uint64_t Fnv1a64(std::string_view str, std::uint64_t hash = 0xcbf29ce484222325ULL)
+{
+    for(const auto c : str)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/// Combines two fingerprints into one with well mixed bits (splitmix64 finalizer).
+constexpr std::uint64_t CombineFingerprints(std::uint64_t l, std::uint64_t r)
+{
+    auto x = l ^ (r + 0x9e3779b97f4a7c15ULL + (l << 6) + (l >> 2));
+    x      = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x      = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace miopen
+
+#endif
@@ -35,12 +35,22 @@
 #include <miopen/handle.hpp>
 #include <miopen/invoke_params.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/measurement_policy.hpp>
 #include <miopen/timer.hpp>
 #include <miopen/type_traits.hpp>
-#include <miopen/mt_queue.hpp>
+#include <miopen/mpmc_queue.hpp>
+#include <miopen/search_strategy.hpp>
+#include <miopen/thread_pool.hpp>
 #include <miopen/generic_search_controls.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <tuple>
 #include <vector>
 #include <cstdlib>
 #include <limits>
@@ -316,47 +326,89 @@ GetAllSolutions(const Solver s, const Context& context_, const Problem& problem)
 
 std::size_t GetTuningIterationsMax();
 std::chrono::milliseconds GetTuningTimeMax(); // returns the max allowed time in milliseconds
+/// Applies the MIOPEN_TUNING_TIME_MS_MAX_PER_SOLVER override for the solver, if any.
+std::chrono::milliseconds GetTuningTimeMax(const std::string& solver_id);
 std::size_t GetTuningThreadsMax();
 
+template <typename PerformanceConfig>
+std::vector<std::vector<float>> GetSearchFeatures(const std::vector<PerformanceConfig>& configs)
+{
+    std::vector<std::vector<float>> features;
+    features.reserve(configs.size());
+    for(const auto& config : configs)
+    {
+        std::ostringstream ss;
+        config.Serialize(ss);
+        features.emplace_back(GetSearchFeatures(ss.str()));
+    }
+    return features;
+}
+
+/// Config, its solution, the "done" flag and the index of the config.
+template <typename PerformanceConfig>
+using CompileItem = std::tuple<PerformanceConfig, ConvSolution, bool, std::size_t>;
+
+template <typename PerformanceConfig>
+using CompileQueue = MpmcQueue<CompileItem<PerformanceConfig>>;
+
+/// Compiles the configs from data and passes them to the benchmarking loop. The agents claim
+/// configs one at a time from the search strategy, so an agent stuck in a slow compilation does
+/// not delay the configs which would otherwise be assigned to it. Every agent finishes by
+/// pushing a single item with the "done" flag set.
 template <typename PerformanceConfig, typename Solver, typename Context, typename Problem>
 void CompileAgent(size_t thread_index,
-                  size_t total_threads,
+                  const std::function<std::optional<std::size_t>()>& next_config,
                   const Solver& s,
                   const Context& context,
                   const Problem& problem,
                   std::vector<PerformanceConfig>& data,
-                  ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>>& comp_queue)
+                  CompileQueue<PerformanceConfig>& comp_queue)
 {
+    const auto push = [&](CompileItem<PerformanceConfig>&& item) {
+        // The queue is sized for all the configs and all the "done" items, this never spins.
+        while(!comp_queue.try_push(std::move(item)))
+            std::this_thread::yield();
+    };
+    const auto push_done = [&]() {
+        push(CompileItem<PerformanceConfig>{{}, {}, true, 0});
+    };
+
     const auto start_time =
         std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now());
-    const auto data_size   = data.size();
-    const auto time_budget = GetTuningTimeMax();
+    const auto time_budget = GetTuningTimeMax(s.SolverDbId());
     const auto& profile_h  = context.GetStream();
-    // start the counter
-    for(auto idx = thread_index; idx < data_size; idx += total_threads)
+
+    try
     {
-        // Check if we are out of time
-        const auto current_time = std::chrono::time_point_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now());
-        if(current_time - start_time > time_budget)
+        while(const auto idx = next_config())
         {
-            MIOPEN_LOG_I2("Thread: " << thread_index << " Done, exhausted time budget");
-            auto tmp = std::make_tuple<PerformanceConfig, ConvSolution, bool>({}, {}, true);
-            comp_queue.push(std::move(tmp));
-            break;
-        }
-        auto& current_config          = data.at(idx);
-        ConvSolution current_solution = s.GetSolution(context, problem, current_config);
-        for(const auto& kernel : current_solution.construction_params)
-        {
-            if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
-                continue;
-            std::ignore = profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, "");
+            // Check if we are out of time
+            const auto current_time = std::chrono::time_point_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now());
+            if(current_time - start_time > time_budget)
+            {
+                MIOPEN_LOG_I2("Thread: " << thread_index << " Done, exhausted time budget");
+                break;
+            }
+            auto& current_config          = data.at(*idx);
+            ConvSolution current_solution = s.GetSolution(context, problem, current_config);
+            for(const auto& kernel : current_solution.construction_params)
+            {
+                if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
+                    continue;
+                std::ignore = profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, "");
+            }
+            push(CompileItem<PerformanceConfig>{
+                std::move(current_config), std::move(current_solution), false, *idx});
         }
-        auto tup = std::make_tuple<PerformanceConfig, ConvSolution, bool>(
-            std::move(current_config), std::move(current_solution), false);
-        comp_queue.push(std::move(tup));
     }
+    catch(...)
+    {
+        // Unblock the benchmarking loop, the exception is rethrown by the task group.
+        push_done();
+        throw;
+    }
+    push_done();
     MIOPEN_LOG_I2("Thread: " << thread_index << " Done, completed tuning");
 }
 
@@ -392,12 +444,7 @@ auto GenericSearch(const Solver s,
     // For random access
     std::vector<PerformanceConfig> all_configs;
     std::copy(tmp_all_configs.begin(), tmp_all_configs.end(), std::back_inserter(all_configs));
-    // shuffle the configs
-    std::random_device rd{};
-    auto rng = std::default_random_engine{rd()};
-    std::shuffle(all_configs.begin(), all_configs.end(), rng);
     std::size_t n_runs_total = std::min(all_configs.size(), GetTuningIterationsMax());
-    all_configs.resize(n_runs_total);
 
     if(all_configs.empty())
     {
@@ -416,6 +463,28 @@ auto GenericSearch(const Solver s,
         }
     }
 
+    // The strategy picks which n_runs_total of the configs are measured and in which order.
+    // The seed is logged to allow reproducing the search with MIOPEN_DEBUG_TUNING_SEED.
+    const auto seed = GetSearchSeed();
+    MIOPEN_LOG_I2("Search seed: " << seed);
+    const auto kind = GetSearchStrategyKind();
+    // Only the surrogate model uses the features, the random search needs just the count.
+    auto features       = kind == SearchStrategyKind::Surrogate
+                              ? GetSearchFeatures(all_configs)
+                              : std::vector<std::vector<float>>(all_configs.size());
+    const auto strategy = MakeSearchStrategy(kind, std::move(features), n_runs_total, seed);
+    std::mutex strategy_mutex;
+    std::atomic<bool> stop_search{false};
+    const std::function<std::optional<std::size_t>()> next_config = [&]() {
+        std::lock_guard<std::mutex> lock(strategy_mutex);
+        if(stop_search)
+            return std::optional<std::size_t>{};
+        return strategy->Next();
+    };
+
+    const auto policy = MeasurementPolicy::FromEnv();
+    PlateauDetector plateau{policy};
+
     bool is_passed  = false; // left false only if all iterations failed.
     float best_time = std::numeric_limits<float>::max();
     size_t n_failed = 0;
@@ -423,23 +492,39 @@ auto GenericSearch(const Solver s,
     HeartBeat<PerformanceConfig> heartbeat;
     heartbeat.Start();
 
-    const auto total_threads = GetTuningThreadsMax();
+    // The agents run on the shared pool, so the effective parallelism is also bounded
+    // by the pool size.
+    const auto total_threads = std::max<std::size_t>(GetTuningThreadsMax(), 1);
 
-    ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>> solution_queue;
-    std::vector<std::thread> compile_agents;
-    compile_agents.reserve(total_threads);
-    for(auto idx = 0; idx < total_threads; ++idx)
+    CompileQueue<PerformanceConfig> solution_queue{n_runs_total + total_threads};
+    TaskGroup compile_agents;
+    for(std::size_t idx = 0; idx < total_threads; ++idx)
     {
-        compile_agents.emplace_back(CompileAgent<PerformanceConfig, Solver, Context, Problem>,
-                                    idx,
-                                    total_threads,
-                                    std::cref(s),
-                                    std::cref(context),
-                                    std::cref(problem),
-                                    std::ref(all_configs),
-                                    std::ref(solution_queue));
+        compile_agents.Run([&, idx]() {
+            CompileAgent<PerformanceConfig, Solver, Context, Problem>(
+                idx, next_config, s, context, problem, all_configs, solution_queue);
+        });
     }
 
+    const auto pop_solution = [&]() {
+        auto idle = 0;
+        while(true)
+        {
+            if(auto item = solution_queue.try_pop())
+                return std::move(*item);
+            if(++idle < 64)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            // The agents may never start if this search itself runs on a busy pool thread.
+            // Only the own agents are run then: an unrelated task would delay the benchmarks.
+            if(ThreadPool::Global().IsWorkerThread() && compile_agents.RunPending())
+                continue;
+            std::this_thread::sleep_for(std::chrono::microseconds{100});
+        }
+    };
+
     if(!env::enabled(MIOPEN_DEBUG_COMPILE_ONLY))
     {
         size_t n_current       = 0;
@@ -449,9 +534,10 @@ auto GenericSearch(const Solver s,
             if(n_current >= n_runs_total)
                 break;
             MIOPEN_LOG_I2("Waiting for item in queue");
-            const auto kinder     = solution_queue.pop();
+            const auto kinder     = pop_solution();
             auto current_config   = std::get<0>(kinder);
             auto current_solution = std::get<1>(kinder);
+            const auto index      = std::get<3>(kinder);
 
             if(std::get<2>(kinder))
             {
@@ -507,50 +593,58 @@ auto GenericSearch(const Solver s,
 
             if(ret == 0)
             {
-                // Smooth the jitter of measurements:
-                // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-                // then re-run it 4 times more and compute average time,
-                // and decide using average of all 5 attempts vs. the best.
-                if(elapsed_time / best_time < 1.05f)
+                // Smooth the jitter of measurements: promising candidates are sampled several
+                // times and scored by the median, see MeasurementPolicy.
+                TimingSamples samples;
+                samples.Add(elapsed_time);
+
+                try
+                {
+                    while(policy.NeedMoreSamples(samples, best_time))
+                    {
+                        invoker(profile_h, invoke_ctx);
+                        samples.Add(profile_h.GetKernelTime());
+                    }
+                }
+                catch(...)
                 {
-                    MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time
-                                                          << " = " << (elapsed_time / best_time));
+                    ret = 1;
+                }
 
-                    try
+                if(ret == 0)
+                {
+                    is_passed    = true;
+                    elapsed_time = samples.Median();
+                    if(samples.Size() > 1)
                     {
-                        for(int i = 0; i < 4; ++i)
-                        {
-                            invoker(profile_h, invoke_ctx);
-                            elapsed_time += profile_h.GetKernelTime();
-                        }
+                        const auto ci = samples.ConfidenceInterval();
+                        MIOPEN_LOG_I2("Median of " << samples.Size() << " samples: " << elapsed_time
+                                                   << ", 95% CI of the mean: [" << ci.first
+                                                   << ", " << ci.second << ']');
                     }
-                    catch(...)
+                    if(elapsed_time < best_time)
                     {
-                        ret = 1;
+                        MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
+                                         << ' ' << elapsed_time << " < " << best_time << ' '
+                                         << current_config);
+                        best_config = current_config;
+                        best_time   = elapsed_time;
+                        n_best      = n_current;
                     }
-
-                    if(ret == 0)
+                    else
                     {
-                        is_passed = true;
-                        elapsed_time /= 5;
-                        if(elapsed_time < best_time)
-                        {
-                            MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                             << ' ' << elapsed_time << " < " << best_time << ' '
-                                             << current_config);
-                            best_config = current_config;
-                            best_time   = elapsed_time;
-                            n_best      = n_current;
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_I2("Average is not better: " << elapsed_time
-                                                                    << " >= " << best_time);
-                        }
+                        MIOPEN_LOG_I2("Median is not better: " << elapsed_time
+                                                               << " >= " << best_time);
                     }
                 }
             }
 
+            {
+                std::lock_guard<std::mutex> lock(strategy_mutex);
+                strategy->Report(index,
+                                 ret == 0 ? std::optional<float>{elapsed_time} : std::nullopt);
+            }
+
             // Banchmarked kernels will not be used anymore.
             // Now we can delete Program objects that belong to OCL/HIP
             // runtime and free the associated resources (memory, file handles...)
@@ -571,16 +665,24 @@ auto GenericSearch(const Solver s,
                               n_runs_total,
                               current_config);
             ++n_current;
+
+            if(plateau.Update(best_time))
+            {
+                MIOPEN_LOG_I("Search has plateaued after " << n_current << " candidates, best "
+                                                           << best_time);
+                stop_search = true;
+                break;
+            }
         }
     }
     else
     {
+        compile_agents.Wait();
         MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
                      "Running kernels on GPU is disabled. Search skipped");
     }
 
-    for(auto& agent : compile_agents)
-        agent.join();
+    compile_agents.Wait();
 
     MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
                           << n_best << ' ' << best_time << ' ' << best_config);
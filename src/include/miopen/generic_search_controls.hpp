@@ -29,6 +29,7 @@
 #include <miopen/config.h>
 #include <chrono>
 #include <limits>
+#include <thread>
 
 MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEBUG_TUNING_ITERATIONS_MAX,
                               std::numeric_limits<std::size_t>::max())
@@ -43,3 +44,8 @@ MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_COMPILE_PARALLEL_LEVEL,
                               std::thread::hardware_concurrency() / 2)
 #endif
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_COMPILE_ONLY)
+// Comma-separated list of SolverDbId=milliseconds overrides of MIOPEN_TUNING_TIME_MS_MAX.
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_TUNING_TIME_MS_MAX_PER_SOLVER)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_TUNING_SAMPLES_MAX, 5)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_TUNING_PLATEAU_WINDOW, 0)
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_TUNING_PLATEAU_THRESHOLD)
@@ -27,6 +27,7 @@
 #define GUARD_MIOPEN_HANDLE_HPP_
 
 #include <miopen/config.h>
+#include <miopen/binary_cache.hpp>
 #include <miopen/kernel_info.hpp>
 #include <miopen/common.hpp>
 #include <miopen/invoker_cache.hpp>
@@ -149,6 +150,13 @@ struct MIOPEN_EXPORT Handle : miopenHandle
     void ClearProgram(const fs::path& program_name, const std::string& params) const;
     void AddProgram(Program prog, const fs::path& program_name, const std::string& params) const;
 
+    /// Loads the cached binaries of the programs into the program cache ahead of their first
+    /// use, querying the kernel cache once and decompressing the binaries in parallel. The
+    /// programs missing from the kernel cache are built on the first use as usual.
+    void WarmUpPrograms(const std::vector<ProgramKey>& programs) const;
+    /// Same for the programs listed in a file, see ReadProgramList().
+    void WarmUpPrograms(const fs::path& program_list) const;
+
     void Finish() const;
     void Flush() const;
 
@@ -252,7 +260,7 @@ public:
                          const std::string& solver,
                          const std::optional<AlgorithmName>& algo = std::nullopt)
     {
-        invokers.Register({config, solver}, invoker);
+        invokers.Register(config, solver, invoker);
         if(algo.has_value())
             SetAsFound1_0(config, *algo, solver);
     }
@@ -273,7 +281,7 @@ public:
         {
             MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            return invokers.GetInvoker(config, solver->ToString());
         }
 
         if(!algo)
@@ -0,0 +1,207 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef MIOPEN_GUARD_MLOPEN_HASH128_HPP
+#define MIOPEN_GUARD_MLOPEN_HASH128_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace miopen {
+
+/// Fixed-size result of Hash128().
+struct Digest128
+{
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    bool operator==(const Digest128& other) const { return lo == other.lo && hi == other.hi; }
+    bool operator!=(const Digest128& other) const { return !(*this == other); }
+    bool operator<(const Digest128& other) const
+    {
+        return lo < other.lo || (lo == other.lo && hi < other.hi);
+    }
+
+    /// 32 lowercase hex digits, the same length as an md5 string.
+    std::string ToString() const
+    {
+        char buffer[33];
+        std::snprintf(buffer,
+                      sizeof(buffer),
+                      "%016llx%016llx",
+                      static_cast<unsigned long long>(hi),
+                      static_cast<unsigned long long>(lo));
+        return {buffer, 32};
+    }
+};
+
+static_assert(std::is_trivially_copyable<Digest128>{});
+
+/// Streaming 128-bit non-cryptographic hash (MurmurHash3 x64_128).
+///
+/// Consumes 16-byte blocks as two independent 64-bit lanes, which is an order of magnitude
+/// faster than md5() on the host. Meant for the internal keys: the kernel cache keys, the
+/// network config fingerprints and the in-memory db maps. The result does not depend on how
+/// the input is split between the Update() calls. The value is part of the file kernel cache
+/// layout, so the algorithm must not be changed without changing that layout too. Use md5()
+/// where an existing on-disk format requires it.
+class Hash128Stream
+{
+public:
+    explicit Hash128Stream(std::uint64_t seed = 0) : h1(seed), h2(seed) {}
+
+    Hash128Stream& Update(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        total += size;
+
+        if(tail_size != 0)
+        {
+            const auto n = std::min(size, BlockSize - tail_size);
+            std::memcpy(tail + tail_size, bytes, n);
+            tail_size += n;
+            bytes += n;
+            size -= n;
+            if(tail_size < BlockSize)
+                return *this;
+            Block(tail);
+            tail_size = 0;
+        }
+
+        for(; size >= BlockSize; bytes += BlockSize, size -= BlockSize)
+            Block(bytes);
+
+        std::memcpy(tail, bytes, size);
+        tail_size = size;
+        return *this;
+    }
+
+    Hash128Stream& Update(std::string_view data) { return Update(data.data(), data.size()); }
+
+    /// Does not modify the state, more data may be added after the call.
+    Digest128 Final() const
+    {
+        auto a = h1;
+        auto b = h2;
+
+        if(tail_size != 0)
+        {
+            unsigned char last[BlockSize] = {};
+            std::memcpy(last, tail, tail_size);
+            if(tail_size > 8)
+                b ^= MixK2(Load(last + 8));
+            a ^= MixK1(Load(last));
+        }
+
+        a ^= total;
+        b ^= total;
+        a += b;
+        b += a;
+        a = Finalize(a);
+        b = Finalize(b);
+        a += b;
+        b += a;
+        return {a, b};
+    }
+
+private:
+    static constexpr std::size_t BlockSize = 16;
+    static constexpr std::uint64_t C1      = 0x87c37b91114253d5ULL;
+    static constexpr std::uint64_t C2      = 0x4cf5ad432745937fULL;
+
+    std::uint64_t h1;
+    std::uint64_t h2;
+    std::uint64_t total   = 0;
+    std::size_t tail_size = 0;
+    unsigned char tail[BlockSize];
+
+    static std::uint64_t Rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    // The blocks are read as little-endian words, as all the supported hosts are.
+    static std::uint64_t Load(const unsigned char* p)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        return word;
+    }
+
+    static std::uint64_t MixK1(std::uint64_t k) { return Rotl(k * C1, 31) * C2; }
+    static std::uint64_t MixK2(std::uint64_t k) { return Rotl(k * C2, 33) * C1; }
+
+    void Block(const unsigned char* p)
+    {
+        h1 ^= MixK1(Load(p));
+        h1 = (Rotl(h1, 27) + h2) * 5 + 0x52dce729;
+        h2 ^= MixK2(Load(p + 8));
+        h2 = (Rotl(h2, 31) + h1) * 5 + 0x38495ab5;
+    }
+
+    static std::uint64_t Finalize(std::uint64_t x)
+    {
+        x = (x ^ (x >> 33)) * 0xff51afd7ed558ccdULL;
+        x = (x ^ (x >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+        return x ^ (x >> 33);
+    }
+};
+
+inline Digest128 Hash128(std::string_view data) { return Hash128Stream{}.Update(data).Final(); }
+
+inline Digest128 Hash128(const std::vector<char>& data)
+{
+    return Hash128Stream{}.Update(data.data(), data.size()).Final();
+}
+
+/// Hash functor for the string keyed containers. Unlike std::hash it does not depend on the
+/// standard library, some of which hash a byte at a time.
+struct StringKeyHash
+{
+    std::size_t operator()(std::string_view key) const
+    {
+        return static_cast<std::size_t>(Hash128(key).lo);
+    }
+};
+
+} // namespace miopen
+
+namespace std {
+template <>
+struct hash<miopen::Digest128>
+{
+    std::size_t operator()(const miopen::Digest128& digest) const
+    {
+        return static_cast<std::size_t>(digest.lo);
+    }
+};
+} // namespace std
+
+#endif
@@ -0,0 +1,318 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef MIOPEN_GUARD_MLOPEN_HOST_GEMM_HPP
+#define MIOPEN_GUARD_MLOPEN_HOST_GEMM_HPP
+
+// Host (CPU) GEMM used by the reference implementations of the driver and the tests.
+//
+// The operands are packed into panels of MR rows of A and NR columns of B converted to the
+// accumulator type, so that the micro-kernel streams both from contiguous memory and keeps an
+// MR x NR block of C in registers. The result is partitioned into MC x NC tiles which are
+// computed in parallel on the shared thread pool. Each tile accumulates the whole K dimension
+// before the result is handed to the caller, thus the store callback sees every element once.
+//
+// Header-only and independent of the library, like par_for.hpp.
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MIOPEN_HOST_GEMM_X86_DISPATCH 1
+#else
+#define MIOPEN_HOST_GEMM_X86_DISPATCH 0
+#endif
+
+namespace miopen {
+namespace host_gemm {
+
+/// Reduced precision types (half, bfloat16) are accumulated in float.
+template <class T>
+using accumulator_t = std::conditional_t<std::is_same<T, double>{}, double, float>;
+
+template <class Acc>
+struct Blocking;
+
+template <>
+struct Blocking<float>
+{
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = 16;
+    static constexpr std::size_t MC = 96;
+    static constexpr std::size_t NC = 128;
+    static constexpr std::size_t KC = 256;
+};
+
+template <>
+struct Blocking<double>
+{
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = 8;
+    static constexpr std::size_t MC = 96;
+    static constexpr std::size_t NC = 128;
+    static constexpr std::size_t KC = 256;
+};
+
+/// Problems smaller than this number of multiply-adds are computed in the calling thread.
+constexpr std::size_t ParallelThreshold = 64 * 64 * 64;
+/// Problems smaller than this are not worth packing and are computed by a plain loop.
+constexpr std::size_t PackingThreshold = 16 * 16 * 16;
+
+namespace detail {
+
+/// c[MR x NR] += pa[kc x MR]^T * pb[kc x NR], c has the row stride ldc.
+/// A row of the block is a single vector of NR elements: written with the vector extension,
+/// rather than as a plain loop, the accumulators are reliably kept in registers at any
+/// optimization level, and the compiler splits the vector according to the target ISA.
+template <class Acc>
+[[gnu::always_inline]] inline void
+MicroKernelImpl(std::size_t kc, const Acc* pa, const Acc* pb, Acc* c, std::size_t ldc)
+{
+    constexpr auto MR = Blocking<Acc>::MR;
+    constexpr auto NR = Blocking<Acc>::NR;
+    typedef Acc Row __attribute__((vector_size(NR * sizeof(Acc))));
+
+    Row ab[MR] = {};
+    for(std::size_t p = 0; p < kc; ++p, pa += MR, pb += NR)
+    {
+        Row b;
+        std::memcpy(&b, pb, sizeof(Row));
+        for(std::size_t i = 0; i < MR; ++i)
+            ab[i] += pa[i] * b;
+    }
+
+    for(std::size_t i = 0; i < MR; ++i)
+    {
+        Row row;
+        std::memcpy(&row, c + i * ldc, sizeof(Row));
+        row += ab[i];
+        std::memcpy(c + i * ldc, &row, sizeof(Row));
+    }
+}
+
+template <class Acc>
+using MicroKernel = void (*)(std::size_t, const Acc*, const Acc*, Acc*, std::size_t);
+
+template <class Acc>
+inline void
+MicroKernelDefault(std::size_t kc, const Acc* pa, const Acc* pb, Acc* c, std::size_t ldc)
+{
+    MicroKernelImpl(kc, pa, pb, c, ldc);
+}
+
+#if MIOPEN_HOST_GEMM_X86_DISPATCH
+template <class Acc>
+__attribute__((target("avx2,fma"))) inline void
+MicroKernelAvx2(std::size_t kc, const Acc* pa, const Acc* pb, Acc* c, std::size_t ldc)
+{
+    MicroKernelImpl(kc, pa, pb, c, ldc);
+}
+
+template <class Acc>
+__attribute__((target("avx512f"))) inline void
+MicroKernelAvx512(std::size_t kc, const Acc* pa, const Acc* pb, Acc* c, std::size_t ldc)
+{
+    MicroKernelImpl(kc, pa, pb, c, ldc);
+}
+#endif
+
+template <class Acc>
+MicroKernel<Acc> SelectMicroKernel()
+{
+#if MIOPEN_HOST_GEMM_X86_DISPATCH
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+        return &MicroKernelAvx512<Acc>;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return &MicroKernelAvx2<Acc>;
+#endif
+    return &MicroKernelDefault<Acc>;
+}
+
+template <class Acc>
+MicroKernel<Acc> GetMicroKernel()
+{
+    static const auto kernel = SelectMicroKernel<Acc>();
+    return kernel;
+}
+
+/// Packs rows [i0, i0 + mc) and columns [p0, p0 + kc) of A into slivers of MR rows stored
+/// column by column. The rows past the end of the matrix are padded with zeros.
+template <class Acc, class A>
+void PackA(A& a, std::size_t i0, std::size_t mc, std::size_t p0, std::size_t kc, Acc* dst)
+{
+    constexpr auto MR = Blocking<Acc>::MR;
+    for(std::size_t ir = 0; ir < mc; ir += MR)
+    {
+        const auto rows = std::min(MR, mc - ir);
+        for(std::size_t p = 0; p < kc; ++p, dst += MR)
+        {
+            for(std::size_t i = 0; i < rows; ++i)
+                dst[i] = static_cast<Acc>(a(i0 + ir + i, p0 + p));
+            std::fill(dst + rows, dst + MR, Acc{0});
+        }
+    }
+}
+
+/// Packs rows [p0, p0 + kc) and columns [j0, j0 + nc) of B into slivers of NR columns stored
+/// row by row. The columns past the end of the matrix are padded with zeros.
+template <class Acc, class B>
+void PackB(B& b, std::size_t p0, std::size_t kc, std::size_t j0, std::size_t nc, Acc* dst)
+{
+    constexpr auto NR = Blocking<Acc>::NR;
+    for(std::size_t jr = 0; jr < nc; jr += NR)
+    {
+        const auto cols = std::min(NR, nc - jr);
+        for(std::size_t p = 0; p < kc; ++p, dst += NR)
+        {
+            for(std::size_t j = 0; j < cols; ++j)
+                dst[j] = static_cast<Acc>(b(p0 + p, j0 + jr + j));
+            std::fill(dst + cols, dst + NR, Acc{0});
+        }
+    }
+}
+
+inline std::size_t RoundUp(std::size_t value, std::size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace detail
+
+/// Computes the m x n product of a(i, p) and b(p, j) with the inner dimension k, accumulating
+/// in Acc, and calls c(i, j, x) exactly once for every element of the result. The accessors
+/// are called concurrently from several threads.
+template <class Acc, class A, class B, class C>
+void Gemm(std::size_t m, std::size_t n, std::size_t k, A a, B b, C c)
+{
+    using Sizes = Blocking<Acc>;
+    if(m == 0 || n == 0)
+        return;
+
+    if(m * n * k < PackingThreshold)
+    {
+        for(std::size_t i = 0; i < m; ++i)
+        {
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                auto x = Acc{0};
+                for(std::size_t p = 0; p < k; ++p)
+                    x += static_cast<Acc>(a(i, p)) * static_cast<Acc>(b(p, j));
+                c(i, j, x);
+            }
+        }
+        return;
+    }
+
+    const auto kernel  = detail::GetMicroKernel<Acc>();
+    const auto m_tiles = (m + Sizes::MC - 1) / Sizes::MC;
+    const auto n_tiles = (n + Sizes::NC - 1) / Sizes::NC;
+
+    const auto run_tile = [&](std::size_t tile) {
+        const auto i0  = (tile / n_tiles) * Sizes::MC;
+        const auto j0  = (tile % n_tiles) * Sizes::NC;
+        const auto mc  = std::min(Sizes::MC, m - i0);
+        const auto nc  = std::min(Sizes::NC, n - j0);
+        const auto ldt = detail::RoundUp(nc, Sizes::NR);
+
+        auto result   = std::vector<Acc>(detail::RoundUp(mc, Sizes::MR) * ldt, Acc{0});
+        auto packed_a = std::vector<Acc>(detail::RoundUp(mc, Sizes::MR) * Sizes::KC);
+        auto packed_b = std::vector<Acc>(Sizes::KC * ldt);
+
+        for(std::size_t p0 = 0; p0 < k; p0 += Sizes::KC)
+        {
+            const auto kc = std::min(Sizes::KC, k - p0);
+            detail::PackA(a, i0, mc, p0, kc, packed_a.data());
+            detail::PackB(b, p0, kc, j0, nc, packed_b.data());
+
+            for(std::size_t jr = 0; jr < nc; jr += Sizes::NR)
+                for(std::size_t ir = 0; ir < mc; ir += Sizes::MR)
+                    kernel(kc,
+                           &packed_a[ir * kc],
+                           &packed_b[jr * kc],
+                           &result[ir * ldt + jr],
+                           ldt);
+        }
+
+        for(std::size_t i = 0; i < mc; ++i)
+            for(std::size_t j = 0; j < nc; ++j)
+                c(i0 + i, j0 + j, result[i * ldt + j]);
+    };
+
+    const auto tiles = m_tiles * n_tiles;
+    if(tiles > 1 && m * n * k >= ParallelThreshold)
+        par_for(tiles, min_grain{1}, run_tile);
+    else
+        for(std::size_t tile = 0; tile < tiles; ++tile)
+            run_tile(tile);
+}
+
+/// Row-major C = alpha * op(A) * op(B) + beta * C, where op(A) is m x k and op(B) is k x n.
+template <class T>
+void Gemm(bool trans_a,
+          bool trans_b,
+          std::size_t m,
+          std::size_t n,
+          std::size_t k,
+          double alpha,
+          const T* a,
+          std::size_t lda,
+          const T* b,
+          std::size_t ldb,
+          double beta,
+          T* c,
+          std::size_t ldc)
+{
+    using Acc = accumulator_t<T>;
+
+    const auto store = [=](std::size_t i, std::size_t j, Acc x) {
+        auto& dst = c[i * ldc + j];
+        dst       = static_cast<T>(static_cast<Acc>(beta) * static_cast<Acc>(dst) +
+                                   static_cast<Acc>(alpha) * x);
+    };
+    const auto a_n = [=](std::size_t i, std::size_t p) { return a[i * lda + p]; };
+    const auto a_t = [=](std::size_t i, std::size_t p) { return a[p * lda + i]; };
+    const auto b_n = [=](std::size_t p, std::size_t j) { return b[p * ldb + j]; };
+    const auto b_t = [=](std::size_t p, std::size_t j) { return b[j * ldb + p]; };
+
+    if(!trans_a && !trans_b)
+        Gemm<Acc>(m, n, k, a_n, b_n, store);
+    else if(trans_a && !trans_b)
+        Gemm<Acc>(m, n, k, a_t, b_n, store);
+    else if(!trans_a && trans_b)
+        Gemm<Acc>(m, n, k, a_n, b_t, store);
+    else
+        Gemm<Acc>(m, n, k, a_t, b_t, store);
+}
+
+} // namespace host_gemm
+} // namespace miopen
+
+#endif
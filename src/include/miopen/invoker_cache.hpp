@@ -26,48 +26,52 @@
 
 #pragma once
 
+#include <miopen/config.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/names.hpp>
 
-#include <map>
 #include <memory>
 #include <string>
-#include <utility>
 #include <optional>
 
 namespace miopen {
 
-class InvokerCache
+/// Invokers registered for problems (network configs) and solvers, and the find 1.0 results.
+///
+/// The entries are kept in sharded insert-only hash tables keyed by the precomputed fingerprint
+/// of the network config combined with the hash of the solver id or the algorithm name.
+/// Lookups are lock-free and may run concurrently with each other and with the registration,
+/// which takes the lock of a single shard. Invokers are never removed.
+class MIOPEN_INTERNALS_EXPORT InvokerCache
 {
 public:
-    // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    InvokerCache();
+    InvokerCache(InvokerCache&&) noexcept;
+    InvokerCache& operator=(InvokerCache&&) noexcept;
+    ~InvokerCache();
 
-    std::optional<Invoker> operator[](const Key& key) const;
+    std::optional<Invoker> GetInvoker(const NetworkConfig& network_config,
+                                      const std::string& solver_id) const;
     // For find 1.0
-    std::optional<Invoker> GetFound1_0(const std::string& network_config,
-                                       const std::string& algorithm) const;
-    std::optional<std::string> GetFound1_0SolverId(const std::string& network_config,
-                                                   const std::string& algorithm) const;
+    std::optional<Invoker> GetFound1_0(const NetworkConfig& network_config,
+                                       const AlgorithmName& algorithm) const;
+    std::optional<std::string> GetFound1_0SolverId(const NetworkConfig& network_config,
+                                                   const AlgorithmName& algorithm) const;
 
-    void Register(const Key& key, const Invoker& invoker);
+    /// The first invoker registered for the network config and the solver is kept.
+    void Register(const NetworkConfig& network_config,
+                  const std::string& solver_id,
+                  const Invoker& invoker);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
-                       const std::string& algorithm,
+    void SetAsFound1_0(const NetworkConfig& network_config,
+                       const AlgorithmName& algorithm,
                        const std::string& solver_id);
 
 private:
-    struct Item
-    {
-        // algorithm -> solver_id
-        // for find 1.0
-        std::map<std::string, std::string> found_1_0;
-        // solver_id -> invoker
-        std::map<std::string, Invoker> invokers;
-    };
+    struct Shard;
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    std::unique_ptr<Shard[]> shards;
 };
 
 } // namespace miopen
@@ -32,6 +32,7 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
+#include <miopen/kern_db_codec.hpp>
 #include <miopen/md5.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
@@ -39,9 +40,11 @@
 #include <boost/optional/optional.hpp>
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <chrono>
 #include <thread>
+#include <tuple>
 
 namespace miopen {
 struct KernelConfig
@@ -64,6 +67,7 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`codec` INT NOT NULL DEFAULT 0"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
@@ -81,8 +85,21 @@ struct KernelConfig
 
 class KernDb : public SQLiteBase<KernDb>
 {
+    // The bz2 codec, replaceable for testing.
     std::function<std::vector<char>(const std::vector<char>&, bool*)> compress_fn;
     std::function<std::vector<char>(const std::vector<char>&, unsigned int)> decompress_fn;
+    KernDbCodec codec = KernDbCodec::Bz2;
+    // The databases created before the codec was recorded have bz2 records only.
+    bool has_codec_column = false;
+    std::shared_ptr<const kern_db_codec::Dictionary> dictionary;
+
+    void SetCodecUnsafe(KernDbCodec codec_);
+    std::shared_ptr<const kern_db_codec::Dictionary> GetDictionary(unsigned id);
+    MIOPEN_INTERNALS_EXPORT boost::optional<std::vector<char>>
+    Decode(std::vector<char> blob, KernDbCodec blob_codec, int64_t uncompressed_size);
+    /// Returns the blob to store, its uncompressed size or 0 if stored as is, and its codec.
+    MIOPEN_INTERNALS_EXPORT std::tuple<std::vector<char>, int64_t, KernDbCodec>
+    Encode(const std::vector<char>& blob) const;
 
 public:
     MIOPEN_INTERNALS_EXPORT KernDb(DbKinds db_kind, const fs::path& filename_, bool is_system);
@@ -93,6 +110,16 @@ public:
            bool is_system_,
            std::function<std::vector<char>(const std::vector<char>&, bool*)> compress_fn_,
            std::function<std::vector<char>(const std::vector<char>&, unsigned int)> decompress_fn_);
+
+    KernDbCodec GetCodec() const { return codec; }
+    /// Sets the codec of the records stored after the call.
+    MIOPEN_INTERNALS_EXPORT void SetCodec(KernDbCodec codec_);
+
+    /// Rewrites all the records with the codec. For zstd, a dictionary of up to dictionary_size
+    /// bytes is trained over the records first, 0 disables it. This is meant to prepare the
+    /// system databases, which are read-only at run time, so shall be opened as a user one.
+    MIOPEN_INTERNALS_EXPORT void Recompress(KernDbCodec codec_, std::size_t dictionary_size);
+
     template <typename T>
     bool RemoveRecordUnsafe(const T& problem_config)
     {
@@ -119,7 +146,8 @@ public:
         if(filename.empty())
             return boost::none;
         // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
+        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size" +
+                            std::string{has_codec_column ? ", codec" : ""} + " FROM " +
                             T::table_name() + " WHERE " + problem_config.Where() + ";";
         auto stmt = SQLite::Statement{sql, select_query};
         // only one result field
@@ -127,15 +155,17 @@ public:
         auto rc = stmt.Step(sql);
         if(rc == SQLITE_ROW)
         {
-            auto compressed_blob                 = stmt.ColumnBlob(0);
-            auto md5_hash                        = stmt.ColumnText(1);
-            auto uncompressed_size               = stmt.ColumnInt64(2);
-            std::vector<char>& decompressed_blob = compressed_blob;
-            if(uncompressed_size != 0)
-            {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
-            }
-            auto new_md5 = md5(decompressed_blob);
+            auto compressed_blob   = stmt.ColumnBlob(0);
+            auto md5_hash          = stmt.ColumnText(1);
+            auto uncompressed_size = stmt.ColumnInt64(2);
+            auto blob_codec        = KernDbCodec::Bz2;
+            if(has_codec_column)
+                blob_codec = static_cast<KernDbCodec>(stmt.ColumnInt64(3));
+            auto decompressed_blob =
+                Decode(std::move(compressed_blob), blob_codec, uncompressed_size);
+            if(!decompressed_blob)
+                return boost::none;
+            auto new_md5 = md5(*decompressed_blob);
             if(new_md5 != md5_hash)
                 MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
             return decompressed_blob;
@@ -151,6 +181,11 @@ public:
         return boost::none;
     }
 
+    /// Searches for the records of all the CONFIGS with a few batched queries and decompresses
+    /// the found ones in parallel. Returns the blobs in the order of the configs.
+    MIOPEN_INTERNALS_EXPORT std::vector<boost::optional<std::vector<char>>>
+    FindRecordsUnsafe(const std::vector<KernelConfig>& configs);
+
     template <typename T>
     bool StoreRecordUnsafe(const T& problem_config)
     {
@@ -158,24 +193,18 @@ public:
             return false;
         auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
                             "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
-        auto md5_sum           = md5(problem_config.kernel_blob);
-        auto uncompressed_size = problem_config.kernel_blob.size();
-        bool success           = false;
-        auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
-        auto stmt              = SQLite::Statement{sql, insert_query};
+                            "uncompressed_size" +
+                            std::string{has_codec_column ? ", codec) VALUES(?, ?, ?, ?, ?, ?);"
+                                                         : ") VALUES(?, ?, ?, ?, ?);"};
+        auto md5_sum                               = md5(problem_config.kernel_blob);
+        auto [blob, uncompressed_size, blob_codec] = Encode(problem_config.kernel_blob);
+        auto stmt                                  = SQLite::Statement{sql, insert_query};
         stmt.BindPath(1, problem_config.kernel_name);
         stmt.BindText(2, problem_config.kernel_args);
-        if(!success)
-        {
-            stmt.BindBlob(3, problem_config.kernel_blob);
-            stmt.BindInt64(5, 0);
-        }
-        else
-        {
-            stmt.BindBlob(3, compressed_blob);
-            stmt.BindInt64(5, uncompressed_size);
-        }
+        stmt.BindBlob(3, blob);
+        stmt.BindInt64(5, uncompressed_size);
+        if(has_codec_column)
+            stmt.BindInt64(6, static_cast<int64_t>(blob_codec));
         stmt.BindText(4, md5_sum);
 
         auto rc = stmt.Step(sql);
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERN_DB_CODEC_HPP_
+#define GUARD_MIOPEN_KERN_DB_CODEC_HPP_
+
+#include <miopen/config.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace miopen {
+
+/// Compression of the code objects in the kernel cache. The value is stored with each record,
+/// thus the existing values shall not be changed.
+enum class KernDbCodec : int
+{
+    /// The only codec of the databases created before the codec was recorded.
+    Bz2 = 0,
+    /// The best ratio, optionally with a dictionary. Meant for the system databases.
+    Zstd = 1,
+    /// The fastest decompression. Meant for the user databases.
+    Lz4 = 2,
+};
+
+namespace kern_db_codec {
+
+MIOPEN_INTERNALS_EXPORT bool IsSupported(KernDbCodec codec);
+MIOPEN_INTERNALS_EXPORT std::string_view ToString(KernDbCodec codec);
+MIOPEN_INTERNALS_EXPORT std::optional<KernDbCodec> Parse(std::string_view name);
+
+/// The codec of the new records: the one set by MIOPEN_KERN_DB_CODEC, otherwise LZ4 for the user
+/// databases and zstd for the system ones. Falls back to bz2 if the codec is not supported.
+MIOPEN_INTERNALS_EXPORT KernDbCodec GetDefault(bool is_system);
+
+/// zstd dictionary, digested once for both directions.
+class MIOPEN_INTERNALS_EXPORT Dictionary
+{
+public:
+    explicit Dictionary(std::vector<char> content_);
+    Dictionary(const Dictionary&) = delete;
+    Dictionary& operator=(const Dictionary&) = delete;
+    ~Dictionary();
+
+    /// The id written to the frames compressed with the dictionary, never 0.
+    unsigned Id() const;
+    const std::vector<char>& Content() const;
+
+    struct Impl;
+    const Impl& GetImpl() const { return *impl; }
+
+private:
+    std::unique_ptr<Impl> impl;
+};
+
+/// Same contract as miopen::compress: if the size can not be reduced, sets *compressed to false
+/// and returns the input, or throws if compressed is nullptr.
+MIOPEN_INTERNALS_EXPORT std::vector<char> Compress(KernDbCodec codec,
+                                                   const std::vector<char>& v,
+                                                   bool* compressed             = nullptr,
+                                                   const Dictionary* dictionary = nullptr);
+
+/// The dictionary is required for the zstd frames which have a dictionary id.
+MIOPEN_INTERNALS_EXPORT std::vector<char> Decompress(KernDbCodec codec,
+                                                     const std::vector<char>& v,
+                                                     std::size_t size,
+                                                     const Dictionary* dictionary = nullptr);
+
+/// Returns the id of the dictionary a zstd frame was compressed with, or 0.
+MIOPEN_INTERNALS_EXPORT unsigned GetDictionaryId(const std::vector<char>& v);
+
+/// Trains a zstd dictionary of up to max_size bytes over the samples.
+/// Returns an empty vector if there is not enough data to train on.
+MIOPEN_INTERNALS_EXPORT std::vector<char>
+TrainDictionary(const std::vector<std::vector<char>>& samples, std::size_t max_size);
+
+} // namespace kern_db_codec
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERN_DB_CODEC_HPP_
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERN_FILE_CACHE_HPP_
+#define GUARD_MIOPEN_KERN_FILE_CACHE_HPP_
+
+#include <miopen/config.hpp>
+#include <miopen/filesystem.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Kernel cache of the builds without the SQLite kernel cache, one file per kernel binary.
+//
+// Layout under the root directory:
+//
+//   objects/<xx>/<hash of the binary>.o    one file per distinct binary
+//   keys/<xx>/<hash of the key>.o          a hard link to the object of the key
+//   index                                  the access log
+//
+// The hashes are Hash128() digests, <xx> are their first two hex digits, so each directory holds
+// 1/256 of the files. A file is published by renaming a complete temporary file over it, so the
+// readers never see a partial binary. The keys with identical binaries share one object, a key
+// is a copy of its object on the file systems without hard links.
+//
+// Index format:
+//
+//   #miopen-kern-cache <bytes>                header written by the gc, the size of the cache
+//   <key hash> <unix time ms> <bytes added>   a lookup or a store of the key
+//
+// The lines are appended under the shared lock. The gc runs under the exclusive lock when the
+// cache outgrows its size limit or the index outgrows IndexCompactionThreshold: it evicts the
+// least recently used keys down to 90% of the limit, removes the objects no key links to and
+// rewrites the index with one line per key. The temporary files of the crashed writers are
+// removed by the gc as well.
+
+namespace miopen {
+
+class LockFile;
+
+struct KernFileCacheStats
+{
+    std::size_t keys    = 0;
+    std::size_t objects = 0;
+    /// The size of the distinct binaries.
+    std::uint64_t bytes       = 0;
+    std::uint64_t index_bytes = 0;
+};
+
+struct KernFileCacheGcResult
+{
+    std::size_t evicted_keys    = 0;
+    std::size_t removed_objects = 0;
+    std::uint64_t freed_bytes   = 0;
+};
+
+class MIOPEN_INTERNALS_EXPORT KernFileCache
+{
+public:
+    static constexpr std::string_view DirName               = "kcache";
+    static constexpr std::uint64_t IndexCompactionThreshold = 1024 * 1024;
+
+    /// One instance per ROOT in a process: the file lock does not exclude the threads of it.
+    /// MAX_SIZE of 0 does not limit the size.
+    KernFileCache(const fs::path& root_, std::uint64_t max_size_);
+
+    KernFileCache(const KernFileCache&) = delete;
+    KernFileCache& operator=(const KernFileCache&) = delete;
+
+    const fs::path& GetRoot() const { return root; }
+
+    /// Returns the path of the binary of the KEY or an empty path.
+    fs::path Find(const std::string& key);
+
+    /// Moves the BINARY file into the cache under the KEY, replacing the previous binary of the
+    /// key. Returns the new path of the binary.
+    fs::path Store(const fs::path& binary, const std::string& key);
+
+    KernFileCacheStats GetStats();
+
+    /// Removes the unused objects and compacts the index. If the cache is over MAX_SIZE, or over
+    /// its own limit if 0, evicts down to 90% of it. Blocks the other users of the cache,
+    /// including other processes, while running.
+    KernFileCacheGcResult Gc(std::uint64_t max_size_ = 0);
+
+private:
+    fs::path root;
+    std::uint64_t max_size;
+    LockFile& lock_file;
+    std::mutex mutex;
+
+    fs::path GetKeyPath(const std::string& key_hash) const;
+    fs::path GetObjectPath(const std::string& object_hash) const;
+    fs::path GetIndexPath() const;
+
+    void AppendUnsafe(const std::string& key_hash, std::uint64_t added_bytes);
+    bool IsGcNeededUnsafe(bool check_size) const;
+    KernFileCacheGcResult GcUnsafe(std::uint64_t limit);
+    void GcIfNeededUnsafe(bool check_size);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERN_FILE_CACHE_HPP_
@@ -36,6 +36,10 @@ namespace miopen {
 std::string_view GetKernelSrc(const fs::path& name);
 std::string_view GetKernelInc(const fs::path& name);
 const std::vector<std::reference_wrapper<const fs::path>>& GetKernelIncList();
+/// Returns the headers included by the named kernel source or header directly or indirectly.
+/// If src is not the embedded text of that file, returns all the headers.
+const std::vector<std::reference_wrapper<const fs::path>>& GetKernelIncList(const fs::path& name,
+                                                                            std::string_view src);
 } // namespace miopen
 
 #if MIOPEN_BACKEND_OPENCL
@@ -54,6 +54,17 @@ std::vector<Program> PrecompileKernels(const Handle& h,
                                        const std::vector<KernelInfo>& kernels,
                                        bool force_attach_binary = false);
 
+/// Programs compiled in advance which are not added to the handle yet.
+struct PrecompiledKernels
+{
+    std::vector<KernelInfo> kernels;
+    std::vector<Program> programs;
+};
+
+/// Adds the programs the handle does not have yet. Unlike the compilation itself this uses the
+/// program cache of the handle, so it shall be called from the thread working with the handle.
+void AddPrecompiledKernels(const Handle& h, const PrecompiledKernels& precompiled);
+
 } // namespace solver
 } // namespace miopen
 
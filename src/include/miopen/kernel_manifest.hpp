@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_MANIFEST_HPP_
+#define GUARD_MIOPEN_KERNEL_MANIFEST_HPP_
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/config.hpp>
+#include <miopen/filesystem.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace miopen {
+
+struct Handle;
+
+namespace kernel_manifest {
+
+/// What a workload compiled and used, to be replayed ahead of the workload: the programs are
+/// compiled into the user kernel cache and the find-db records are stored into the user find-db.
+///
+/// The file is line based, the fields are separated by tabs:
+///
+///   <program> <options>                       a program, the same as ReadProgramList() reads
+///   @invoker  <network config> <solver id>    an invoker the workload registered
+///   @find     <db suffix> <key> <contents>    a find-db record the workload used
+///
+/// Empty lines and lines starting with '#' are skipped.
+struct Manifest
+{
+    std::set<ProgramKey> programs;
+    std::set<std::pair<std::string, std::string>> invokers;
+    /// By the find-db path suffix and the key, the contents in the "id:values;..." form.
+    std::map<std::pair<std::string, std::string>, std::string> find_records;
+
+    void Merge(const Manifest& other);
+};
+
+/// The manifest is recorded if MIOPEN_KERNEL_MANIFEST holds the path to write it to. It is
+/// written at the normal exit of the process, merged with the manifest already in the file.
+MIOPEN_INTERNALS_EXPORT bool IsRecording();
+
+MIOPEN_INTERNALS_EXPORT void RecordProgram(const fs::path& program, const std::string& options);
+void RecordInvoker(const std::string& network_config, const std::string& solver_id);
+void RecordFindRecord(const std::string& db_suffix,
+                      const std::string& key,
+                      const std::string& contents);
+
+/// The manifest recorded so far by the process.
+MIOPEN_INTERNALS_EXPORT Manifest GetRecorded();
+
+MIOPEN_INTERNALS_EXPORT Manifest Read(std::istream& stream, const std::string& name = "");
+MIOPEN_INTERNALS_EXPORT Manifest Read(const fs::path& path);
+MIOPEN_INTERNALS_EXPORT void Write(std::ostream& stream, const Manifest& manifest);
+/// Writes to a temporary file first, so that the readers never see a partial manifest.
+MIOPEN_INTERNALS_EXPORT void Write(const fs::path& path, const Manifest& manifest);
+
+struct ReplayResult
+{
+    std::size_t programs     = 0;
+    std::size_t find_records = 0;
+    std::size_t failures     = 0;
+};
+
+/// Compiles the programs of the manifest into the user kernel cache of the device of the handle,
+/// with up to JOBS compilations at a time, and stores the find-db records into the user find-db.
+/// The invokers live in memory only, so are not replayed. A failure is logged and counted only.
+MIOPEN_INTERNALS_EXPORT ReplayResult Replay(Handle& handle,
+                                            const Manifest& manifest,
+                                            std::size_t jobs);
+
+} // namespace kernel_manifest
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERNEL_MANIFEST_HPP_
@@ -79,6 +79,7 @@ public:
         LockOperation("lock", MIOPEN_GET_FN_NAME, [&]() { std::lock(access_mutex, flock); });
     }
 
+    /// Like lock(), throws if the file can't be locked. The in-process lock is released first.
     void lock_shared()
     {
         access_mutex.lock_shared();
@@ -88,14 +89,16 @@ public:
         }
         catch(...)
         {
-            access_mutex.unlock();
+            access_mutex.unlock_shared();
+            throw;
         }
     }
 
     bool try_lock()
     {
+        // std::try_lock returns the index of the lock it failed to take, or -1 on success.
         return TryLockOperation(
-            "lock", MIOPEN_GET_FN_NAME, [&]() { return std::try_lock(access_mutex, flock) != 0; });
+            "lock", MIOPEN_GET_FN_NAME, [&]() { return std::try_lock(access_mutex, flock) == -1; });
     }
 
     bool try_lock_shared()
@@ -106,7 +109,7 @@ public:
         if(TryLockOperation(
                "shared lock", MIOPEN_GET_FN_NAME, [&]() { return flock.try_lock_sharable(); }))
             return true;
-        access_mutex.unlock();
+        access_mutex.unlock_shared();
         return false;
     }
 
@@ -148,7 +151,7 @@ public:
                return flock.timed_lock_sharable(ToPTime(duration));
            }))
             return true;
-        access_mutex.unlock();
+        access_mutex.unlock_shared();
         return false;
     }
 
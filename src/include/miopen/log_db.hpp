@@ -0,0 +1,245 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_GUARD_MLOPEN_LOG_DB_HPP
+#define MIOPEN_GUARD_MLOPEN_LOG_DB_HPP
+
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/hash128.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Append-only user database.
+//
+// The data lives in two files: a snapshot in the format of PlainTextDb (so existing user dbs are
+// picked up as is) and a log next to it. Every write appends a single self-checking line to the
+// log instead of rewriting the whole file under the exclusive lock, so concurrent writers from
+// different processes only hold the shared lock. Readers keep the decoded database in memory and
+// apply the lines appended since their previous access.
+//
+// Log format:
+//
+//   #miopen-log-db <generation>              optional header, generation 0 if missing
+//   <op><checksum> <key>=<ids and values>    op is S (store) or U (update)
+//   <op><checksum> <key>                     op is R (remove record)
+//   <op><checksum> <key>=<id>                op is D (remove id)
+//
+// The checksum is 16 hex digits of Fnv1a64 of the rest of the line after the space. Lines which
+// fail the check (e.g. torn by a crashed writer) are skipped. When the log grows over
+// MIOPEN_DEBUG_USER_DB_COMPACTION_THRESHOLD bytes, it is merged into a new sorted snapshot in the
+// background and replaced by an empty log of the next generation, which makes the readers reload
+// the snapshot. Replaying a log over a snapshot it has already been merged into gives the same
+// result, so a crash in the middle of the compaction loses nothing.
+
+namespace miopen {
+
+class MIOPEN_INTERNALS_EXPORT LogDb : protected PlainTextDb
+{
+public:
+    LogDb(DbKinds db_kind_,
+          const fs::path& path,
+          bool is_system,
+          const std::string& /*arch*/,
+          std::size_t /*num_cu*/)
+        : LogDb(db_kind_, path, is_system)
+    {
+    }
+
+    LogDb(DbKinds db_kind_, const fs::path& path, bool is_system = false);
+
+    LogDb(const LogDb&) = delete;
+    LogDb(LogDb&&)      = delete;
+    LogDb& operator=(const LogDb&) = delete;
+    LogDb& operator=(LogDb&&) = delete;
+
+    static fs::path GetLogFilePath(const fs::path& path);
+    static LogDb& GetCached(DbKinds db_kind_, const fs::path& path, bool is_system);
+
+    static LogDb& GetCached(DbKinds db_kind_,
+                            const fs::path& path,
+                            bool is_system,
+                            const std::string& /*arch*/,
+                            std::size_t /*num_cu*/)
+    {
+        return GetCached(db_kind_, path, is_system);
+    }
+
+    boost::optional<DbRecord> FindRecord(const std::string& problem);
+
+    template <class TProblem>
+    boost::optional<DbRecord> FindRecord(const TProblem& problem)
+    {
+        const auto key = DbRecord::SerializeKey(db_kind, problem);
+        return FindRecord(key);
+    }
+
+    template <class TProblem, class TValue>
+    bool Load(const TProblem& problem, const std::string& id, TValue& value)
+    {
+        const auto record = FindRecord(problem);
+        if(!record)
+            return false;
+        return record->GetValues(id, value);
+    }
+
+    bool StoreRecord(const DbRecord& record);
+    bool UpdateRecord(DbRecord& record);
+    bool RemoveRecord(const std::string& key);
+    bool Remove(const std::string& key, const std::string& id);
+
+    template <class T>
+    inline bool Remove(const T& problem_config, const std::string& id)
+    {
+        const auto key = DbRecord::SerializeKey(db_kind, problem_config);
+        return Remove(key, id);
+    }
+
+    template <class T>
+    inline bool RemoveRecord(const T& problem_config)
+    {
+        const auto key = DbRecord::SerializeKey(db_kind, problem_config);
+        return RemoveRecord(key);
+    }
+
+    template <class T, class V>
+    inline boost::optional<DbRecord>
+    Update(const T& problem_config, const std::string& id, const V& values)
+    {
+        DbRecord record(db_kind, problem_config);
+        record.SetValues(id, values);
+        const auto ok = UpdateRecord(record);
+        if(ok)
+            return record;
+        else
+            return boost::none;
+    }
+
+    /// Merges the log into the snapshot. Blocks the other readers and writers of the database,
+    /// including other processes, while running.
+    bool Compact();
+
+    /// Size of the log in bytes as of the last access of this instance.
+    std::uint64_t GetLogSize() const;
+
+private:
+    std::mutex& mutex;
+    std::unordered_map<std::string, DbRecord, StringKeyHash> records;
+    std::uint64_t generation = 0;
+    std::uint64_t log_offset = 0;
+    bool loaded              = false;
+    std::atomic<bool> compaction_pending{false};
+    // The compaction task references this object, thus it is destroyed (and waited) first.
+    TaskGroup compaction_task;
+
+    void RefreshUnsafe();
+    void LoadSnapshotUnsafe();
+    void ApplyLogUnsafe(const std::string& data, std::size_t& consumed);
+    bool ApplyEntryUnsafe(char op, const std::string& payload);
+    bool Append(char op, const std::string& payload);
+    bool AppendUnsafe(char op, const std::string& payload);
+    bool CompactUnsafe();
+    void ScheduleCompaction();
+};
+
+/// \todo This is modified copy of code from db.hpp. Make a proper fix.
+template <>
+// cppcheck-suppress noConstructor
+class DbTimer<LogDb>
+{
+    LogDb& inner;
+
+    template <class TFunc>
+    static auto Measure(const std::string& funcName, TFunc&& func)
+    {
+        if(!miopen::IsLogging(LoggingLevel::Info2))
+            return func();
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        auto ret         = func();
+        const auto end   = std::chrono::high_resolution_clock::now();
+        MIOPEN_LOG_I2("Db::" << funcName << " time: " << (end - start).count() * .000001f << " ms");
+        return ret;
+    }
+
+public:
+    template <class... TArgs>
+    DbTimer(TArgs&&... args) : inner(LogDb::GetCached(args...))
+    {
+    }
+
+    template <class TProblem>
+    auto FindRecord(const TProblem& problem)
+    {
+        return Measure("FindRecord", [&]() { return inner.FindRecord(problem); });
+    }
+
+    bool StoreRecord(const DbRecord& record)
+    {
+        return Measure("StoreRecord", [&]() { return inner.StoreRecord(record); });
+    }
+
+    bool UpdateRecord(DbRecord& record)
+    {
+        return Measure("UpdateRecord", [&]() { return inner.UpdateRecord(record); });
+    }
+
+    template <class TProblem>
+    bool RemoveRecord(const TProblem& problem)
+    {
+        return Measure("RemoveRecord", [&]() { return inner.RemoveRecord(problem); });
+    }
+
+    template <class TProblem, class TValue>
+    auto Update(const TProblem& problem, const std::string& id, const TValue& value)
+    {
+        return Measure("Update", [&]() { return inner.Update(problem, id, value); });
+    }
+
+    template <class TProblem, class TValue>
+    bool Load(const TProblem& problem, const std::string& id, TValue& value)
+    {
+        return Measure("Load", [&]() { return inner.Load(problem, id, value); });
+    }
+
+    template <class TProblem>
+    bool Remove(const TProblem& problem, const std::string& id)
+    {
+        return Measure("Remove", [&]() { return inner.Remove(problem, id); });
+    }
+};
+
+} // namespace miopen
+
+#endif
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_GUARD_MLOPEN_MEASUREMENT_POLICY_HPP
+#define MIOPEN_GUARD_MLOPEN_MEASUREMENT_POLICY_HPP
+
+#include <miopen/config.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Timing samples of a single tuning candidate.
+class MIOPEN_INTERNALS_EXPORT TimingSamples
+{
+public:
+    void Add(float time) { values.push_back(time); }
+    std::size_t Size() const { return values.size(); }
+
+    /// The score of the candidate. Unlike the mean, it is not skewed by a single outlier.
+    float Median() const;
+
+    /// Two-sided 95% confidence interval of the mean (Student's t).
+    /// Degenerates to the only sample if there is just one.
+    std::pair<float, float> ConfidenceInterval() const;
+
+private:
+    std::vector<float> values;
+};
+
+/// Controls how many times GenericSearch measures each candidate and when it ends the search
+/// before the iteration and time budgets are exhausted.
+struct MIOPEN_INTERNALS_EXPORT MeasurementPolicy
+{
+    /// Max number of samples of a promising candidate.
+    std::size_t samples_max = 5;
+    /// A candidate is promising if its first sample is within this margin of the best score.
+    /// Other candidates are measured only once.
+    float promising_margin = 0.05f;
+    /// The search ends if the best score has improved by less than plateau_threshold
+    /// (relative) over the last plateau_window candidates. 0 disables the detection, which is
+    /// the default since it may change the tuning results.
+    std::size_t plateau_window = 0;
+    float plateau_threshold    = 0.005f;
+
+    /// The defaults with the MIOPEN_TUNING_SAMPLES_MAX, MIOPEN_TUNING_PLATEAU_WINDOW and
+    /// MIOPEN_TUNING_PLATEAU_THRESHOLD overrides applied.
+    static MeasurementPolicy FromEnv();
+
+    /// Returns true if one more sample of the candidate is worth taking. Sampling stops early
+    /// once the confidence interval shows that the candidate is worse than the best one.
+    bool NeedMoreSamples(const TimingSamples& samples, float best_score) const;
+};
+
+class MIOPEN_INTERNALS_EXPORT PlateauDetector
+{
+public:
+    explicit PlateauDetector(const MeasurementPolicy& policy);
+
+    /// Records the best score after a candidate. Returns true if the search has plateaued.
+    bool Update(float best_score);
+
+private:
+    std::size_t window;
+    float threshold;
+    std::deque<float> history;
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif
@@ -72,6 +72,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <miopen/handle.hpp>
 #include <miopen/problem_description.hpp>
 #include <miopen/conv/problem_description.hpp>
+#include <miopen/log_db.hpp>
 #include <miopen/ramdb.hpp>
 
 #if MIOPEN_BACKEND_OPENCL
@@ -138,11 +139,19 @@ struct AnyInvokeParams;
 
 #if MIOPEN_ENABLE_SQLITE && MIOPEN_USE_SQLITE_PERFDB
 using PerformanceDb = DbTimer<MultiFileDb<SQLitePerfDb, SQLitePerfDb, true>>;
+#elif MIOPEN_USE_LOG_USERDB
+using PerformanceDb = DbTimer<MultiFileDb<ReadonlyRamDb, LogDb, true>>;
 #else
 using PerformanceDb = DbTimer<MultiFileDb<ReadonlyRamDb, RamDb, true>>;
 #endif
 MIOPEN_INTERNALS_EXPORT miopen::PerformanceDb GetDb(const miopen::ExecutionContext& ctx);
 
+/// Loads the perf db records of all the problems in a few batched queries. Meant to be used
+/// before searching the solutions for a whole model, so that each of its problems is then
+/// served from memory for all the solvers.
+MIOPEN_INTERNALS_EXPORT void PrefetchPerfDb(const miopen::ExecutionContext& ctx,
+                                            const std::vector<conv::ProblemDescription>& problems);
+
 template <class TTo>
 size_t setTopDescFromMLDesc(int spatial_dims, TTo& to, const TensorDescriptor& tensor)
 {
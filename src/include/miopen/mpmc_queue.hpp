@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_GUARD_MLOPEN_MPMC_QUEUE_HPP
+#define MIOPEN_GUARD_MLOPEN_MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace miopen {
+
+/// Bounded lock-free multi-producer multi-consumer queue (D. Vyukov's algorithm).
+///
+/// Every cell carries a sequence number which tells producers and consumers whether the
+/// cell is ready for them, so push and pop are a single CAS on the shared position in the
+/// uncontended case and never take a lock. The capacity is rounded up to a power of two.
+template <typename T>
+class MpmcQueue
+{
+public:
+    explicit MpmcQueue(std::size_t capacity) : mask(RoundUp(capacity) - 1)
+    {
+        cells = std::make_unique<Cell[]>(mask + 1);
+        for(std::size_t i = 0; i <= mask; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    ~MpmcQueue()
+    {
+        while(try_pop())
+            ;
+    }
+
+    std::size_t capacity() const { return mask + 1; }
+
+    /// Returns false if the queue is full, the item is left intact in this case.
+    bool try_push(T&& item)
+    {
+        auto pos = enqueue_pos.load(std::memory_order_relaxed);
+        while(true)
+        {
+            auto& cell     = cells[pos & mask];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            const auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if(dif == 0)
+            {
+                if(enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    new(&cell.storage) T(std::move(item));
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(dif < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::optional<T> try_pop()
+    {
+        auto pos = dequeue_pos.load(std::memory_order_relaxed);
+        while(true)
+        {
+            auto& cell     = cells[pos & mask];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            const auto dif =
+                static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if(dif == 0)
+            {
+                if(dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    auto& stored = *std::launder(reinterpret_cast<T*>(&cell.storage));
+                    auto result  = std::optional<T>{std::move(stored)};
+                    stored.~T();
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return result;
+                }
+            }
+            else if(dif < 0)
+            {
+                return std::nullopt;
+            }
+            else
+            {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    };
+
+    static std::size_t RoundUp(std::size_t n)
+    {
+        std::size_t result = 2;
+        while(result < n)
+            result *= 2;
+        return result;
+    }
+
+    // Producers and consumers touch different positions, keep them on separate cache lines.
+    static constexpr std::size_t cache_line = 64;
+
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(cache_line) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(cache_line) std::atomic<std::size_t> dequeue_pos{0};
+};
+
+} // namespace miopen
+
+#endif
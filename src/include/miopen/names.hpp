@@ -26,19 +26,29 @@
 
 #pragma once
 
+#include <miopen/hash128.hpp>
+
+#include <cstdint>
 #include <string>
+#include <utility>
 
 namespace miopen {
 
 struct NetworkConfig
 {
-    NetworkConfig() = default;
-    explicit NetworkConfig(const std::string& value_) : value(value_) {}
+    NetworkConfig() : fingerprint(Hash128(std::string_view{}).lo) {}
+    explicit NetworkConfig(std::string value_)
+        : value(std::move(value_)), fingerprint(Hash128(value).lo)
+    {
+    }
     operator std::string() const { return value; }
     const std::string& ToString() const { return value; }
+    /// Hash of the string computed once on construction, used as a key by the hot lookups.
+    std::uint64_t Fingerprint() const { return fingerprint; }
 
 private:
     std::string value;
+    std::uint64_t fingerprint;
 };
 
 struct AlgorithmName
@@ -27,7 +27,10 @@
 #ifndef MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
+#include <miopen/thread_pool.hpp>
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <functional>
@@ -55,24 +58,9 @@ struct joinable_thread : std::thread
     }
 };
 
-struct thread_factory
-{
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
-    {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
-            {
-                f(i);
-            }
-        });
-        work += grainsize;
-        return result;
-    }
-};
-
+/// Splits [0, n) into threadsize contiguous chunks and runs them on the shared thread pool.
+/// The calling thread runs one of the chunks and the not yet started ones while waiting for the
+/// others, so nested par_for calls do not deadlock. The first exception thrown by f is rethrown.
 template <class F>
 void par_for_impl(std::size_t n, std::size_t threadsize, F f)
 {
@@ -83,14 +71,18 @@ void par_for_impl(std::size_t n, std::size_t threadsize, F f)
     }
     else
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threadsize);
+        const auto run_chunk        = [&f, n, grainsize](std::size_t start) {
+            const std::size_t last = std::min(n, start + grainsize);
+            for(std::size_t i = start; i < last; i++)
+                f(i);
+        };
+
+        TaskGroup tasks;
+        for(std::size_t start = grainsize; start < n; start += grainsize)
+            tasks.Run([&run_chunk, start] { run_chunk(start); });
+        run_chunk(0);
+        tasks.Wait();
     }
 }
 
@@ -132,16 +124,31 @@ void par_for(std::size_t n, max_threads mt, F f)
     par_for_impl(n, std::min(threadsize, n), f);
 }
 
+/// Runs f(i) for every i in [0, n) using up to mt.n threads of the shared pool. Indices are
+/// claimed dynamically one at a time rather than in a fixed stride, so a single slow item
+/// (e.g. a long kernel compilation) does not hold back the items queued behind it.
 template <class F>
 void par_for_strided(std::size_t n, max_threads mt, F f)
 {
-    auto threadsize = std::min<std::size_t>(std::thread::hardware_concurrency(), mt.n);
-    par_for_impl(threadsize, threadsize, [&](auto start) {
-        for(std::size_t i = start; i < n; i += threadsize)
-        {
+    const auto threadsize =
+        std::min<std::size_t>({std::thread::hardware_concurrency(), mt.n, n});
+    std::atomic<std::size_t> next{0};
+    const auto agent = [&] {
+        for(auto i = next.fetch_add(1); i < n; i = next.fetch_add(1))
             f(i);
-        }
-    });
+    };
+
+    if(threadsize <= 1)
+    {
+        agent();
+        return;
+    }
+
+    TaskGroup tasks;
+    for(std::size_t i = 1; i < threadsize; i++)
+        tasks.Run(agent);
+    agent();
+    tasks.Wait();
 }
 
 } // namespace miopen
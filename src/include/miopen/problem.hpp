@@ -266,6 +266,16 @@ struct ProblemContainer : miopenProblem
     friend void from_json(const nlohmann::json& j, ProblemContainer& problem);
 };
 
+/// Finds the solutions for a list of problems, e.g. all the convolutions of a model.
+/// Problems with the same configuration are searched once. Unless the exhaustive search is
+/// requested, the kernels of the convolutions are compiled on the thread pool while the
+/// preceding ones are benchmarked. Returns the sorted solutions of each problem in order.
+MIOPEN_INTERNALS_EXPORT std::vector<std::vector<Solution>>
+FindSolutions(Handle& handle,
+              const std::vector<const ProblemContainer*>& problems,
+              const FindOptions& options,
+              std::size_t max_solutions);
+
 } // namespace miopen
 
 inline std::ostream& operator<<(std::ostream& stream, const miopen::Problem& problem)
@@ -28,6 +28,7 @@
 
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
+#include <miopen/problem_fingerprint.hpp>
 
 #include <string>
 
@@ -60,6 +61,15 @@ struct ProblemDescriptionBase
     ProblemDescriptionBase& operator=(const ProblemDescriptionBase&) = default;
 
     [[nodiscard]] virtual NetworkConfig MakeNetworkConfig() const = 0;
+
+    /// Binary identity of the problem for the in-memory lookups. The network config remains
+    /// the key for everything stored on disk. The default implementation hashes the network
+    /// config, the primitives on the hot path override it with a hash of the packed fields.
+    [[nodiscard]] virtual ProblemFingerprint MakeFingerprint() const
+    {
+        const auto config = MakeNetworkConfig().ToString();
+        return FingerprintBuilder{}.Add(std::string_view{config}).Get();
+    }
 };
 
 } // namespace miopen
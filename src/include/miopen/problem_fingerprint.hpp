@@ -0,0 +1,182 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_GUARD_MLOPEN_PROBLEM_FINGERPRINT_HPP
+#define MIOPEN_GUARD_MLOPEN_PROBLEM_FINGERPRINT_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace miopen {
+
+/// Compact binary identity of a problem: a 128-bit hash of its packed fields.
+///
+/// Unlike the network config and the db keys it does not have to be formatted as a string,
+/// so it is cheap to compute, compare and hash. It is an in-memory key only: the value is not
+/// stable between releases and must not be stored, use the legacy strings for that.
+struct ProblemFingerprint
+{
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    bool operator==(const ProblemFingerprint& other) const
+    {
+        return lo == other.lo && hi == other.hi;
+    }
+    bool operator!=(const ProblemFingerprint& other) const { return !(*this == other); }
+    bool operator<(const ProblemFingerprint& other) const
+    {
+        return lo < other.lo || (lo == other.lo && hi < other.hi);
+    }
+
+    std::string ToString() const
+    {
+        char buffer[33];
+        std::snprintf(buffer,
+                      sizeof(buffer),
+                      "%016llx%016llx",
+                      static_cast<unsigned long long>(hi),
+                      static_cast<unsigned long long>(lo));
+        return {buffer, 32};
+    }
+};
+
+static_assert(std::is_trivially_copyable<ProblemFingerprint>{});
+
+/// Packs the fields of a problem into a ProblemFingerprint. The fields are hashed as they are
+/// added, nothing is allocated.
+class FingerprintBuilder
+{
+public:
+    template <class T, std::enable_if_t<std::is_integral<T>{} || std::is_enum<T>{}, bool> = true>
+    FingerprintBuilder& Add(T value)
+    {
+        Mix(static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+        return *this;
+    }
+
+    FingerprintBuilder& Add(std::string_view value)
+    {
+        Mix(value.size());
+        for(std::size_t i = 0; i < value.size(); i += sizeof(std::uint64_t))
+        {
+            std::uint64_t word = 0;
+            std::memcpy(&word, value.data() + i, std::min(sizeof(word), value.size() - i));
+            Mix(word);
+        }
+        return *this;
+    }
+
+    ProblemFingerprint Get() const
+    {
+        // Final avalanche so that every input bit affects every output bit.
+        return {Finalize(lo ^ hi), Finalize(hi + (lo >> 1))};
+    }
+
+private:
+    std::uint64_t lo = 0x243f6a8885a308d3ULL;
+    std::uint64_t hi = 0x13198a2e03707344ULL;
+
+    void Mix(std::uint64_t word)
+    {
+        lo = (lo ^ word) * 0x9e3779b97f4a7c15ULL;
+        lo ^= lo >> 32;
+        hi = (hi + word) * 0xc2b2ae3d27d4eb4fULL;
+        hi ^= hi >> 29;
+    }
+
+    static std::uint64_t Finalize(std::uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+};
+
+/// Appends the fields of a legacy string key (network config, db key) to a string. Does the
+/// same formatting as std::ostream for integers, characters and strings without the costs of
+/// the stream construction and locale handling.
+class KeyBuilder
+{
+public:
+    explicit KeyBuilder(std::string& out_) : out(out_) {}
+
+    template <class T, std::enable_if_t<std::is_integral<T>{}, bool> = true>
+    KeyBuilder& operator<<(T value)
+    {
+        char buffer[24];
+        const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+        out.append(buffer, result.ptr);
+        return *this;
+    }
+
+    KeyBuilder& operator<<(char value)
+    {
+        out.push_back(value);
+        return *this;
+    }
+
+    KeyBuilder& operator<<(std::string_view value)
+    {
+        out.append(value);
+        return *this;
+    }
+
+    KeyBuilder& operator<<(const char* value) { return *this << std::string_view{value}; }
+    KeyBuilder& operator<<(const std::string& value) { return *this << std::string_view{value}; }
+
+    template <class F, std::enable_if_t<std::is_invocable<F, KeyBuilder&>{}, bool> = true>
+    KeyBuilder& operator<<(F&& manipulator)
+    {
+        manipulator(*this);
+        return *this;
+    }
+
+private:
+    std::string& out;
+};
+
+} // namespace miopen
+
+namespace std {
+template <>
+struct hash<miopen::ProblemFingerprint>
+{
+    std::size_t operator()(const miopen::ProblemFingerprint& fingerprint) const
+    {
+        return static_cast<std::size_t>(fingerprint.lo);
+    }
+};
+} // namespace std
+
+#endif
@@ -0,0 +1,267 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef MIOPEN_GUARD_MLOPEN_READONLY_BIN_DB_HPP
+#define MIOPEN_GUARD_MLOPEN_READONLY_BIN_DB_HPP
+
+// Compiled ("binary") form of the read-only system databases.
+//
+// This header intentionally depends on the standard library only: it is shared between
+// the library (which maps the file and queries it in place) and the offline converter
+// in tools/dbcompile (which produces the file from a text or SQLite database).
+//
+// Layout (native little-endian byte order, all offsets are from the start of the file):
+//
+//   Header
+//   Record[num_records]     sorted by key
+//   uint32_t[num_buckets]   open addressing table of record indices, linear probing
+//   char[blob_size]         keys and values, not null-terminated
+//
+// A lookup hashes the key, probes the bucket table and compares the key bytes in place,
+// so opening the database costs O(1) regardless of its size and the pages are shared by
+// all the processes which map the same file.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miopen {
+namespace bin_db {
+
+constexpr char Magic[8]              = {'M', 'I', 'O', 'B', 'I', 'N', 'D', 'B'};
+constexpr std::uint32_t Version      = 1;
+constexpr std::uint32_t EmptyBucket  = 0xFFFFFFFFU;
+constexpr std::uint32_t EndianMarker = 0x01020304U;
+
+/// Extension appended to the path of a text database to get the path of its compiled form.
+constexpr std::string_view FileSuffix = ".bin";
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endian_marker;
+    std::uint32_t num_records;
+    std::uint32_t num_buckets;
+    std::uint64_t records_offset;
+    std::uint64_t buckets_offset;
+    std::uint64_t blob_offset;
+    std::uint64_t blob_size;
+};
+
+struct Record
+{
+    std::uint64_t hash;
+    std::uint64_t key_offset;
+    std::uint64_t value_offset;
+    std::uint32_t key_size;
+    std::uint32_t value_size;
+    /// Line number in the source text database, kept for diagnostics.
+    std::uint32_t line;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 56, "Binary db header layout is part of the file format");
+static_assert(sizeof(Record) == 40, "Binary db record layout is part of the file format");
+
+/// 64-bit FNV-1a. Part of the file format, must not be changed without bumping Version.
+inline std::uint64_t Hash(std::string_view str)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for(const auto c : str)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+struct Entry
+{
+    std::string key;
+    std::string value;
+    int line;
+};
+
+/// Read-only view over a compiled database residing in memory (usually a mapped file).
+/// Does not own the memory.
+class View
+{
+public:
+    View() = default;
+
+    /// Validates the header and the bounds of all the sections.
+    /// An invalid buffer results in an empty view, see IsValid().
+    View(const char* data_, std::size_t size_)
+    {
+        if(data_ == nullptr || size_ < sizeof(Header))
+            return;
+
+        Header h;
+        std::memcpy(&h, data_, sizeof(Header));
+
+        if(std::memcmp(h.magic, Magic, sizeof(Magic)) != 0 || h.version != Version ||
+           h.endian_marker != EndianMarker)
+            return;
+
+        const auto fits = [&](std::uint64_t offset, std::uint64_t bytes) {
+            return offset <= size_ && bytes <= size_ - offset;
+        };
+
+        if(h.num_buckets == 0 || (h.num_buckets & (h.num_buckets - 1)) != 0 ||
+           h.num_records >= h.num_buckets || h.records_offset % alignof(Record) != 0 ||
+           h.buckets_offset % alignof(std::uint32_t) != 0 ||
+           !fits(h.records_offset, std::uint64_t{h.num_records} * sizeof(Record)) ||
+           !fits(h.buckets_offset, std::uint64_t{h.num_buckets} * sizeof(std::uint32_t)) ||
+           !fits(h.blob_offset, h.blob_size))
+            return;
+
+        data    = data_;
+        header  = h;
+        records = reinterpret_cast<const Record*>(data + h.records_offset);
+        buckets = reinterpret_cast<const std::uint32_t*>(data + h.buckets_offset);
+    }
+
+    bool IsValid() const { return data != nullptr; }
+    std::size_t Size() const { return IsValid() ? header.num_records : 0; }
+
+    const Record* Find(std::string_view key) const
+    {
+        if(!IsValid())
+            return nullptr;
+
+        const auto hash = Hash(key);
+        const auto mask = header.num_buckets - 1;
+
+        auto bucket     = static_cast<std::uint32_t>(hash) & mask;
+
+        // The probe count is bounded to survive a corrupted table without empty buckets.
+        for(auto probe = std::uint32_t{0}; probe < header.num_buckets;
+            ++probe, bucket = (bucket + 1) & mask)
+        {
+            const auto index = buckets[bucket];
+            if(index == EmptyBucket || index >= header.num_records)
+                return nullptr;
+            const auto& record = records[index];
+            if(record.hash == hash && Key(record) == key)
+                return &record;
+        }
+        return nullptr;
+    }
+
+    std::string_view Key(const Record& record) const
+    {
+        return Blob(record.key_offset, record.key_size);
+    }
+
+    std::string_view Value(const Record& record) const
+    {
+        return Blob(record.value_offset, record.value_size);
+    }
+
+    const Record* begin() const { return records; }
+    const Record* end() const { return records + Size(); }
+
+private:
+    const char* data              = nullptr;
+    Header header                 = {};
+    const Record* records         = nullptr;
+    const std::uint32_t* buckets  = nullptr;
+
+    std::string_view Blob(std::uint64_t offset, std::uint32_t size) const
+    {
+        if(offset > header.blob_size || size > header.blob_size - offset)
+            return {};
+        return {data + header.blob_offset + offset, size};
+    }
+};
+
+/// Serializes the entries to the compiled format. For duplicate keys the first entry wins,
+/// which matches the behavior of ReadonlyRamDb loading the text database.
+inline void Write(std::ostream& out, std::vector<Entry> entries)
+{
+    std::stable_sort(entries.begin(), entries.end(), [](const auto& l, const auto& r) {
+        return l.key < r.key;
+    });
+    entries.erase(std::unique(entries.begin(),
+                              entries.end(),
+                              [](const auto& l, const auto& r) { return l.key == r.key; }),
+                  entries.end());
+
+    auto num_buckets = std::uint32_t{16};
+    while(num_buckets < entries.size() * 2)
+        num_buckets *= 2;
+
+    auto records = std::vector<Record>{};
+    auto buckets = std::vector<std::uint32_t>(num_buckets, EmptyBucket);
+    auto blob    = std::string{};
+    records.reserve(entries.size());
+
+    for(const auto& entry : entries)
+    {
+        auto record         = Record{};
+        record.hash         = Hash(entry.key);
+        record.key_offset   = blob.size();
+        record.key_size     = static_cast<std::uint32_t>(entry.key.size());
+        blob.append(entry.key);
+        record.value_offset = blob.size();
+        record.value_size   = static_cast<std::uint32_t>(entry.value.size());
+        blob.append(entry.value);
+        record.line = static_cast<std::uint32_t>(entry.line);
+
+        auto bucket = static_cast<std::uint32_t>(record.hash) & (num_buckets - 1);
+        while(buckets[bucket] != EmptyBucket)
+            bucket = (bucket + 1) & (num_buckets - 1);
+        buckets[bucket] = static_cast<std::uint32_t>(records.size());
+
+        records.push_back(record);
+    }
+
+    auto header = Header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version        = Version;
+    header.endian_marker  = EndianMarker;
+    header.num_records    = static_cast<std::uint32_t>(records.size());
+    header.num_buckets    = num_buckets;
+    header.records_offset = sizeof(Header);
+    header.buckets_offset = header.records_offset + records.size() * sizeof(Record);
+    header.blob_offset    = header.buckets_offset + buckets.size() * sizeof(std::uint32_t);
+    header.blob_size      = blob.size();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+    out.write(reinterpret_cast<const char*>(buckets.data()),
+              buckets.size() * sizeof(std::uint32_t));
+    out.write(blob.data(), blob.size());
+}
+
+} // namespace bin_db
+} // namespace miopen
+
+#endif
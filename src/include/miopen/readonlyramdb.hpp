@@ -28,11 +28,14 @@
 
 #include <miopen/db_record.hpp>
 #include <miopen/filesystem.hpp>
+#include <miopen/hash128.hpp>
 
 #include <boost/optional.hpp>
 
+#include <memory>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <sstream>
 
 namespace miopen {
@@ -52,21 +55,21 @@ public:
     boost::optional<DbRecord> FindRecord(const std::string& problem) const
     {
         MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        const auto it = cache.find(problem);
+        const auto item = FindItem(problem);
 
-        if(it == cache.end())
+        if(!item)
             return boost::none;
 
         auto record = DbRecord{problem};
 
         MIOPEN_LOG_I2("Key match: " << problem);
-        MIOPEN_LOG_I2("Contents found: " << it->second.content);
+        MIOPEN_LOG_I2("Contents found: " << item->content);
 
-        if(!record.ParseContents(it->second.content))
+        if(!record.ParseContents(std::string{item->content}))
         {
             MIOPEN_LOG_E("Error parsing payload under the key: "
-                         << problem << " form file " << db_path << "#" << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
+                         << problem << " form file " << db_path << "#" << item->line);
+            MIOPEN_LOG_E("Contents: " << item->content);
             return boost::none;
         }
 
@@ -95,19 +98,38 @@ public:
         std::string content;
     };
 
-    const std::unordered_map<std::string, CacheItem>& GetCacheMap() const { return cache; }
+    using CacheMap = std::unordered_map<std::string, CacheItem, StringKeyHash>;
+
+    /// When the database is served from its compiled form, the map is materialized on the
+    /// first call. Intended for tools and tests which need to enumerate the whole database.
+    const CacheMap& GetCacheMap() const;
+
+    /// True if the database is served from a memory-mapped compiled file
+    /// (see readonly_bin_db.hpp) rather than from the text file loaded into the heap.
+    bool IsMapped() const { return mapped != nullptr; }
 
 private:
+    struct ItemRef
+    {
+        int line;
+        std::string_view content;
+    };
+
+    struct MappedFile;
+
     DbKinds db_kind;
     fs::path db_path;
-    std::unordered_map<std::string, CacheItem> cache;
+    CacheMap cache;
+    std::shared_ptr<const MappedFile> mapped;
 
     ReadonlyRamDb(const ReadonlyRamDb&) = default;
     ReadonlyRamDb(ReadonlyRamDb&&)      = default;
     ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
     ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
 
+    boost::optional<ItemRef> FindItem(const std::string& problem) const;
     void Prefetch(bool warn_if_unreadable);
+    bool TryMapCompiledDb();
     void ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable);
 };
 
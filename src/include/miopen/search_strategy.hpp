@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_GUARD_MLOPEN_SEARCH_STRATEGY_HPP
+#define MIOPEN_GUARD_MLOPEN_SEARCH_STRATEGY_HPP
+
+#include <miopen/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// Decides which of the candidate performance configs GenericSearch measures and in which order.
+///
+/// The candidates are known to the strategy only by their indices and feature vectors, see
+/// GetSearchFeatures(). Next() and Report() calls may interleave arbitrarily: GenericSearch
+/// compiles several candidates ahead of the measurements. The implementations are not
+/// thread-safe.
+class MIOPEN_INTERNALS_EXPORT SearchStrategy
+{
+public:
+    virtual ~SearchStrategy() = default;
+
+    /// Returns the index of the next candidate to measure or nothing if the search is over.
+    /// Every index is returned at most once and no more than budget indices are returned.
+    virtual std::optional<std::size_t> Next() = 0;
+
+    /// Reports the measured time of a candidate returned by Next(), nothing if it has failed.
+    virtual void Report(std::size_t index, std::optional<float> time) = 0;
+};
+
+enum class SearchStrategyKind
+{
+    /// Measures a random subset of the candidates in random order.
+    Random,
+    /// Measures a random sample first, then the candidates with the lowest time predicted by
+    /// the nearest measured neighbours in the feature space. The model is updated with every
+    /// measurement, a small share of picks stays random to avoid getting stuck in a local
+    /// minimum. Every measurement costs O(candidates), so a search without a budget costs
+    /// O(candidates^2): it only pays off when the number of measurements is limited.
+    Surrogate,
+};
+
+/// Returns the kind named by MIOPEN_TUNING_STRATEGY ("random", the default, or "surrogate").
+MIOPEN_INTERNALS_EXPORT SearchStrategyKind GetSearchStrategyKind();
+
+/// Returns the value of MIOPEN_DEBUG_TUNING_SEED or a random seed if it is not set or 0.
+MIOPEN_INTERNALS_EXPORT std::uint64_t GetSearchSeed();
+
+/// Converts a serialized performance config to a vector of numeric features. Numbers become
+/// log-scaled values, other tokens (e.g. kernel names) become hashes in [0, 1).
+MIOPEN_INTERNALS_EXPORT std::vector<float> GetSearchFeatures(std::string_view serialized);
+
+/// The same seed and the same sequence of Next() and Report() calls yield the same picks.
+MIOPEN_INTERNALS_EXPORT std::unique_ptr<SearchStrategy>
+MakeSearchStrategy(SearchStrategyKind kind,
+                   std::vector<std::vector<float>> features,
+                   std::size_t budget,
+                   std::uint64_t seed);
+
+} // namespace solver
+} // namespace miopen
+
+#endif
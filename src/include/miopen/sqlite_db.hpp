@@ -45,8 +45,13 @@
 #include <boost/thread.hpp>
 #include <boost/thread/thread_time.hpp>
 #include "sqlite3.h"
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include <string>
 #include <chrono>
@@ -292,7 +297,10 @@ public:
         }
     }
 
-    static Derived& GetCached(const fs::path& path, bool is_system);
+    /// Shares one instance per file between all the callers, so that the records cached in it
+    /// (see SQLitePerfDb::Prefetch) outlive a single lookup. The calls on the shared connection
+    /// are serialized by the access mutex.
+    static Derived& GetCached(DbKinds db_kind, const fs::path& path, bool is_system);
     // TODO: Fix this for the overhead of having fields per record
 
     inline auto CheckTableColumns(const std::string& tableName,
@@ -323,14 +331,36 @@ public:
         using Ret = decltype(reinterpret_cast<Derived*>(this)->FindRecordUnsafe(args...));
         if(!is_system && DisableUserDbFileIO)
             return Ret{};
+        const std::lock_guard<std::mutex> lock(*access_mutex);
         return reinterpret_cast<Derived*>(this)->FindRecordUnsafe(args...);
     }
 
+    template <typename T>
+    inline auto FindRecords(const std::vector<T>& items)
+    {
+        using Ret = decltype(reinterpret_cast<Derived*>(this)->FindRecordsUnsafe(items));
+        // One missing record per item, so that MultiFileDb falls back to the installed db.
+        if(!is_system && DisableUserDbFileIO)
+            return Ret(items.size());
+        const std::lock_guard<std::mutex> lock(*access_mutex);
+        return reinterpret_cast<Derived*>(this)->FindRecordsUnsafe(items);
+    }
+
+    template <typename... U>
+    inline void Prefetch(const U&... args)
+    {
+        if(!is_system && DisableUserDbFileIO)
+            return;
+        const std::lock_guard<std::mutex> lock(*access_mutex);
+        reinterpret_cast<Derived*>(this)->PrefetchUnsafe(args...);
+    }
+
     template <typename... U>
     inline auto RemoveRecord(U&... args)
     {
         if(!is_system && DisableUserDbFileIO)
             return true;
+        const std::lock_guard<std::mutex> lock(*access_mutex);
         return reinterpret_cast<Derived*>(this)->RemoveRecordUnsafe(args...);
     }
 
@@ -339,6 +369,7 @@ public:
     {
         if(!is_system && DisableUserDbFileIO)
             return true;
+        const std::lock_guard<std::mutex> lock(*access_mutex);
         return reinterpret_cast<Derived*>(this)->StoreRecordUnsafe(args...);
     }
 
@@ -347,6 +378,7 @@ public:
     {
         if(!is_system && DisableUserDbFileIO)
             return true;
+        const std::lock_guard<std::mutex> lock(*access_mutex);
         return reinterpret_cast<Derived*>(this)->RemoveUnsafe(args...);
     }
 
@@ -356,6 +388,7 @@ public:
         using Ret = decltype(reinterpret_cast<Derived*>(this)->UpdateUnsafe(args...));
         if(!is_system && DisableUserDbFileIO)
             return Ret{};
+        const std::lock_guard<std::mutex> lock(*access_mutex);
         return reinterpret_cast<Derived*>(this)->UpdateUnsafe(args...);
     }
 
@@ -364,6 +397,7 @@ public:
     {
         if(!is_system && DisableUserDbFileIO)
             return false;
+        const std::lock_guard<std::mutex> lock(*access_mutex);
         return reinterpret_cast<Derived*>(this)->LoadUnsafe(args...);
     }
 
@@ -371,24 +405,27 @@ public:
     bool dbInvalid;
     SQLite sql;
     bool is_system;
+    /// Serializes the calls on the instance, which GetCached() shares between the threads.
+    /// Behind a pointer to keep the db movable.
+    std::unique_ptr<std::mutex> access_mutex = std::make_unique<std::mutex>();
 };
 
 template <typename Derived>
-Derived& SQLiteBase<Derived>::GetCached(const fs::path& path, bool is_system)
+Derived& SQLiteBase<Derived>::GetCached(DbKinds db_kind, const fs::path& path, bool is_system)
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
     static std::mutex mutex;
     const std::lock_guard<std::mutex> lock{mutex};
 
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static auto instances = std::map<fs::path, Derived>{};
-    const auto it         = instances.find(path);
+    static auto instances = std::map<std::pair<fs::path, bool>, Derived>{};
+    const auto key        = std::make_pair(path, is_system);
+    const auto it         = instances.find(key);
 
     if(it != instances.end())
         return it->second;
 
-    instances.emplace(path, Derived{path, is_system});
-    return instances.at(path);
+    return instances.emplace(key, Derived{db_kind, path, is_system}).first->second;
 }
 
 class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
@@ -471,6 +508,15 @@ public:
         std::string clause;
         std::vector<std::string> values;
         std::tie(clause, values) = problem_config.WhereClause();
+
+        const auto cache_key = is_system ? JoinStrings(values, "\x1f") : std::string{};
+        if(is_system)
+        {
+            const auto cached = record_cache.find(cache_key);
+            if(cached != record_cache.end())
+                return cached->second;
+        }
+
         // clang-format off
         auto select_query =
             "SELECT solver, params "
@@ -498,10 +544,124 @@ public:
                 MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
             }
         }
-        if(rec.GetSize() == 0)
-            return boost::none;
-        else
-            return {rec};
+
+        auto ret = boost::optional<DbRecord>{};
+        if(rec.GetSize() != 0)
+            ret = std::move(rec);
+        if(is_system)
+            record_cache.emplace(cache_key, ret);
+        return ret;
+    }
+
+    /// Searches for the records of all the PROBLEMS, issuing one query per as many problems as
+    /// fit into the limit of the bound parameters instead of one query per problem.
+    ///
+    /// Returns the records in the order of the problems, none for the ones not found.
+    template <typename T>
+    inline std::vector<boost::optional<DbRecord>> FindRecordsUnsafe(const std::vector<T>& problems)
+    {
+        auto records = std::vector<boost::optional<DbRecord>>(problems.size());
+        if(dbInvalid || problems.empty())
+            return records;
+
+        // SQLITE_MAX_VARIABLE_NUMBER of the older SQLite versions.
+        constexpr std::size_t max_parameters = 999;
+
+        const auto fields     = problems.front().FieldNames();
+        const auto chunk_size = std::max<std::size_t>(1, max_parameters / fields.size());
+
+        std::vector<std::string> joins;
+        for(const auto& field : fields)
+        {
+            const auto column = T::table_name() + "." + field;
+            joins.push_back("(" + column + " = keys." + field + ")");
+        }
+        const auto placeholders =
+            JoinStrings(std::vector<std::string>(fields.size(), "?"), ", ");
+
+        for(std::size_t first = 0; first < problems.size(); first += chunk_size)
+        {
+            const auto last = std::min(problems.size(), first + chunk_size);
+
+            std::vector<std::string> rows;
+            std::vector<std::string> values;
+            for(auto i = first; i < last; ++i)
+            {
+                // The index is inlined into the query to leave the parameters for the fields.
+                rows.push_back("(" + std::to_string(i) + ", " + placeholders + ")");
+                const auto problem_values = std::get<1>(problems[i].WhereClause());
+                values.insert(values.end(), problem_values.begin(), problem_values.end());
+            }
+
+            // clang-format off
+            const auto query =
+                "WITH keys(idx, " + JoinStrings(fields, ", ") + ") AS "
+                "( VALUES " + JoinStrings(rows, ", ") + " ) "
+                "SELECT keys.idx, perf_db.solver, perf_db.params "
+                "FROM keys "
+                "INNER JOIN " + T::table_name() + " "
+                "ON " + JoinStrings(joins, " AND ") + " "
+                "INNER JOIN perf_db "
+                "ON perf_db.config = " + T::table_name() + ".id;";
+            // clang-format on
+
+            auto stmt = SQLite::Statement{sql, query, values};
+            while(true)
+            {
+                auto rc = stmt.Step(sql);
+                if(rc == SQLITE_ROW)
+                {
+                    const auto idx = static_cast<std::size_t>(stmt.ColumnInt64(0));
+                    if(idx >= records.size())
+                        MIOPEN_THROW(miopenStatusInternalError, "Invalid index in perf db query");
+                    if(!records[idx])
+                        records[idx].emplace(DbKinds::PerfDb, problems[idx]);
+                    records[idx]->SetValues(stmt.ColumnText(1), stmt.ColumnText(2));
+                }
+                else if(rc == SQLITE_DONE)
+                {
+                    break;
+                }
+                else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
+                {
+                    MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+                }
+            }
+        }
+
+        return records;
+    }
+
+    /// Loads the records of all the PROBLEMS into the cache in a few batched queries, so that the
+    /// subsequent FindRecord() calls for all the solvers do not touch the database.
+    ///
+    /// Only the system databases are cached: they are read-only and thus never go stale, while
+    /// the user databases may be updated by other processes.
+    template <typename T>
+    inline void PrefetchUnsafe(const std::vector<T>& problems)
+    {
+        if(dbInvalid || !is_system)
+            return;
+
+        std::vector<T> missing;
+        std::vector<std::string> keys;
+        for(const auto& problem : problems)
+        {
+            auto key = JoinStrings(std::get<1>(problem.WhereClause()), "\x1f");
+            if(record_cache.count(key) != 0 ||
+               std::find(keys.begin(), keys.end(), key) != keys.end())
+                continue;
+            missing.push_back(problem);
+            keys.push_back(std::move(key));
+        }
+
+        if(missing.empty())
+            return;
+
+        MIOPEN_LOG_I2("Prefetching " << missing.size() << " perf db records from " << filename);
+        auto records = FindRecordsUnsafe(missing);
+        for(std::size_t i = 0; i < keys.size(); ++i)
+            record_cache.emplace(std::move(keys[i]), std::move(records[i]));
     }
 
     /// Removes ID with associated VALUES from record with key PROBLEM_CONFIG from db.
@@ -648,5 +808,9 @@ public:
             return false;
         return record->GetValues(id, values);
     }
+
+private:
+    /// The records of the system database by the values of their key. Guarded by the access mutex.
+    std::unordered_map<std::string, boost::optional<DbRecord>> record_cache;
 };
 } // namespace miopen
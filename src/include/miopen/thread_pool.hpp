@@ -0,0 +1,306 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_GUARD_MLOPEN_THREAD_POOL_HPP
+#define MIOPEN_GUARD_MLOPEN_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Persistent work-stealing thread pool.
+///
+/// Each worker owns a task deque. Tasks submitted from a worker go to its own deque and are
+/// executed in LIFO order (good locality for nested parallelism), tasks submitted from other
+/// threads are distributed round-robin. An idle worker steals from the front of other deques.
+///
+/// The pool is header-only so that it can be used by the tests and the driver via par_for.hpp,
+/// thus "process-wide" means "per module" when the library is built with hidden inlines.
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(std::size_t n_workers)
+    {
+        n_workers = std::max<std::size_t>(n_workers, 1);
+        queues.reserve(n_workers);
+        for(std::size_t i = 0; i < n_workers; ++i)
+            queues.emplace_back(std::make_unique<Queue>());
+        workers.reserve(n_workers);
+        for(std::size_t i = 0; i < n_workers; ++i)
+            workers.emplace_back([this, i] { WorkerLoop(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for(auto& worker : workers)
+            worker.join();
+    }
+
+    /// The shared pool used by par_for, the tuning and the kernel precompilation.
+    /// Created on first use and sized by the number of hardware threads.
+    static ThreadPool& Global()
+    {
+        // The pool is intentionally leaked: joining the workers from a static destructor
+        // may deadlock if the process exits from a worker or while a task is running.
+        // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+        static auto* const pool = new ThreadPool{std::thread::hardware_concurrency()};
+        return *pool;
+    }
+
+    std::size_t Size() const { return workers.size(); }
+
+    /// Returns true if the calling thread is a worker of this pool.
+    bool IsWorkerThread() const { return CurrentWorker().pool == this; }
+
+    /// The task shall not throw, use TaskGroup to propagate exceptions to the waiting thread.
+    void Submit(Task task)
+    {
+        const auto& current = CurrentWorker();
+        const auto index    = current.pool == this
+                                  ? current.index
+                                  : next_queue.fetch_add(1, std::memory_order_relaxed) % Size();
+        // Counted before it becomes visible, so that the counter never underflows.
+        pending.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        {
+            // Taking the lock guarantees that a worker about to sleep sees the new task.
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+        }
+        wake.notify_one();
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct WorkerId
+    {
+        const ThreadPool* pool = nullptr;
+        std::size_t index      = 0;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> next_queue{0};
+    std::atomic<std::size_t> pending{0};
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    bool stop = false;
+
+    static WorkerId& CurrentWorker()
+    {
+        static thread_local WorkerId id;
+        return id;
+    }
+
+    bool TryPop(std::size_t self, Task& task)
+    {
+        if(pending.load(std::memory_order_acquire) == 0)
+            return false;
+
+        {
+            auto& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if(!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        for(std::size_t i = 1; i < queues.size(); ++i)
+        {
+            auto& victim = *queues[(self + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if(!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void WorkerLoop(std::size_t index)
+    {
+        CurrentWorker() = WorkerId{this, index};
+
+        while(true)
+        {
+            Task task;
+            if(TryPop(index, task))
+            {
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            wake.wait(lock, [&] { return stop || pending.load(std::memory_order_acquire) != 0; });
+            if(stop)
+                return;
+        }
+    }
+};
+
+/// Tracks a set of tasks submitted to a ThreadPool. Wait() runs the tasks of the group that
+/// have not started yet while the group is not finished and rethrows the first exception
+/// thrown by a task.
+///
+/// The waiting thread only helps with its own group: running an unrelated task (e.g. a long
+/// kernel compilation) would delay the waiter past the end of its group. Nested groups stay
+/// deadlock-free, since every waiter can run the tasks it waits for.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool& pool_ = ThreadPool::Global())
+        : pool(pool_), state(std::make_shared<State>())
+    {
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup()
+    {
+        // The tasks reference the caller's data, so they must finish even if Wait() was skipped.
+        WaitImpl();
+    }
+
+    template <class F>
+    void Run(F f)
+    {
+        state->unfinished.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->tasks.emplace_back(std::move(f));
+        }
+        // The pool runs any task of the group, not necessarily this one. The state outlives the
+        // group, since the waiter may run all the tasks before the pool gets to this one.
+        pool.Submit([state = state]() { state->RunPending(); });
+    }
+
+    /// Runs one task of the group that has not started yet in the calling thread, if any.
+    bool RunPending() { return state->RunPending(); }
+
+    void Wait()
+    {
+        WaitImpl();
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if(state->error)
+            std::rethrow_exception(std::exchange(state->error, nullptr));
+    }
+
+private:
+    struct State
+    {
+        std::mutex mutex;
+        std::deque<ThreadPool::Task> tasks;
+        std::atomic<std::size_t> unfinished{0};
+        std::exception_ptr error;
+
+        bool RunPending()
+        {
+            ThreadPool::Task task;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(tasks.empty())
+                    return false;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            try
+            {
+                task();
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!error)
+                    error = std::current_exception();
+            }
+            unfinished.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    };
+
+    ThreadPool& pool;
+    std::shared_ptr<State> state;
+
+    void WaitImpl()
+    {
+        auto idle = 0;
+        while(state->unfinished.load(std::memory_order_acquire) != 0)
+        {
+            if(state->RunPending())
+            {
+                idle = 0;
+                continue;
+            }
+            // Back off gradually: the remaining tasks may be long (e.g. kernel compilation).
+            if(++idle < 64)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds{std::min(idle, 1000)});
+        }
+    }
+};
+
+} // namespace miopen
+
+#endif
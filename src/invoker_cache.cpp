@@ -25,118 +25,265 @@
  *******************************************************************************/
 
 #include <miopen/invoker_cache.hpp>
+#include <miopen/fnv1a.hpp>
+#include <miopen/hash128.hpp>
+#include <miopen/kernel_manifest.hpp>
 #include <miopen/logger.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
 namespace miopen {
 
-std::optional<Invoker> InvokerCache::operator[](const Key& key) const
+namespace {
+
+constexpr std::size_t ShardCountLog2 = 4;
+constexpr std::size_t ShardCount     = std::size_t{1} << ShardCountLog2;
+
+struct InvokerNode
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
-        return std::nullopt;
-    const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
-    if(invoker == item_invokers.end())
-        return std::nullopt;
-    return invoker->second;
-}
+    std::uint64_t hash;
+    std::string network_config;
+    std::string solver_id;
+    Invoker invoker;
 
-std::optional<Invoker> InvokerCache::GetFound1_0(const std::string& network_config,
-                                                 const std::string& algorithm) const
+    bool Matches(const std::string& config, const std::string& id) const
+    {
+        return solver_id == id && network_config == config;
+    }
+};
+
+struct FoundNode
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    std::uint64_t hash;
+    std::string network_config;
+    std::string algorithm;
+    std::string solver_id;
+
+    bool Matches(const std::string& config, const std::string& algo) const
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
-        return std::nullopt;
+        return algorithm == algo && network_config == config;
     }
-    if(item->second.found_1_0.empty())
+};
+
+/// Open addressing hash table with lock-free lookups and serialized insertion.
+///
+/// The nodes are immutable once published. A replaced node or a slot array left behind by
+/// growing the table is retired but not freed until the table is destroyed, so a concurrent
+/// reader never touches freed memory. The set of the keys is small (problems used by the
+/// process times solvers), so the retired memory is bounded.
+template <class Node>
+class ConcurrentTable
+{
+public:
+    ConcurrentTable() { Publish(std::make_unique<Slots>(16)); }
+
+    const Node* Find(std::uint64_t hash, const std::string& config, const std::string& name) const
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
-        return std::nullopt;
+        const auto& slots = *current.load(std::memory_order_acquire);
+        for(auto i = hash & slots.mask;; i = (i + 1) & slots.mask)
+        {
+            const auto* node = slots.items[i].load(std::memory_order_acquire);
+            if(node == nullptr)
+                return nullptr;
+            if(node->hash == hash && node->Matches(config, name))
+                return node;
+        }
     }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
+
+    /// Shall be serialized by the caller. Returns false if the key is present and replace is
+    /// false, the table is not changed in that case.
+    bool Insert(std::unique_ptr<Node> node, const std::string& config, const std::string& name,
+                bool replace)
     {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
-        return std::nullopt;
+        auto& slots = *current.load(std::memory_order_relaxed);
+        for(auto i = node->hash & slots.mask;; i = (i + 1) & slots.mask)
+        {
+            const auto* existing = slots.items[i].load(std::memory_order_relaxed);
+            if(existing == nullptr)
+            {
+                slots.items[i].store(node.get(), std::memory_order_release);
+                nodes.emplace_back(std::move(node));
+                if(++count * 2 > slots.mask + 1)
+                    Grow();
+                return true;
+            }
+            if(existing->hash == node->hash && existing->Matches(config, name))
+            {
+                if(!replace)
+                    return false;
+                slots.items[i].store(node.get(), std::memory_order_release);
+                nodes.emplace_back(std::move(node));
+                return true;
+            }
+        }
     }
-    const auto invoker = item_invokers.find(found_1_0_id->second);
-    if(invoker == item_invokers.end())
+
+private:
+    struct Slots
     {
-        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
+        explicit Slots(std::size_t size)
+            : mask(size - 1), items(std::make_unique<std::atomic<const Node*>[]>(size))
+        {
+            for(std::size_t i = 0; i < size; ++i)
+                items[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<const Node*>[]> items;
+    };
+
+    std::atomic<const Slots*> current{nullptr};
+    std::vector<std::unique_ptr<Slots>> all_slots;
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::size_t count = 0;
+
+    void Publish(std::unique_ptr<Slots> slots)
+    {
+        current.store(slots.get(), std::memory_order_release);
+        all_slots.emplace_back(std::move(slots));
     }
-    return invoker->second;
+
+    void Grow()
+    {
+        const auto& old = *current.load(std::memory_order_relaxed);
+        auto grown      = std::make_unique<Slots>((old.mask + 1) * 2);
+        for(std::size_t i = 0; i <= old.mask; ++i)
+        {
+            const auto* node = old.items[i].load(std::memory_order_relaxed);
+            if(node == nullptr)
+                continue;
+            auto j = node->hash & grown->mask;
+            while(grown->items[j].load(std::memory_order_relaxed) != nullptr)
+                j = (j + 1) & grown->mask;
+            grown->items[j].store(node, std::memory_order_relaxed);
+        }
+        Publish(std::move(grown));
+    }
+};
+
+std::uint64_t GetKeyHash(const NetworkConfig& network_config, const std::string& name)
+{
+    return CombineFingerprints(network_config.Fingerprint(), Hash128(name).lo);
 }
 
-std::optional<std::string> InvokerCache::GetFound1_0SolverId(const std::string& network_config,
-                                                             const std::string& algorithm) const
+} // namespace
+
+struct InvokerCache::Shard
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-    {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
+    std::mutex mutex;
+    ConcurrentTable<InvokerNode> invokers;
+    ConcurrentTable<FoundNode> found_1_0;
+};
+
+namespace {
+
+template <class Shards>
+auto& GetShard(Shards& shards, std::uint64_t hash)
+{
+    // The low bits select the slot within the shard.
+    return shards[hash >> (64 - ShardCountLog2)];
+}
+
+} // namespace
+
+InvokerCache::InvokerCache() : shards(std::make_unique<Shard[]>(ShardCount)) {}
+InvokerCache::InvokerCache(InvokerCache&&) noexcept = default;
+InvokerCache& InvokerCache::operator=(InvokerCache&&) noexcept = default;
+InvokerCache::~InvokerCache()                                 = default;
+
+std::optional<Invoker> InvokerCache::GetInvoker(const NetworkConfig& network_config,
+                                                const std::string& solver_id) const
+{
+    const auto hash  = GetKeyHash(network_config, solver_id);
+    const auto* node =
+        GetShard(shards, hash).invokers.Find(hash, network_config.ToString(), solver_id);
+    if(node == nullptr)
         return std::nullopt;
-    }
-    if(item->second.found_1_0.empty())
-    {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
+    return node->invoker;
+}
+
+std::optional<Invoker> InvokerCache::GetFound1_0(const NetworkConfig& network_config,
+                                                 const AlgorithmName& algorithm) const
+{
+    const auto solver_id = GetFound1_0SolverId(network_config, algorithm);
+    if(!solver_id)
         return std::nullopt;
-    }
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
+    auto invoker = GetInvoker(network_config, *solver_id);
+    if(!invoker)
     {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
-        return std::nullopt;
+        MIOPEN_THROW("No invoker with solver_id of " + *solver_id + " was registered for " +
+                     network_config.ToString());
     }
-    return found_1_0_id->second;
+    return invoker;
 }
 
-void InvokerCache::Register(const Key& key, const Invoker& invoker)
+std::optional<std::string> InvokerCache::GetFound1_0SolverId(const NetworkConfig& network_config,
+                                                             const AlgorithmName& algorithm) const
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
+    const auto hash  = GetKeyHash(network_config, algorithm.ToString());
+    const auto* node = GetShard(shards, hash).found_1_0.Find(
+        hash, network_config.ToString(), algorithm.ToString());
+    if(node == nullptr)
     {
-        it->second.invokers.insert({key.second, invoker});
+        MIOPEN_LOG_I2("No find 1.0 result for " << network_config.ToString()
+                                                << " and algorithm " << algorithm.ToString());
+        return std::nullopt;
     }
-    else
+    return node->solver_id;
+}
+
+void InvokerCache::Register(const NetworkConfig& network_config,
+                            const std::string& solver_id,
+                            const Invoker& invoker)
+{
+    const auto hash = GetKeyHash(network_config, solver_id);
+    auto& shard     = GetShard(shards, hash);
     {
-        auto& item = invokers.insert({key.first, Item{}}).first->second;
-        item.invokers.insert({key.second, invoker});
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.invokers.Insert(
+            std::make_unique<InvokerNode>(
+                InvokerNode{hash, network_config.ToString(), solver_id, invoker}),
+            network_config.ToString(),
+            solver_id,
+            false);
     }
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    kernel_manifest::RecordInvoker(network_config.ToString(), solver_id);
+    MIOPEN_LOG_I2("Invoker registered for algorithm " << network_config.ToString()
+                                                      << " and solver " << solver_id);
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
-                                 const std::string& algorithm,
+void InvokerCache::SetAsFound1_0(const NetworkConfig& network_config,
+                                 const AlgorithmName& algorithm,
                                  const std::string& solver_id)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
+    // Validating at find time
+    if(!GetInvoker(network_config, solver_id))
+    {
+        MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
+                     network_config.ToString());
+    }
 
+    const auto hash = GetKeyHash(network_config, algorithm.ToString());
+    auto& shard     = GetShard(shards, hash);
     {
-        // Validating at find time
-        const auto& item_invokers = item->second.invokers;
-        const auto invoker        = item_invokers.find(solver_id);
-        if(invoker == item_invokers.end())
+        const std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto* current =
+            shard.found_1_0.Find(hash, network_config.ToString(), algorithm.ToString());
+        if(current == nullptr || current->solver_id != solver_id)
         {
-            MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
+            shard.found_1_0.Insert(
+                std::make_unique<FoundNode>(FoundNode{
+                    hash, network_config.ToString(), algorithm.ToString(), solver_id}),
+                network_config.ToString(),
+                algorithm.ToString(),
+                true);
         }
     }
-
-    item->second.found_1_0[algorithm] = solver_id;
-    MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
-                            << " in " << network_config);
+    MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for "
+                            << algorithm.ToString() << " in " << network_config.ToString());
 }
 
 } // namespace miopen
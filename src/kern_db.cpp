@@ -25,11 +25,26 @@
  *******************************************************************************/
 #include "miopen/bz2.hpp"
 #include <miopen/kern_db.hpp>
+#include <miopen/par_for.hpp>
+
+#include <map>
+#include <mutex>
+#include <utility>
 
 namespace miopen {
+
+namespace {
+
+// The zstd dictionaries referenced by the records, by the dictionary id.
+constexpr const char* DictionaryTable = "kern_db_dict";
+
+} // namespace
+
 KernDb::KernDb(DbKinds db_kind, const fs::path& filename_, bool is_system_)
     : KernDb(db_kind, filename_, is_system_, compress, decompress)
 {
+    // The testing constructor keeps bz2 so that the replaced functions are used.
+    codec = kern_db_codec::GetDefault(is_system_);
 }
 
 KernDb::KernDb(
@@ -66,7 +81,295 @@ KernDb::KernDb(
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
+    }
+
+    has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    if(!has_codec_column && !is_system)
+    {
+        // The existing records get the default, which is bz2.
+        try
+        {
+            sql.Exec("ALTER TABLE `" + KernelConfig::table_name() +
+                     "` ADD COLUMN `codec` INT NOT NULL DEFAULT 0;");
+        }
+        catch(const Exception&)
+        {
+            // Another process might have added the column meanwhile, checked below.
+        }
+        has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    }
+}
+
+void KernDb::SetCodec(KernDbCodec codec_)
+{
+    const std::lock_guard<std::mutex> lock(*access_mutex);
+    SetCodecUnsafe(codec_);
+}
+
+void KernDb::SetCodecUnsafe(KernDbCodec codec_)
+{
+    if(!kern_db_codec::IsSupported(codec_))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Kernel cache codec is not supported: " +
+                         std::string{kern_db_codec::ToString(codec_)});
     }
+    codec      = codec_;
+    dictionary = nullptr;
+}
+
+std::shared_ptr<const kern_db_codec::Dictionary> KernDb::GetDictionary(unsigned id)
+{
+    if(dictionary != nullptr && dictionary->Id() == id)
+        return dictionary;
+
+    // The databases are opened for each lookup, so the digested dictionaries are shared.
+    static std::mutex mutex;
+    static std::map<std::pair<fs::path, unsigned>, std::shared_ptr<const kern_db_codec::Dictionary>>
+        cache;
+
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto& cached = cache[{filename, id}];
+    if(cached == nullptr)
+    {
+        auto stmt = SQLite::Statement{
+            sql, "SELECT dict FROM " + std::string{DictionaryTable} + " WHERE id = ?;"};
+        stmt.BindInt64(1, id);
+        if(stmt.Step(sql) != SQLITE_ROW)
+        {
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "Missing kernel cache dictionary " + std::to_string(id) + " in " +
+                             filename.string());
+        }
+        cached = std::make_shared<const kern_db_codec::Dictionary>(stmt.ColumnBlob(0));
+    }
+    return cached;
+}
+
+boost::optional<std::vector<char>>
+KernDb::Decode(std::vector<char> blob, KernDbCodec blob_codec, int64_t uncompressed_size)
+{
+    if(uncompressed_size == 0)
+        return blob;
+    if(blob_codec == KernDbCodec::Bz2)
+        return decompress_fn(blob, static_cast<unsigned int>(uncompressed_size));
+    if(!kern_db_codec::IsSupported(blob_codec))
+    {
+        // Written by a newer or differently built library, the kernel gets recompiled.
+        MIOPEN_LOG_W("Kernel cache record codec is not supported: "
+                     << kern_db_codec::ToString(blob_codec) << " in " << filename);
+        return boost::none;
+    }
+
+    const auto id = blob_codec == KernDbCodec::Zstd ? kern_db_codec::GetDictionaryId(blob) : 0;
+    const auto dict = id != 0 ? GetDictionary(id) : nullptr;
+    return kern_db_codec::Decompress(blob_codec, blob, uncompressed_size, dict.get());
+}
+
+std::tuple<std::vector<char>, int64_t, KernDbCodec>
+KernDb::Encode(const std::vector<char>& blob) const
+{
+    const auto blob_codec = has_codec_column ? codec : KernDbCodec::Bz2;
+    auto success          = false;
+    auto compressed =
+        blob_codec == KernDbCodec::Bz2
+            ? compress_fn(blob, &success)
+            : kern_db_codec::Compress(blob_codec, blob, &success, dictionary.get());
+    if(!success)
+        return {blob, 0, blob_codec};
+    return {std::move(compressed), static_cast<int64_t>(blob.size()), blob_codec};
+}
+
+std::vector<boost::optional<std::vector<char>>>
+KernDb::FindRecordsUnsafe(const std::vector<KernelConfig>& configs)
+{
+    auto records = std::vector<boost::optional<std::vector<char>>>(configs.size());
+    if(filename.empty() || dbInvalid || configs.empty())
+        return records;
+
+    struct Row
+    {
+        std::size_t idx;
+        std::vector<char> blob;
+        std::string md5_hash;
+        int64_t uncompressed_size;
+        KernDbCodec blob_codec;
+    };
+    auto rows = std::vector<Row>{};
+
+    // SQLITE_MAX_VARIABLE_NUMBER of the older SQLite versions, two parameters per config.
+    constexpr std::size_t chunk_size = 999 / 2;
+    const auto table                 = KernelConfig::table_name();
+
+    for(std::size_t first = 0; first < configs.size(); first += chunk_size)
+    {
+        const auto last = std::min(configs.size(), first + chunk_size);
+
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        for(auto i = first; i < last; ++i)
+        {
+            keys.push_back("(" + std::to_string(i) + ", ?, ?)");
+            values.push_back(configs[i].kernel_name.string());
+            values.push_back(configs[i].kernel_args);
+        }
+
+        // clang-format off
+        const auto query =
+            "WITH keys(idx, kernel_name, kernel_args) AS "
+            "( VALUES " + JoinStrings(keys, ", ") + " ) "
+            "SELECT keys.idx, kernel_blob, kernel_hash, uncompressed_size" +
+            std::string{has_codec_column ? ", codec " : " "} +
+            "FROM keys "
+            "INNER JOIN " + table + " "
+            "ON (" + table + ".kernel_name = keys.kernel_name) "
+            "AND (" + table + ".kernel_args = keys.kernel_args);";
+        // clang-format on
+
+        auto stmt = SQLite::Statement{sql, query, values};
+        for(auto rc = stmt.Step(sql); rc != SQLITE_DONE; rc = stmt.Step(sql))
+        {
+            if(rc != SQLITE_ROW)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            const auto idx = static_cast<std::size_t>(stmt.ColumnInt64(0));
+            if(idx >= configs.size())
+                MIOPEN_THROW(miopenStatusInternalError, "Invalid index in kernel db query");
+            rows.push_back({idx,
+                            stmt.ColumnBlob(1),
+                            stmt.ColumnText(2),
+                            stmt.ColumnInt64(3),
+                            has_codec_column ? static_cast<KernDbCodec>(stmt.ColumnInt64(4))
+                                             : KernDbCodec::Bz2});
+        }
+    }
+
+    // The decompression dominates, the database is not touched past this point but for the
+    // dictionaries, which are loaded under a lock.
+    par_for(rows.size(), min_grain{1}, [&](std::size_t i) {
+        auto& row  = rows[i];
+        auto& blob = records[row.idx];
+        blob       = Decode(std::move(row.blob), row.blob_codec, row.uncompressed_size);
+        if(blob && md5(*blob) != row.md5_hash)
+            MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
+    });
+
+    return records;
+}
+
+void KernDb::Recompress(KernDbCodec codec_, std::size_t dictionary_size)
+{
+    if(is_system || dbInvalid || filename.empty() || !has_codec_column)
+        MIOPEN_THROW(miopenStatusInvalidValue, "Recompression requires a writable database");
+    const std::lock_guard<std::mutex> lock(*access_mutex);
+    SetCodecUnsafe(codec_);
+
+    const auto table = KernelConfig::table_name();
+    std::vector<int64_t> ids;
+    {
+        auto stmt = SQLite::Statement{sql, "SELECT id FROM " + table + ";"};
+        for(auto rc = stmt.Step(sql); rc != SQLITE_DONE; rc = stmt.Step(sql))
+        {
+            if(rc != SQLITE_ROW)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            ids.push_back(stmt.ColumnInt64(0));
+        }
+    }
+
+    const auto read = [&](int64_t id) {
+        auto stmt = SQLite::Statement{
+            sql, "SELECT kernel_blob, uncompressed_size, codec FROM " + table + " WHERE id = ?;"};
+        stmt.BindInt64(1, id);
+        if(stmt.Step(sql) != SQLITE_ROW)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        auto blob = Decode(stmt.ColumnBlob(0),
+                           static_cast<KernDbCodec>(stmt.ColumnInt64(2)),
+                           stmt.ColumnInt64(1));
+        if(!blob)
+            MIOPEN_THROW(miopenStatusNotImplemented, "Record codec is not supported");
+        return std::move(*blob);
+    };
+
+    sql.Exec("CREATE TABLE IF NOT EXISTS `" + std::string{DictionaryTable} +
+             "` (`id` INTEGER PRIMARY KEY, `dict` BLOB NOT NULL);");
+
+    auto trained = std::shared_ptr<const kern_db_codec::Dictionary>{};
+    if(codec == KernDbCodec::Zstd && dictionary_size != 0)
+    {
+        // zstd suggests about a hundred times the dictionary size of samples. Those are
+        // taken evenly over the records, which are ordered by the insertion.
+        const auto budget = dictionary_size * 100;
+        const auto stride = std::max<std::size_t>(1, ids.size() / 4096);
+        auto samples      = std::vector<std::vector<char>>{};
+        auto sampled      = std::size_t{0};
+        for(std::size_t i = 0; i < ids.size() && sampled < budget; i += stride)
+        {
+            samples.push_back(read(ids[i]));
+            sampled += samples.back().size();
+        }
+
+        auto content = kern_db_codec::TrainDictionary(samples, dictionary_size);
+        if(!content.empty())
+            trained = std::make_shared<const kern_db_codec::Dictionary>(std::move(content));
+    }
+
+    // The dictionary is stored with the records, so that a failure leaves neither of them.
+    const auto previous = dictionary;
+    sql.Exec("BEGIN;");
+    try
+    {
+        if(trained != nullptr)
+        {
+            auto stmt = SQLite::Statement{sql,
+                                          "INSERT OR REPLACE INTO " + std::string{DictionaryTable} +
+                                              "(id, dict) VALUES(?, ?);"};
+            stmt.BindInt64(1, trained->Id());
+            stmt.BindBlob(2, trained->Content());
+            if(stmt.Step(sql) != SQLITE_DONE)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            dictionary = trained;
+        }
+
+        for(const auto id : ids)
+        {
+            const auto [blob, uncompressed_size, blob_codec] = Encode(read(id));
+            auto stmt = SQLite::Statement{sql,
+                                          "UPDATE " + table +
+                                              " SET kernel_blob = ?, uncompressed_size = ?,"
+                                              " codec = ? WHERE id = ?;"};
+            stmt.BindBlob(1, blob);
+            stmt.BindInt64(2, uncompressed_size);
+            stmt.BindInt64(3, static_cast<int64_t>(blob_codec));
+            stmt.BindInt64(4, id);
+            if(stmt.Step(sql) != SQLITE_DONE)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        }
+
+        // No record refers to the other dictionaries anymore.
+        const auto keep = dictionary != nullptr ? dictionary->Id() : 0;
+        sql.Exec("DELETE FROM " + std::string{DictionaryTable} +
+                 " WHERE id != " + std::to_string(keep) + ";");
+        sql.Exec("COMMIT;");
+    }
+    catch(...)
+    {
+        dictionary = previous;
+        // A failed rollback shall not replace the original error.
+        try
+        {
+            sql.Exec("ROLLBACK;");
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Rollback of " << filename << " failed: " << ex.what());
+        }
+        throw;
+    }
+    sql.Exec("VACUUM;");
+
+    MIOPEN_LOG_I("Recompressed " << ids.size() << " records of " << filename << " with "
+                                 << kern_db_codec::ToString(codec)
+                                 << (dictionary != nullptr ? " and a dictionary" : ""));
 }
 
 } // namespace miopen
@@ -0,0 +1,344 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kern_db_codec.hpp>
+
+#include <miopen/bz2.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <numeric>
+#include <string>
+
+#if MIOPEN_USE_ZSTD
+#include <zdict.h>
+#include <zstd.h>
+#endif
+#if MIOPEN_USE_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_KERN_DB_CODEC)
+
+namespace miopen {
+namespace kern_db_codec {
+
+namespace {
+
+#if MIOPEN_USE_ZSTD
+// The decompression speed does not depend on the level, and the records are compressed once.
+constexpr int ZstdLevel = 19;
+
+struct ZstdCCtxDeleter
+{
+    void operator()(ZSTD_CCtx* ctx) const { ZSTD_freeCCtx(ctx); }
+};
+
+struct ZstdDCtxDeleter
+{
+    void operator()(ZSTD_DCtx* ctx) const { ZSTD_freeDCtx(ctx); }
+};
+
+// The contexts are reused, they are large and expensive to set up.
+ZSTD_CCtx* GetZstdCCtx()
+{
+    static thread_local const std::unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> ctx{ZSTD_createCCtx()};
+    return ctx.get();
+}
+
+ZSTD_DCtx* GetZstdDCtx()
+{
+    static thread_local const std::unique_ptr<ZSTD_DCtx, ZstdDCtxDeleter> ctx{ZSTD_createDCtx()};
+    return ctx.get();
+}
+#endif
+
+[[noreturn]] void ThrowNotSupported(KernDbCodec codec)
+{
+    MIOPEN_THROW(miopenStatusNotImplemented,
+                 "Kernel cache codec is not supported by this build: " +
+                     std::string{ToString(codec)});
+}
+
+} // namespace
+
+#if MIOPEN_USE_ZSTD
+struct Dictionary::Impl
+{
+    std::vector<char> content;
+    unsigned id                                            = 0;
+    std::unique_ptr<ZSTD_CDict, size_t (*)(ZSTD_CDict*)> c = {nullptr, ZSTD_freeCDict};
+    std::unique_ptr<ZSTD_DDict, size_t (*)(ZSTD_DDict*)> d = {nullptr, ZSTD_freeDDict};
+};
+
+Dictionary::Dictionary(std::vector<char> content_) : impl(std::make_unique<Impl>())
+{
+    impl->content = std::move(content_);
+    impl->id      = ZSTD_getDictID_fromDict(impl->content.data(), impl->content.size());
+    if(impl->id == 0)
+        MIOPEN_THROW(miopenStatusInvalidValue, "Not a zstd dictionary");
+    impl->c.reset(ZSTD_createCDict(impl->content.data(), impl->content.size(), ZstdLevel));
+    impl->d.reset(ZSTD_createDDict(impl->content.data(), impl->content.size()));
+    if(impl->c == nullptr || impl->d == nullptr)
+        MIOPEN_THROW(miopenStatusAllocFailed, "Failed to load a zstd dictionary");
+}
+#else
+struct Dictionary::Impl
+{
+    std::vector<char> content;
+    unsigned id = 0;
+};
+
+Dictionary::Dictionary(std::vector<char> content_) : impl(std::make_unique<Impl>())
+{
+    impl->content = std::move(content_);
+    ThrowNotSupported(KernDbCodec::Zstd);
+}
+#endif
+
+Dictionary::~Dictionary() = default;
+
+unsigned Dictionary::Id() const { return impl->id; }
+
+const std::vector<char>& Dictionary::Content() const { return impl->content; }
+
+bool IsSupported(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::Bz2: return true;
+    case KernDbCodec::Zstd: return MIOPEN_USE_ZSTD;
+    case KernDbCodec::Lz4: return MIOPEN_USE_LZ4;
+    }
+    return false;
+}
+
+std::string_view ToString(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::Bz2: return "bz2";
+    case KernDbCodec::Zstd: return "zstd";
+    case KernDbCodec::Lz4: return "lz4";
+    }
+    return "unknown";
+}
+
+std::optional<KernDbCodec> Parse(std::string_view name)
+{
+    for(const auto codec : {KernDbCodec::Bz2, KernDbCodec::Zstd, KernDbCodec::Lz4})
+    {
+        if(name == ToString(codec))
+            return codec;
+    }
+    return std::nullopt;
+}
+
+KernDbCodec GetDefault(bool is_system)
+{
+    const auto& name = env::value(MIOPEN_KERN_DB_CODEC);
+    if(!name.empty())
+    {
+        const auto codec = Parse(name);
+        if(codec && IsSupported(*codec))
+            return *codec;
+        MIOPEN_LOG_W("Unknown or unsupported kernel cache codec: " << name);
+    }
+
+    const auto preferred = is_system ? KernDbCodec::Zstd : KernDbCodec::Lz4;
+    return IsSupported(preferred) ? preferred : KernDbCodec::Bz2;
+}
+
+std::vector<char> Compress(KernDbCodec codec,
+                           const std::vector<char>& v,
+                           bool* compressed,
+                           const Dictionary* dictionary)
+{
+    auto result = std::vector<char>{};
+
+    switch(codec)
+    {
+    case KernDbCodec::Bz2: return compress(v, compressed);
+    case KernDbCodec::Zstd: {
+#if MIOPEN_USE_ZSTD
+        result.resize(ZSTD_compressBound(v.size()));
+        const auto size =
+            dictionary != nullptr
+                ? ZSTD_compress_usingCDict(GetZstdCCtx(),
+                                           result.data(),
+                                           result.size(),
+                                           v.data(),
+                                           v.size(),
+                                           dictionary->GetImpl().c.get())
+                : ZSTD_compressCCtx(
+                      GetZstdCCtx(), result.data(), result.size(), v.data(), v.size(), ZstdLevel);
+        if(ZSTD_isError(size) != 0u)
+            MIOPEN_THROW(std::string{"zstd compression failed: "} + ZSTD_getErrorName(size));
+        result.resize(size);
+        break;
+#else
+        std::ignore = dictionary;
+        ThrowNotSupported(codec);
+#endif
+    }
+    case KernDbCodec::Lz4: {
+#if MIOPEN_USE_LZ4
+        if(v.size() > LZ4_MAX_INPUT_SIZE)
+            MIOPEN_THROW("LZ4 compression failed: the input is too large");
+        result.resize(LZ4_compressBound(static_cast<int>(v.size())));
+        const auto size = LZ4_compress_HC(v.data(),
+                                          result.data(),
+                                          static_cast<int>(v.size()),
+                                          static_cast<int>(result.size()),
+                                          LZ4HC_CLEVEL_DEFAULT);
+        if(size <= 0)
+            MIOPEN_THROW("LZ4 compression failed");
+        result.resize(size);
+        break;
+#else
+        ThrowNotSupported(codec);
+#endif
+    }
+    default: ThrowNotSupported(codec);
+    }
+
+    if(v.empty() || result.size() >= v.size())
+    {
+        if(compressed == nullptr)
+            MIOPEN_THROW(std::string{ToString(codec)} + " compression does not reduce the size");
+        *compressed = false;
+        return v;
+    }
+    if(compressed != nullptr)
+        *compressed = true;
+    return result;
+}
+
+std::vector<char> Decompress(KernDbCodec codec,
+                             const std::vector<char>& v,
+                             std::size_t size,
+                             const Dictionary* dictionary)
+{
+    if(codec == KernDbCodec::Bz2)
+        return decompress(v, static_cast<unsigned int>(size));
+
+    auto result = std::vector<char>(size);
+
+    switch(codec)
+    {
+    case KernDbCodec::Zstd: {
+#if MIOPEN_USE_ZSTD
+        const auto id = GetDictionaryId(v);
+        if(id != 0 && (dictionary == nullptr || dictionary->Id() != id))
+            MIOPEN_THROW("zstd decompression failed: missing dictionary " + std::to_string(id));
+        const auto decompressed =
+            id != 0 ? ZSTD_decompress_usingDDict(GetZstdDCtx(),
+                                                 result.data(),
+                                                 result.size(),
+                                                 v.data(),
+                                                 v.size(),
+                                                 dictionary->GetImpl().d.get())
+                    : ZSTD_decompressDCtx(
+                          GetZstdDCtx(), result.data(), result.size(), v.data(), v.size());
+        if(ZSTD_isError(decompressed) != 0u)
+        {
+            MIOPEN_THROW(std::string{"zstd decompression failed: "} +
+                         ZSTD_getErrorName(decompressed));
+        }
+        if(decompressed != size)
+            MIOPEN_THROW("zstd decompression failed: unexpected size");
+        return result;
+#else
+        std::ignore = dictionary;
+        ThrowNotSupported(codec);
+#endif
+    }
+    case KernDbCodec::Lz4: {
+#if MIOPEN_USE_LZ4
+        if(v.size() > LZ4_MAX_INPUT_SIZE || size > LZ4_MAX_INPUT_SIZE)
+            MIOPEN_THROW("LZ4 decompression failed: the data is too large");
+        const auto decompressed = LZ4_decompress_safe(v.data(),
+                                                      result.data(),
+                                                      static_cast<int>(v.size()),
+                                                      static_cast<int>(result.size()));
+        if(decompressed < 0 || static_cast<std::size_t>(decompressed) != size)
+            MIOPEN_THROW("LZ4 decompression failed");
+        return result;
+#else
+        ThrowNotSupported(codec);
+#endif
+    }
+    default: ThrowNotSupported(codec);
+    }
+}
+
+unsigned GetDictionaryId(const std::vector<char>& v)
+{
+#if MIOPEN_USE_ZSTD
+    return ZSTD_getDictID_fromFrame(v.data(), v.size());
+#else
+    std::ignore = v;
+    return 0;
+#endif
+}
+
+std::vector<char> TrainDictionary(const std::vector<std::vector<char>>& samples,
+                                  std::size_t max_size)
+{
+#if MIOPEN_USE_ZSTD
+    auto data  = std::vector<char>{};
+    auto sizes = std::vector<size_t>{};
+    data.reserve(std::accumulate(
+        samples.begin(), samples.end(), std::size_t{0}, [](auto sum, const auto& sample) {
+            return sum + sample.size();
+        }));
+    for(const auto& sample : samples)
+    {
+        data.insert(data.end(), sample.begin(), sample.end());
+        sizes.push_back(sample.size());
+    }
+
+    auto dictionary = std::vector<char>(max_size);
+    const auto size = ZDICT_trainFromBuffer(
+        dictionary.data(), dictionary.size(), data.data(), sizes.data(), sizes.size());
+    if(ZDICT_isError(size) != 0u)
+    {
+        MIOPEN_LOG_I("Kernel cache dictionary not trained: " << ZDICT_getErrorName(size));
+        return {};
+    }
+    dictionary.resize(size);
+    return dictionary;
+#else
+    std::ignore = samples;
+    std::ignore = max_size;
+    ThrowNotSupported(KernDbCodec::Zstd);
+#endif
+}
+
+} // namespace kern_db_codec
+} // namespace miopen
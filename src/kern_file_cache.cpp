@@ -0,0 +1,437 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kern_file_cache.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/hash128.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <shared_mutex>
+#include <sstream>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#define MIOPEN_VALIDATE_LOCK(lock)                                 \
+    do                                                             \
+    {                                                              \
+        if(!(lock))                                                \
+            MIOPEN_THROW("Kernel cache lock has failed to lock."); \
+    } while(false)
+
+namespace miopen {
+
+namespace {
+
+constexpr std::string_view HeaderPrefix = "#miopen-kern-cache ";
+constexpr std::string_view TempInfix    = ".tmp-";
+// The temporary files of the crashed writers are removed by the gc after this time.
+constexpr auto TempFileLifetime = std::chrono::hours{1};
+
+std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+
+using exclusive_lock = std::unique_lock<LockFile>;
+using shared_lock    = std::shared_lock<LockFile>;
+
+std::int64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+fs::path GetShardedPath(const fs::path& dir, const std::string& hash)
+{
+    return dir / hash.substr(0, 2) / (hash + object_file_postfix);
+}
+
+fs::path GetTempPath(const fs::path& path)
+{
+    return path + TempInfix + boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%").string();
+}
+
+bool IsTempPath(const fs::path& path)
+{
+    return path.filename().string().find(TempInfix) != std::string::npos;
+}
+
+bool IsStaleTempPath(const fs::path& path)
+{
+    return IsTempPath(path) &&
+           fs::file_time_type::clock::now() - fs::last_write_time(path) > TempFileLifetime;
+}
+
+struct IndexLine
+{
+    std::string key_hash;
+    std::int64_t time         = 0;
+    std::uint64_t added_bytes = 0;
+};
+
+/// Returns the size from the header, calls F for every valid line.
+template <class F>
+std::uint64_t ReadIndex(const fs::path& path, F f)
+{
+    auto file  = std::ifstream{path};
+    auto line  = std::string{};
+    auto bytes = std::uint64_t{0};
+
+    while(std::getline(file, line))
+    {
+        if(line.rfind(HeaderPrefix, 0) == 0)
+        {
+            bytes = std::strtoull(line.c_str() + HeaderPrefix.size(), nullptr, 10);
+            continue;
+        }
+
+        auto entry = IndexLine{};
+        auto ss    = std::istringstream{line};
+        // A line torn by a crashed writer is skipped.
+        if(ss >> entry.key_hash >> entry.time >> entry.added_bytes)
+            f(entry);
+    }
+    return bytes;
+}
+
+} // namespace
+
+KernFileCache::KernFileCache(const fs::path& root_, std::uint64_t max_size_)
+    : root(root_), max_size(max_size_), lock_file(LockFile::Get(LockFilePath(GetIndexPath())))
+{
+    fs::create_directories(root);
+}
+
+fs::path KernFileCache::GetKeyPath(const std::string& key_hash) const
+{
+    return GetShardedPath(root / "keys", key_hash);
+}
+
+fs::path KernFileCache::GetObjectPath(const std::string& object_hash) const
+{
+    return GetShardedPath(root / "objects", object_hash);
+}
+
+fs::path KernFileCache::GetIndexPath() const { return root / "index"; }
+
+fs::path KernFileCache::Find(const std::string& key)
+{
+    const auto key_hash = Hash128(key).ToString();
+    const auto path     = GetKeyPath(key_hash);
+
+    const std::lock_guard<std::mutex> guard{mutex};
+    if(!fs::exists(path))
+        return {};
+
+    {
+        const auto lock = shared_lock(lock_file, GetLockTimeout());
+        MIOPEN_VALIDATE_LOCK(lock);
+        AppendUnsafe(key_hash, 0);
+    }
+
+    // The lookups do not add to the size, so only the index is checked, which is cheaper.
+    GcIfNeededUnsafe(false);
+    return path;
+}
+
+fs::path KernFileCache::Store(const fs::path& binary, const std::string& key)
+{
+    const auto key_path = GetKeyPath(Hash128(key).ToString());
+
+    const std::lock_guard<std::mutex> guard{mutex};
+    {
+        // Keeps the gc from removing the object before it is linked.
+        const auto lock = shared_lock(lock_file, GetLockTimeout());
+        MIOPEN_VALIDATE_LOCK(lock);
+
+        const auto object = GetObjectPath(Hash128(LoadFile(binary)).ToString());
+        const auto size   = fs::file_size(binary);
+        auto added_bytes  = std::uint64_t{0};
+        auto error        = std::error_code{};
+
+        if(fs::exists(object))
+        {
+            fs::remove(binary);
+            MIOPEN_LOG_I2("Deduplicated " << key_path << " with " << object);
+        }
+        else
+        {
+            fs::create_directories(object.parent_path());
+            const auto temp = GetTempPath(object);
+            fs::rename(binary, temp, error);
+            if(error)
+            {
+                // E.g. the binary is on another file system.
+                fs::copy_file(binary, temp);
+                fs::remove(binary);
+            }
+            fs::rename(temp, object);
+            added_bytes += size;
+        }
+
+        if(!fs::equivalent(object, key_path, error))
+        {
+            fs::create_directories(key_path.parent_path());
+            const auto temp = GetTempPath(key_path);
+            fs::create_hard_link(object, temp, error);
+            if(error)
+            {
+                fs::copy_file(object, temp);
+                added_bytes += size;
+            }
+            fs::rename(temp, key_path);
+            // Renaming a link over another link to the same file does nothing.
+            fs::remove(temp, error);
+        }
+
+        AppendUnsafe(key_path.stem().string(), added_bytes);
+    }
+
+    GcIfNeededUnsafe(true);
+    return key_path;
+}
+
+KernFileCacheStats KernFileCache::GetStats()
+{
+    const std::lock_guard<std::mutex> guard{mutex};
+    const auto lock = shared_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    auto stats = KernFileCacheStats{};
+    for(const auto& dir : {root / "objects", root / "keys"})
+    {
+        if(!fs::exists(dir))
+            continue;
+        for(const auto& entry : fs::recursive_directory_iterator(dir))
+        {
+            if(!fs::is_regular_file(entry.path()) || IsTempPath(entry.path()))
+                continue;
+            const auto is_object = dir.filename() == "objects";
+            if(is_object)
+                ++stats.objects;
+            else
+                ++stats.keys;
+            // A key which is not a link to an object holds a binary of its own.
+            if(is_object || fs::hard_link_count(entry.path()) == 1)
+                stats.bytes += fs::file_size(entry.path());
+        }
+    }
+
+    auto error        = std::error_code{};
+    const auto index  = fs::file_size(GetIndexPath(), error);
+    stats.index_bytes = error ? 0 : index;
+    return stats;
+}
+
+KernFileCacheGcResult KernFileCache::Gc(std::uint64_t max_size_)
+{
+    const std::lock_guard<std::mutex> guard{mutex};
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return GcUnsafe(max_size_ != 0 ? max_size_ : max_size);
+}
+
+void KernFileCache::AppendUnsafe(const std::string& key_hash, std::uint64_t added_bytes)
+{
+    const auto line =
+        key_hash + " " + std::to_string(Now()) + " " + std::to_string(added_bytes) + "\n";
+
+    // Unbuffered, so that the line is appended by a single write and the concurrent writers
+    // never interleave inside of it.
+    auto file = std::ofstream{};
+    file.rdbuf()->pubsetbuf(nullptr, 0);
+    file.open(GetIndexPath(), std::ios::binary | std::ios::app);
+    file.write(line.data(), static_cast<std::streamsize>(line.size()));
+    if(!file)
+        MIOPEN_LOG_W("Unable to append to the kernel cache index: " << GetIndexPath());
+}
+
+bool KernFileCache::IsGcNeededUnsafe(bool check_size) const
+{
+    auto error       = std::error_code{};
+    const auto index = fs::file_size(GetIndexPath(), error);
+    if(error)
+        return false;
+    if(index > IndexCompactionThreshold)
+        return true;
+    if(!check_size || max_size == 0)
+        return false;
+
+    auto added       = std::uint64_t{0};
+    const auto bytes = ReadIndex(GetIndexPath(), [&](const auto& line) {
+        added += line.added_bytes;
+    });
+    return bytes + added > max_size;
+}
+
+void KernFileCache::GcIfNeededUnsafe(bool check_size)
+{
+    if(!IsGcNeededUnsafe(check_size))
+        return;
+
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    // Another process may have collected the garbage while this one was waiting.
+    if(!IsGcNeededUnsafe(check_size))
+        return;
+
+    try
+    {
+        GcUnsafe(max_size);
+    }
+    catch(const fs::filesystem_error& ex)
+    {
+        MIOPEN_LOG_W("Kernel cache gc has failed: " << ex.what());
+    }
+}
+
+KernFileCacheGcResult KernFileCache::GcUnsafe(std::uint64_t limit)
+{
+    auto result      = KernFileCacheGcResult{};
+    auto last_access = std::unordered_map<std::string, std::int64_t>{};
+    ReadIndex(GetIndexPath(), [&](const auto& line) {
+        auto& time = last_access[line.key_hash];
+        time       = std::max(time, line.time);
+    });
+
+    struct Key
+    {
+        fs::path path;
+        std::int64_t time;
+        std::uint64_t size;
+    };
+
+    auto keys  = std::vector<Key>{};
+    auto bytes = std::uint64_t{0};
+
+    const auto objects_dir = root / "objects";
+    if(fs::exists(objects_dir))
+    {
+        for(const auto& entry : fs::recursive_directory_iterator(objects_dir))
+        {
+            const auto& path = entry.path();
+            if(!fs::is_regular_file(path))
+                continue;
+            if(IsTempPath(path))
+            {
+                if(IsStaleTempPath(path))
+                    fs::remove(path);
+                continue;
+            }
+
+            const auto size = fs::file_size(path);
+            if(fs::hard_link_count(path) == 1)
+            {
+                fs::remove(path);
+                ++result.removed_objects;
+                result.freed_bytes += size;
+                continue;
+            }
+            bytes += size;
+        }
+    }
+
+    const auto keys_dir = root / "keys";
+    if(fs::exists(keys_dir))
+    {
+        for(const auto& entry : fs::recursive_directory_iterator(keys_dir))
+        {
+            const auto& path = entry.path();
+            if(!fs::is_regular_file(path))
+                continue;
+            if(IsTempPath(path))
+            {
+                if(IsStaleTempPath(path))
+                    fs::remove(path);
+                continue;
+            }
+
+            // The keys missing from the index are evicted first.
+            const auto access = last_access.find(path.stem().string());
+            const auto time   = access != last_access.end() ? access->second : 0;
+            const auto size   = fs::file_size(path);
+            if(fs::hard_link_count(path) == 1)
+                bytes += size;
+            keys.push_back({path, time, size});
+        }
+    }
+
+    std::sort(keys.begin(), keys.end(), [](const auto& l, const auto& r) {
+        return l.time < r.time;
+    });
+
+    // Evicts below the limit, so that the next gc does not follow the next store.
+    const auto target = limit != 0 && bytes > limit ? limit - limit / 10 : bytes;
+    auto evicted      = keys.begin();
+    for(; bytes > target && evicted != keys.end(); ++evicted)
+    {
+        const auto links  = fs::hard_link_count(evicted->path);
+        const auto object =
+            links > 1 ? GetObjectPath(Hash128(LoadFile(evicted->path)).ToString()) : fs::path{};
+        fs::remove(evicted->path);
+        ++result.evicted_keys;
+
+        if(links == 1)
+        {
+            bytes -= evicted->size;
+            result.freed_bytes += evicted->size;
+        }
+        else if(fs::exists(object) && fs::hard_link_count(object) == 1)
+        {
+            fs::remove(object);
+            ++result.removed_objects;
+            bytes -= evicted->size;
+            result.freed_bytes += evicted->size;
+        }
+    }
+
+    // The index is replaced by one line per key, not to lose the access times of the rest.
+    const auto temp = GetTempPath(GetIndexPath());
+    {
+        auto file = std::ofstream{temp};
+        file << HeaderPrefix << bytes << "\n";
+        for(auto key = evicted; key != keys.end(); ++key)
+            file << key->path.stem().string() << " " << key->time << " 0\n";
+        if(!file)
+            MIOPEN_THROW("Unable to write the kernel cache index: " + temp.string());
+    }
+    fs::rename(temp, GetIndexPath());
+
+    MIOPEN_LOG_I2("Kernel cache gc: evicted " << result.evicted_keys << " keys, removed "
+                                              << result.removed_objects << " objects, freed "
+                                              << result.freed_bytes << " bytes, "
+                                              << bytes << " bytes left");
+    return result;
+}
+
+} // namespace miopen
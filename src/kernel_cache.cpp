@@ -42,6 +42,7 @@
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
+#include <miopen/kernel_manifest.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/stringutils.hpp>
 
@@ -128,6 +129,9 @@ Kernel KernelCache::AddKernel(const Handle& h,
         {
             auto program = h.LoadProgram(program_name, params, kernel_src, program_out != nullptr);
 
+            // The programs built from a source given at run time can not be replayed.
+            if(kernel_src.empty())
+                kernel_manifest::RecordProgram(program_name, params);
             program_map[std::make_pair(program_name, params)] = program;
             return program;
         }
@@ -0,0 +1,329 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel_manifest.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/expanduser.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/stringutils.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_KERNEL_MANIFEST)
+
+namespace miopen {
+namespace kernel_manifest {
+
+namespace {
+
+constexpr const char* Header      = "# MIOpen kernel manifest";
+constexpr const char* InvokerTag  = "@invoker";
+constexpr const char* FindTag     = "@find";
+constexpr auto LockTimeout        = std::chrono::seconds{60};
+
+// The fields can not hold the separators. None of the recorded strings have those in practice.
+bool IsWritable(const std::string& field)
+{
+    return field.find_first_of("\t\n\r") == std::string::npos;
+}
+
+class Recorder
+{
+public:
+    explicit Recorder(fs::path path_)
+        : path(std::move(path_)),
+          // Created first to be destroyed after the recorder, which uses it at exit.
+          lock_file(LockFile::Get(LockFilePath(path)))
+    {
+    }
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    ~Recorder()
+    {
+        // Runs at exit, when the logging may be unavailable already.
+        try
+        {
+            const auto lock = std::unique_lock<LockFile>(lock_file, LockTimeout);
+            if(!lock)
+                return;
+            auto merged = GetRecorded();
+            if(fs::exists(path))
+                merged.Merge(Read(path));
+            Write(path, merged);
+        }
+        catch(...) // NOLINT (bugprone-empty-catch)
+        {
+        }
+    }
+
+    template <class F>
+    void Update(F f)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        f(manifest);
+    }
+
+    Manifest GetRecorded()
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        return manifest;
+    }
+
+private:
+    fs::path path;
+    LockFile& lock_file;
+    std::mutex mutex;
+    Manifest manifest;
+};
+
+Recorder* GetRecorder()
+{
+    // Constructed on the first use and destroyed, thus written, at the exit of the process.
+    static auto recorder = [] {
+        const auto& path = env::value(MIOPEN_KERNEL_MANIFEST);
+        return path.empty() ? std::unique_ptr<Recorder>{}
+                            : std::make_unique<Recorder>(ExpandUser(path));
+    }();
+    return recorder.get();
+}
+
+} // namespace
+
+void Manifest::Merge(const Manifest& other)
+{
+    programs.insert(other.programs.begin(), other.programs.end());
+    invokers.insert(other.invokers.begin(), other.invokers.end());
+    // The records of this manifest are the more recent ones.
+    find_records.insert(other.find_records.begin(), other.find_records.end());
+}
+
+bool IsRecording() { return GetRecorder() != nullptr; }
+
+void RecordProgram(const fs::path& program, const std::string& options)
+{
+    auto* const recorder = GetRecorder();
+    if(recorder == nullptr)
+        return;
+    recorder->Update([&](auto& manifest) { manifest.programs.emplace(program, options); });
+}
+
+void RecordInvoker(const std::string& network_config, const std::string& solver_id)
+{
+    auto* const recorder = GetRecorder();
+    if(recorder == nullptr)
+        return;
+    recorder->Update([&](auto& manifest) { manifest.invokers.emplace(network_config, solver_id); });
+}
+
+void RecordFindRecord(const std::string& db_suffix,
+                      const std::string& key,
+                      const std::string& contents)
+{
+    auto* const recorder = GetRecorder();
+    if(recorder == nullptr)
+        return;
+    recorder->Update(
+        [&](auto& manifest) { manifest.find_records[std::make_pair(db_suffix, key)] = contents; });
+}
+
+Manifest GetRecorded()
+{
+    auto* const recorder = GetRecorder();
+    return recorder != nullptr ? recorder->GetRecorded() : Manifest{};
+}
+
+Manifest Read(std::istream& stream, const std::string& name)
+{
+    auto manifest = Manifest{};
+    auto line     = std::string{};
+    for(auto line_num = 1; std::getline(stream, line); ++line_num)
+    {
+        if(line.empty() || line.front() == '#')
+            continue;
+
+        const auto fields  = SplitDelim(line, '\t');
+        const auto invalid = [&]() {
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Invalid kernel manifest entry at " + name + ":" +
+                             std::to_string(line_num));
+        };
+
+        if(fields.front() == InvokerTag)
+        {
+            if(fields.size() != 3)
+                invalid();
+            manifest.invokers.emplace(fields[1], fields[2]);
+        }
+        else if(fields.front() == FindTag)
+        {
+            if(fields.size() != 4)
+                invalid();
+            manifest.find_records[std::make_pair(fields[1], fields[2])] = fields[3];
+        }
+        else
+        {
+            // SplitDelim drops the empty trailing field of a program without options.
+            const auto tab = line.find('\t');
+            if(tab == std::string::npos || tab == 0 || line.front() == '@')
+                invalid();
+            manifest.programs.emplace(line.substr(0, tab), line.substr(tab + 1));
+        }
+    }
+    return manifest;
+}
+
+Manifest Read(const fs::path& path)
+{
+    std::ifstream file{path};
+    if(!file)
+        MIOPEN_THROW(miopenStatusBadParm, "Unable to open the kernel manifest: " + path.string());
+    return Read(file, path.string());
+}
+
+void Write(std::ostream& stream, const Manifest& manifest)
+{
+    stream << Header << '\n';
+    for(const auto& [program, options] : manifest.programs)
+    {
+        if(IsWritable(program.string()) && IsWritable(options))
+            stream << program.string() << '\t' << options << '\n';
+    }
+    for(const auto& [network_config, solver_id] : manifest.invokers)
+    {
+        if(IsWritable(network_config) && IsWritable(solver_id))
+            stream << InvokerTag << '\t' << network_config << '\t' << solver_id << '\n';
+    }
+    for(const auto& [db_key, contents] : manifest.find_records)
+    {
+        if(IsWritable(db_key.first) && IsWritable(db_key.second) && IsWritable(contents))
+        {
+            stream << FindTag << '\t' << db_key.first << '\t' << db_key.second << '\t' << contents
+                   << '\n';
+        }
+    }
+}
+
+void Write(const fs::path& path, const Manifest& manifest)
+{
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream file{temp_path};
+        if(!file)
+        {
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "Unable to write the kernel manifest: " + temp_path.string());
+        }
+        Write(file, manifest);
+    }
+    fs::rename(temp_path, path);
+}
+
+ReplayResult Replay(Handle& handle, const Manifest& manifest, std::size_t jobs)
+{
+    auto result = ReplayResult{};
+
+    const auto programs =
+        std::vector<ProgramKey>(manifest.programs.begin(), manifest.programs.end());
+    std::atomic<std::size_t> compiled{0};
+    std::atomic<std::size_t> failed{0};
+    // clang-format off
+    par_for_strided(programs.size(),
+                    max_threads{jobs},
+                    [&](auto i) {
+                        const auto& [name, options] = programs[i];
+                        try
+                        {
+                            std::ignore = handle.LoadProgram(name, options, "");
+                            ++compiled;
+                        }
+                        catch(const Exception& ex)
+                        {
+                            MIOPEN_LOG_E("Unable to build " << name << " " << options << ": "
+                                                             << ex.what());
+                            ++failed;
+                        }
+                    });
+    // clang-format on
+    result.programs = compiled;
+    result.failures = failed;
+
+#if !MIOPEN_DISABLE_USERDB
+    // The records are sorted by the db suffix, so each db is opened once.
+    auto db        = std::optional<DbTimer<UserFindDb>>{};
+    auto db_suffix = std::optional<std::string>{};
+    for(const auto& [db_key, contents] : manifest.find_records)
+    {
+        const auto& [suffix, key] = db_key;
+        if(db_suffix != suffix)
+        {
+            db.emplace(DbKinds::FindDb, FindDbRecord::GetUserPath(handle, suffix), false);
+            db_suffix = suffix;
+        }
+
+        auto record = DbRecord{DbKinds::FindDb, key};
+        for(const auto& item : SplitDelim(contents, ';'))
+        {
+            const auto id_size = item.find(':');
+            auto data          = FindDbData{};
+            if(id_size == std::string::npos || !data.Deserialize(item.substr(id_size + 1)))
+            {
+                MIOPEN_LOG_W("Skipping an ill-formed find-db item: " << item << ", key: " << key);
+                continue;
+            }
+            record.SetValues(item.substr(0, id_size), data);
+        }
+
+        if(record.GetSize() != 0 && db->UpdateRecord(record))
+            ++result.find_records;
+        else
+            ++result.failures;
+    }
+#endif
+
+    if(!manifest.invokers.empty())
+        MIOPEN_LOG_I(manifest.invokers.size() << " invokers are not replayable, skipped");
+
+    return result;
+}
+
+} // namespace kernel_manifest
+} // namespace miopen
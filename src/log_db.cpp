@@ -0,0 +1,553 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/log_db.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/fnv1a.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <miopen/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEBUG_USER_DB_COMPACTION_THRESHOLD, 1024 * 1024)
+
+namespace miopen {
+
+namespace {
+
+constexpr std::string_view HeaderPrefix = "#miopen-log-db ";
+// Op, 16 hex digits of the checksum and a space.
+constexpr std::size_t EntryPrefixSize = 18;
+
+std::string FormatEntry(char op, const std::string& payload)
+{
+    auto ss = std::ostringstream{};
+    ss << op << std::hex << std::setw(16) << std::setfill('0') << Fnv1a64(payload) << ' '
+       << payload << '\n';
+    return ss.str();
+}
+
+std::string SerializePayload(const DbRecord& record, void (DbRecord::*write)(std::ostream&) const)
+{
+    auto ss = std::ostringstream{};
+    (record.*write)(ss);
+    auto payload = ss.str();
+    while(!payload.empty() && payload.back() == '\n')
+        payload.pop_back();
+    return payload;
+}
+
+/// Each LogDb instance is protected by the mutex of its path: the file lock is per process, so
+/// two threads must never hold it via different instances at the same time.
+std::mutex& GetPathMutex(const fs::path& path)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto mutexes = std::map<fs::path, std::unique_ptr<std::mutex>>{};
+    auto& item          = mutexes[path];
+    if(!item)
+        item = std::make_unique<std::mutex>();
+    return *item;
+}
+
+} // namespace
+
+#define MIOPEN_VALIDATE_LOCK(lock)                       \
+    do                                                   \
+    {                                                    \
+        if(!(lock))                                      \
+            MIOPEN_THROW("Db lock has failed to lock."); \
+    } while(false)
+
+static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+
+using exclusive_lock = std::unique_lock<LockFile>;
+using shared_lock    = std::shared_lock<LockFile>;
+
+fs::path LogDb::GetLogFilePath(const fs::path& path) { return path + ".log"; }
+
+LogDb::LogDb(DbKinds db_kind_, const fs::path& path, bool is_system)
+    : PlainTextDb(db_kind_, path, is_system), mutex(GetPathMutex(path))
+{
+}
+
+LogDb& LogDb::GetCached(DbKinds db_kind_, const fs::path& path, bool is_system)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // We don't have to store kind to properly index as different dbs would have different paths
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::map<fs::path, std::unique_ptr<LogDb>>{};
+    const auto it         = instances.find(path);
+
+    if(it != instances.end())
+        return *it->second;
+
+    // The files are read on the first access.
+    return *instances.emplace(path, std::make_unique<LogDb>(db_kind_, path, is_system))
+                .first->second;
+}
+
+boost::optional<DbRecord> LogDb::FindRecord(const std::string& problem)
+{
+    const std::lock_guard<std::mutex> guard{mutex};
+
+    if constexpr(!DisableUserDbFileIO)
+    {
+        const auto lock = shared_lock(GetLockFile(), GetLockTimeout());
+        MIOPEN_VALIDATE_LOCK(lock);
+        RefreshUnsafe();
+    }
+
+    MIOPEN_LOG_I2("Looking for key " << problem << " in cache for file " << GetFileName());
+    const auto it = records.find(problem);
+    if(it == records.end())
+        return boost::none;
+    return it->second;
+}
+
+bool LogDb::StoreRecord(const DbRecord& record)
+{
+    const auto& key = record.GetKey();
+    MIOPEN_LOG_I2("Trying to store record at key " << key << " in file " << GetFileName());
+
+    // An empty record replaces the stored one with nothing, same as in PlainTextDb.
+    if(record.GetSize() == 0)
+        return RemoveRecord(key);
+
+    const std::lock_guard<std::mutex> guard{mutex};
+    if(!Append('S', SerializePayload(record, &DbRecord::WriteContents)))
+        return false;
+    ScheduleCompaction();
+    return true;
+}
+
+bool LogDb::UpdateRecord(DbRecord& record)
+{
+    const auto& key = record.GetKey();
+    MIOPEN_LOG_I2("Trying to update record at key " << key << " in file " << GetFileName());
+
+    const std::lock_guard<std::mutex> guard{mutex};
+    if(record.GetSize() != 0)
+    {
+        if(!Append('U', SerializePayload(record, &DbRecord::WriteContents)))
+            return false;
+    }
+    else if constexpr(!DisableUserDbFileIO)
+    {
+        const auto lock = shared_lock(GetLockFile(), GetLockTimeout());
+        MIOPEN_VALIDATE_LOCK(lock);
+        RefreshUnsafe();
+    }
+
+    // Gives the caller the merged record, as PlainTextDb does.
+    const auto it = records.find(key);
+    if(it != records.end())
+        record = it->second;
+    ScheduleCompaction();
+    return true;
+}
+
+bool LogDb::RemoveRecord(const std::string& key)
+{
+    MIOPEN_LOG_I2("Trying to remove record at key " << key << " from file " << GetFileName());
+
+    const std::lock_guard<std::mutex> guard{mutex};
+    if(!Append('R', key))
+        return false;
+    ScheduleCompaction();
+    return true;
+}
+
+bool LogDb::Remove(const std::string& key, const std::string& id)
+{
+    MIOPEN_LOG_I2("Trying to remove value at key " << key << " and id " << id << " from file "
+                                                   << GetFileName());
+
+    const std::lock_guard<std::mutex> guard{mutex};
+
+    // Checked and appended under the same lock to keep the result consistent with the log.
+    auto lock = shared_lock{};
+    if constexpr(!DisableUserDbFileIO)
+    {
+        lock = shared_lock(GetLockFile(), GetLockTimeout());
+        MIOPEN_VALIDATE_LOCK(lock);
+        RefreshUnsafe();
+    }
+
+    const auto it = records.find(key);
+    auto values   = std::string{};
+    if(it == records.end() || !it->second.GetValues(id, values))
+        return false;
+
+    if(!AppendUnsafe('D', key + "=" + id))
+        return false;
+    ScheduleCompaction();
+    return true;
+}
+
+bool LogDb::Compact()
+{
+    if(DisableUserDbFileIO)
+        return true;
+
+    const std::lock_guard<std::mutex> guard{mutex};
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return CompactUnsafe();
+}
+
+std::uint64_t LogDb::GetLogSize() const
+{
+    const std::lock_guard<std::mutex> guard{mutex};
+    return log_offset;
+}
+
+void LogDb::RefreshUnsafe()
+{
+    const auto log_path = GetLogFilePath(GetFileName());
+    auto file           = std::ifstream{log_path, std::ios::binary};
+
+    auto file_generation = std::uint64_t{0};
+    auto header_size     = std::uint64_t{0};
+    auto file_size       = std::uint64_t{0};
+
+    if(file)
+    {
+        auto line = std::string{};
+        if(std::getline(file, line) && !file.eof() && line.rfind(HeaderPrefix, 0) == 0)
+        {
+            file_generation = std::strtoull(line.c_str() + HeaderPrefix.size(), nullptr, 10);
+            header_size     = line.size() + 1;
+        }
+        file.clear();
+        file.seekg(0, std::ios::end);
+        file_size = static_cast<std::uint64_t>(file.tellg());
+    }
+
+    // The log has been compacted (or removed) since the previous access.
+    if(!loaded || file_generation != generation || file_size < log_offset)
+    {
+        LoadSnapshotUnsafe();
+        generation = file_generation;
+        log_offset = header_size;
+        loaded     = true;
+    }
+
+    if(file_size == log_offset)
+        return;
+
+    file.seekg(static_cast<std::streamoff>(log_offset));
+    const auto data = std::string{std::istreambuf_iterator<char>{file}, {}};
+    auto consumed   = std::size_t{0};
+    ApplyLogUnsafe(data, consumed);
+    log_offset += consumed;
+}
+
+void LogDb::LoadSnapshotUnsafe()
+{
+    records.clear();
+
+    auto file = std::ifstream{GetFileName()};
+    if(!file)
+    {
+        const auto log_level = IsWarningIfUnreadable() ? LoggingLevel::Warning : LoggingLevel::Info;
+        MIOPEN_LOG(log_level, "File is unreadable: " << GetFileName());
+        return;
+    }
+
+    auto line   = std::string{};
+    auto n_line = 0;
+
+    while(std::getline(file, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << GetFileName() << "#" << n_line);
+            continue;
+        }
+
+        auto record = DbRecord{line.substr(0, key_size)};
+        if(!record.ParseContents(line.substr(key_size + 1)))
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: " << record.GetKey() << " form file "
+                                                                 << GetFileName() << "#"
+                                                                 << n_line);
+            continue;
+        }
+
+        // The first record wins for duplicate keys, same as in PlainTextDb.
+        records.emplace(record.GetKey(), std::move(record));
+    }
+}
+
+void LogDb::ApplyLogUnsafe(const std::string& data, std::size_t& consumed)
+{
+    auto begin = std::size_t{0};
+
+    // A line without the end of line is being written or has been torn, it is left for later.
+    for(auto end = data.find('\n'); end != std::string::npos; end = data.find('\n', begin))
+    {
+        const auto line        = std::string_view{data}.substr(begin, end - begin);
+        const auto line_offset = log_offset + begin;
+        begin                  = end + 1;
+
+        if(line.empty() || line.front() == '#')
+            continue;
+
+        if(line.size() < EntryPrefixSize || line[EntryPrefixSize - 1] != ' ')
+        {
+            MIOPEN_LOG_E("Ill-formed log entry: " << GetLogFilePath(GetFileName()) << "@"
+                                                  << line_offset);
+            continue;
+        }
+
+        const auto checksum_text = std::string{line.substr(1, EntryPrefixSize - 2)};
+        const auto payload       = std::string{line.substr(EntryPrefixSize)};
+        char* checksum_end       = nullptr;
+        const auto checksum      = std::strtoull(checksum_text.c_str(), &checksum_end, 16);
+
+        if(checksum_end != checksum_text.c_str() + checksum_text.size() ||
+           checksum != Fnv1a64(payload))
+        {
+            MIOPEN_LOG_E("Log entry checksum mismatch: " << GetLogFilePath(GetFileName()) << "@"
+                                                         << line_offset);
+            continue;
+        }
+
+        if(!ApplyEntryUnsafe(line.front(), payload))
+            MIOPEN_LOG_E("Error applying log entry: " << GetLogFilePath(GetFileName()) << "@"
+                                                      << line_offset);
+    }
+
+    consumed = begin;
+}
+
+bool LogDb::ApplyEntryUnsafe(char op, const std::string& payload)
+{
+    const auto separator = payload.find('=');
+    const auto key       = payload.substr(0, separator);
+
+    if(key.empty())
+        return false;
+
+    switch(op)
+    {
+    case 'S':
+    case 'U': {
+        if(separator == std::string::npos)
+            return false;
+        auto record = DbRecord{key};
+        if(!record.ParseContents(payload.substr(separator + 1)))
+            return false;
+        const auto it = records.find(key);
+        if(op == 'U' && it != records.end())
+            record.Merge(it->second);
+        records.insert_or_assign(key, std::move(record));
+        return true;
+    }
+    case 'R': records.erase(key); return true;
+    case 'D': {
+        if(separator == std::string::npos)
+            return false;
+        const auto it = records.find(key);
+        if(it != records.end())
+        {
+            it->second.EraseValues(payload.substr(separator + 1));
+            if(it->second.GetSize() == 0)
+                records.erase(it);
+        }
+        return true;
+    }
+    default: return false;
+    }
+}
+
+bool LogDb::Append(char op, const std::string& payload)
+{
+    if constexpr(DisableUserDbFileIO)
+    {
+        ApplyEntryUnsafe(op, payload);
+        return true;
+    }
+
+    const auto lock = shared_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return AppendUnsafe(op, payload);
+}
+
+bool LogDb::AppendUnsafe(char op, const std::string& payload)
+{
+    if constexpr(DisableUserDbFileIO)
+    {
+        ApplyEntryUnsafe(op, payload);
+        return true;
+    }
+
+    const auto log_path = GetLogFilePath(GetFileName());
+    auto entry          = FormatEntry(op, payload);
+
+    // Terminate a line torn by a crashed writer, otherwise it would swallow this entry.
+    {
+        auto file = std::ifstream{log_path, std::ios::binary | std::ios::ate};
+        if(file && file.tellg() > 0)
+        {
+            file.seekg(-1, std::ios::end);
+            if(file.get() != '\n')
+                entry.insert(entry.begin(), '\n');
+        }
+    }
+
+    // Unbuffered, so that the entry is appended by a single write and the concurrent writers
+    // from other processes (holding the shared lock too) never interleave inside of a line.
+    auto file = std::ofstream{};
+    file.rdbuf()->pubsetbuf(nullptr, 0);
+    file.open(log_path, std::ios::binary | std::ios::app);
+    file.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+
+    if(!file)
+    {
+        MIOPEN_LOG_E("Unable to append to the database log: " << log_path);
+        return false;
+    }
+
+    file.close();
+    // Applies this entry in the order it has been appended relative to the other writers.
+    RefreshUnsafe();
+    return true;
+}
+
+bool LogDb::CompactUnsafe()
+{
+    RefreshUnsafe();
+
+    const auto& path    = GetFileName();
+    const auto log_path = GetLogFilePath(path);
+
+    auto sorted = std::vector<const DbRecord*>{};
+    sorted.reserve(records.size());
+    for(const auto& record : records)
+        sorted.push_back(&record.second);
+    std::sort(sorted.begin(), sorted.end(), [](auto l, auto r) {
+        return l->GetKey() < r->GetKey();
+    });
+
+    const auto replace = [](const fs::path& from, const fs::path& to) {
+        auto error = std::error_code{};
+        fs::rename(from, to, error);
+        if(!error)
+            return true;
+        MIOPEN_LOG_E("Unable to replace " << to << ": " << error.message());
+        fs::remove(from, error);
+        return false;
+    };
+
+    // The snapshot goes first: a log which has already been merged can be replayed again.
+    const auto snapshot_tmp = fs::path{path + ".compact"};
+    {
+        auto file = std::ofstream{snapshot_tmp};
+        for(const auto record : sorted)
+            record->WriteContents(file);
+        if(!file)
+        {
+            MIOPEN_LOG_E("Unable to write the database snapshot: " << snapshot_tmp);
+            return false;
+        }
+    }
+    if(!replace(snapshot_tmp, path))
+        return false;
+
+    const auto header  = std::string{HeaderPrefix} + std::to_string(generation + 1) + "\n";
+    const auto log_tmp = fs::path{log_path + ".compact"};
+    {
+        auto file = std::ofstream{log_tmp, std::ios::binary};
+        file << header;
+        if(!file)
+        {
+            MIOPEN_LOG_E("Unable to write the database log: " << log_tmp);
+            return false;
+        }
+    }
+    if(!replace(log_tmp, log_path))
+        return false;
+
+    MIOPEN_LOG_I2("Compacted " << log_path << " into " << path << ", " << records.size()
+                               << " records");
+    // The records in memory are exactly the new snapshot.
+    ++generation;
+    log_offset = header.size();
+    return true;
+}
+
+void LogDb::ScheduleCompaction()
+{
+    if(DisableUserDbFileIO)
+        return;
+    if(log_offset < env::value(MIOPEN_DEBUG_USER_DB_COMPACTION_THRESHOLD))
+        return;
+    if(compaction_pending.exchange(true))
+        return;
+
+    compaction_task.Run([this]() {
+        try
+        {
+            Compact();
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_E("Database compaction has failed: " << ex.what());
+        }
+        compaction_pending = false;
+    });
+}
+
+} // namespace miopen
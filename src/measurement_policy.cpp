@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/measurement_policy.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/generic_search_controls.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <numeric>
+#include <string>
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+/// 97.5% quantiles of Student's t-distribution for 1..30 degrees of freedom.
+constexpr std::array<float, 30> StudentT975 = {
+    12.706f, 4.303f, 3.182f, 2.776f, 2.571f, 2.447f, 2.365f, 2.306f, 2.262f, 2.228f,
+    2.201f,  2.179f, 2.160f, 2.145f, 2.131f, 2.120f, 2.110f, 2.101f, 2.093f, 2.086f,
+    2.080f,  2.074f, 2.069f, 2.064f, 2.060f, 2.056f, 2.052f, 2.048f, 2.045f, 2.042f};
+
+float GetStudentT975(std::size_t degrees)
+{
+    if(degrees == 0)
+        return std::numeric_limits<float>::infinity();
+    if(degrees <= StudentT975.size())
+        return StudentT975[degrees - 1];
+    return 1.96f;
+}
+
+} // namespace
+
+float TimingSamples::Median() const
+{
+    if(values.empty())
+        return 0.0f;
+    auto sorted     = values;
+    const auto half = sorted.size() / 2;
+    std::nth_element(sorted.begin(), sorted.begin() + half, sorted.end());
+    if(sorted.size() % 2 != 0)
+        return sorted[half];
+    const auto upper = sorted[half];
+    const auto lower = *std::max_element(sorted.begin(), sorted.begin() + half);
+    return (lower + upper) / 2;
+}
+
+std::pair<float, float> TimingSamples::ConfidenceInterval() const
+{
+    if(values.empty())
+        return {0.0f, 0.0f};
+    const auto n    = values.size();
+    const auto mean = std::accumulate(values.begin(), values.end(), 0.0f) / n;
+    if(n < 2)
+        return {mean, mean};
+
+    auto sum_sq = 0.0f;
+    for(const auto value : values)
+        sum_sq += (value - mean) * (value - mean);
+    const auto stddev = std::sqrt(sum_sq / (n - 1));
+    const auto half   = GetStudentT975(n - 1) * stddev / std::sqrt(static_cast<float>(n));
+    return {mean - half, mean + half};
+}
+
+MeasurementPolicy MeasurementPolicy::FromEnv()
+{
+    auto policy           = MeasurementPolicy{};
+    policy.samples_max    = std::max<std::size_t>(env::value(MIOPEN_TUNING_SAMPLES_MAX), 1);
+    policy.plateau_window = env::value(MIOPEN_TUNING_PLATEAU_WINDOW);
+
+    const auto threshold = env::value(MIOPEN_TUNING_PLATEAU_THRESHOLD);
+    if(!threshold.empty())
+    {
+        try
+        {
+            policy.plateau_threshold = std::stof(threshold);
+        }
+        catch(const std::exception&)
+        {
+            MIOPEN_LOG_W("Wrong MIOPEN_TUNING_PLATEAU_THRESHOLD, using default.");
+        }
+    }
+    return policy;
+}
+
+bool MeasurementPolicy::NeedMoreSamples(const TimingSamples& samples, float best_score) const
+{
+    const auto n = samples.Size();
+    if(n == 0)
+        return true;
+    if(n >= samples_max)
+        return false;
+    if(n == 1)
+        return samples.Median() < best_score * (1.0f + promising_margin);
+    // Two samples give too wide an interval to reject anything.
+    if(n >= 3 && samples.ConfidenceInterval().first > best_score)
+        return false;
+    return true;
+}
+
+PlateauDetector::PlateauDetector(const MeasurementPolicy& policy)
+    : window(policy.plateau_window), threshold(policy.plateau_threshold)
+{
+}
+
+bool PlateauDetector::Update(float best_score)
+{
+    if(window == 0)
+        return false;
+
+    // Nothing has been measured yet, the failed candidates do not make a plateau.
+    if(!std::isfinite(best_score) || best_score == std::numeric_limits<float>::max())
+        return false;
+
+    // The front is the best score before the last window candidates.
+    history.push_back(best_score);
+    if(history.size() > window + 1)
+        history.pop_front();
+    if(history.size() <= window)
+        return false;
+
+    return best_score > history.front() * (1.0f - threshold);
+}
+
+} // namespace solver
+} // namespace miopen
@@ -54,6 +54,14 @@ miopen::PerformanceDb miopen::GetDb(const miopen::ExecutionContext& ctx)
     return {DbKinds::PerfDb, ctx.GetPerfDbPath(), ctx.GetUserPerfDbPath()};
 }
 
+void miopen::PrefetchPerfDb(const miopen::ExecutionContext& ctx,
+                            const std::vector<miopen::conv::ProblemDescription>& problems)
+{
+    if(ctx.disable_perfdb_access || problems.empty())
+        return;
+    GetDb(ctx).Prefetch(problems);
+}
+
 static auto GetGemmSolvers()
 {
     return miopen::solver::SolverContainer<miopen::solver::conv::GemmFwd1x1_0_1,
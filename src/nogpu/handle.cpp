@@ -228,6 +228,44 @@ Program Handle::LoadProgram(const fs::path& program_name,
     return p;
 }
 
+void Handle::WarmUpPrograms(const std::vector<ProgramKey>& programs) const
+{
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    std::vector<ProgramKey> pending;
+    std::vector<ProgramKey> keys;
+    for(const auto& program : programs)
+    {
+        if(this->HasProgram(program.first, program.second))
+            continue;
+        pending.push_back(program);
+        keys.push_back(program);
+        if(program.first.extension() == ".mlir")
+            keys.back().second += " -mcpu=" + this->GetTargetProperties().Name();
+    }
+
+    auto binaries = miopen::LoadBinaries(GetTargetProperties(), GetMaxComputeUnits(), keys);
+    for(std::size_t i = 0; i < pending.size(); ++i)
+    {
+        if(binaries[i].empty())
+            continue;
+        auto pgmImpl     = std::make_shared<HIPOCProgramImpl>();
+        pgmImpl->program = pending[i].first;
+        pgmImpl->target  = this->GetTargetProperties();
+        pgmImpl->binary  = std::move(binaries[i]);
+        auto p           = HIPOCProgram{};
+        p.impl           = pgmImpl;
+        this->AddProgram(p, pending[i].first, pending[i].second);
+    }
+#else
+    std::ignore = programs;
+#endif
+}
+
+void Handle::WarmUpPrograms(const fs::path& program_list) const
+{
+    this->WarmUpPrograms(miopen::ReadProgramList(program_list));
+}
+
 bool Handle::HasProgram(const fs::path& program_name, const std::string& params) const
 {
     return this->impl->cache.HasProgram(program_name, params);
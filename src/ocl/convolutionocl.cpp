@@ -207,6 +207,35 @@ std::vector<Solution> FindConvolution(const ExecutionContext& ctx,
     return results;
 }
 
+bool IsConvolutionFindCoreExpected(const ExecutionContext& ctx,
+                                   const conv::ProblemDescription& problem)
+{
+    const auto& findMode = problem.GetConv().findMode;
+
+    // Kernels built during the search depend on the measurements, so there is nothing to prepare.
+    if(ctx.do_search || FindEnforce{}.IsSomethingEnforced(ctx) || findMode.IsFast(ctx))
+        return false;
+    // The same conditions FindConvolution() uses to skip FindCore(), except for the immediate
+    // mode fallback, which can't be checked without the immediate mode query itself.
+    if(findMode.IsHybrid(ctx) && !FindDbRecord{ctx.GetStream(), problem}.empty())
+        return false;
+    return UserFindDbRecord{ctx.GetStream(), problem}.empty();
+}
+
+solver::PrecompiledKernels PrecompileConvolution(const ExecutionContext& ctx,
+                                                 const conv::ProblemDescription& problem,
+                                                 const AnyInvokeParams& invoke_ctx)
+{
+    const auto& conv = problem.GetConv();
+
+    auto ctx_copy                       = ctx;
+    ctx_copy.use_dynamic_solutions_only = conv.findMode.IsDynamicHybrid(ctx);
+    const auto params =
+        conv::ConvFindParameters{conv.IsWinograd3x3SupportedAndFast(ctx_copy, problem)};
+
+    return PrecompileFindCore(invoke_ctx, ctx_copy, problem, params, conv::GetConvSolverFinders());
+}
+
 template <class FieldType>
 static inline void FillFindReturnParameters(const std::vector<Solution>& results,
                                             FieldType miopenConvAlgoPerf_t::*field,
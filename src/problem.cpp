@@ -44,14 +44,19 @@
 #include <miopen/handle.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/perf_field.hpp>
+#include <miopen/problem_fingerprint.hpp>
 #include <miopen/solution.hpp>
 #include <miopen/search_options.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/thread_pool.hpp>
 
 #include <nlohmann/json.hpp>
 
 #include <boost/hof/match.hpp>
 
+#include <cstdint>
+#include <cstring>
+
 namespace miopen::debug {
 /// \todo: This should be updated when a separate driver command is implemented
 void LogCmdFindConvolution(const miopen::TensorDescriptor& x,
@@ -1187,4 +1192,199 @@ FusionPlanDescriptor FusedProblem::AsFusionPlan() const
     return plan;
 }
 
+/// Returns the problem FindSolutionsImpl() passes to FindConvolution(), if any. Invalid problems
+/// are left to the regular path, which reports the error.
+static std::optional<conv::ProblemDescription> TryGetConvolution(const ProblemContainer& container)
+{
+    const auto* problem = std::get_if<Problem>(&container.item);
+    if(problem == nullptr)
+        return std::nullopt;
+
+    const auto* conv_desc = std::get_if<ConvolutionDescriptor>(&problem->GetOperatorDescriptor());
+    if(conv_desc == nullptr)
+        return std::nullopt;
+
+    try
+    {
+        return conv_desc->mode == miopenTranspose ? problem->MakeTransposed().AsConvolution()
+                                                  : problem->AsConvolution();
+    }
+    catch(const Exception&)
+    {
+        return std::nullopt;
+    }
+}
+
+/// Convolutions with the same key get the same results from the find. The fingerprint of the
+/// problem only covers what the perf db and the kernels depend on, so the strides and the
+/// values of alpha and beta, which the solutions carry, are added separately.
+static ProblemFingerprint MakeBatchKey(const conv::ProblemDescription& problem)
+{
+    const auto& conv       = problem.GetConv();
+    const auto fingerprint = problem.MakeFingerprint();
+
+    auto builder = FingerprintBuilder{};
+    builder.Add(fingerprint.lo).Add(fingerprint.hi);
+    for(const auto* tensor : {&problem.GetIn(), &problem.GetWeights(), &problem.GetOut()})
+    {
+        const auto& strides = tensor->GetStrides();
+        builder.Add(strides.size());
+        for(const auto stride : strides)
+            builder.Add(stride);
+    }
+    for(const auto* scalar : {&problem.GetAlpha(), &problem.GetBeta()})
+    {
+        const auto value = scalar->GetAsDouble();
+        auto bits        = std::uint64_t{};
+        std::memcpy(&bits, &value, sizeof(bits));
+        builder.Add(bits).Add(scalar->GetType());
+    }
+    builder.Add(conv.mode).Add(conv.findMode.Get());
+    builder.Add(conv.attribute.Get(MIOPEN_CONVOLUTION_ATTRIB_FP16_ALT_IMPL))
+        .Add(conv.attribute.Get(MIOPEN_CONVOLUTION_ATTRIB_DETERMINISTIC))
+        .Add(conv.attribute.fp8rounding_mode.Get());
+    return builder.Get();
+}
+
+/// The solvers don't access the buffers unless they search, which is not the case for the
+/// precompilation, see IsConvolutionFindCoreExpected().
+static AnyInvokeParams MakeDetachedInvokeParams(const conv::ProblemDescription& problem)
+{
+    const auto& fp16alt = problem.GetConv().attribute.gfx90aFp16alt;
+
+    switch(problem.GetDirection())
+    {
+    case conv::Direction::Forward:
+        return conv::DataInvokeParams{
+            {problem.GetIn(), nullptr, problem.GetWeights(), nullptr, problem.GetOut(), nullptr},
+            nullptr,
+            0,
+            fp16alt.GetFwd()};
+    case conv::Direction::BackwardData:
+        return conv::DataInvokeParams{
+            {problem.GetIn(), nullptr, problem.GetWeights(), nullptr, problem.GetOut(), nullptr},
+            nullptr,
+            0,
+            fp16alt.GetBwd()};
+    case conv::Direction::BackwardWeights:
+        return conv::WrWInvokeParams{
+            {problem.GetIn(), nullptr, problem.GetOut(), nullptr, problem.GetWeights(), nullptr},
+            nullptr,
+            0,
+            fp16alt.GetWrW()};
+    }
+    MIOPEN_THROW(miopenStatusNotImplemented);
+}
+
+namespace {
+
+struct ConvPrecompilation
+{
+    solver::PrecompiledKernels kernels;
+    // Declared last to wait for the tasks writing the kernels before they are destroyed.
+    TaskGroup tasks;
+};
+
+} // namespace
+
+std::vector<std::vector<Solution>>
+FindSolutions(Handle& handle,
+              const std::vector<const ProblemContainer*>& problems,
+              const FindOptions& options,
+              std::size_t max_solutions)
+{
+    auto ret = std::vector<std::vector<Solution>>(problems.size());
+
+    // Deduplicate
+    auto convs        = std::vector<std::optional<conv::ProblemDescription>>(problems.size());
+    auto first_of     = std::vector<std::size_t>(problems.size());
+    auto unique_keys  = std::unordered_map<ProblemFingerprint, std::size_t>{};
+    auto unique_convs = std::vector<conv::ProblemDescription>{};
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        convs[i]    = TryGetConvolution(*problems[i]);
+        first_of[i] = convs[i] ? unique_keys.emplace(MakeBatchKey(*convs[i]), i).first->second : i;
+        if(convs[i] && first_of[i] == i)
+            unique_convs.push_back(*convs[i]);
+    }
+
+    MIOPEN_LOG_I("Batched find: " << problems.size() << " problems, " << unique_convs.size()
+                                  << " unique convolutions");
+
+    auto ctx      = ExecutionContext{&handle};
+    ctx.do_search = options.exhaustive_search;
+    PrefetchPerfDb(ctx, unique_convs);
+
+    // Select the convolutions which are going to compile the kernels found by the solvers
+    auto to_precompile = std::vector<std::size_t>{};
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        if(convs[i] && first_of[i] == i && IsConvolutionFindCoreExpected(ctx, *convs[i]))
+            to_precompile.push_back(i);
+    }
+
+    // The compilation doesn't use the program cache of the handle, so it may run in parallel with
+    // the benchmarking. The lookahead is bounded to keep the order of the compilation close to the
+    // order of the benchmarking.
+    auto& pool         = ThreadPool::Global();
+    auto precompiled   = std::vector<std::unique_ptr<ConvPrecompilation>>(problems.size());
+    auto next_to_start = std::size_t{0};
+
+    const auto start_precompilation = [&]() {
+        const auto i   = to_precompile[next_to_start++];
+        precompiled[i] = std::make_unique<ConvPrecompilation>();
+        precompiled[i]->tasks.Run(
+            [&handle, &problem = *convs[i], &kernels = precompiled[i]->kernels]() {
+                auto detached_ctx = ExecutionContext{&handle};
+                problem.SetupFloats(detached_ctx);
+                kernels =
+                    PrecompileConvolution(detached_ctx, problem, MakeDetachedInvokeParams(problem));
+            });
+    };
+
+    while(next_to_start < std::min(to_precompile.size(), pool.Size()))
+        start_precompilation();
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        if(first_of[i] != i)
+            continue;
+
+        if(precompiled[i])
+        {
+            try
+            {
+                precompiled[i]->tasks.Wait();
+                solver::AddPrecompiledKernels(handle, precompiled[i]->kernels);
+            }
+            catch(const std::exception& ex)
+            {
+                // Not fatal: the find compiles the kernels it is missing.
+                MIOPEN_LOG_W("Batched find: precompilation failed: " << ex.what());
+            }
+            precompiled[i].reset();
+
+            if(next_to_start < to_precompile.size())
+                start_precompilation();
+        }
+
+        const auto find = [&](auto&& problem) {
+            return problem.FindSolutions(handle, options, max_solutions);
+        };
+        ret[i] = std::visit(find, problems[i]->item);
+    }
+
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        if(first_of[i] == i)
+            continue;
+        ret[i] = ret[first_of[i]];
+        for(auto& solution : ret[i])
+            solution.SetProblem(*problems[i]);
+    }
+
+    return ret;
+}
+
 } // namespace miopen
@@ -25,10 +25,15 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/readonly_bin_db.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/filesystem.hpp>
 
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
 #if MIOPEN_EMBED_DB
 #include <miopen_data.hpp>
 #endif
@@ -38,6 +43,8 @@
 #include <sstream>
 #include <map>
 
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_DISABLE_BINARY_SYSDB)
+
 namespace miopen {
 
 namespace debug {
@@ -78,6 +85,54 @@ ReadonlyRamDb::GetCached(DbKinds db_kind_, const fs::path& path, bool warn_if_un
     return *instance;
 }
 
+struct ReadonlyRamDb::MappedFile
+{
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+    bin_db::View view;
+};
+
+boost::optional<ReadonlyRamDb::ItemRef> ReadonlyRamDb::FindItem(const std::string& problem) const
+{
+    if(mapped != nullptr)
+    {
+        const auto record = mapped->view.Find(problem);
+        if(record == nullptr)
+            return boost::none;
+        return ItemRef{static_cast<int>(record->line), mapped->view.Value(*record)};
+    }
+
+    const auto it = cache.find(problem);
+    if(it == cache.end())
+        return boost::none;
+    return ItemRef{it->second.line, it->second.content};
+}
+
+const ReadonlyRamDb::CacheMap& ReadonlyRamDb::GetCacheMap() const
+{
+    if(mapped == nullptr)
+        return cache;
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    if(cache.empty())
+    {
+        // Materializing is a debugging/tooling path only, lookups never use the map
+        // while the compiled file is mapped.
+        auto& materialized = const_cast<CacheMap&>(cache);
+        materialized.reserve(mapped->view.Size());
+        for(const auto& record : mapped->view)
+        {
+            materialized.emplace(std::string{mapped->view.Key(record)},
+                                 CacheItem{static_cast<int>(record.line),
+                                           std::string{mapped->view.Value(record)}});
+        }
+    }
+    return cache;
+}
+
 template <class TFunc>
 static auto Measure(const std::string& funcName, TFunc&& func)
 {
@@ -127,6 +182,56 @@ void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream, bool warn_if_unre
     }
 }
 
+bool ReadonlyRamDb::TryMapCompiledDb()
+{
+    if(env::enabled(MIOPEN_DEBUG_DISABLE_BINARY_SYSDB))
+        return false;
+
+    const auto bin_path = fs::path{db_path + bin_db::FileSuffix};
+
+    try
+    {
+        if(!fs::exists(bin_path))
+            return false;
+
+        // The text database is the source of truth. A compiled file which is older than
+        // its source has most likely been left behind by a previous installation.
+        if(fs::exists(db_path) && fs::last_write_time(bin_path) < fs::last_write_time(db_path))
+        {
+            MIOPEN_LOG_W("Compiled database is older than its source, ignored: " << bin_path);
+            return false;
+        }
+
+        auto file = std::make_shared<MappedFile>();
+        file->file =
+            boost::interprocess::file_mapping{bin_path.string().c_str(), boost::interprocess::read_only};
+        file->region =
+            boost::interprocess::mapped_region{file->file, boost::interprocess::read_only};
+        file->view = bin_db::View{static_cast<const char*>(file->region.get_address()),
+                                  file->region.get_size()};
+
+        if(!file->view.IsValid())
+        {
+            MIOPEN_LOG_W("Invalid or incompatible compiled database, ignored: " << bin_path);
+            return false;
+        }
+
+        MIOPEN_LOG_I2("Mapped compiled database: " << bin_path << ", records: "
+                                                   << file->view.Size());
+        mapped = std::move(file);
+        return true;
+    }
+    catch(const fs::filesystem_error& ex)
+    {
+        MIOPEN_LOG_W("Unable to access compiled database " << bin_path << ": " << ex.what());
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to map compiled database " << bin_path << ": " << ex.what());
+    }
+    return false;
+}
+
 void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
 {
     Measure("Prefetch", [this, warn_if_unreadable]() {
@@ -153,6 +258,8 @@ void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
         }
         else
         {
+            if(TryMapCompiledDb())
+                return;
             auto input_stream = std::ifstream{db_path};
             ParseAndLoadDb(input_stream, warn_if_unreadable);
         }
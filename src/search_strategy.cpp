@@ -0,0 +1,331 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_strategy.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/fnv1a.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_TUNING_STRATEGY)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEBUG_TUNING_SEED)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+class RandomSearch final : public SearchStrategy
+{
+public:
+    RandomSearch(std::size_t size, std::size_t budget, std::uint64_t seed) : order(size)
+    {
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), std::mt19937_64{seed});
+        order.resize(std::min(size, budget));
+    }
+
+    std::optional<std::size_t> Next() override
+    {
+        if(issued == order.size())
+            return std::nullopt;
+        return order[issued++];
+    }
+
+    void Report(std::size_t, std::optional<float>) override {}
+
+private:
+    std::vector<std::size_t> order;
+    std::size_t issued = 0;
+};
+
+/// Inverse distance weighted k nearest neighbours regression of the log of the time.
+/// The neighbour lists of the not yet issued candidates are updated with every report, so
+/// both Next() and Report() cost O(candidates) rather than O(candidates * measurements).
+class SurrogateSearch final : public SearchStrategy
+{
+public:
+    SurrogateSearch(std::vector<std::vector<float>> features_,
+                    std::size_t budget_,
+                    std::uint64_t seed)
+        : features(std::move(features_)),
+          budget(std::min(budget_, features.size())),
+          n_explore(std::min(budget, std::max<std::size_t>(MinExplore, budget / 8))),
+          issued(features.size(), false),
+          neighbours(features.size()),
+          rng(seed)
+    {
+        Normalize();
+        explore_order.resize(features.size());
+        std::iota(explore_order.begin(), explore_order.end(), 0);
+        std::shuffle(explore_order.begin(), explore_order.end(), rng);
+    }
+
+    std::optional<std::size_t> Next() override
+    {
+        if(n_issued == budget)
+            return std::nullopt;
+
+        const auto explore = n_issued < n_explore || n_measured == 0 ||
+                             std::uniform_real_distribution<float>{}(rng) < ExploreShare;
+        const auto index   = explore ? NextRandom() : NextPredicted();
+        issued[index]      = true;
+        ++n_issued;
+        return index;
+    }
+
+    void Report(std::size_t index, std::optional<float> time) override
+    {
+        auto value = FailedValue;
+        if(time)
+        {
+            value      = std::log(std::max(*time, MinTime));
+            worst_time = std::max(worst_time, value);
+        }
+        ++n_measured;
+
+        for(std::size_t i = 0; i < features.size(); ++i)
+        {
+            if(issued[i])
+                continue;
+            auto& list = neighbours[i];
+            const Neighbour candidate{Distance(i, index), value};
+            if(list.size < list.items.size())
+            {
+                list.items[list.size++] = candidate;
+                continue;
+            }
+            const auto farthest = std::max_element(
+                list.items.begin(), list.items.end(), [](const auto& l, const auto& r) {
+                    return l.distance < r.distance;
+                });
+            if(candidate.distance < farthest->distance)
+                *farthest = candidate;
+        }
+    }
+
+private:
+    static constexpr std::size_t MinExplore = 8;
+    static constexpr std::size_t K          = 4;
+    static constexpr float ExploreShare     = 0.1f;
+    static constexpr float MinTime          = 1e-6f;
+
+    // Failures are replaced by a value worse than any measured one at prediction time.
+    static constexpr float FailedValue    = std::numeric_limits<float>::quiet_NaN();
+    static constexpr float FailurePenalty = 1.0f;
+
+    struct Neighbour
+    {
+        float distance;
+        float value;
+    };
+
+    struct NeighbourList
+    {
+        std::array<Neighbour, K> items;
+        std::size_t size = 0;
+    };
+
+    std::vector<std::vector<float>> features;
+    std::size_t budget;
+    std::size_t n_explore;
+    std::vector<bool> issued;
+    std::vector<NeighbourList> neighbours;
+    std::vector<std::size_t> explore_order;
+    std::size_t explore_pos = 0;
+    std::size_t n_issued    = 0;
+    std::size_t n_measured  = 0;
+    float worst_time        = std::log(MinTime);
+    std::mt19937_64 rng;
+
+    /// Pads the features to the same length and scales every component to [0, 1].
+    void Normalize()
+    {
+        std::size_t dims = 0;
+        for(const auto& f : features)
+            dims = std::max(dims, f.size());
+
+        for(auto& f : features)
+            f.resize(dims, 0.0f);
+
+        for(std::size_t d = 0; d < dims; ++d)
+        {
+            auto lo = std::numeric_limits<float>::max();
+            auto hi = std::numeric_limits<float>::lowest();
+            for(const auto& f : features)
+            {
+                lo = std::min(lo, f[d]);
+                hi = std::max(hi, f[d]);
+            }
+            const auto scale = hi > lo ? 1.0f / (hi - lo) : 0.0f;
+            for(auto& f : features)
+                f[d] = (f[d] - lo) * scale;
+        }
+    }
+
+    float Distance(std::size_t l, std::size_t r) const
+    {
+        auto sum = 0.0f;
+        for(std::size_t d = 0; d < features[l].size(); ++d)
+        {
+            const auto diff = features[l][d] - features[r][d];
+            sum += diff * diff;
+        }
+        return std::sqrt(sum);
+    }
+
+    std::size_t NextRandom()
+    {
+        while(issued[explore_order[explore_pos]])
+            ++explore_pos;
+        return explore_order[explore_pos++];
+    }
+
+    std::size_t NextPredicted() const
+    {
+        const auto failed = worst_time + FailurePenalty;
+        auto best         = std::numeric_limits<float>::max();
+        auto best_index   = features.size();
+
+        for(std::size_t i = 0; i < features.size(); ++i)
+        {
+            if(issued[i])
+                continue;
+
+            const auto& list = neighbours[i];
+            auto weighted    = 0.0f;
+            auto weights     = 0.0f;
+            for(std::size_t n = 0; n < list.size; ++n)
+            {
+                const auto& item  = list.items[n];
+                const auto weight = 1.0f / (item.distance + 1e-3f);
+                weighted += weight * (std::isnan(item.value) ? failed : item.value);
+                weights += weight;
+            }
+
+            const auto predicted = weights > 0.0f ? weighted / weights : failed;
+            if(best_index == features.size() || predicted < best)
+            {
+                best       = predicted;
+                best_index = i;
+            }
+        }
+
+        return best_index;
+    }
+};
+
+} // namespace
+
+SearchStrategyKind GetSearchStrategyKind()
+{
+    auto str = env::value(MIOPEN_TUNING_STRATEGY);
+    for(auto& c : str)
+        c = tolower(static_cast<unsigned char>(c));
+    if(str.empty() || str == "random")
+        return SearchStrategyKind::Random;
+    if(str == "surrogate")
+        return SearchStrategyKind::Surrogate;
+    MIOPEN_LOG_W("Wrong MIOPEN_TUNING_STRATEGY, using default.");
+    return SearchStrategyKind::Random;
+}
+
+std::uint64_t GetSearchSeed()
+{
+    const auto seed = env::value(MIOPEN_DEBUG_TUNING_SEED);
+    if(seed != 0)
+        return seed;
+    std::random_device rd{};
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+}
+
+std::vector<float> GetSearchFeatures(std::string_view serialized)
+{
+    const auto is_token_char = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '.' || c == '-' ||
+               c == '_';
+    };
+
+    std::vector<float> features;
+    auto pos = std::size_t{0};
+    while(pos < serialized.size())
+    {
+        if(!is_token_char(serialized[pos]))
+        {
+            ++pos;
+            continue;
+        }
+
+        const auto begin = pos;
+        while(pos < serialized.size() && is_token_char(serialized[pos]))
+            ++pos;
+        const auto token = std::string{serialized.substr(begin, pos - begin)};
+
+        char* end          = nullptr;
+        const auto number  = std::strtod(token.c_str(), &end);
+        const auto numeric = end == token.c_str() + token.size() && std::isfinite(number);
+        if(numeric)
+        {
+            // Most tunables are sizes and counts, compare them by magnitude.
+            const auto magnitude = std::log2(1.0 + std::abs(number));
+            features.push_back(static_cast<float>(number < 0 ? -magnitude : magnitude));
+        }
+        else
+        {
+            features.push_back(static_cast<float>(Fnv1a64(token) % 1024) / 1024.0f);
+        }
+    }
+    return features;
+}
+
+std::unique_ptr<SearchStrategy> MakeSearchStrategy(SearchStrategyKind kind,
+                                                   std::vector<std::vector<float>> features,
+                                                   std::size_t budget,
+                                                   std::uint64_t seed)
+{
+    switch(kind)
+    {
+    case SearchStrategyKind::Random:
+        return std::make_unique<RandomSearch>(features.size(), budget, seed);
+    case SearchStrategyKind::Surrogate:
+        return std::make_unique<SurrogateSearch>(std::move(features), budget, seed);
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown search strategy");
+}
+
+} // namespace solver
+} // namespace miopen
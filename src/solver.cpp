@@ -50,6 +50,8 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <ostream>
+#include <set>
+#include <utility>
 
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_ENABLE_DEPRECATED_SOLVERS)
 
@@ -85,6 +87,16 @@ PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels, bool
     return programs;
 }
 
+void AddPrecompiledKernels(const Handle& h, const PrecompiledKernels& precompiled)
+{
+    for(std::size_t i = 0; i < precompiled.programs.size(); i++)
+    {
+        const KernelInfo& k = precompiled.kernels[i];
+        if(!h.HasProgram(k.kernel_file, k.comp_options))
+            h.AddProgram(precompiled.programs[i], k.kernel_file, k.comp_options);
+    }
+}
+
 void PrecompileSolutions(const Handle& h,
                          const std::vector<const ConvSolution*>& sols,
                          bool force_attach_binary)
@@ -114,6 +126,26 @@ void PrecompileSolutions(const Handle& h,
     }
 }
 
+PrecompiledKernels PrecompileSolutionsDetached(const Handle& h,
+                                               const std::vector<const ConvSolution*>& sols)
+{
+    auto ret  = PrecompiledKernels{};
+    auto seen = std::set<std::pair<fs::path, std::string>>{};
+    for(auto&& sol : sols)
+    {
+        if(!sol->Succeeded())
+            continue;
+        for(auto&& kernel : sol->construction_params)
+        {
+            if(seen.emplace(kernel.kernel_file, kernel.comp_options).second)
+                ret.kernels.push_back(kernel);
+        }
+    }
+
+    ret.programs = PrecompileKernels(h, ret.kernels);
+    return ret;
+}
+
 std::ostream& operator<<(std::ostream& os, const ConvSolution& s)
 {
     auto strings =
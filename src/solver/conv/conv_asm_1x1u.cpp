@@ -416,7 +416,7 @@ bool PerformanceConfigConvAsm1x1U::RunParameterPredictionModel(const ExecutionCo
     static const std::string solver = "ConvAsm1x1U";
     std::vector<float> features     = TransformFeatures(problem, n);
     if(ai::tuning::ModelSetParams(
-           arch, solver, problem.GetDirection(), features, true, [&](int idx, std::string value) {
+           arch, solver, problem.GetDirection(), features, [&](int idx, std::string value) {
                return this->ModelApplyToken(idx, value, problem);
            }))
     {
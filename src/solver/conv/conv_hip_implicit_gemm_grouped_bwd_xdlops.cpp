@@ -311,7 +311,7 @@ bool PerformanceConfigHipImplicitGemmGroupBwdXdlops::RunParameterPredictionModel
     static const std::string solver = "ConvHipIgemmGroupXdlops";
     std::vector<float> features     = GetFeatures(problem);
     if(ai::tuning::ModelSetParams(
-           arch, solver, problem.GetDirection(), features, true, [&](int idx, std::string value) {
+           arch, solver, problem.GetDirection(), features, [&](int idx, std::string value) {
                return this->ModelApplyToken(idx, value);
            }))
     {
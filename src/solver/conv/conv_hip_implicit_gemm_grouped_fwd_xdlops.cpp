@@ -324,12 +324,10 @@ bool PerformanceConfigHipImplicitGemmGroupFwdXdlops::RunParameterPredictionModel
         InitHeuristicKernelIDs("DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle");
     static const std::string solver = "ConvHipIgemmGroupFwdXdlops";
     std::vector<float> features = GetFeatures(problem, ctx.GetStream().GetMaxComputeUnits(), arch);
-    bool transform              = (arch == "gfx90a") ? false : true;
     if(ai::tuning::ModelSetParams(arch,
                                   solver,
                                   problem.GetDirection(),
                                   features,
-                                  transform,
                                   [&](int idx, const std::string& value) {
                                       return this->ModelApplyToken(idx, value, arch);
                                   }))
@@ -389,7 +389,7 @@ bool PerformanceConfigHipImplicitGemmGroupWrwXdlops::RunParameterPredictionModel
         (arch == "gfx90a") ? "ConvHipIgemmGroupXdlops" : "ConvHipIgemmGroupWrwXdlops";
     std::vector<float> features = GetFeatures(problem, arch);
     if(ai::tuning::ModelSetParams(
-           arch, solver, problem.GetDirection(), features, true, [&](int idx, std::string value) {
+           arch, solver, problem.GetDirection(), features, [&](int idx, std::string value) {
                return this->ModelApplyToken(idx, value, arch, problem);
            }))
     {
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/tmp_dir.hpp>
+#include <miopen/compile_server.hpp>
 #include <miopen/env.hpp>
 #include <miopen/filesystem.hpp>
 #include <miopen/errors.hpp>
@@ -32,6 +33,7 @@
 #include <miopen/process.hpp>
 #include <boost/filesystem/operations.hpp>
 
+#include <atomic>
 #include <thread>
 #include <string_view>
 
@@ -40,6 +42,26 @@ MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_EXIT_STATUS_TEMP_DIR)
 
 namespace miopen {
 
+namespace {
+
+boost::optional<int>
+ExecuteOnServer(std::string_view cmd, std::string_view args, const fs::path& cwd)
+{
+    const auto socket = compile_server::GetSocketPath();
+    if(socket.empty())
+        return boost::none;
+    const auto status = compile_server::Execute(socket, cmd, args, cwd);
+    if(!status)
+    {
+        static std::atomic<bool> warned{false};
+        if(!warned.exchange(true))
+            MIOPEN_LOG_W("No compile server at " << socket << ", building the kernels locally");
+    }
+    return status;
+}
+
+} // namespace
+
 TmpDir::TmpDir(std::string_view prefix) : path{fs::temp_directory_path()}
 {
     std::string p{prefix.empty() ? "" : (prefix[0] == '-' ? "" : "-")};
@@ -56,12 +78,14 @@ int TmpDir::Execute(std::string_view cmd, std::string_view args) const
     {
         MIOPEN_LOG_I2(path);
     }
-    auto status = Process{cmd}(args, path);
+    auto status = ExecuteOnServer(cmd, args, path);
+    if(!status)
+        status = Process{cmd}(args, path);
     if(env::enabled(MIOPEN_DEBUG_EXIT_STATUS_TEMP_DIR))
     {
-        MIOPEN_LOG_I2(status);
+        MIOPEN_LOG_I2(*status);
     }
-    return status;
+    return *status;
 }
 
 TmpDir::~TmpDir()
@@ -36,6 +36,8 @@
 #include <miopen/tensor.hpp>
 #include <utility>
 
+#include "cpu_conv_engine.hpp"
+#include "reference_cache.hpp"
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
 #include <miopen/functional.hpp>
@@ -71,6 +73,54 @@ struct cpu_convolution_acc_type<int8_t, int8_t, float>
     using type = double;
 };
 
+// Runs compute() unless its result is found in the reference cache, see reference_cache.hpp.
+// The element-wise transformations are a part of the key by type only, so the stateful ones
+// bypass the cache.
+template <typename Tacc,
+          typename FX,
+          typename FY,
+          typename Tx,
+          typename Ty,
+          typename Tr,
+          typename Range,
+          typename Compute>
+void cpu_convolution_cached(std::string_view primitive,
+                            const tensor<Tx>& x,
+                            const tensor<Ty>& y,
+                            tensor<Tr>& result,
+                            const Range& pads,
+                            const Range& strides,
+                            const Range& dilations,
+                            std::size_t group_count,
+                            Compute compute)
+{
+    if constexpr(!std::is_empty_v<FX> || !std::is_empty_v<FY>)
+    {
+        compute();
+    }
+    else
+    {
+        reference_cache::Cached(
+            [&] {
+                auto key = reference_cache::Key{primitive};
+                key.Type<Tacc>();
+                key.Type<FX>();
+                key.Type<FY>();
+                key.Problem(cpu_conv::default_accumulation_order())
+                    .Problem(pads)
+                    .Problem(strides)
+                    .Problem(dilations)
+                    .Problem(group_count)
+                    .Input(x)
+                    .Input(y)
+                    .Layout(result);
+                return key;
+            },
+            compute,
+            result);
+    }
+}
+
 template <std::size_t ConvDim,
           typename Tacc,
           typename FI,
@@ -283,7 +333,7 @@ void cpu_convolution_backward_data_impl(tensor<Tin>& in,
                 });
             });
             // TODO: Why do we need a no-lint here ?
-            in(in_n_id, in_c_id, in_spatial_id_pack...) = static_cast<Tout>(acc); // NOLINT
+            in(in_n_id, in_c_id, in_spatial_id_pack...) = static_cast<Tin>(acc); // NOLINT
         });
 }
 
@@ -375,6 +425,151 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
         });
 }
 
+// Fills the problem of the blocked engine (cpu_conv_engine.hpp) from the descriptors.
+// Returns false for the layouts it does not support (vectorized tensors, CHWNc weights),
+// which are computed by the element-wise implementations above.
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+bool make_cpu_conv_problem(const tensor<Tin>& in,
+                           const tensor<Twei>& wei,
+                           const tensor<Tout>& out,
+                           const Range& pads,
+                           const Range& strides,
+                           const Range& dilations,
+                           std::size_t group_count,
+                           cpu_conv::problem<ConvDim>& problem)
+{
+    if(in.desc.GetNumDims() != ConvDim + 2 || wei.desc.GetNumDims() != ConvDim + 2 ||
+       out.desc.GetNumDims() != ConvDim + 2 || in.desc.GetVectorLength() != 1 ||
+       wei.desc.GetVectorLength() != 1 || out.desc.GetVectorLength() != 1 ||
+       wei.desc.GetLayout_str() == "CHWNc" || group_count == 0)
+        return false;
+
+    problem.n      = in.desc.GetLengths()[0];
+    problem.k      = wei.desc.GetLengths()[0];
+    problem.c      = wei.desc.GetLengths()[1];
+    problem.groups = group_count;
+    for(std::size_t i = 0; i < ConvDim; ++i)
+    {
+        problem.in_len[i]    = in.desc.GetLengths()[i + 2];
+        problem.wei_len[i]   = wei.desc.GetLengths()[i + 2];
+        problem.out_len[i]   = out.desc.GetLengths()[i + 2];
+        problem.pads[i]      = pads[i];
+        problem.strides[i]   = strides[i];
+        problem.dilations[i] = dilations[i];
+    }
+    std::copy_n(in.desc.GetStrides().begin(), ConvDim + 2, problem.in_strides.begin());
+    std::copy_n(wei.desc.GetStrides().begin(), ConvDim + 2, problem.wei_strides.begin());
+    std::copy_n(out.desc.GetStrides().begin(), ConvDim + 2, problem.out_strides.begin());
+    return true;
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename FI,
+          typename FW,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_forward_blocked(const tensor<Tin>& in,
+                                     const tensor<Twei>& wei,
+                                     tensor<Tout>& out,
+                                     const Range& pads,
+                                     const Range& strides,
+                                     const Range& dilations,
+                                     std::size_t group_count,
+                                     FI fi,
+                                     FW fw)
+{
+    const auto compute = [&] {
+        cpu_conv::problem<ConvDim> problem;
+        if(make_cpu_conv_problem(in, wei, out, pads, strides, dilations, group_count, problem))
+            cpu_conv::forward<ConvDim, Tacc>(
+                problem, in.data.data(), wei.data.data(), out.data.data(), fi, fw);
+        else
+            cpu_convolution_forward_impl<ConvDim, Tacc>(
+                in, wei, out, pads, strides, dilations, group_count, fi, fw);
+    };
+    cpu_convolution_cached<Tacc, FI, FW>(
+        "cpu_convolution_forward", in, wei, out, pads, strides, dilations, group_count, compute);
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename FW,
+          typename FO,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_data_blocked(tensor<Tin>& in,
+                                           const tensor<Twei>& wei,
+                                           const tensor<Tout>& out,
+                                           const Range& pads,
+                                           const Range& strides,
+                                           const Range& dilations,
+                                           std::size_t group_count,
+                                           FW fw,
+                                           FO fo)
+{
+    const auto compute = [&] {
+        cpu_conv::problem<ConvDim> problem;
+        if(make_cpu_conv_problem(in, wei, out, pads, strides, dilations, group_count, problem))
+            cpu_conv::backward_data<ConvDim, Tacc>(
+                problem, in.data.data(), wei.data.data(), out.data.data(), fw, fo);
+        else
+            cpu_convolution_backward_data_impl<ConvDim, Tacc>(
+                in, wei, out, pads, strides, dilations, group_count, fw, fo);
+    };
+    cpu_convolution_cached<Tacc, FW, FO>("cpu_convolution_backward_data",
+                                         wei,
+                                         out,
+                                         in,
+                                         pads,
+                                         strides,
+                                         dilations,
+                                         group_count,
+                                         compute);
+}
+
+template <std::size_t ConvDim,
+          typename Tacc,
+          typename FI,
+          typename FO,
+          typename Tin,
+          typename Twei,
+          typename Tout,
+          typename Range>
+void cpu_convolution_backward_weight_blocked(const tensor<Tin>& in,
+                                             tensor<Twei>& wei,
+                                             const tensor<Tout>& out,
+                                             const Range& pads,
+                                             const Range& strides,
+                                             const Range& dilations,
+                                             std::size_t group_count,
+                                             FI fi,
+                                             FO fo)
+{
+    const auto compute = [&] {
+        cpu_conv::problem<ConvDim> problem;
+        if(make_cpu_conv_problem(in, wei, out, pads, strides, dilations, group_count, problem))
+            cpu_conv::backward_weight<ConvDim, Tacc>(
+                problem, in.data.data(), wei.data.data(), out.data.data(), fi, fo);
+        else
+            cpu_convolution_backward_weight_impl<ConvDim, Tacc>(
+                in, wei, out, pads, strides, dilations, group_count, fi, fo);
+    };
+    cpu_convolution_cached<Tacc, FI, FO>("cpu_convolution_backward_weight",
+                                         in,
+                                         out,
+                                         wei,
+                                         pads,
+                                         strides,
+                                         dilations,
+                                         group_count,
+                                         compute);
+}
+
 template <typename Tin,
           typename Twei,
           typename Tout,
@@ -396,22 +591,22 @@ void cpu_convolution_forward(std::size_t spatial_dim,
     switch(spatial_dim)
     {
     case 1: {
-        cpu_convolution_forward_impl<1, Tacc>(
+        cpu_convolution_forward_blocked<1, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fi, fw);
         break;
     }
     case 2: {
-        cpu_convolution_forward_impl<2, Tacc>(
+        cpu_convolution_forward_blocked<2, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fi, fw);
         break;
     }
     case 3: {
-        cpu_convolution_forward_impl<3, Tacc>(
+        cpu_convolution_forward_blocked<3, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fi, fw);
         break;
     }
     case 4: {
-        cpu_convolution_forward_impl<4, Tacc>(
+        cpu_convolution_forward_blocked<4, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fi, fw);
         break;
     }
@@ -442,22 +637,22 @@ void cpu_convolution_backward_data(std::size_t spatial_dim,
     switch(spatial_dim)
     {
     case 1: {
-        cpu_convolution_backward_data_impl<1, Tacc>(
+        cpu_convolution_backward_data_blocked<1, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fw, fo);
         break;
     }
     case 2: {
-        cpu_convolution_backward_data_impl<2, Tacc>(
+        cpu_convolution_backward_data_blocked<2, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fw, fo);
         break;
     }
     case 3: {
-        cpu_convolution_backward_data_impl<3, Tacc>(
+        cpu_convolution_backward_data_blocked<3, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fw, fo);
         break;
     }
     case 4: {
-        cpu_convolution_backward_data_impl<4, Tacc>(
+        cpu_convolution_backward_data_blocked<4, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fw, fo);
         break;
     }
@@ -488,22 +683,22 @@ void cpu_convolution_backward_weight(std::size_t spatial_dim,
     switch(spatial_dim)
     {
     case 1: {
-        cpu_convolution_backward_weight_impl<1, Tacc>(
+        cpu_convolution_backward_weight_blocked<1, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fi, fo);
         break;
     }
     case 2: {
-        cpu_convolution_backward_weight_impl<2, Tacc>(
+        cpu_convolution_backward_weight_blocked<2, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fi, fo);
         break;
     }
     case 3: {
-        cpu_convolution_backward_weight_impl<3, Tacc>(
+        cpu_convolution_backward_weight_blocked<3, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fi, fo);
         break;
     }
     case 4: {
-        cpu_convolution_backward_weight_impl<4, Tacc>(
+        cpu_convolution_backward_weight_blocked<4, Tacc>(
             in, wei, out, pads, strides, dilations, group_count, fi, fo);
         break;
     }
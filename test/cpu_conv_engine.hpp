@@ -0,0 +1,570 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_CONV_ENGINE_HPP
+#define GUARD_CPU_CONV_ENGINE_HPP
+
+// Blocked CPU convolution used by cpu_convolution_forward/backward_data/backward_weight.
+//
+// The reference implementations in cpu_conv.hpp compute every element of the result through
+// GetIndex() and nested ford lambdas. This engine works on the raw data with the strides of the
+// descriptors, so any packed or strided layout (NCHW, NHWC, NCDHW, NDHWC, ...) is supported:
+//  - the innermost spatial dimension is processed as a row: a row of the source tensor is
+//    converted to the accumulator type once and reused by all the filter taps and channels of a
+//    block, the taps are applied to whole rows of the result with axpy kernels,
+//  - the rows of the result are distributed over the shared thread pool.
+//
+// Only independent elements of the result are computed together: every element accumulates its
+// products in exactly the same order as the reference, so by default (deterministic order) the
+// result is bitwise identical to it and the existing tolerances hold. The relaxed order
+// (MIOPEN_DEBUG_CPU_CONV_RELAXED_ORDER) allows fused multiply-adds and splits the batch
+// reduction of the backward weights among threads, which changes the rounding of the result.
+
+#include <miopen/env.hpp>
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MIOPEN_CPU_CONV_X86_DISPATCH 1
+#else
+#define MIOPEN_CPU_CONV_X86_DISPATCH 0
+#endif
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_CPU_CONV_RELAXED_ORDER)
+
+namespace cpu_conv {
+
+enum class accumulation_order
+{
+    deterministic, // Same order and rounding as the element-wise reference.
+    relaxed,       // Fused multiply-adds and split reductions are allowed.
+};
+
+inline accumulation_order default_accumulation_order()
+{
+    return miopen::env::enabled(MIOPEN_DEBUG_CPU_CONV_RELAXED_ORDER)
+               ? accumulation_order::relaxed
+               : accumulation_order::deterministic;
+}
+
+/// Lengths and strides are in the NC[D]HW order of the descriptors, regardless of the layout.
+/// The weights are K x C/G x filter, c is the number of input channels per group.
+template <std::size_t ConvDim>
+struct problem
+{
+    std::size_t n      = 0;
+    std::size_t k      = 0;
+    std::size_t c      = 0;
+    std::size_t groups = 1;
+    std::array<std::size_t, ConvDim> in_len{};
+    std::array<std::size_t, ConvDim> wei_len{};
+    std::array<std::size_t, ConvDim> out_len{};
+    std::array<std::ptrdiff_t, ConvDim> pads{};
+    std::array<std::ptrdiff_t, ConvDim> strides{};
+    std::array<std::ptrdiff_t, ConvDim> dilations{};
+    std::array<std::size_t, ConvDim + 2> in_strides{};
+    std::array<std::size_t, ConvDim + 2> wei_strides{};
+    std::array<std::size_t, ConvDim + 2> out_strides{};
+};
+
+namespace detail {
+
+/// Number of output (forward, backward weights) or input (backward data) channels computed
+/// together, which share the converted rows of the source tensor.
+constexpr std::size_t channel_block = 16;
+
+/// y[r * ldy + i * incy] += a[r * inca] * x[i * incx] for r in [0, rows) and i in [0, n).
+/// Every element of y receives a single product, thus the kernel is free to vectorize.
+template <class T>
+[[gnu::always_inline]] inline void axpy_impl(std::size_t rows,
+                                             std::size_t n,
+                                             const T* a,
+                                             std::size_t inca,
+                                             const T* __restrict x,
+                                             std::size_t incx,
+                                             T* __restrict y,
+                                             std::size_t incy,
+                                             std::size_t ldy)
+{
+    for(std::size_t r = 0; r < rows; ++r, a += inca, y += ldy)
+    {
+        const auto scale = *a;
+        if(incx == 1 && incy == 1)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+                y[i] += scale * x[i];
+        }
+        else
+        {
+            for(std::size_t i = 0; i < n; ++i)
+                y[i * incy] += scale * x[i * incx];
+        }
+    }
+}
+
+template <class T>
+using axpy_kernel = void (*)(std::size_t,
+                             std::size_t,
+                             const T*,
+                             std::size_t,
+                             const T*,
+                             std::size_t,
+                             T*,
+                             std::size_t,
+                             std::size_t);
+
+#define MIOPEN_CPU_CONV_AXPY_ARGS                                                          \
+    std::size_t rows, std::size_t n, const T* a, std::size_t inca, const T* x, std::size_t incx, \
+        T* y, std::size_t incy, std::size_t ldy
+
+template <class T>
+inline void axpy_default(MIOPEN_CPU_CONV_AXPY_ARGS)
+{
+    axpy_impl(rows, n, a, inca, x, incx, y, incy, ldy);
+}
+
+#if MIOPEN_CPU_CONV_X86_DISPATCH
+// No FMA: the products are rounded before the additions, as in the reference.
+template <class T>
+__attribute__((target("avx2"))) inline void axpy_avx2(MIOPEN_CPU_CONV_AXPY_ARGS)
+{
+    axpy_impl(rows, n, a, inca, x, incx, y, incy, ldy);
+}
+
+template <class T>
+__attribute__((target("avx2,fma"))) inline void axpy_avx2_fma(MIOPEN_CPU_CONV_AXPY_ARGS)
+{
+    axpy_impl(rows, n, a, inca, x, incx, y, incy, ldy);
+}
+
+template <class T>
+__attribute__((target("avx512f"))) inline void axpy_avx512(MIOPEN_CPU_CONV_AXPY_ARGS)
+{
+    axpy_impl(rows, n, a, inca, x, incx, y, incy, ldy);
+}
+#endif
+
+#undef MIOPEN_CPU_CONV_AXPY_ARGS
+
+template <class T>
+axpy_kernel<T> select_axpy(accumulation_order order)
+{
+#if MIOPEN_CPU_CONV_X86_DISPATCH
+    __builtin_cpu_init();
+    if(order == accumulation_order::relaxed)
+    {
+        if(__builtin_cpu_supports("avx512f"))
+            return &axpy_avx512<T>;
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return &axpy_avx2_fma<T>;
+    }
+    else if(__builtin_cpu_supports("avx2"))
+    {
+        return &axpy_avx2<T>;
+    }
+#else
+    (void)order;
+#endif
+    return &axpy_default<T>;
+}
+
+template <std::size_t L, std::size_t N>
+std::size_t product(const std::array<std::size_t, N>& lens)
+{
+    std::size_t result = 1;
+    for(std::size_t i = 0; i < L; ++i)
+        result *= lens[i];
+    return result;
+}
+
+/// Coordinates of the flat index in the first L dimensions, the last one changing fastest.
+template <std::size_t L, std::size_t N>
+std::array<std::size_t, L> unflatten(std::size_t index, const std::array<std::size_t, N>& lens)
+{
+    std::array<std::size_t, L> ids{};
+    for(std::size_t i = L; i-- > 0;)
+    {
+        ids[i] = index % lens[i];
+        index /= lens[i];
+    }
+    return ids;
+}
+
+/// Range [first, last) of the result positions r such that r * stride + offset is in [0, len).
+inline std::pair<std::size_t, std::size_t>
+valid_range(std::size_t count, std::ptrdiff_t stride, std::ptrdiff_t offset, std::size_t len)
+{
+    const auto l     = static_cast<std::ptrdiff_t>(len);
+    const auto first = offset >= 0 ? 0 : (-offset + stride - 1) / stride;
+    const auto last =
+        l - 1 - offset < 0 ? 0 : std::min<std::ptrdiff_t>(count, (l - 1 - offset) / stride + 1);
+    if(first >= last)
+        return {0, 0};
+    return {static_cast<std::size_t>(first), static_cast<std::size_t>(last)};
+}
+
+inline void run_tasks(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+    miopen::par_for_strided(count, miopen::max_threads{std::thread::hardware_concurrency()}, task);
+}
+
+/// Weights converted to the accumulator type, in the dense K x C/G x filter order.
+template <std::size_t ConvDim, class Tacc, class Twei, class FW>
+std::vector<Tacc> pack_weights(const problem<ConvDim>& p, const Twei* wei, FW& fw)
+{
+    const auto filter = product<ConvDim>(p.wei_len);
+    auto packed       = std::vector<Tacc>(p.k * p.c * filter);
+    run_tasks(p.k * p.c, [&](std::size_t kc) {
+        const auto base = (kc / p.c) * p.wei_strides[0] + (kc % p.c) * p.wei_strides[1];
+        for(std::size_t f = 0; f < filter; ++f)
+        {
+            const auto ids = unflatten<ConvDim>(f, p.wei_len);
+            auto offset    = base;
+            for(std::size_t i = 0; i < ConvDim; ++i)
+                offset += ids[i] * p.wei_strides[i + 2];
+            packed[kc * filter + f] = static_cast<Tacc>(fw(wei[offset]));
+        }
+    });
+    return packed;
+}
+
+} // namespace detail
+
+template <std::size_t ConvDim, class Tacc, class Tin, class Twei, class Tout, class FI, class FW>
+void forward(const problem<ConvDim>& p,
+             const Tin* in,
+             const Twei* wei,
+             Tout* out,
+             FI fi,
+             FW fw,
+             accumulation_order order = default_accumulation_order())
+{
+    using namespace detail;
+    constexpr auto L = ConvDim - 1;
+
+    const auto axpy    = select_axpy<Tacc>(order);
+    const auto packed  = pack_weights<ConvDim, Tacc>(p, wei, fw);
+    const auto wo_len  = p.out_len[L];
+    const auto wi_len  = p.in_len[L];
+    const auto x_len   = p.wei_len[L];
+    const auto filter  = product<ConvDim>(p.wei_len);
+    const auto rows    = product<L>(p.out_len);
+    const auto taps    = product<L>(p.wei_len);
+    const auto k_group = p.k / p.groups;
+    const auto blocks  = (k_group + channel_block - 1) / channel_block;
+
+    run_tasks(p.n * p.groups * blocks * rows, [&](std::size_t task) {
+        const auto row   = task % rows;
+        const auto block = task / rows % blocks;
+        const auto g     = task / rows / blocks % p.groups;
+        const auto n     = task / rows / blocks / p.groups;
+        const auto k0    = g * k_group + block * channel_block;
+        const auto kn    = std::min(channel_block, k_group - block * channel_block);
+        const auto o_ids = unflatten<L>(row, p.out_len);
+
+        auto acc    = std::vector<Tacc>(kn * wo_len, Tacc{0});
+        auto in_row = std::vector<Tacc>(wi_len);
+
+        for(std::size_t c = 0; c < p.c; ++c)
+        {
+            for(std::size_t tap = 0; tap < taps; ++tap)
+            {
+                const auto f_ids = unflatten<L>(tap, p.wei_len);
+                auto offset      = n * p.in_strides[0] + (g * p.c + c) * p.in_strides[1];
+                auto inside      = true;
+                for(std::size_t i = 0; i < L; ++i)
+                {
+                    const auto id = static_cast<std::ptrdiff_t>(o_ids[i]) * p.strides[i] +
+                                    static_cast<std::ptrdiff_t>(f_ids[i]) * p.dilations[i] -
+                                    p.pads[i];
+                    inside = inside && id >= 0 && id < static_cast<std::ptrdiff_t>(p.in_len[i]);
+                    offset += id * p.in_strides[i + 2];
+                }
+                if(!inside)
+                    continue;
+
+                for(std::size_t wi = 0; wi < wi_len; ++wi)
+                    in_row[wi] = static_cast<Tacc>(fi(in[offset + wi * p.in_strides[L + 2]]));
+
+                for(std::size_t x = 0; x < x_len; ++x)
+                {
+                    const auto shift = static_cast<std::ptrdiff_t>(x) * p.dilations[L] - p.pads[L];
+                    const auto range = valid_range(wo_len, p.strides[L], shift, wi_len);
+                    if(range.first == range.second)
+                        continue;
+                    const auto first_wi = range.first * p.strides[L] + shift;
+                    axpy(kn,
+                         range.second - range.first,
+                         &packed[(k0 * p.c + c) * filter + tap * x_len + x],
+                         p.c * filter,
+                         &in_row[first_wi],
+                         p.strides[L],
+                         &acc[range.first],
+                         1,
+                         wo_len);
+                }
+            }
+        }
+
+        auto offset = n * p.out_strides[0];
+        for(std::size_t i = 0; i < L; ++i)
+            offset += o_ids[i] * p.out_strides[i + 2];
+        for(std::size_t kk = 0; kk < kn; ++kk)
+            for(std::size_t wo = 0; wo < wo_len; ++wo)
+                out[offset + (k0 + kk) * p.out_strides[1] + wo * p.out_strides[L + 2]] =
+                    static_cast<Tout>(acc[kk * wo_len + wo]);
+    });
+}
+
+template <std::size_t ConvDim, class Tacc, class Tin, class Twei, class Tout, class FW, class FO>
+void backward_data(const problem<ConvDim>& p,
+                   Tin* in,
+                   const Twei* wei,
+                   const Tout* out,
+                   FW fw,
+                   FO fo,
+                   accumulation_order order = default_accumulation_order())
+{
+    using namespace detail;
+    constexpr auto L = ConvDim - 1;
+
+    const auto axpy    = select_axpy<Tacc>(order);
+    const auto packed  = pack_weights<ConvDim, Tacc>(p, wei, fw);
+    const auto wo_len  = p.out_len[L];
+    const auto wi_len  = p.in_len[L];
+    const auto x_len   = p.wei_len[L];
+    const auto stride  = p.strides[L];
+    const auto filter  = product<ConvDim>(p.wei_len);
+    const auto rows    = product<L>(p.in_len);
+    const auto taps    = product<L>(p.wei_len);
+    const auto k_group = p.k / p.groups;
+    const auto blocks  = (p.c + channel_block - 1) / channel_block;
+
+    run_tasks(p.n * p.groups * blocks * rows, [&](std::size_t task) {
+        const auto row   = task % rows;
+        const auto block = task / rows % blocks;
+        const auto g     = task / rows / blocks % p.groups;
+        const auto n     = task / rows / blocks / p.groups;
+        const auto c0    = block * channel_block;
+        const auto cn    = std::min(channel_block, p.c - c0);
+        const auto i_ids = unflatten<L>(row, p.in_len);
+
+        auto acc     = std::vector<Tacc>(cn * wi_len, Tacc{0});
+        auto out_row = std::vector<Tacc>(wo_len);
+
+        for(std::size_t kk = 0; kk < k_group; ++kk)
+        {
+            const auto k = g * k_group + kk;
+            for(std::size_t tap = 0; tap < taps; ++tap)
+            {
+                const auto f_ids = unflatten<L>(tap, p.wei_len);
+                auto offset      = n * p.out_strides[0] + k * p.out_strides[1];
+                auto use         = true;
+                for(std::size_t i = 0; i < L; ++i)
+                {
+                    const auto id = p.pads[i] + static_cast<std::ptrdiff_t>(i_ids[i]) -
+                                    static_cast<std::ptrdiff_t>(f_ids[i]) * p.dilations[i];
+                    use = use && id % p.strides[i] == 0 && id >= 0 &&
+                          id / p.strides[i] < static_cast<std::ptrdiff_t>(p.out_len[i]);
+                    offset += id / p.strides[i] * p.out_strides[i + 2];
+                }
+                if(!use)
+                    continue;
+
+                for(std::size_t wo = 0; wo < wo_len; ++wo)
+                    out_row[wo] = static_cast<Tacc>(fo(out[offset + wo * p.out_strides[L + 2]]));
+
+                for(std::size_t x = 0; x < x_len; ++x)
+                {
+                    // wo * stride == pad + wi - x * dilation
+                    const auto shift = static_cast<std::ptrdiff_t>(x) * p.dilations[L] - p.pads[L];
+                    auto first_wi    = std::max<std::ptrdiff_t>(shift, 0);
+                    first_wi += (stride - (first_wi - shift) % stride) % stride;
+                    if(first_wi >= static_cast<std::ptrdiff_t>(wi_len))
+                        continue;
+                    const auto first_wo = static_cast<std::size_t>((first_wi - shift) / stride);
+                    if(first_wo >= wo_len)
+                        continue;
+                    const auto count = std::min<std::size_t>(
+                        (static_cast<std::ptrdiff_t>(wi_len) - first_wi + stride - 1) / stride,
+                        wo_len - first_wo);
+                    axpy(cn,
+                         count,
+                         &packed[(k * p.c + c0) * filter + tap * x_len + x],
+                         filter,
+                         &out_row[first_wo],
+                         1,
+                         &acc[first_wi],
+                         stride,
+                         wi_len);
+                }
+            }
+        }
+
+        auto offset = n * p.in_strides[0];
+        for(std::size_t i = 0; i < L; ++i)
+            offset += i_ids[i] * p.in_strides[i + 2];
+        for(std::size_t cc = 0; cc < cn; ++cc)
+            for(std::size_t wi = 0; wi < wi_len; ++wi)
+                in[offset + (g * p.c + c0 + cc) * p.in_strides[1] + wi * p.in_strides[L + 2]] =
+                    static_cast<Tin>(acc[cc * wi_len + wi]);
+    });
+}
+
+template <std::size_t ConvDim, class Tacc, class Tin, class Twei, class Tout, class FI, class FO>
+void backward_weight(const problem<ConvDim>& p,
+                     const Tin* in,
+                     Twei* wei,
+                     const Tout* out,
+                     FI fi,
+                     FO fo,
+                     accumulation_order order = default_accumulation_order())
+{
+    using namespace detail;
+    constexpr auto L = ConvDim - 1;
+
+    const auto wo_len  = p.out_len[L];
+    const auto wi_len  = p.in_len[L];
+    const auto x_len   = p.wei_len[L];
+    const auto rows    = product<L>(p.out_len);
+    const auto taps    = product<L>(p.wei_len);
+    const auto k_group = p.k / p.groups;
+    const auto blocks  = (k_group + channel_block - 1) / channel_block;
+    const auto tasks   = p.groups * blocks * p.c * taps;
+    const auto block   = x_len * channel_block;
+
+    // In the relaxed order the batch is split among the threads when there are not enough
+    // weights to keep them busy, and the partial sums are added afterwards.
+    auto chunks = std::size_t{1};
+    if(order == accumulation_order::relaxed)
+    {
+        const auto threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        chunks             = std::min(p.n, (4 * threads + tasks - 1) / tasks);
+        chunks             = std::max<std::size_t>(chunks, 1);
+    }
+    const auto chunk_len = (p.n + chunks - 1) / chunks;
+    auto partial         = std::vector<Tacc>(chunks * tasks * block, Tacc{0});
+
+    run_tasks(chunks * tasks, [&](std::size_t index) {
+        const auto task  = index % tasks;
+        const auto chunk = index / tasks;
+        const auto tap   = task % taps;
+        const auto c     = task / taps % p.c;
+        const auto kb    = task / taps / p.c % blocks;
+        const auto g     = task / taps / p.c / blocks;
+        const auto k0    = g * k_group + kb * channel_block;
+        const auto kn    = std::min(channel_block, k_group - kb * channel_block);
+        const auto f_ids = unflatten<L>(tap, p.wei_len);
+
+        auto* const acc = &partial[index * block];
+        auto in_row     = std::vector<Tacc>(wi_len);
+        auto out_rows   = std::vector<Tacc>(wo_len * kn);
+
+        for(auto n = chunk * chunk_len; n < std::min(p.n, (chunk + 1) * chunk_len); ++n)
+        {
+            for(std::size_t row = 0; row < rows; ++row)
+            {
+                const auto o_ids = unflatten<L>(row, p.out_len);
+                auto in_offset   = n * p.in_strides[0] + (g * p.c + c) * p.in_strides[1];
+                auto out_offset  = n * p.out_strides[0];
+                auto inside      = true;
+                for(std::size_t i = 0; i < L; ++i)
+                {
+                    const auto id = static_cast<std::ptrdiff_t>(o_ids[i]) * p.strides[i] +
+                                    static_cast<std::ptrdiff_t>(f_ids[i]) * p.dilations[i] -
+                                    p.pads[i];
+                    inside = inside && id >= 0 && id < static_cast<std::ptrdiff_t>(p.in_len[i]);
+                    in_offset += id * p.in_strides[i + 2];
+                    out_offset += o_ids[i] * p.out_strides[i + 2];
+                }
+                if(!inside)
+                    continue;
+
+                for(std::size_t wi = 0; wi < wi_len; ++wi)
+                    in_row[wi] = static_cast<Tacc>(fi(in[in_offset + wi * p.in_strides[L + 2]]));
+                for(std::size_t wo = 0; wo < wo_len; ++wo)
+                    for(std::size_t kk = 0; kk < kn; ++kk)
+                        out_rows[wo * kn + kk] = static_cast<Tacc>(
+                            fo(out[out_offset + (k0 + kk) * p.out_strides[1] +
+                                   wo * p.out_strides[L + 2]]));
+
+                // The output channels of the block are the independent lanes, the sum over
+                // the output row is kept in order.
+                for(std::size_t wo = 0; wo < wo_len; ++wo)
+                {
+                    for(std::size_t x = 0; x < x_len; ++x)
+                    {
+                        const auto wi = static_cast<std::ptrdiff_t>(wo) * p.strides[L] +
+                                        static_cast<std::ptrdiff_t>(x) * p.dilations[L] -
+                                        p.pads[L];
+                        if(wi < 0 || wi >= static_cast<std::ptrdiff_t>(wi_len))
+                            continue;
+                        const auto a = in_row[wi];
+                        for(std::size_t kk = 0; kk < kn; ++kk)
+                            acc[x * kn + kk] += a * out_rows[wo * kn + kk];
+                    }
+                }
+            }
+        }
+    });
+
+    run_tasks(tasks, [&](std::size_t task) {
+        const auto tap   = task % taps;
+        const auto c     = task / taps % p.c;
+        const auto kb    = task / taps / p.c % blocks;
+        const auto g     = task / taps / p.c / blocks;
+        const auto k0    = g * k_group + kb * channel_block;
+        const auto kn    = std::min(channel_block, k_group - kb * channel_block);
+        const auto f_ids = unflatten<L>(tap, p.wei_len);
+
+        auto offset = c * p.wei_strides[1];
+        for(std::size_t i = 0; i < L; ++i)
+            offset += f_ids[i] * p.wei_strides[i + 2];
+
+        for(std::size_t x = 0; x < x_len; ++x)
+        {
+            for(std::size_t kk = 0; kk < kn; ++kk)
+            {
+                auto sum = partial[task * block + x * kn + kk];
+                for(std::size_t chunk = 1; chunk < chunks; ++chunk)
+                    sum += partial[(chunk * tasks + task) * block + x * kn + kk];
+                wei[offset + (k0 + kk) * p.wei_strides[0] + x * p.wei_strides[L + 2]] =
+                    static_cast<Twei>(sum);
+            }
+        }
+    });
+}
+
+} // namespace cpu_conv
+
+#endif
@@ -0,0 +1,836 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_NORM_HPP
+#define GUARD_CPU_NORM_HPP
+
+// Host references of the normalizations: batch norm (spatial and per activation), group norm,
+// layer norm, the fused add + layer norm and the RMS norm of T5. Used by the tests and by
+// MIOpenDriver, so it works on raw pointers and depends on the public API only.
+//
+// The statistics are gathered in a single pass over the data. A row is split into blocks which
+// stay in the L1 cache: a block is converted to the accumulator type once and reduced to its
+// (count, mean, M2) in independent lanes that the compiler can vectorize, and the blocks are
+// merged with the parallel form of Welford's algorithm (Chan et al.). Compared to the
+// E[x^2] - E[x]^2 form this does not lose the variance of data with a large mean. The per
+// activation batch norm runs the element-wise Welford update along the batch instead, which is
+// vectorized across the contiguous elements of a row.
+//
+// Independent rows, channels and batch items are processed on the shared thread pool. The
+// partial results are always merged in the same order, so the results do not depend on the
+// number of threads.
+
+#include <miopen/miopen.h>
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace cpu_norm {
+
+/// Batch norm problem. x, y, dy and dx share the strides. The parameters (scale, bias, their
+/// gradients, the saved and the running statistics) have their own strides: the spatial ones
+/// are ignored in the spatial mode, so 1xCx1x1 and 1xCxDxHxW descriptors both work.
+struct batchnorm_problem
+{
+    miopenBatchNormMode_t mode = miopenBNSpatial;
+    std::size_t n              = 0;
+    std::size_t c              = 0;
+    std::array<std::size_t, 3> spatial{1, 1, 1};  // D, H, W
+    std::array<std::size_t, 5> strides{};         // N, C, D, H, W
+    std::array<std::size_t, 4> param_strides{};   // C, D, H, W
+
+    bool per_activation() const { return mode == miopenBNPerActivation; }
+    std::size_t spatial_size() const { return spatial[0] * spatial[1] * spatial[2]; }
+};
+
+/// Packed NCDHW problem (D is 1 for 2D), as used by MIOpenDriver.
+inline batchnorm_problem make_batchnorm_problem(miopenBatchNormMode_t mode,
+                                                std::size_t n,
+                                                std::size_t c,
+                                                std::size_t d,
+                                                std::size_t h,
+                                                std::size_t w)
+{
+    auto p          = batchnorm_problem{};
+    p.mode          = mode;
+    p.n             = n;
+    p.c             = c;
+    p.spatial       = {d, h, w};
+    p.strides       = {c * d * h * w, d * h * w, h * w, w, 1};
+    p.param_strides = mode == miopenBNPerActivation
+                          ? std::array<std::size_t, 4>{d * h * w, h * w, w, 1}
+                          : std::array<std::size_t, 4>{1, 1, 1, 1};
+    return p;
+}
+
+namespace detail {
+
+/// Independent accumulators of the vectorized reductions.
+constexpr std::size_t lanes = 8;
+/// Elements of a row reduced at once, kept in the L1 cache between the two passes over a block.
+constexpr std::size_t block = 256;
+/// Elements of a row updated together by the per activation batch norm.
+constexpr std::size_t chunk = 64;
+/// Approximate number of elements processed by a task of the thread pool.
+constexpr std::size_t task_elements = std::size_t{1} << 15;
+
+/// Runs f(first, last) over the ranges of [0, count) on the shared thread pool. A range holds
+/// about task_elements / cost items, cost being the number of elements processed per item.
+template <class F>
+void par_ranges(std::size_t count, std::size_t cost, F f)
+{
+    const auto grain = std::max<std::size_t>(1, task_elements / std::max<std::size_t>(cost, 1));
+    const auto tasks = (count + grain - 1) / grain;
+    miopen::par_for_strided(
+        tasks, miopen::max_threads{std::thread::hardware_concurrency()}, [&](std::size_t t) {
+            f(t * grain, std::min(count, (t + 1) * grain));
+        });
+}
+
+/// Sum of f(i) over [0, n) in independent lanes.
+template <class Tacc, class F>
+Tacc lane_sum(std::size_t n, F f)
+{
+    Tacc acc[lanes] = {};
+    std::size_t i   = 0;
+    for(; i + lanes <= n; i += lanes)
+        for(std::size_t l = 0; l < lanes; ++l)
+            acc[l] += f(i + l);
+    for(std::size_t l = 0; i < n; ++i, ++l)
+        acc[l] += f(i);
+
+    auto sum = Tacc{0};
+    for(const auto a : acc)
+        sum += a;
+    return sum;
+}
+
+} // namespace detail
+
+/// Count, mean and sum of the squared deviations of a set of values.
+template <class Tacc>
+struct welford
+{
+    std::size_t count = 0;
+    Tacc mean         = 0;
+    Tacc m2           = 0;
+
+    /// Adds the values of a disjoint set.
+    void merge(const welford& other)
+    {
+        if(other.count == 0)
+            return;
+        const auto total = count + other.count;
+        const auto delta = other.mean - mean;
+        const auto ratio = static_cast<Tacc>(other.count) / static_cast<Tacc>(total);
+        mean += delta * ratio;
+        m2 += other.m2 + delta * delta * static_cast<Tacc>(count) * ratio;
+        count = total;
+    }
+
+    /// Biased (population) variance.
+    Tacc variance() const { return count == 0 ? Tacc{0} : m2 / static_cast<Tacc>(count); }
+};
+
+/// Welford statistics of x together with the sums needed by the batch norm backward pass.
+template <class Tacc>
+struct grad_stats
+{
+    welford<Tacc> x;
+    Tacc dy_sum   = 0;
+    Tacc x_dy_sum = 0; // sum((x - x.mean) * dy)
+
+    void merge(const grad_stats& other)
+    {
+        auto merged = x;
+        merged.merge(other.x);
+        x_dy_sum = centered_x_dy(merged.mean) + other.centered_x_dy(merged.mean);
+        dy_sum += other.dy_sum;
+        x = merged;
+    }
+
+    /// sum((x - mean) * dy) for an arbitrary mean, e.g. the one saved by the forward pass.
+    Tacc centered_x_dy(Tacc mean) const { return x_dy_sum + (x.mean - mean) * dy_sum; }
+};
+
+namespace detail {
+
+/// Statistics of the n values returned by load(i).
+template <class Tacc, class Load>
+welford<Tacc> block_stats(std::size_t n, Load load)
+{
+    auto result = welford<Tacc>{};
+    Tacc values[block];
+    for(std::size_t first = 0; first < n; first += block)
+    {
+        const auto count = std::min(block, n - first);
+        for(std::size_t i = 0; i < count; ++i)
+            values[i] = load(first + i);
+
+        const auto mean = lane_sum<Tacc>(count, [&](auto i) { return values[i]; }) /
+                          static_cast<Tacc>(count);
+        const auto m2 = lane_sum<Tacc>(count, [&](auto i) {
+            const auto d = values[i] - mean;
+            return d * d;
+        });
+        result.merge({count, mean, m2});
+    }
+    return result;
+}
+
+template <class Tacc, class T>
+welford<Tacc> row_stats(const T* x, std::size_t n, std::size_t stride)
+{
+    if(stride == 1)
+        return block_stats<Tacc>(n, [&](auto i) { return static_cast<Tacc>(x[i]); });
+    return block_stats<Tacc>(n, [&](auto i) { return static_cast<Tacc>(x[i * stride]); });
+}
+
+template <class Tacc, class Tx, class Tdy>
+grad_stats<Tacc> row_grad_stats(const Tx* x, const Tdy* dy, std::size_t n, std::size_t stride)
+{
+    auto result = grad_stats<Tacc>{};
+    Tacc xs[block];
+    Tacc dys[block];
+    for(std::size_t first = 0; first < n; first += block)
+    {
+        const auto count = std::min(block, n - first);
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            xs[i]  = static_cast<Tacc>(x[(first + i) * stride]);
+            dys[i] = static_cast<Tacc>(dy[(first + i) * stride]);
+        }
+
+        const auto mean =
+            lane_sum<Tacc>(count, [&](auto i) { return xs[i]; }) / static_cast<Tacc>(count);
+        const auto m2 = lane_sum<Tacc>(count, [&](auto i) {
+            const auto d = xs[i] - mean;
+            return d * d;
+        });
+        const auto dy_sum = lane_sum<Tacc>(count, [&](auto i) { return dys[i]; });
+        const auto x_dy   = lane_sum<Tacc>(count, [&](auto i) { return (xs[i] - mean) * dys[i]; });
+        result.merge({{count, mean, m2}, dy_sum, x_dy});
+    }
+    return result;
+}
+
+/// The spatial dimensions as rows of contiguous (in the sense of the strides) elements. The
+/// dimensions are merged when both the data and the parameters allow it, so a packed tensor is
+/// a single row per (n, c) whatever its layout.
+struct spatial_rows
+{
+    std::size_t count = 1;
+    std::size_t len   = 1;
+    std::size_t h     = 1;
+    std::array<std::size_t, 3> strides{};       // D, H, W
+    std::array<std::size_t, 3> param_strides{}; // D, H, W
+
+    explicit spatial_rows(const batchnorm_problem& p)
+    {
+        auto lens = p.spatial;
+        std::copy_n(p.strides.begin() + 2, 3, strides.begin());
+        if(p.per_activation())
+            std::copy_n(p.param_strides.begin() + 1, 3, param_strides.begin());
+
+        const auto merge = [&](std::size_t outer, std::size_t inner) {
+            if(lens[outer] == 1)
+                return true;
+            if(strides[outer] != lens[inner] * strides[inner] ||
+               param_strides[outer] != lens[inner] * param_strides[inner])
+                return false;
+            lens[inner] *= lens[outer];
+            lens[outer] = 1;
+            return true;
+        };
+        if(merge(1, 2))
+            merge(0, 2);
+        else
+            merge(0, 1);
+
+        h     = lens[1];
+        len   = lens[2];
+        count = lens[0] * lens[1];
+    }
+
+    std::size_t offset(std::size_t row) const
+    {
+        return (row / h) * strides[0] + (row % h) * strides[1];
+    }
+
+    std::size_t param_offset(std::size_t row) const
+    {
+        return (row / h) * param_strides[0] + (row % h) * param_strides[1];
+    }
+};
+
+/// Offset in the parameter tensors of the k-th statistic: a channel in the spatial mode, a
+/// (channel, spatial position) pair in the per activation mode.
+inline std::size_t
+param_offset(const batchnorm_problem& p, const spatial_rows& rows, std::size_t k)
+{
+    if(!p.per_activation())
+        return k * p.param_strides[0];
+    const auto s = k % (rows.count * rows.len);
+    return (k / (rows.count * rows.len)) * p.param_strides[0] +
+           rows.param_offset(s / rows.len) + (s % rows.len) * rows.param_strides[2];
+}
+
+/// Number of values reduced into one statistic.
+inline std::size_t reduction_size(const batchnorm_problem& p)
+{
+    return p.per_activation() ? p.n : p.n * p.spatial_size();
+}
+
+/// Runs f(c, row, first, len) over the chunks of the rows of every channel, for the reductions
+/// along the batch of the per activation mode.
+template <class F>
+void for_each_chunk(const batchnorm_problem& p, const spatial_rows& rows, F f)
+{
+    const auto chunks = (rows.len + chunk - 1) / chunk;
+    par_ranges(p.c * rows.count * chunks, p.n * chunk, [&](std::size_t first, std::size_t last) {
+        for(auto item = first; item < last; ++item)
+        {
+            const auto j   = (item % chunks) * chunk;
+            const auto row = (item / chunks) % rows.count;
+            f(item / chunks / rows.count, row, j, std::min(chunk, rows.len - j));
+        }
+    });
+}
+
+/// Statistics of x for every channel (spatial) or element of a channel (per activation).
+template <class Tacc, class Tx>
+std::vector<welford<Tacc>>
+batchnorm_stats(const batchnorm_problem& p, const spatial_rows& rows, const Tx* x)
+{
+    if(p.per_activation())
+    {
+        auto stats = std::vector<welford<Tacc>>(p.c * rows.count * rows.len);
+        for_each_chunk(p, rows, [&](auto c, auto row, auto j, auto len) {
+            Tacc mean[chunk] = {};
+            Tacc m2[chunk]   = {};
+            const auto ws    = rows.strides[2];
+            for(std::size_t b = 0; b < p.n; ++b)
+            {
+                const auto* src = x + b * p.strides[0] + c * p.strides[1] + rows.offset(row);
+                const auto rk   = Tacc{1} / static_cast<Tacc>(b + 1);
+                for(std::size_t i = 0; i < len; ++i)
+                {
+                    const auto v     = static_cast<Tacc>(src[(j + i) * ws]);
+                    const auto delta = v - mean[i];
+                    mean[i] += delta * rk;
+                    m2[i] += delta * (v - mean[i]);
+                }
+            }
+            auto* dst = &stats[(c * rows.count + row) * rows.len + j];
+            for(std::size_t i = 0; i < len; ++i)
+                dst[i] = {p.n, mean[i], m2[i]};
+        });
+        return stats;
+    }
+
+    auto partial = std::vector<welford<Tacc>>(p.c * p.n);
+    par_ranges(p.c * p.n, p.spatial_size(), [&](std::size_t first, std::size_t last) {
+        for(auto item = first; item < last; ++item)
+        {
+            const auto* src = x + (item % p.n) * p.strides[0] + (item / p.n) * p.strides[1];
+            for(std::size_t row = 0; row < rows.count; ++row)
+                partial[item].merge(
+                    row_stats<Tacc>(src + rows.offset(row), rows.len, rows.strides[2]));
+        }
+    });
+
+    auto stats = std::vector<welford<Tacc>>(p.c);
+    for(std::size_t c = 0; c < p.c; ++c)
+        for(std::size_t b = 0; b < p.n; ++b)
+            stats[c].merge(partial[c * p.n + b]);
+    return stats;
+}
+
+/// Same as batchnorm_stats, with the sums of dy and (x - mean) * dy.
+template <class Tacc, class Tx, class Tdy>
+std::vector<grad_stats<Tacc>> batchnorm_grad_stats(const batchnorm_problem& p,
+                                                   const spatial_rows& rows,
+                                                   const Tx* x,
+                                                   const Tdy* dy)
+{
+    if(p.per_activation())
+    {
+        auto stats = std::vector<grad_stats<Tacc>>(p.c * rows.count * rows.len);
+        for_each_chunk(p, rows, [&](auto c, auto row, auto j, auto len) {
+            Tacc mean[chunk]  = {};
+            Tacc m2[chunk]    = {};
+            Tacc dy_sum[chunk] = {};
+            Tacc x_dy[chunk]  = {};
+            const auto ws     = rows.strides[2];
+            for(std::size_t b = 0; b < p.n; ++b)
+            {
+                const auto offset = b * p.strides[0] + c * p.strides[1] + rows.offset(row);
+                const auto rk     = Tacc{1} / static_cast<Tacc>(b + 1);
+                for(std::size_t i = 0; i < len; ++i)
+                {
+                    const auto v     = static_cast<Tacc>(x[offset + (j + i) * ws]);
+                    const auto g     = static_cast<Tacc>(dy[offset + (j + i) * ws]);
+                    const auto delta = v - mean[i];
+                    const auto shift = delta * rk;
+                    // Moving the mean by shift changes the centered sum by -shift * sum(dy).
+                    mean[i] += shift;
+                    m2[i] += delta * (v - mean[i]);
+                    x_dy[i] += (v - mean[i]) * g - shift * dy_sum[i];
+                    dy_sum[i] += g;
+                }
+            }
+            auto* dst = &stats[(c * rows.count + row) * rows.len + j];
+            for(std::size_t i = 0; i < len; ++i)
+                dst[i] = {{p.n, mean[i], m2[i]}, dy_sum[i], x_dy[i]};
+        });
+        return stats;
+    }
+
+    auto partial = std::vector<grad_stats<Tacc>>(p.c * p.n);
+    par_ranges(p.c * p.n, 2 * p.spatial_size(), [&](std::size_t first, std::size_t last) {
+        for(auto item = first; item < last; ++item)
+        {
+            const auto base = (item % p.n) * p.strides[0] + (item / p.n) * p.strides[1];
+            for(std::size_t row = 0; row < rows.count; ++row)
+            {
+                const auto offset = base + rows.offset(row);
+                partial[item].merge(row_grad_stats<Tacc>(
+                    x + offset, dy + offset, rows.len, rows.strides[2]));
+            }
+        }
+    });
+
+    auto stats = std::vector<grad_stats<Tacc>>(p.c);
+    for(std::size_t c = 0; c < p.c; ++c)
+        for(std::size_t b = 0; b < p.n; ++b)
+            stats[c].merge(partial[c * p.n + b]);
+    return stats;
+}
+
+/// Runs f(first, last, data, k, ks) over every row of the data. data is the offset of the row,
+/// k the index of the statistic of its first element and ks the step of k along the row.
+template <class F>
+void for_each_row(const batchnorm_problem& p, const spatial_rows& rows, F f)
+{
+    const auto spatial = rows.count * rows.len;
+    par_ranges(p.c * p.n * rows.count, rows.len, [&](std::size_t first, std::size_t last) {
+        for(auto item = first; item < last; ++item)
+        {
+            const auto row   = item % rows.count;
+            const auto b     = (item / rows.count) % p.n;
+            const auto c     = item / rows.count / p.n;
+            const auto data  = b * p.strides[0] + c * p.strides[1] + rows.offset(row);
+            if(p.per_activation())
+                f(data, c * spatial + row * rows.len, 1);
+            else
+                f(data, c, 0);
+        }
+    });
+}
+
+} // namespace detail
+
+/// y = scale * (x - mean) / sqrt(var + epsilon) + bias with the statistics of the batch. The
+/// saved (mean, inverse of the standard deviation) and the running (mean, unbiased variance)
+/// statistics are updated when the pointers are not null.
+template <class Tacc, class Tx, class Ty, class Tp, class Ts>
+void batchnorm_forward_training(const batchnorm_problem& p,
+                                const Tx* x,
+                                Ty* y,
+                                const Tp* scale,
+                                const Tp* bias,
+                                double epsilon,
+                                double exp_avg_factor,
+                                Ts* save_mean,
+                                Ts* save_inv_var,
+                                Ts* running_mean,
+                                Ts* running_var)
+{
+    const auto rows  = detail::spatial_rows{p};
+    const auto stats = detail::batchnorm_stats<Tacc>(p, rows, x);
+    const auto nhw   = static_cast<Tacc>(detail::reduction_size(p));
+    const auto eps   = static_cast<Tacc>(epsilon);
+    const auto f     = static_cast<Tacc>(exp_avg_factor);
+
+    auto mean = std::vector<Tacc>(stats.size());
+    auto inv  = std::vector<Tacc>(stats.size());
+    for(std::size_t k = 0; k < stats.size(); ++k)
+    {
+        const auto var = stats[k].variance();
+        mean[k]        = stats[k].mean;
+        inv[k]         = Tacc{1} / std::sqrt(var + eps);
+
+        const auto po = detail::param_offset(p, rows, k);
+        if(save_mean != nullptr)
+            save_mean[po] = static_cast<Ts>(mean[k]);
+        if(save_inv_var != nullptr)
+            save_inv_var[po] = static_cast<Ts>(inv[k]);
+        if(running_mean != nullptr)
+        {
+            const auto old   = static_cast<Tacc>(running_mean[po]);
+            running_mean[po] = static_cast<Ts>(mean[k] * f + old * (Tacc{1} - f));
+        }
+        if(running_var != nullptr)
+        {
+            const auto unbiased = nhw == Tacc{1} ? var : nhw / (nhw - Tacc{1}) * var;
+            const auto old      = static_cast<Tacc>(running_var[po]);
+            running_var[po]     = static_cast<Ts>((Tacc{1} - f) * old + f * unbiased);
+        }
+    }
+
+    detail::for_each_row(p, rows, [&](auto data, auto k, auto ks) {
+        const auto ws = rows.strides[2];
+        const auto ps = ks * rows.param_strides[2];
+        const auto po = detail::param_offset(p, rows, k);
+        for(std::size_t i = 0; i < rows.len; ++i)
+        {
+            const auto xhat = (static_cast<Tacc>(x[data + i * ws]) - mean[k + i * ks]) *
+                              inv[k + i * ks];
+            y[data + i * ws] = static_cast<Ty>(static_cast<Tacc>(scale[po + i * ps]) * xhat +
+                                               static_cast<Tacc>(bias[po + i * ps]));
+        }
+    });
+}
+
+/// y = scale * (x - mean) / sqrt(var + epsilon) + bias with the estimated statistics.
+template <class Tacc, class Tx, class Ty, class Tp, class Ts>
+void batchnorm_forward_inference(const batchnorm_problem& p,
+                                 const Tx* x,
+                                 Ty* y,
+                                 const Tp* scale,
+                                 const Tp* bias,
+                                 double epsilon,
+                                 const Ts* estimated_mean,
+                                 const Ts* estimated_var)
+{
+    const auto rows = detail::spatial_rows{p};
+    const auto eps  = static_cast<Tacc>(epsilon);
+
+    detail::for_each_row(p, rows, [&](auto data, auto k, auto ks) {
+        const auto ws = rows.strides[2];
+        const auto ps = ks * rows.param_strides[2];
+        const auto po = detail::param_offset(p, rows, k);
+        for(std::size_t i = 0; i < rows.len; ++i)
+        {
+            const auto pi   = po + i * ps;
+            const auto inv  = Tacc{1} / std::sqrt(static_cast<Tacc>(estimated_var[pi]) + eps);
+            const auto xhat = (static_cast<Tacc>(x[data + i * ws]) -
+                               static_cast<Tacc>(estimated_mean[pi])) *
+                              inv;
+            y[data + i * ws] = static_cast<Ty>(static_cast<Tacc>(scale[pi]) * xhat +
+                                               static_cast<Tacc>(bias[pi]));
+        }
+    });
+}
+
+/// Gradients of the training forward pass. The statistics of x are recomputed when the saved
+/// ones are null.
+template <class Tacc, class Tx, class Tdy, class Tdx, class Tp, class Td, class Ts>
+void batchnorm_backward(const batchnorm_problem& p,
+                        const Tx* x,
+                        const Tdy* dy,
+                        Tdx* dx,
+                        const Tp* scale,
+                        Td* dscale,
+                        Td* dbias,
+                        double epsilon,
+                        const Ts* saved_mean,
+                        const Ts* saved_inv_var)
+{
+    const auto rows  = detail::spatial_rows{p};
+    const auto stats = detail::batchnorm_grad_stats<Tacc>(p, rows, x, dy);
+    const auto nhw   = static_cast<Tacc>(detail::reduction_size(p));
+    const auto eps   = static_cast<Tacc>(epsilon);
+    const bool saved = saved_mean != nullptr && saved_inv_var != nullptr;
+
+    auto mean = std::vector<Tacc>(stats.size());
+    auto inv  = std::vector<Tacc>(stats.size());
+    auto ds   = std::vector<Tacc>(stats.size());
+    auto db   = std::vector<Tacc>(stats.size());
+    for(std::size_t k = 0; k < stats.size(); ++k)
+    {
+        const auto po = detail::param_offset(p, rows, k);
+        mean[k]       = saved ? static_cast<Tacc>(saved_mean[po]) : stats[k].x.mean;
+        inv[k]        = saved ? static_cast<Tacc>(saved_inv_var[po])
+                              : Tacc{1} / std::sqrt(stats[k].x.variance() + eps);
+        db[k]         = stats[k].dy_sum;
+        ds[k]         = stats[k].centered_x_dy(mean[k]) * inv[k];
+        dbias[po]     = static_cast<Td>(db[k]);
+        dscale[po]    = static_cast<Td>(ds[k]);
+    }
+
+    detail::for_each_row(p, rows, [&](auto data, auto k, auto ks) {
+        const auto ws = rows.strides[2];
+        const auto ps = ks * rows.param_strides[2];
+        const auto po = detail::param_offset(p, rows, k);
+        for(std::size_t i = 0; i < rows.len; ++i)
+        {
+            const auto ki   = k + i * ks;
+            const auto xhat = (static_cast<Tacc>(x[data + i * ws]) - mean[ki]) * inv[ki];
+            const auto g    = static_cast<Tacc>(dy[data + i * ws]);
+            const auto a    = static_cast<Tacc>(scale[po + i * ps]) * inv[ki] / nhw;
+            dx[data + i * ws] = static_cast<Tdx>(a * (nhw * g - db[ki] - xhat * ds[ki]));
+        }
+    });
+}
+
+namespace detail {
+
+/// Normalizes rows of inner contiguous elements, load(i) returns the element of index i of the
+/// flattened input. weight and bias are indexed by param(o, j), j in [0, inner); the identity is
+/// used when weight is null.
+template <class Tacc, class Load, class Param, class Tw, class Ty, class Ts>
+void normalize_rows(std::size_t outer,
+                    std::size_t inner,
+                    Load load,
+                    Param param,
+                    const Tw* weight,
+                    const Tw* bias,
+                    Ty* y,
+                    Ts* mean,
+                    Ts* rstd,
+                    double epsilon)
+{
+    const auto eps = static_cast<Tacc>(epsilon);
+    par_ranges(outer, 2 * inner, [&](std::size_t first, std::size_t last) {
+        for(auto o = first; o < last; ++o)
+        {
+            const auto base  = o * inner;
+            const auto stats = block_stats<Tacc>(inner, [&](auto i) { return load(base + i); });
+            const auto r     = Tacc{1} / std::sqrt(stats.variance() + eps);
+            mean[o]          = static_cast<Ts>(stats.mean);
+            rstd[o]          = static_cast<Ts>(r);
+
+            for(std::size_t j = 0; j < inner; ++j)
+            {
+                auto v = (load(base + j) - stats.mean) * r;
+                if(weight != nullptr)
+                {
+                    const auto pi = param(o, j);
+                    v = v * static_cast<Tacc>(weight[pi]) +
+                        (bias != nullptr ? static_cast<Tacc>(bias[pi]) : Tacc{0});
+                }
+                y[base + j] = static_cast<Ty>(v);
+            }
+        }
+    });
+}
+
+} // namespace detail
+
+/// Layer norm of the rows of inner contiguous elements, weight and bias have inner elements.
+/// weight and bias are null for the element-wise affine mode.
+template <class Tacc, class Tx, class Tw, class Ty, class Ts>
+void layernorm_forward(std::size_t outer,
+                       std::size_t inner,
+                       const Tx* x,
+                       const Tw* weight,
+                       const Tw* bias,
+                       Ty* y,
+                       Ts* mean,
+                       Ts* rstd,
+                       double epsilon)
+{
+    detail::normalize_rows<Tacc>(
+        outer,
+        inner,
+        [&](auto i) { return static_cast<Tacc>(x[i]); },
+        [](auto, auto j) { return j; },
+        weight,
+        bias,
+        y,
+        mean,
+        rstd,
+        epsilon);
+}
+
+/// Layer norm of x + x2.
+template <class Tacc, class Tx, class Tw, class Ty, class Ts>
+void add_layernorm_forward(std::size_t outer,
+                           std::size_t inner,
+                           const Tx* x,
+                           const Tx* x2,
+                           const Tw* weight,
+                           const Tw* bias,
+                           Ty* y,
+                           Ts* mean,
+                           Ts* rstd,
+                           double epsilon)
+{
+    detail::normalize_rows<Tacc>(
+        outer,
+        inner,
+        [&](auto i) { return static_cast<Tacc>(x[i]) + static_cast<Tacc>(x2[i]); },
+        [](auto, auto j) { return j; },
+        weight,
+        bias,
+        y,
+        mean,
+        rstd,
+        epsilon);
+}
+
+/// Group norm of a packed N x C x spatial tensor, mean and rstd have N x groups elements and
+/// weight and bias have C elements.
+template <class Tacc, class Tx, class Tw, class Ty, class Ts>
+void groupnorm_forward(std::size_t n,
+                       std::size_t c,
+                       std::size_t spatial,
+                       std::size_t groups,
+                       const Tx* x,
+                       const Tw* weight,
+                       const Tw* bias,
+                       Ty* y,
+                       Ts* mean,
+                       Ts* rstd,
+                       double epsilon)
+{
+    const auto channels = c / groups;
+    detail::normalize_rows<Tacc>(
+        n * groups,
+        channels * spatial,
+        [&](auto i) { return static_cast<Tacc>(x[i]); },
+        [&](auto o, auto j) { return (o % groups) * channels + j / spatial; },
+        weight,
+        bias,
+        y,
+        mean,
+        rstd,
+        epsilon);
+}
+
+/// RMS norm of T5: y = x / sqrt(mean(x^2) + epsilon) * weight. weight is null for the
+/// element-wise affine mode.
+template <class Tacc, class Tx, class Tw, class Ty, class Ts>
+void rmsnorm_forward(std::size_t outer,
+                     std::size_t inner,
+                     const Tx* x,
+                     const Tw* weight,
+                     Ty* y,
+                     Ts* rstd,
+                     double epsilon)
+{
+    const auto eps = static_cast<Tacc>(epsilon);
+    detail::par_ranges(outer, 2 * inner, [&](std::size_t first, std::size_t last) {
+        for(auto o = first; o < last; ++o)
+        {
+            const auto* src = x + o * inner;
+            const auto ss   = detail::lane_sum<Tacc>(inner, [&](auto i) {
+                const auto v = static_cast<Tacc>(src[i]);
+                return v * v;
+            });
+            const auto r    = Tacc{1} / std::sqrt(ss / static_cast<Tacc>(inner) + eps);
+            rstd[o]         = static_cast<Ts>(r);
+
+            auto* dst = y + o * inner;
+            for(std::size_t i = 0; i < inner; ++i)
+            {
+                const auto w = weight != nullptr ? static_cast<Tacc>(weight[i]) : Tacc{1};
+                dst[i]       = static_cast<Ty>(static_cast<Tacc>(src[i]) * r * w);
+            }
+        }
+    });
+}
+
+/// Input gradient of the RMS norm. dy may be null for a zero gradient.
+template <class Tacc, class Tdy, class Tx, class Tw, class Ts, class Tdx>
+void rmsnorm_backward(std::size_t outer,
+                      std::size_t inner,
+                      const Tdy* dy,
+                      const Tx* x,
+                      const Tw* weight,
+                      const Ts* rstd,
+                      Tdx* dx)
+{
+    if(dy == nullptr)
+    {
+        std::fill_n(dx, outer * inner, static_cast<Tdx>(0));
+        return;
+    }
+
+    detail::par_ranges(outer, 2 * inner, [&](std::size_t first, std::size_t last) {
+        for(auto o = first; o < last; ++o)
+        {
+            const auto base = o * inner;
+            const auto w    = [&](auto i) {
+                return weight != nullptr ? static_cast<Tacc>(weight[i]) : Tacc{1};
+            };
+            const auto sum = detail::lane_sum<Tacc>(inner, [&](auto i) {
+                return static_cast<Tacc>(dy[base + i]) * static_cast<Tacc>(x[base + i]) * w(i);
+            });
+            const auto r = static_cast<Tacc>(rstd[o]);
+            const auto a = sum * r * r * r / static_cast<Tacc>(inner);
+
+            for(std::size_t i = 0; i < inner; ++i)
+                dx[base + i] = static_cast<Tdx>(r * static_cast<Tacc>(dy[base + i]) * w(i) -
+                                                a * static_cast<Tacc>(x[base + i]));
+        }
+    });
+}
+
+/// Weight gradient of the RMS norm, reduced over the rows. dy may be null for a zero gradient.
+template <class Tacc, class Tdy, class Tx, class Ts, class Tdw>
+void rmsnorm_backward_weight(std::size_t outer,
+                             std::size_t inner,
+                             const Tdy* dy,
+                             const Tx* x,
+                             const Ts* rstd,
+                             Tdw* dw)
+{
+    if(dy == nullptr)
+    {
+        std::fill_n(dw, inner, static_cast<Tdw>(0));
+        return;
+    }
+
+    // The columns are independent, a task walks down a chunk of them.
+    const auto chunks = (inner + detail::chunk - 1) / detail::chunk;
+    detail::par_ranges(chunks, outer * detail::chunk, [&](std::size_t first, std::size_t last) {
+        for(auto t = first; t < last; ++t)
+        {
+            const auto j   = t * detail::chunk;
+            const auto len = std::min(detail::chunk, inner - j);
+            Tacc sum[detail::chunk] = {};
+            for(std::size_t o = 0; o < outer; ++o)
+            {
+                const auto r = static_cast<Tacc>(rstd[o]);
+                const auto base = o * inner + j;
+                for(std::size_t i = 0; i < len; ++i)
+                    sum[i] += static_cast<Tacc>(dy[base + i]) * static_cast<Tacc>(x[base + i]) * r;
+            }
+            for(std::size_t i = 0; i < len; ++i)
+                dw[j + i] = static_cast<Tdw>(sum[i]);
+        }
+    });
+}
+
+} // namespace cpu_norm
+
+#endif
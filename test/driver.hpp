@@ -657,10 +657,9 @@ struct test_driver
 
                 auto mxdiff = miopen::max_diff(out_cpu, out_gpu);
                 std::cout << "Max diff: " << mxdiff << std::endl;
-                //            auto max_idx = miopen::mismatch_diff(out_cpu, out_gpu, mxdiff);
-                //            std::cout << "Max diff at " << max_idx << ": " << out_cpu[max_idx] <<
-                //            " !=
-                //            " << out_gpu[max_idx] << std::endl;
+                if constexpr(miopen::is_contiguous_range_v<decltype(out_cpu)> &&
+                             miopen::is_contiguous_range_v<decltype(out_gpu)>)
+                    std::cout << miopen::compare_range(out_cpu, out_gpu);
 
                 if(miopen::range_zero(out_cpu))
                     std::cout << "Cpu data is all zeros" << std::endl;
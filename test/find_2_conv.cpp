@@ -124,6 +124,7 @@ private:
 
         AddConvTensorDescriptors(problem);
 
+        TestFindSolutionsBatch(handle, problem);
         std::ignore          = TestFindSolutions(handle, problem);
         const auto solutions = TestFindSolutionsWithOptions(handle, problem);
 
@@ -170,6 +171,42 @@ private:
         return solutions;
     }
 
+    void TestFindSolutionsBatch(miopenHandle_t handle, miopenProblem_t problem)
+    {
+        std::cerr << "Testing miopenFindSolutionsBatch..." << std::endl;
+
+        // The same problem twice: the duplicate gets the results of the first one.
+        const miopenProblem_t problems[2]   = {problem, problem};
+        constexpr std::size_t max_solutions = 100;
+
+        auto solutions       = std::vector<miopenSolution_t>(2 * max_solutions);
+        std::size_t found[2] = {0, 0};
+
+        EXPECT_EQUAL(miopenFindSolutionsBatch(
+                         handle, problems, 2, nullptr, solutions.data(), found, max_solutions),
+                     miopenStatusSuccess);
+        EXPECT_EQUAL(found[0], found[1]);
+
+        for(std::size_t i = 0; i < found[0]; ++i)
+        {
+            uint64_t first_id;
+            uint64_t second_id;
+            EXPECT_EQUAL(miopenGetSolutionSolverId(solutions[i], &first_id), miopenStatusSuccess);
+            EXPECT_EQUAL(miopenGetSolutionSolverId(solutions[max_solutions + i], &second_id),
+                         miopenStatusSuccess);
+            EXPECT_EQUAL(first_id, second_id);
+        }
+
+        for(std::size_t p = 0; p < 2; ++p)
+        {
+            for(std::size_t i = 0; i < found[p]; ++i)
+                EXPECT_EQUAL(miopenDestroySolution(solutions[p * max_solutions + i]),
+                             miopenStatusSuccess);
+        }
+
+        std::cerr << "Finished testing miopenFindSolutionsBatch." << std::endl;
+    }
+
     std::vector<miopenSolution_t> TestFindSolutionsWithOptions(miopenHandle_t handle,
                                                                miopenProblem_t problem)
     {
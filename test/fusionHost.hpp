@@ -36,6 +36,7 @@
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
 #include <utility>
+#include "cpu_norm.hpp"
 #include "get_handle.hpp"
 #include "tensor_holder.hpp"
 #include "verify.hpp"
@@ -134,6 +135,26 @@ void convHostForward(const tensor<T>& input,
     }
 }
 
+/// 4D batch norm problem of the host references. The parameter tensors have the strides of
+/// param, which is 1xCx1x1 or 1xCxHxW.
+template <class T, class U>
+cpu_norm::batchnorm_problem
+batchnorm_host_problem(miopenBatchNormMode_t mode, const tensor<T>& x, const tensor<U>& param)
+{
+    auto problem = cpu_norm::batchnorm_problem{};
+    std::size_t height, width;
+    std::tie(problem.n, problem.c, height, width) = miopen::tien<4>(x.desc.GetLengths());
+
+    const auto& strides  = x.desc.GetStrides();
+    const auto& pstrides = param.desc.GetStrides();
+
+    problem.mode          = mode;
+    problem.spatial       = {1, height, width};
+    problem.strides       = {strides[0], strides[1], height * strides[2], strides[2], strides[3]};
+    problem.param_strides = {pstrides[1], height * pstrides[2], pstrides[2], pstrides[3]};
+    return problem;
+}
+
 template <class T, class U, class V = U>
 void batchNormSpatialHostInference(const tensor<T>& input,
                                    tensor<T>& output,
@@ -143,29 +164,15 @@ void batchNormSpatialHostInference(const tensor<T>& input,
                                    const tensor<V>& estimatedMean,
                                    const tensor<V>& estimatedVariance)
 {
-
-    int n_batches, channels, height, width;
-    std::tie(n_batches, channels, height, width) = miopen::tien<4>(input.desc.GetLengths());
-    par_for(channels, 1, [&](int cidx) { // via channel
-        V mean           = estimatedMean(0, cidx, 0, 0);
-        V variance       = estimatedVariance(0, cidx, 0, 0);
-        double invertVar = 1.0 / sqrt(variance + epsilon);
-        // process the batch per channel
-        for(int row = 0; row < height; row++)
-        { // via rows
-            for(int column = 0; column < width; column++)
-            { // via columns
-                for(int bidx = 0; bidx < n_batches; bidx++)
-                { // via mini_batch
-                    double elemStd = static_cast<double>(input(bidx, cidx, row, column)) - mean;
-                    double inhat   = elemStd * invertVar;
-                    output(bidx, cidx, row, column) =
-                        static_cast<T>(scale(0, cidx, 0, 0) * inhat + bias(0, cidx, 0, 0));
-                    // printf("output: %f\n",scale(0, cidx, 0, 0) * inhat + bias(0, cidx, 0, 0));
-                }
-            }
-        }
-    });
+    cpu_norm::batchnorm_forward_inference<double>(
+        batchnorm_host_problem(miopenBNSpatial, input, scale),
+        input.data.data(),
+        output.data.data(),
+        scale.data.data(),
+        bias.data.data(),
+        epsilon,
+        estimatedMean.data.data(),
+        estimatedVariance.data.data());
 }
 
 template <class T, class U>
@@ -177,29 +184,15 @@ void batchNormPerActivHostInference(const tensor<T>& input,
                                     const tensor<U>& estimatedMean,
                                     const tensor<U>& estimatedVariance)
 {
-    int n_batches, channels, height, width;
-    std::tie(n_batches, channels, height, width) = miopen::tien<4>(input.desc.GetLengths());
-    par_for(channels, 1, [&](int cidx) { // via channel
-        for(int row = 0; row < height; row++)
-        { // via rows
-            for(int column = 0; column < width; column++)
-            { // via columns
-                // apply down the n_batch dimension
-                double mean       = estimatedMean(0, cidx, row, column);
-                double variance   = estimatedVariance(0, cidx, row, column);
-                double elemInvVar = 1.0 / sqrt(variance + epsilon);
-                for(int bidx = 0; bidx < n_batches; bidx++)
-                { // via mini_batch
-                    // per (x-dims) channel load a block of data into LDS
-                    double elemStd = input(bidx, cidx, row, column) - mean;
-                    double inhat   = elemStd * elemInvVar;
-                    output(bidx, cidx, row, column) =
-                        scale(0, cidx, row, column) * inhat + bias(0, cidx, row, column);
-                    //    printf("output: %f\n",output(bidx, cidx, row, column));
-                }
-            }
-        }
-    });
+    cpu_norm::batchnorm_forward_inference<double>(
+        batchnorm_host_problem(miopenBNPerActivation, input, scale),
+        input.data.data(),
+        output.data.data(),
+        scale.data.data(),
+        bias.data.data(),
+        epsilon,
+        estimatedMean.data.data(),
+        estimatedVariance.data.data());
 }
 
 template <class T, class U, class V = U>
@@ -214,68 +207,18 @@ void batchNormSpatialHostFwdTrain(const tensor<T>& input,
                                   tensor<V>& runMean,
                                   tensor<V>& runVar)
 {
-
-    int height, width, n_batch, channels;
-    std::tie(n_batch, channels, height, width) = miopen::tien<4>(input.desc.GetLengths());
-    const auto nhw                             = double(height * width * n_batch);
-
-    par_for(channels, 1, [&](int cidx) {
-        double elemStd        = 0.;
-        double variance_accum = 0.;
-        double mean_accum     = 0.;
-        double invVar         = 0.;
-        double newRunMean     = 0.;
-        double adjust         = 0.;
-
-        // process the batch per channel
-        for(int bidx = 0; bidx < n_batch; bidx++)
-        { // via mini_batch
-            for(int row = 0; row < height; row++)
-            { // via rows
-                for(int column = 0; column < width; column++)
-                { // via columns
-                    // #1 calculate the mean
-                    // iterating through the stack of images in the mini_batch
-                    auto inval = static_cast<double>(input(bidx, cidx, row, column));
-                    mean_accum += inval;
-                    variance_accum += inval * inval;
-                } // end for (column)
-            }     // end for (row)
-        }         // end for (n)
-
-        mean_accum /= nhw;
-        variance_accum /= nhw;
-        variance_accum += (-mean_accum * mean_accum);
-        invVar = 1.0 / sqrt(variance_accum + epsilon);
-
-        // #4 apply the normalization
-        // x_hat = (x_i - mean) / sqrt(variance_accum + epsilon)
-        for(int bidx = 0; bidx < n_batch; bidx++)
-        { // via mini_batch
-            for(int row = 0; row < height; row++)
-            { // via rows
-                for(int column = 0; column < width; column++)
-                { // via columns
-                    // #5 Gamma and Beta adjust
-                    // y_i = gamma*x_hat + beta
-                    elemStd = (static_cast<double>(input(bidx, cidx, row, column)) -
-                               mean_accum); // (x_i - mean)
-                    out(bidx, cidx, row, column) = static_cast<T>(
-                        scale(0, cidx, 0, 0) * (invVar * elemStd) + bias(0, cidx, 0, 0));
-                } // for (column)
-            }     // for (row)
-        }         // end for(n_batchs)
-
-        saveMean(0, cidx, 0, 0)   = mean_accum;
-        saveInvVar(0, cidx, 0, 0) = invVar;
-
-        newRunMean             = runMean(0, cidx, 0, 0) * (1 - expAvgFactor);
-        runMean(0, cidx, 0, 0) = mean_accum * expAvgFactor + newRunMean; // newMean*factor + tmp
-        // var(n+1) = p * var(n-1) + (1 - p)*(b/b-1)*var(n)
-        adjust =
-            (n_batch * height * width == 1) ? variance_accum : (nhw / (nhw - 1)) * variance_accum;
-        runVar(0, cidx, 0, 0) = (1 - expAvgFactor) * runVar(0, cidx, 0, 0) + expAvgFactor * adjust;
-    });
+    cpu_norm::batchnorm_forward_training<double>(
+        batchnorm_host_problem(miopenBNSpatial, input, scale),
+        input.data.data(),
+        out.data.data(),
+        scale.data.data(),
+        bias.data.data(),
+        epsilon,
+        expAvgFactor,
+        saveMean.data.data(),
+        saveInvVar.data.data(),
+        runMean.data.data(),
+        runVar.data.data());
 }
 
 template <class DataType, class XAndScaleDataType>
@@ -288,57 +231,17 @@ void batchNormSpatialHostBwdTrain(const tensor<XAndScaleDataType>& x_input,
                                   const tensor<DataType>& savedMean,
                                   const tensor<DataType>& savedInvVar)
 {
-
-    int height, width, n_batch, channels;
-    std::tie(n_batch, channels, height, width) = miopen::tien<4>(x_input.desc.GetLengths());
-    auto nhw                                   = double(height * width * n_batch);
-    int in_cstride                             = height * width;
-
-    par_for(channels, 1, [&](int cidx) {
-        double elemStd = 0.;
-        unsigned int xhat_index;
-        double mean   = savedMean(0, cidx, 0, 0);   // HxW elements
-        double invVar = savedInvVar(0, cidx, 0, 0); // HxW elements
-        double dyelem = 0.;
-        std::vector<double> xhat(static_cast<std::size_t>(n_batch) * in_cstride, 0.0);
-        // process the batch per channel
-        dscale(0, cidx, 0, 0) = 0.;
-        dbias(0, cidx, 0, 0)  = 0.;
-
-        for(int row = 0; row < height; row++)
-        { // via rows
-            for(int column = 0; column < width; column++)
-            { // via columns
-                for(int bidx = 0; bidx < n_batch; bidx++)
-                { // via mini_batch
-                    xhat_index = in_cstride * bidx + (width * row + column);
-                    // per (x-dims) channel load a block of data into LDS
-                    elemStd = static_cast<double>(x_input(bidx, cidx, row, column)) -
-                              mean; // (x_i - mean)
-                    xhat[xhat_index] = elemStd * invVar;
-                    dyelem           = static_cast<double>(dy_input(bidx, cidx, row, column));
-                    dbias(0, cidx, 0, 0) += dyelem;
-                    dscale(0, cidx, 0, 0) += xhat[xhat_index] * dyelem;
-                } // end for(n_batch)
-            }     // for (column)
-        }         // for (row)
-
-        for(int row = 0; row < height; row++)
-        { // via rows
-            for(int column = 0; column < width; column++)
-            { // via columns
-                for(int bidx = 0; bidx < n_batch; bidx++)
-                { // via mini_batch
-                    xhat_index = in_cstride * bidx + (width * row + column);
-
-                    double tmp1 = nhw * dy_input(bidx, cidx, row, column) - dbias(0, cidx, 0, 0);
-                    double tmp2 = -xhat[xhat_index] * dscale(0, cidx, 0, 0);
-                    double tmp3 = (scale(0, cidx, 0, 0) * invVar) / nhw;
-                    dx_out(bidx, cidx, row, column) = static_cast<DataType>(tmp3 * (tmp2 + tmp1));
-                } // end for(n_batchs)
-            }     // for (column)
-        }         // for (row)
-    });           // for (channel)
+    // The statistics are the saved ones, epsilon is not used.
+    cpu_norm::batchnorm_backward<double>(batchnorm_host_problem(miopenBNSpatial, x_input, scale),
+                                         x_input.data.data(),
+                                         dy_input.data.data(),
+                                         dx_out.data.data(),
+                                         scale.data.data(),
+                                         dscale.data.data(),
+                                         dbias.data.data(),
+                                         0.,
+                                         savedMean.data.data(),
+                                         savedInvVar.data.data());
 }
 
 template <class T, class U>
@@ -441,67 +344,18 @@ void batchNormPerActHostFwdTrain(const tensor<T>& input,
                                  tensor<U>& runMean,
                                  tensor<U>& runVar)
 {
-
-    int height, width, n_batch, channels;
-    std::tie(n_batch, channels, height, width) = miopen::tien<4>(input.desc.GetLengths());
-    const auto n                               = double(n_batch);
-
-    par_for(channels, 1, [&](int cidx) {
-        double mean_accum     = 0.;
-        double variance_accum = 0.;
-        double elemStd        = 0.;
-        double elemInvVar     = 0.;
-        double inhat          = 0.;
-        double newRunMean     = 0.;
-        double adjust         = 0.;
-
-        // process the batch per channel
-        for(int row = 0; row < height; row++)
-        { // via rows
-            for(int column = 0; column < width; column++)
-            { // via columns
-
-                mean_accum     = 0.;
-                variance_accum = 0.;
-                for(int bidx = 0; bidx < n_batch; bidx++)
-                { // via mini_batch
-                    // #1 calculate the mean :: iterating through the stack of images in the
-                    // mini_batch
-                    auto intval = static_cast<double>(input(bidx, cidx, row, column));
-                    mean_accum += intval;
-                    variance_accum += intval * intval;
-                }
-                mean_accum /= n;
-                variance_accum /= n;
-                variance_accum = variance_accum - (mean_accum * mean_accum);
-                elemInvVar     = 1.0 / double(sqrt(variance_accum + epsilon));
-
-                // #4 apply the normalization :: x_hat = (x_i - mean) / sqrt(variance_accum -
-                // epsilon)
-                for(int bidx = 0; bidx < n_batch; bidx++)
-                {                                                            // via mini_batch
-                    elemStd = (input(bidx, cidx, row, column) - mean_accum); // (x_i - mean)
-                    inhat   = elemStd * elemInvVar;
-                    // #5 Gamma and Beta adjust :: y_i = gamma*x_hat + beta
-                    out(bidx, cidx, row, column) = static_cast<T>(
-                        scale(0, cidx, row, column) * inhat + bias(0, cidx, row, column));
-                } // end for(n_batch)
-
-                newRunMean = runMean(0, cidx, row, column) * (1.0 - expAvgFactor);
-                runMean(0, cidx, row, column) =
-                    mean_accum * expAvgFactor + newRunMean; // newMean*factor + tmp
-
-                // var(n+1) = p * var(n-1) + (1 - p)*(b/b-1)*var(n)
-                adjust = (n_batch == 1) ? variance_accum : (n / (n - 1.0)) * variance_accum;
-                runVar(0, cidx, row, column) =
-                    (1 - expAvgFactor) * runVar(0, cidx, row, column) + expAvgFactor * adjust;
-
-                saveMean(0, cidx, row, column)   = static_cast<U>(mean_accum);
-                saveInvVar(0, cidx, row, column) = static_cast<U>(elemInvVar);
-
-            } // for (column)
-        }     // for (row)
-    });
+    cpu_norm::batchnorm_forward_training<double>(
+        batchnorm_host_problem(miopenBNPerActivation, input, scale),
+        input.data.data(),
+        out.data.data(),
+        scale.data.data(),
+        bias.data.data(),
+        epsilon,
+        expAvgFactor,
+        saveMean.data.data(),
+        saveInvVar.data.data(),
+        runMean.data.data(),
+        runVar.data.data());
 }
 
 template <class T, class U>
@@ -514,63 +368,18 @@ void batchNormPerActHostBwdTrain(const tensor<T>& x_input,
                                  const tensor<U>& savedMean,
                                  const tensor<U>& savedInvVar)
 {
-
-    int height, width, n_batch, channels;
-    std::tie(n_batch, channels, height, width) = miopen::tien<4>(x_input.desc.GetLengths());
-    int in_cstride                             = height * width;
-    auto n                                     = double(n_batch);
-
-    par_for(channels, 1, [&](int cidx) {
-        double elemStd = 0.;
-        unsigned int xhat_index;
-        double mean       = 0.;
-        double elemInvVar = 0.;
-        double dyelem     = 0.;
-        double dxhat      = 0.;
-        double dxhathat   = 0.;
-        double tmp1       = 0.;
-        std::vector<double> xhat(static_cast<std::size_t>(n_batch) * in_cstride);
-
-        // process the batch per channel
-        for(int row = 0; row < height; row++)
-        { // via rows
-            for(int column = 0; column < width; column++)
-            { // via columns
-                dxhat    = 0.;
-                dxhathat = 0.;
-
-                mean       = savedMean(0, cidx, row, column);   // HxW elements
-                elemInvVar = savedInvVar(0, cidx, row, column); // HxW elements
-
-                for(int bidx = 0; bidx < n_batch; bidx++)
-                { // via mini_batch
-                    xhat_index = in_cstride * bidx + (width * row + column);
-                    // per (x-dims) channel load a block of data into LDS
-                    elemStd = static_cast<double>(x_input(bidx, cidx, row, column)) -
-                              mean; // (x_i - mean)
-                    xhat[xhat_index] = elemStd * elemInvVar;
-                    dyelem           = static_cast<double>(dy_input(bidx, cidx, row, column));
-                    dbias(0, cidx, row, column) += dyelem;
-                    dscale(0, cidx, row, column) += xhat[xhat_index] * dyelem;
-                    tmp1 = scale(0, cidx, row, column) * dyelem;
-                    dxhat += tmp1;
-                    dxhathat += tmp1 * xhat[xhat_index];
-
-                } // end for(n_batchs)
-
-                for(int bidx = 0; bidx < n_batch; bidx++)
-                { // via mini_batch
-                    xhat_index = in_cstride * bidx + (width * row + column);
-                    tmp1       = xhat[xhat_index] * dxhathat + dxhat;
-                    double tmp2 =
-                        n_batch * scale(0, cidx, row, column) * dy_input(bidx, cidx, row, column) -
-                        tmp1;
-                    double tmp3                     = elemInvVar / (double(n));
-                    dx_out(bidx, cidx, row, column) = static_cast<T>(tmp3 * tmp2);
-                } // end for(n_batchs)
-            }     // for (column)
-        }         // for (row)
-    });
+    // The statistics are the saved ones, epsilon is not used.
+    cpu_norm::batchnorm_backward<double>(
+        batchnorm_host_problem(miopenBNPerActivation, x_input, scale),
+        x_input.data.data(),
+        dy_input.data.data(),
+        dx_out.data.data(),
+        scale.data.data(),
+        dscale.data.data(),
+        dbias.data.data(),
+        0.,
+        savedMean.data.data(),
+        savedInvVar.data.data());
 }
 
 template <class T, class U>
@@ -27,24 +27,14 @@
 #define GUARD_GEMM_HPP
 
 #include "ford.hpp"
+#include <miopen/host_gemm.hpp>
 #include <miopen/returns.hpp>
 
+/// c(i, j, x) receives the n x m product of a(i, kk) and b(kk, j), accumulated in double.
 template <class AF, class BF, class CF>
 void gemm(std::size_t n, std::size_t m, std::size_t k, AF a, BF b, CF c)
 {
-    auto inner_loop = [&](int i, int j) {
-        double x = 0.0;
-        ford(k)([&](int kk) { x += a(i, kk) * b(kk, j); });
-        c(i, j, x);
-    };
-    if(n * m > 32)
-    {
-        par_ford(n, m)(inner_loop);
-    }
-    else
-    {
-        ford(n, m)(inner_loop);
-    }
+    miopen::host_gemm::Gemm<double>(n, m, k, a, b, c);
 }
 
 struct with_stride_impl
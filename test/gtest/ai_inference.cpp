@@ -0,0 +1,181 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+
+#if MIOPEN_ENABLE_AI_IMMED_MODE_FALLBACK || MIOPEN_ENABLE_AI_KERNEL_TUNING
+
+#include <miopen/conv/heuristics/ai_inference.hpp>
+#include <miopen/db_path.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+using miopen::ai::nn::Network;
+
+std::string EncodeFloats(const std::vector<float>& values)
+{
+    const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string bytes(values.size() * sizeof(float), '\0');
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+
+    std::string encoded;
+    for(std::size_t i = 0; i < bytes.size(); i += 3)
+    {
+        const auto n     = std::min<std::size_t>(3, bytes.size() - i);
+        std::uint32_t v = 0;
+        for(std::size_t j = 0; j < 3; ++j)
+            v = (v << 8) | (j < n ? static_cast<unsigned char>(bytes[i + j]) : 0);
+        for(std::size_t j = 0; j < 4; ++j)
+            encoded.push_back(j <= n ? alphabet[(v >> (18 - 6 * j)) & 0x3F] : '=');
+    }
+    return encoded;
+}
+
+// y = relu(x * [[1, 2], [3, 4]] + [0.5, -0.5])
+nlohmann::json TinyModel(const std::vector<float>& test_input,
+                         const std::vector<float>& test_output)
+{
+    auto model = nlohmann::json::parse(R"({
+        "architecture": {"config": {
+            "layers": [
+                {"class_name": "InputLayer", "name": "input_1", "inbound_nodes": [],
+                 "config": {"batch_input_shape": [null, 2]}},
+                {"class_name": "Dense", "name": "dense", "inbound_nodes": [[["input_1", 0, 0, {}]]],
+                 "config": {"units": 2, "activation": "linear", "use_bias": true}},
+                {"class_name": "ReLU", "name": "re_lu", "inbound_nodes": [[["dense", 0, 0, {}]]],
+                 "config": {"max_value": null, "negative_slope": 0.0, "threshold": 0.0}}],
+            "input_layers": [["input_1", 0, 0]],
+            "output_layers": [["re_lu", 0, 0]]}}
+    })");
+    model["trainable_params"]["dense"]["weights"] = {EncodeFloats({1, 2, 3, 4})};
+    model["trainable_params"]["dense"]["bias"]    = {EncodeFloats({0.5f, -0.5f})};
+    model["tests"] = {{{"inputs", {{{"values", {EncodeFloats(test_input)}}}}},
+                       {"outputs", {{{"values", {EncodeFloats(test_output)}}}}}}};
+    return model;
+}
+
+std::vector<miopen::fs::path> ModelFiles()
+{
+    std::vector<miopen::fs::path> files;
+    const auto dir = miopen::GetSystemDbPath();
+    if(!miopen::fs::is_directory(dir))
+        return files;
+    for(const auto& entry : miopen::fs::directory_iterator(dir))
+    {
+        const auto name = entry.path().filename().string();
+        if(name.find(".model") != std::string::npos && name.find("_metadata.") == std::string::npos)
+            files.push_back(entry.path());
+    }
+    return files;
+}
+
+} // namespace
+
+TEST(CPU_AiInference_None, TinyModel)
+{
+    const auto network = Network::FromJson(TinyModel({1, 1}, {4.5f, 5.5f}));
+    ASSERT_EQ(network.GetInputCount(), 1);
+    ASSERT_EQ(network.GetOutputCount(), 1);
+
+    const auto out = network.Predict({{1, 1, 1, -1}}, 2);
+    ASSERT_EQ(out.front(), (std::vector<float>{4.5f, 5.5f, 0.0f, 0.0f}));
+
+    EXPECT_ANY_THROW(Network::FromJson(TinyModel({1, 1}, {4.5f, 5.0f})));
+    EXPECT_ANY_THROW(network.Predict({{1, 1, 1}}, 2));
+}
+
+TEST(CPU_AiInference_None, CompiledFormat)
+{
+    const auto network = Network::FromJson(TinyModel({1, 1}, {4.5f, 5.5f}));
+    std::stringstream ss;
+    network.Write(ss);
+    const auto blob = ss.str();
+
+    std::istringstream in{blob};
+    const auto read = Network::Read(in);
+    ASSERT_TRUE(read);
+    EXPECT_EQ(read->Predict({{1, 1}}, 1), network.Predict({{1, 1}}, 1));
+
+    for(auto size = std::size_t{0}; size < blob.size(); ++size)
+    {
+        std::istringstream truncated{blob.substr(0, size)};
+        EXPECT_FALSE(Network::Read(truncated)) << size;
+    }
+}
+
+TEST(CPU_AiInference_None, ShippedModels)
+{
+    const auto files = ModelFiles();
+    if(files.empty())
+        GTEST_SKIP() << "No AI models in " << miopen::GetSystemDbPath();
+
+    for(const auto& file : files)
+    {
+        SCOPED_TRACE(file.string());
+        // Conversion verifies the network against the test vectors stored in the model.
+        const auto network = Network::FromJson(nlohmann::json::parse(std::ifstream{file}));
+
+        // A batch must give the same results as the problems evaluated one by one.
+        constexpr std::size_t batch = 5;
+        std::vector<std::vector<float>> inputs(network.GetInputCount());
+        for(std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            const auto size = network.GetInputShape(i).Size();
+            for(std::size_t j = 0; j < batch * size; ++j)
+                inputs[i].push_back(size == 1 ? static_cast<float>(j) : 0.01f * (j % 97));
+        }
+
+        const auto batched = network.Predict(inputs, batch);
+        for(std::size_t b = 0; b < batch; ++b)
+        {
+            std::vector<std::vector<float>> single;
+            for(std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const auto size = network.GetInputShape(i).Size();
+                single.emplace_back(inputs[i].begin() + b * size,
+                                    inputs[i].begin() + (b + 1) * size);
+            }
+            const auto out = network.Predict(single, 1);
+            for(std::size_t i = 0; i < out.size(); ++i)
+            {
+                const auto size = network.GetOutputShape(i).Size();
+                ASSERT_EQ(out[i],
+                          std::vector<float>(batched[i].begin() + b * size,
+                                             batched[i].begin() + (b + 1) * size));
+            }
+        }
+    }
+}
+
+#endif
@@ -29,6 +29,7 @@
 #include <miopen/kern_db.hpp>
 #include <miopen/temp_file.hpp>
 #include <algorithm>
+#include <fstream>
 #include <vector>
 #include "test.hpp"
 #include "random.hpp"
@@ -133,8 +134,212 @@ TEST(CPU_Cache_None, check_kern_db)
         EXPECT_TRUE(err_db.RemoveRecordUnsafe(cfg0));
     }
 }
+
+namespace {
+
+const std::vector<miopen::KernDbCodec>& all_codecs()
+{
+    static const std::vector<miopen::KernDbCodec> codecs = {
+        miopen::KernDbCodec::Bz2, miopen::KernDbCodec::Zstd, miopen::KernDbCodec::Lz4};
+    return codecs;
+}
+
+// Code objects compress well unlike the random bytes, the repeated chunks mimic that.
+std::vector<char> kernel_like_bytes(size_t length)
+{
+    const auto chunk = random_bytes(64);
+    std::vector<char> v(length);
+    for(size_t i = 0; i < length; ++i)
+        v[i] = i % 7 == 0 ? static_cast<char>(prng::gen_0_to_B(128)) : chunk[i % chunk.size()];
+    return v;
+}
+
+miopen::KernelConfig make_kernel_config(int i)
+{
+    miopen::KernelConfig cfg;
+    cfg.kernel_name = "kernel" + std::to_string(i) + ".s";
+    cfg.kernel_args = "-DINDEX=" + std::to_string(i);
+    cfg.kernel_blob = kernel_like_bytes(4096 + i * 64);
+    return cfg;
+}
+
+} // namespace
+
+TEST(CPU_Cache_None, check_kern_db_codecs)
+{
+    miopen::TempFile temp_file("tmp-kerndb");
+    std::vector<miopen::KernelConfig> configs;
+
+    {
+        miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+        for(const auto codec : all_codecs())
+        {
+            if(!miopen::kern_db_codec::IsSupported(codec))
+            {
+                EXPECT_TRUE(throws([&]() { db.SetCodec(codec); }));
+                continue;
+            }
+            db.SetCodec(codec);
+            EXPECT_EQ(db.GetCodec(), codec);
+            configs.push_back(make_kernel_config(static_cast<int>(configs.size())));
+            EXPECT_TRUE(db.StoreRecordUnsafe(configs.back()));
+            auto readout = db.FindRecordUnsafe(configs.back());
+            ASSERT_TRUE(readout);
+            EXPECT_TRUE(readout.get() == configs.back().kernel_blob);
+        }
+    }
+
+    // The codec is per record, so a database written with mixed codecs reads back entirely.
+    miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+    for(const auto& cfg : configs)
+    {
+        auto readout = db.FindRecordUnsafe(cfg);
+        ASSERT_TRUE(readout);
+        EXPECT_TRUE(readout.get() == cfg.kernel_blob);
+    }
+}
+
+TEST(CPU_Cache_None, check_kern_db_recompress)
+{
+    miopen::TempFile temp_file("tmp-kerndb");
+    std::vector<miopen::KernelConfig> configs;
+    for(int i = 0; i < 64; ++i)
+        configs.push_back(make_kernel_config(i));
+
+    {
+        miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+        db.SetCodec(miopen::KernDbCodec::Bz2);
+        for(const auto& cfg : configs)
+            EXPECT_TRUE(db.StoreRecordUnsafe(cfg));
+    }
+
+    const auto check = [&]() {
+        miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+        for(const auto& cfg : configs)
+        {
+            auto readout = db.FindRecordUnsafe(cfg);
+            ASSERT_TRUE(readout);
+            EXPECT_TRUE(readout.get() == cfg.kernel_blob);
+        }
+    };
+
+    for(const auto codec : all_codecs())
+    {
+        if(!miopen::kern_db_codec::IsSupported(codec))
+            continue;
+        {
+            miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+            db.Recompress(codec, codec == miopen::KernDbCodec::Zstd ? 4096 : 0);
+        }
+        check();
+
+        const auto dictionaries =
+            miopen::SQLite{temp_file, false}.Exec("SELECT id FROM kern_db_dict;");
+        const auto codecs =
+            miopen::SQLite{temp_file, false}.Exec("SELECT DISTINCT codec FROM kern_db;");
+        EXPECT_LE(dictionaries.size(), codec == miopen::KernDbCodec::Zstd ? 1 : 0);
+        ASSERT_EQ(codecs.size(), 1);
+        EXPECT_EQ(codecs.front().at("codec"), std::to_string(static_cast<int>(codec)));
+    }
+}
+
+TEST(CPU_Cache_None, check_kern_db_find_records)
+{
+    miopen::TempFile temp_file("tmp-kerndb");
+    std::vector<miopen::KernelConfig> configs;
+    // More than fit into a single query.
+    for(int i = 0; i < 1000; ++i)
+        configs.push_back(make_kernel_config(i));
+
+    {
+        miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+        for(std::size_t i = 0; i < configs.size(); i += 4)
+        {
+            const auto codec = all_codecs()[i / 4 % all_codecs().size()];
+            db.SetCodec(miopen::kern_db_codec::IsSupported(codec) ? codec
+                                                                  : miopen::KernDbCodec::Bz2);
+            EXPECT_TRUE(db.StoreRecordUnsafe(configs[i]));
+        }
+    }
+
+    miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+    const auto records = db.FindRecordsUnsafe(configs);
+    ASSERT_EQ(records.size(), configs.size());
+    for(std::size_t i = 0; i < configs.size(); ++i)
+    {
+        ASSERT_EQ(static_cast<bool>(records[i]), i % 4 == 0) << i;
+        if(records[i])
+            EXPECT_TRUE(records[i].get() == configs[i].kernel_blob) << i;
+    }
+
+    miopen::KernDb empty_db(miopen::DbKinds::KernelDb, "", false);
+    const auto none = empty_db.FindRecordsUnsafe(configs);
+    EXPECT_EQ(none.size(), configs.size());
+    EXPECT_TRUE(std::none_of(none.begin(), none.end(), [](const auto& r) { return r; }));
+}
+
+TEST(CPU_Cache_None, check_kern_db_old_schema)
+{
+    miopen::TempFile temp_file("tmp-kerndb");
+    auto cfg0 = make_kernel_config(0);
+    auto cfg1 = make_kernel_config(1);
+
+    {
+        // The schema before the codec column, all the records are bz2.
+        miopen::SQLite sql{temp_file, false};
+        sql.Exec("CREATE TABLE `kern_db` (`id` INTEGER PRIMARY KEY ASC,"
+                 "`kernel_name` TEXT NOT NULL,`kernel_args` TEXT NOT NULL,"
+                 "`kernel_blob` BLOB NOT NULL,`kernel_hash` TEXT NOT NULL,"
+                 "`uncompressed_size` INT NOT NULL);"
+                 "CREATE UNIQUE INDEX `idx_kern_db` ON kern_db(kernel_name, kernel_args);");
+        auto stmt = miopen::SQLite::Statement{
+            sql,
+            "INSERT INTO kern_db(kernel_name, kernel_args, kernel_blob, kernel_hash, "
+            "uncompressed_size) VALUES(?, ?, ?, ?, ?);"};
+        stmt.BindPath(1, cfg0.kernel_name);
+        stmt.BindText(2, cfg0.kernel_args);
+        stmt.BindBlob(3, miopen::compress(cfg0.kernel_blob, nullptr));
+        stmt.BindText(4, miopen::md5(cfg0.kernel_blob));
+        stmt.BindInt64(5, cfg0.kernel_blob.size());
+        ASSERT_EQ(stmt.Step(sql), SQLITE_DONE);
+    }
+
+    miopen::KernDb db(miopen::DbKinds::KernelDb, temp_file, false);
+    auto readout = db.FindRecordUnsafe(cfg0);
+    ASSERT_TRUE(readout);
+    EXPECT_TRUE(readout.get() == cfg0.kernel_blob);
+    EXPECT_TRUE(db.StoreRecordUnsafe(cfg1));
+    readout = db.FindRecordUnsafe(cfg1);
+    ASSERT_TRUE(readout);
+    EXPECT_TRUE(readout.get() == cfg1.kernel_blob);
+}
 #endif
 
+TEST(CPU_Cache_None, check_program_list)
+{
+    miopen::TempFile temp_file("tmp-program-list");
+    {
+        std::ofstream file{temp_file.Path()};
+        file << "# program\toptions\n"
+             << "MIOpenBatchNormFwdTrainSpatial.cl\t-DMIO_BN_N=64 -DMIO_BN_C=256\n"
+             << "\n"
+             << "naive_conv.cpp\t\n";
+    }
+    const auto programs = miopen::ReadProgramList(temp_file);
+    ASSERT_EQ(programs.size(), 2);
+    EXPECT_EQ(programs[0].first, "MIOpenBatchNormFwdTrainSpatial.cl");
+    EXPECT_EQ(programs[0].second, "-DMIO_BN_N=64 -DMIO_BN_C=256");
+    EXPECT_EQ(programs[1].first, "naive_conv.cpp");
+    EXPECT_EQ(programs[1].second, "");
+
+    {
+        std::ofstream file{temp_file.Path(), std::ios::app};
+        file << "naive_conv.cpp -DNO_TAB\n";
+    }
+    EXPECT_TRUE(throws([&]() { miopen::ReadProgramList(temp_file); }));
+    EXPECT_TRUE(throws([&]() { miopen::ReadProgramList(temp_file.Path() / "missing"); }));
+}
+
 TEST(CPU_Cache_None, check_cache_file)
 {
     auto p = miopen::GetCacheFile("gfx", "base", "args");
@@ -0,0 +1,235 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_server.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/write_file.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_COMPILE_SERVER)
+
+namespace {
+
+namespace fs = miopen::fs;
+
+// Runs a server with a stub compiler, which copies its first argument to its third one after a
+// delay, or fails if the input contains "error". Each run of the compiler is logged.
+struct TestServer
+{
+    miopen::TmpDir dir{"compile_server"};
+    fs::path compiler = dir / "compiler.sh";
+    fs::path socket   = dir / "socket";
+    miopen::compile_server::Server server;
+    std::thread thread;
+
+    explicit TestServer(bool with_cache = true)
+        : server{socket, 2, with_cache ? dir / "cache" : fs::path{}, 0}
+    {
+        miopen::WriteFile("#!/bin/sh\n"
+                          "echo \"$@\" >> " +
+                              (dir / "runs").string() +
+                              "\n"
+                              "sleep 0.2\n"
+                              "grep -q error \"$1\" && exit 3\n"
+                              "cp \"$1\" \"$3\"\n",
+                          compiler);
+        fs::permissions(compiler, fs::perms::owner_all);
+        thread = std::thread{[this] { server.Run(); }};
+    }
+
+    ~TestServer()
+    {
+        server.Stop();
+        thread.join();
+    }
+
+    std::size_t Runs() const
+    {
+        std::ifstream log{dir / "runs"};
+        auto runs = std::size_t{0};
+        for(std::string line; std::getline(log, line);)
+            ++runs;
+        return runs;
+    }
+
+    // Compiles the source in a directory of its own, as the library does.
+    int Compile(const std::string& source, std::string* binary = nullptr) const
+    {
+        const auto src = miopen::TmpDir{"compile_server_client"};
+        miopen::WriteFile(source, src / "kernel.cpp");
+        const auto status = miopen::compile_server::Execute(
+            socket, compiler.string(), "kernel.cpp -o " + (src / "kernel.o").string(), src);
+        EXPECT_TRUE(status);
+        if(binary != nullptr && fs::exists(src / "kernel.o"))
+        {
+            const auto contents = miopen::LoadFile(src / "kernel.o");
+            binary->assign(contents.begin(), contents.end());
+        }
+        return status.value_or(-1);
+    }
+};
+
+} // namespace
+
+TEST(CPU_CompileServer_None, Deduplication)
+{
+    auto server = TestServer{};
+
+    auto clients  = std::vector<std::thread>{};
+    auto statuses = std::vector<int>(8, -1);
+    auto binaries = std::vector<std::string>(statuses.size());
+    for(std::size_t i = 0; i < statuses.size(); ++i)
+        clients.emplace_back([&, i] { statuses[i] = server.Compile("kernel 1", &binaries[i]); });
+    for(auto& client : clients)
+        client.join();
+
+    for(std::size_t i = 0; i < statuses.size(); ++i)
+    {
+        EXPECT_EQ(statuses[i], 0);
+        EXPECT_EQ(binaries[i], "kernel 1");
+    }
+    EXPECT_EQ(server.Runs(), 1u);
+    const auto stats = server.server.GetStats();
+    EXPECT_EQ(stats.requests, statuses.size());
+    EXPECT_EQ(stats.builds, 1u);
+    EXPECT_EQ(stats.deduplicated + stats.cache_hits, statuses.size() - 1);
+
+    // Served from the cache once the build is over.
+    auto binary = std::string{};
+    EXPECT_EQ(server.Compile("kernel 1", &binary), 0);
+    EXPECT_EQ(binary, "kernel 1");
+    EXPECT_EQ(server.Runs(), 1u);
+
+    EXPECT_EQ(server.Compile("kernel 2", &binary), 0);
+    EXPECT_EQ(binary, "kernel 2");
+    EXPECT_EQ(server.Runs(), 2u);
+}
+
+TEST(CPU_CompileServer_None, Failure)
+{
+    auto server = TestServer{};
+
+    auto clients  = std::vector<std::thread>{};
+    auto statuses = std::vector<int>(4, -1);
+    for(auto& status : statuses)
+        clients.emplace_back([&] { status = server.Compile("error"); });
+    for(auto& client : clients)
+        client.join();
+    for(const auto status : statuses)
+        EXPECT_EQ(status, 3);
+    EXPECT_EQ(server.Runs(), 1u);
+
+    // The failures are not cached.
+    EXPECT_EQ(server.Compile("error"), 3);
+    EXPECT_EQ(server.Runs(), 2u);
+}
+
+TEST(CPU_CompileServer_None, NoCache)
+{
+    auto server = TestServer{false};
+    EXPECT_EQ(server.Compile("kernel"), 0);
+    EXPECT_EQ(server.Compile("kernel"), 0);
+    EXPECT_EQ(server.Runs(), 2u);
+}
+
+TEST(CPU_CompileServer_None, TmpDirExecute)
+{
+    const auto src = miopen::TmpDir{"compile_server_client"};
+    miopen::WriteFile(std::string{"kernel"}, src / "kernel.cpp");
+    const auto args = "kernel.cpp -o " + (src / "kernel.o").string();
+
+    {
+        auto server = TestServer{};
+        miopen::env::update(MIOPEN_COMPILE_SERVER, server.socket.string());
+        EXPECT_EQ(src.Execute(server.compiler.string(), args), 0);
+        EXPECT_EQ(server.Runs(), 1u);
+        EXPECT_TRUE(fs::exists(src / "kernel.o"));
+
+        // Without a server the command runs in the process.
+        fs::remove(src / "kernel.o");
+        miopen::env::update(MIOPEN_COMPILE_SERVER, (server.dir / "no_server").string());
+        EXPECT_EQ(src.Execute(server.compiler.string(), args), 0);
+        EXPECT_EQ(server.Runs(), 2u);
+        EXPECT_TRUE(fs::exists(src / "kernel.o"));
+    }
+    miopen::env::clear(MIOPEN_COMPILE_SERVER);
+
+    EXPECT_FALSE(miopen::compile_server::Execute("/nonexistent/socket", "true", "", src));
+}
+
+TEST(CPU_CompileServer_None, MalformedReply)
+{
+    const auto dir    = miopen::TmpDir{"compile_server"};
+    const auto socket = dir / "socket";
+
+    auto address       = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket.c_str(), sizeof(address.sun_path) - 1);
+    const auto listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(listener, 0);
+    ASSERT_EQ(::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+    ASSERT_EQ(::listen(listener, 1), 0);
+
+    // Reads the magic, the directory, the command and the arguments, then replies with a status
+    // that is not a number.
+    auto server = std::thread{[listener] {
+        const auto connection = ::accept(listener, nullptr, nullptr);
+        for(auto i = 0; i < 4; ++i)
+        {
+            auto size = std::uint64_t{0};
+            ::recv(connection, &size, sizeof(size), MSG_WAITALL);
+            auto message = std::string(size, '\0');
+            ::recv(connection, message.data(), size, MSG_WAITALL);
+        }
+        const auto reply = std::string{"12abc"};
+        const auto size  = static_cast<std::uint64_t>(reply.size());
+        ::send(connection, &size, sizeof(size), MSG_NOSIGNAL);
+        ::send(connection, reply.data(), reply.size(), MSG_NOSIGNAL);
+        ::close(connection);
+    }};
+
+    EXPECT_FALSE(miopen::compile_server::Execute(socket, "cc", "-c kernel.cpp", dir));
+    server.join();
+    ::close(listener);
+}
+
+#endif
@@ -0,0 +1,184 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_conv.hpp"
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+struct EngineTestCase
+{
+    std::size_t groups;
+    std::vector<std::size_t> in;  // N, C, spatial
+    std::vector<std::size_t> wei; // K, C / G, spatial
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    miopenTensorLayout_t layout;
+
+    std::vector<std::size_t> GetOutput() const
+    {
+        auto out = std::vector<std::size_t>{in[0], wei[0]};
+        for(std::size_t i = 0; i < pads.size(); ++i)
+            out.push_back((in[i + 2] + 2 * pads[i] - dilations[i] * (wei[i + 2] - 1) - 1) /
+                              strides[i] +
+                          1);
+        return out;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const EngineTestCase& tc)
+    {
+        os << "G:" << tc.groups << " in:";
+        for(auto l : tc.in)
+            os << l << ",";
+        os << " wei:";
+        for(auto l : tc.wei)
+            os << l << ",";
+        return os << " pad:" << tc.pads[0] << " stride:" << tc.strides[0]
+                  << " dilation:" << tc.dilations[0] << " layout:" << tc.layout;
+    }
+};
+
+std::vector<EngineTestCase> EngineTestCases()
+{
+    // clang-format off
+    return {{1, {2, 6, 9, 11},      {4, 6, 3, 3},     {1, 1},    {1, 1},    {1, 1},    miopenTensorNCHW},
+            {1, {2, 6, 9, 11},      {4, 6, 3, 3},     {1, 1},    {1, 1},    {1, 1},    miopenTensorNHWC},
+            {2, {3, 8, 10, 13},     {12, 4, 3, 2},    {2, 0},    {2, 3},    {1, 1},    miopenTensorNCHW},
+            {6, {2, 6, 12, 12},     {6, 1, 5, 3},     {0, 1},    {1, 1},    {2, 2},    miopenTensorNHWC},
+            {2, {2, 4, 7, 20},      {40, 2, 1, 4},    {3, 3},    {3, 2},    {2, 2},    miopenTensorNCHW},
+            {1, {3, 5, 17},         {7, 5, 4},        {1},       {2},       {1},       miopenTensorNCHW},
+            {2, {2, 4, 5, 6, 7},    {6, 2, 3, 3, 2},  {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, miopenTensorNCDHW},
+            {1, {1, 3, 4, 9, 5},    {5, 3, 2, 3, 3},  {2, 2, 2}, {2, 1, 2}, {2, 2, 1}, miopenTensorNDHWC}};
+    // clang-format on
+}
+
+template <class T>
+tensor<T> RandomTensor(miopenTensorLayout_t layout, const std::vector<std::size_t>& dims)
+{
+    // The 1D case has no layout of its own, the default packed descriptor is NCW.
+    auto result = dims.size() == 3 ? tensor<T>{dims} : tensor<T>{layout, dims};
+    auto gen    = std::mt19937{static_cast<unsigned>(dims.size() * 1000 + result.data.size())};
+    auto dist   = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+    for(auto& value : result.data)
+        value = static_cast<T>(dist(gen));
+    return result;
+}
+
+template <std::size_t ConvDim>
+void CheckEngine(const EngineTestCase& tc)
+{
+    const auto in  = RandomTensor<float>(tc.layout, tc.in);
+    const auto wei = RandomTensor<float>(tc.layout, tc.wei);
+    const auto out = RandomTensor<float>(tc.layout, tc.GetOutput());
+    const auto fi  = PassThru<float>{};
+
+    // The default (deterministic) order shall reproduce the element-wise implementation exactly.
+    auto out_ref = out;
+    auto out_new = out;
+    cpu_convolution_forward_impl<ConvDim, double>(
+        in, wei, out_ref, tc.pads, tc.strides, tc.dilations, tc.groups, fi, fi);
+    cpu_convolution_forward(
+        ConvDim, in, wei, out_new, tc.pads, tc.strides, tc.dilations, tc.groups);
+    EXPECT_EQ(out_ref.data, out_new.data) << tc;
+
+    auto in_ref = in;
+    auto in_new = in;
+    cpu_convolution_backward_data_impl<ConvDim, double>(
+        in_ref, wei, out, tc.pads, tc.strides, tc.dilations, tc.groups, fi, fi);
+    cpu_convolution_backward_data(
+        ConvDim, in_new, wei, out, tc.pads, tc.strides, tc.dilations, tc.groups);
+    EXPECT_EQ(in_ref.data, in_new.data) << tc;
+
+    auto wei_ref = wei;
+    auto wei_new = wei;
+    cpu_convolution_backward_weight_impl<ConvDim, double>(
+        in, wei_ref, out, tc.pads, tc.strides, tc.dilations, tc.groups, fi, fi);
+    cpu_convolution_backward_weight(
+        ConvDim, in, wei_new, out, tc.pads, tc.strides, tc.dilations, tc.groups);
+    EXPECT_EQ(wei_ref.data, wei_new.data) << tc;
+
+    // The relaxed order only changes the rounding.
+    auto problem = cpu_conv::problem<ConvDim>{};
+    ASSERT_TRUE(make_cpu_conv_problem(
+        in, wei_new, out, tc.pads, tc.strides, tc.dilations, tc.groups, problem));
+    cpu_conv::backward_weight<ConvDim, double>(problem,
+                                               in.data.data(),
+                                               wei_new.data.data(),
+                                               out.data.data(),
+                                               fi,
+                                               fi,
+                                               cpu_conv::accumulation_order::relaxed);
+    for(std::size_t i = 0; i < wei_ref.data.size(); ++i)
+        ASSERT_NEAR(wei_ref.data[i], wei_new.data[i], 1e-4) << tc;
+}
+
+} // namespace
+
+struct CPU_ConvReference_None : testing::TestWithParam<EngineTestCase>
+{
+};
+
+TEST_P(CPU_ConvReference_None, MatchesElementwise)
+{
+    const auto& tc = GetParam();
+    switch(tc.pads.size())
+    {
+    case 1: CheckEngine<1>(tc); break;
+    case 2: CheckEngine<2>(tc); break;
+    case 3: CheckEngine<3>(tc); break;
+    default: FAIL() << "Unsupported spatial dimension";
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Full, CPU_ConvReference_None, testing::ValuesIn(EngineTestCases()));
+
+TEST(CPU_ConvReferenceMixedTypes_None, BackwardDataStoresInputType)
+{
+    // The input gradient has the type of the input, which differs from the one of the output.
+    const auto tc  = EngineTestCases()[0];
+    auto in_ref    = tensor<float>{tc.layout, tc.in};
+    const auto wei = RandomTensor<float>(tc.layout, tc.wei);
+    auto out       = tensor<int8_t>{tc.layout, tc.GetOutput()};
+    for(std::size_t i = 0; i < out.data.size(); ++i)
+        out.data[i] = static_cast<int8_t>(i % 5) - 2;
+    const auto fw = PassThru<float>{};
+    const auto fo = [](int8_t x) { return static_cast<double>(x); };
+
+    auto in_new = in_ref;
+    cpu_convolution_backward_data_impl<2, double>(
+        in_ref, wei, out, tc.pads, tc.strides, tc.dilations, tc.groups, fw, fo);
+    auto problem = cpu_conv::problem<2>{};
+    ASSERT_TRUE(make_cpu_conv_problem(
+        in_new, wei, out, tc.pads, tc.strides, tc.dilations, tc.groups, problem));
+    cpu_conv::backward_data<2, double>(
+        problem, in_new.data.data(), wei.data.data(), out.data.data(), fw, fo);
+    EXPECT_EQ(in_ref.data, in_new.data);
+}
@@ -0,0 +1,310 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "cpu_norm.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+std::vector<float> RandomData(std::size_t size, float offset, unsigned seed)
+{
+    auto gen    = std::mt19937{seed};
+    auto dist   = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+    auto result = std::vector<float>(size);
+    for(auto& value : result)
+        value = dist(gen) + offset;
+    return result;
+}
+
+struct Moments
+{
+    double mean;
+    double variance;
+};
+
+// Two-pass statistics of the values at the given offsets.
+Moments ComputeMoments(const std::vector<float>& data, const std::vector<std::size_t>& offsets)
+{
+    auto mean = 0.0;
+    for(auto i : offsets)
+        mean += data[i];
+    mean /= offsets.size();
+    auto variance = 0.0;
+    for(auto i : offsets)
+        variance += (data[i] - mean) * (data[i] - mean);
+    return {mean, variance / offsets.size()};
+}
+
+struct BatchNormTestCase
+{
+    miopenBatchNormMode_t mode;
+    std::size_t n, c, d, h, w;
+    bool channels_last;
+
+    friend std::ostream& operator<<(std::ostream& os, const BatchNormTestCase& tc)
+    {
+        return os << "mode:" << tc.mode << " N:" << tc.n << " C:" << tc.c << " D:" << tc.d
+                  << " H:" << tc.h << " W:" << tc.w << " channels_last:" << tc.channels_last;
+    }
+};
+
+std::vector<BatchNormTestCase> BatchNormTestCases()
+{
+    return {{miopenBNSpatial, 5, 3, 1, 7, 9, false},
+            {miopenBNSpatial, 5, 3, 1, 7, 9, true},
+            {miopenBNSpatial, 2, 4, 3, 5, 6, false},
+            {miopenBNSpatial, 1, 2, 1, 33, 40, false},
+            {miopenBNPerActivation, 5, 3, 1, 7, 9, false},
+            {miopenBNPerActivation, 6, 3, 1, 5, 4, true},
+            {miopenBNPerActivation, 3, 2, 3, 4, 70, false}};
+}
+
+cpu_norm::batchnorm_problem MakeProblem(const BatchNormTestCase& tc)
+{
+    auto p = cpu_norm::make_batchnorm_problem(tc.mode, tc.n, tc.c, tc.d, tc.h, tc.w);
+    if(tc.channels_last)
+        p.strides = {tc.c * tc.d * tc.h * tc.w, 1, tc.h * tc.w * tc.c, tc.w * tc.c, tc.c};
+    return p;
+}
+
+} // namespace
+
+struct CPU_NormReference_None : testing::TestWithParam<BatchNormTestCase>
+{
+};
+
+TEST_P(CPU_NormReference_None, BatchNorm)
+{
+    const auto& tc    = GetParam();
+    const auto p      = MakeProblem(tc);
+    const auto size   = tc.n * tc.c * p.spatial_size();
+    const auto params = tc.mode == miopenBNSpatial ? tc.c : tc.c * p.spatial_size();
+    const auto eps    = 1e-5;
+
+    // A large mean makes the E[x^2] - E[x]^2 form lose the variance.
+    const auto x     = RandomData(size, 100.0f, 1);
+    const auto dy    = RandomData(size, 0.0f, 2);
+    const auto scale = RandomData(params, 1.0f, 3);
+    const auto bias  = RandomData(params, 0.0f, 4);
+
+    auto y            = std::vector<float>(size);
+    auto save_mean    = std::vector<float>(params);
+    auto save_inv_var = std::vector<float>(params);
+    auto run_mean     = std::vector<float>(params, 0.5f);
+    auto run_var      = std::vector<float>(params, 2.0f);
+    cpu_norm::batchnorm_forward_training<double>(p,
+                                                 x.data(),
+                                                 y.data(),
+                                                 scale.data(),
+                                                 bias.data(),
+                                                 eps,
+                                                 0.1,
+                                                 save_mean.data(),
+                                                 save_inv_var.data(),
+                                                 run_mean.data(),
+                                                 run_var.data());
+
+    // The saved statistics are not passed, so that the backward pass recomputes them.
+    auto dx     = std::vector<float>(size);
+    auto dscale = std::vector<float>(params);
+    auto dbias  = std::vector<float>(params);
+    float* none = nullptr;
+    cpu_norm::batchnorm_backward<double>(p,
+                                         x.data(),
+                                         dy.data(),
+                                         dx.data(),
+                                         scale.data(),
+                                         dscale.data(),
+                                         dbias.data(),
+                                         eps,
+                                         none,
+                                         none);
+
+    for(std::size_t k = 0; k < params; ++k)
+    {
+        // The offsets of the values reduced into the k-th statistic.
+        auto offsets = std::vector<std::size_t>{};
+        for(std::size_t n = 0; n < tc.n; ++n)
+        {
+            for(std::size_t s = 0; s < p.spatial_size(); ++s)
+            {
+                const auto c = tc.mode == miopenBNSpatial ? k : k / p.spatial_size();
+                if(tc.mode == miopenBNPerActivation && s != k % p.spatial_size())
+                    continue;
+                const auto w = s % tc.w;
+                const auto h = s / tc.w % tc.h;
+                const auto d = s / tc.w / tc.h;
+                offsets.push_back(n * p.strides[0] + c * p.strides[1] + d * p.strides[2] +
+                                  h * p.strides[3] + w * p.strides[4]);
+            }
+        }
+
+        const auto m   = ComputeMoments(x, offsets);
+        const auto inv = 1.0 / std::sqrt(m.variance + eps);
+        const auto cnt = static_cast<double>(offsets.size());
+        ASSERT_NEAR(save_mean[k], m.mean, 1e-4) << tc;
+        ASSERT_NEAR(save_inv_var[k], inv, 1e-3 * inv) << tc;
+        ASSERT_NEAR(run_mean[k], 0.45 + 0.1 * m.mean, 1e-4) << tc;
+        ASSERT_NEAR(run_var[k], 1.8 + 0.1 * m.variance * cnt / (cnt - 1), 1e-4) << tc;
+
+        auto db = 0.0;
+        auto ds = 0.0;
+        for(auto i : offsets)
+        {
+            const auto xhat = (x[i] - m.mean) * inv;
+            ASSERT_NEAR(y[i], scale[k] * xhat + bias[k], 1e-4) << tc;
+            db += dy[i];
+            ds += xhat * dy[i];
+        }
+        ASSERT_NEAR(dbias[k], db, 1e-3) << tc;
+        ASSERT_NEAR(dscale[k], ds, 1e-3) << tc;
+        for(auto i : offsets)
+        {
+            const auto xhat = (x[i] - m.mean) * inv;
+            const auto ref  = scale[k] * inv / cnt * (cnt * dy[i] - db - xhat * ds);
+            ASSERT_NEAR(dx[i], ref, 1e-3) << tc;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Full, CPU_NormReference_None, testing::ValuesIn(BatchNormTestCases()));
+
+TEST(CPU_NormReference_None, RowNorms)
+{
+    const std::size_t outer = 37;
+    const std::size_t inner = 1000;
+    const auto eps          = 1e-5;
+
+    const auto x      = RandomData(outer * inner, 100.0f, 5);
+    const auto x2     = RandomData(outer * inner, 0.0f, 6);
+    const auto weight = RandomData(inner, 1.0f, 7);
+    const auto bias   = RandomData(inner, 0.0f, 8);
+    const auto dy     = RandomData(outer * inner, 0.0f, 9);
+
+    auto y    = std::vector<float>(outer * inner);
+    auto mean = std::vector<float>(outer);
+    auto rstd = std::vector<float>(outer);
+    auto sum  = std::vector<float>(outer * inner);
+    for(std::size_t i = 0; i < sum.size(); ++i)
+        sum[i] = x[i] + x2[i];
+
+    cpu_norm::add_layernorm_forward<double>(outer,
+                                            inner,
+                                            x.data(),
+                                            x2.data(),
+                                            weight.data(),
+                                            bias.data(),
+                                            y.data(),
+                                            mean.data(),
+                                            rstd.data(),
+                                            eps);
+    for(std::size_t o = 0; o < outer; ++o)
+    {
+        auto offsets = std::vector<std::size_t>(inner);
+        for(std::size_t i = 0; i < inner; ++i)
+            offsets[i] = o * inner + i;
+        const auto m = ComputeMoments(sum, offsets);
+        const auto r = 1.0 / std::sqrt(m.variance + eps);
+        ASSERT_NEAR(mean[o], m.mean, 1e-4);
+        ASSERT_NEAR(rstd[o], r, 1e-4 * r);
+        for(std::size_t i = 0; i < inner; ++i)
+        {
+            const auto j = o * inner + i;
+            ASSERT_NEAR(y[j], (sum[j] - m.mean) * r * weight[i] + bias[i], 1e-4);
+        }
+    }
+
+    // Group norm is a layer norm with a weight and a bias per channel.
+    const std::size_t channels = 8;
+    const std::size_t groups   = 4;
+    const std::size_t spatial  = inner / channels;
+    auto group_mean            = std::vector<float>(outer * groups);
+    auto group_rstd            = std::vector<float>(outer * groups);
+    cpu_norm::groupnorm_forward<double>(outer,
+                                        channels,
+                                        spatial,
+                                        groups,
+                                        x.data(),
+                                        weight.data(),
+                                        bias.data(),
+                                        y.data(),
+                                        group_mean.data(),
+                                        group_rstd.data(),
+                                        eps);
+    for(std::size_t g = 0; g < outer * groups; ++g)
+    {
+        auto offsets = std::vector<std::size_t>(inner / groups);
+        for(std::size_t i = 0; i < offsets.size(); ++i)
+            offsets[i] = g * offsets.size() + i;
+        const auto m = ComputeMoments(x, offsets);
+        const auto r = 1.0 / std::sqrt(m.variance + eps);
+        ASSERT_NEAR(group_mean[g], m.mean, 1e-4);
+        ASSERT_NEAR(group_rstd[g], r, 1e-4 * r);
+        for(auto i : offsets)
+        {
+            const auto c = i / spatial % channels;
+            ASSERT_NEAR(y[i], (x[i] - m.mean) * r * weight[c] + bias[c], 1e-4);
+        }
+    }
+
+    auto dx = std::vector<float>(outer * inner);
+    auto dw = std::vector<double>(inner);
+    cpu_norm::rmsnorm_forward<double>(
+        outer, inner, x2.data(), weight.data(), y.data(), rstd.data(), eps);
+    cpu_norm::rmsnorm_backward<double>(
+        outer, inner, dy.data(), x2.data(), weight.data(), rstd.data(), dx.data());
+    cpu_norm::rmsnorm_backward_weight<double>(
+        outer, inner, dy.data(), x2.data(), rstd.data(), dw.data());
+    auto dw_ref = std::vector<double>(inner);
+    for(std::size_t o = 0; o < outer; ++o)
+    {
+        auto ss  = 0.0;
+        auto dot = 0.0;
+        for(std::size_t i = 0; i < inner; ++i)
+        {
+            const auto v = static_cast<double>(x2[o * inner + i]);
+            ss += v * v;
+            dot += dy[o * inner + i] * v * weight[i];
+            dw_ref[i] += dy[o * inner + i] * v * rstd[o];
+        }
+        const auto r = 1.0 / std::sqrt(ss / inner + eps);
+        const auto a = dot * rstd[o] * rstd[o] * rstd[o] / inner;
+        ASSERT_NEAR(rstd[o], r, 1e-4 * r);
+        for(std::size_t i = 0; i < inner; ++i)
+        {
+            const auto j = o * inner + i;
+            ASSERT_NEAR(y[j], x2[j] * r * weight[i], 1e-4);
+            ASSERT_NEAR(dx[j], rstd[o] * dy[j] * weight[i] - a * x2[j], 1e-4);
+        }
+    }
+    for(std::size_t i = 0; i < inner; ++i)
+        ASSERT_NEAR(dw[i], dw_ref[i], 1e-6);
+}
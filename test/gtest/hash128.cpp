@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_path.hpp>
+#include <miopen/filesystem.hpp>
+#include <miopen/hash128.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+const std::string Fox = "The quick brown fox jumps over the lazy dog";
+
+/// The problem keys of the installed text find databases.
+std::vector<std::string> InstalledDbKeys()
+{
+    std::vector<std::string> keys;
+    const auto dir = miopen::GetSystemDbPath();
+    if(!miopen::fs::is_directory(dir))
+        return keys;
+    for(const auto& entry : miopen::fs::directory_iterator(dir))
+    {
+        const auto name = entry.path().filename().string();
+        if(name.size() < 8 || name.compare(name.size() - 8, 8, ".fdb.txt") != 0)
+            continue;
+        std::ifstream file{entry.path()};
+        std::string line;
+        while(std::getline(file, line))
+        {
+            const auto eq = line.find('=');
+            if(eq != std::string::npos)
+                keys.push_back(line.substr(0, eq));
+        }
+    }
+    return keys;
+}
+
+} // namespace
+
+TEST(CPU_Hash128_None, KnownValues)
+{
+    // The reference values of MurmurHash3 x64_128 with the seed 0.
+    EXPECT_EQ(miopen::Hash128(std::string_view{}), (miopen::Digest128{0, 0}));
+    const auto fox = miopen::Hash128(Fox);
+    EXPECT_EQ(fox.lo, 0xe34bbc7bbc071b6cULL);
+    EXPECT_EQ(fox.hi, 0x7a433ca9c49a9347ULL);
+    EXPECT_EQ(fox.ToString(), "7a433ca9c49a9347e34bbc7bbc071b6c");
+    EXPECT_EQ(miopen::Hash128(std::vector<char>(Fox.begin(), Fox.end())), fox);
+    EXPECT_NE(miopen::Hash128(Fox + "."), fox);
+    EXPECT_NE(miopen::Hash128Stream{1}.Update(Fox).Final(), fox);
+}
+
+TEST(CPU_Hash128_None, Streaming)
+{
+    auto data = std::string(300, ' ');
+    for(std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<char>(i * 7);
+    const auto expected = miopen::Hash128(data);
+
+    for(std::size_t first = 0; first <= data.size(); first += 7)
+    {
+        for(std::size_t second = first; second <= data.size(); second += 11)
+        {
+            auto stream = miopen::Hash128Stream{};
+            stream.Update(data.substr(0, first));
+            stream.Update(data.substr(first, second - first));
+            stream.Update(data.substr(second));
+            ASSERT_EQ(stream.Final(), expected) << first << " " << second;
+        }
+    }
+
+    // Final() leaves the state intact.
+    auto stream = miopen::Hash128Stream{};
+    stream.Update(data.substr(0, 100));
+    EXPECT_EQ(stream.Final(), miopen::Hash128(data.substr(0, 100)));
+    stream.Update(data.substr(100));
+    EXPECT_EQ(stream.Final(), expected);
+}
+
+TEST(CPU_Hash128_None, NoCollisionsInInstalledDbs)
+{
+    const auto keys = InstalledDbKeys();
+    if(keys.empty())
+        GTEST_SKIP() << "No find databases in " << miopen::GetSystemDbPath();
+
+    // The low half alone is used as the hash of the containers and the network configs.
+    auto digests = std::unordered_map<miopen::Digest128, const std::string*>{};
+    auto halves  = std::unordered_map<std::uint64_t, const std::string*>{};
+    for(const auto& key : keys)
+    {
+        const auto digest = miopen::Hash128(key);
+        const auto full   = digests.emplace(digest, &key);
+        if(!full.second && *full.first->second != key)
+            ADD_FAILURE() << "Collision: " << key << " and " << *full.first->second;
+        const auto half = halves.emplace(digest.lo, &key);
+        if(!half.second && *half.first->second != key)
+            ADD_FAILURE() << "64-bit collision: " << key << " and " << *half.first->second;
+    }
+    std::cout << keys.size() << " keys, " << digests.size() << " distinct" << std::endl;
+}
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <half/half.hpp>
+
+#include <miopen/bfloat16.hpp>
+#include <miopen/host_gemm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+struct GemmCase
+{
+    std::size_t m;
+    std::size_t n;
+    std::size_t k;
+    bool trans_a;
+    bool trans_b;
+};
+
+template <class T>
+std::vector<T> RandomMatrix(std::size_t rows, std::size_t stride, std::mt19937& gen)
+{
+    auto dist   = std::uniform_real_distribution<float>{-1.0f, 1.0f};
+    auto result = std::vector<T>(rows * stride);
+    for(auto& value : result)
+        value = static_cast<T>(dist(gen));
+    return result;
+}
+
+template <class T>
+void CheckGemm(const GemmCase& test_case, double tolerance)
+{
+    const auto [m, n, k, trans_a, trans_b] = test_case;
+
+    // Padded strides check that the leading dimensions are honored.
+    const auto lda = (trans_a ? m : k) + 3;
+    const auto ldb = (trans_b ? k : n) + 5;
+    const auto ldc = n + 7;
+
+    auto gen = std::mt19937{static_cast<unsigned>(m * 131 + n * 17 + k)};
+    const auto a = RandomMatrix<T>(trans_a ? k : m, lda, gen);
+    const auto b = RandomMatrix<T>(trans_b ? n : k, ldb, gen);
+    auto c       = RandomMatrix<T>(m, ldc, gen);
+    const auto c_in = c;
+
+    const auto alpha = 0.75;
+    const auto beta  = 0.5;
+    miopen::host_gemm::Gemm(
+        trans_a, trans_b, m, n, k, alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc);
+
+    for(std::size_t i = 0; i < m; ++i)
+    {
+        for(std::size_t j = 0; j < ldc; ++j)
+        {
+            if(j >= n)
+            {
+                // The padding is not touched.
+                ASSERT_EQ(static_cast<double>(c[i * ldc + j]),
+                          static_cast<double>(c_in[i * ldc + j]));
+                continue;
+            }
+
+            auto expected = 0.0;
+            for(std::size_t p = 0; p < k; ++p)
+                expected += static_cast<double>(trans_a ? a[p * lda + i] : a[i * lda + p]) *
+                            static_cast<double>(trans_b ? b[j * ldb + p] : b[p * ldb + j]);
+            expected = beta * static_cast<double>(c_in[i * ldc + j]) + alpha * expected;
+
+            ASSERT_NEAR(static_cast<double>(c[i * ldc + j]),
+                        expected,
+                        tolerance * std::max(1.0, std::sqrt(static_cast<double>(k))))
+                << "m=" << m << " n=" << n << " k=" << k << " trans_a=" << trans_a
+                << " trans_b=" << trans_b << " i=" << i << " j=" << j;
+        }
+    }
+}
+
+std::vector<GemmCase> GemmCases()
+{
+    auto cases = std::vector<GemmCase>{};
+    // Below the packing threshold, single tile with partial slivers, several tiles of all
+    // kinds of partial blocks (run in parallel), and several blocks along k.
+    for(const auto& [m, n, k] : {std::make_tuple(1, 1, 1),
+                                 std::make_tuple(7, 13, 5),
+                                 std::make_tuple(17, 19, 23),
+                                 std::make_tuple(97, 131, 300),
+                                 std::make_tuple(200, 270, 520)})
+    {
+        for(const auto trans_a : {false, true})
+            for(const auto trans_b : {false, true})
+                cases.push_back({static_cast<std::size_t>(m),
+                                 static_cast<std::size_t>(n),
+                                 static_cast<std::size_t>(k),
+                                 trans_a,
+                                 trans_b});
+    }
+    return cases;
+}
+
+} // namespace
+
+TEST(CPU_HostGemm_None, Float)
+{
+    for(const auto& test_case : GemmCases())
+        CheckGemm<float>(test_case, 1e-5);
+}
+
+TEST(CPU_HostGemm_None, Double)
+{
+    for(const auto& test_case : GemmCases())
+        CheckGemm<double>(test_case, 1e-12);
+}
+
+TEST(CPU_HostGemm_None, Half)
+{
+    // Accumulated in float, the only error is the rounding of the result.
+    for(const auto& test_case : GemmCases())
+        CheckGemm<half_float::half>(test_case, 1e-2);
+}
+
+TEST(CPU_HostGemm_None, BFloat16)
+{
+    for(const auto& test_case : GemmCases())
+        CheckGemm<bfloat16>(test_case, 1e-2);
+}
+
+TEST(CPU_HostGemm_None, Accessors)
+{
+    // c(i, j, x) shall be called exactly once per element.
+    const std::size_t m = 150, n = 140, k = 70;
+    auto calls          = std::vector<int>(m * n, 0);
+    auto result         = std::vector<double>(m * n, 0.0);
+
+    miopen::host_gemm::Gemm<double>(
+        m,
+        n,
+        k,
+        [](std::size_t i, std::size_t p) { return static_cast<double>(i + p); },
+        [](std::size_t p, std::size_t j) { return static_cast<double>(p * 3) - j; },
+        [&](std::size_t i, std::size_t j, double x) {
+            ++calls[i * n + j];
+            result[i * n + j] = x;
+        });
+
+    for(std::size_t i = 0; i < m; ++i)
+    {
+        for(std::size_t j = 0; j < n; ++j)
+        {
+            auto expected = 0.0;
+            for(std::size_t p = 0; p < k; ++p)
+                expected += static_cast<double>(i + p) * (static_cast<double>(p * 3) - j);
+            ASSERT_EQ(calls[i * n + j], 1);
+            ASSERT_EQ(result[i * n + j], expected);
+        }
+    }
+}
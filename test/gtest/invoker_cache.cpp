@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/invoker_cache.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct TestInvoker
+{
+    int id;
+    void operator()(const miopen::Handle&, const miopen::AnyInvokeParams&) const {}
+};
+
+int GetId(const std::optional<miopen::Invoker>& invoker)
+{
+    if(!invoker || invoker->target<TestInvoker>() == nullptr)
+        return -1;
+    return invoker->target<TestInvoker>()->id;
+}
+
+} // namespace
+
+TEST(CPU_InvokerCache_None, RegisterAndGet)
+{
+    miopen::InvokerCache cache;
+    const miopen::NetworkConfig config{"1x2x3"};
+
+    EXPECT_FALSE(cache.GetInvoker(config, "SolverA"));
+    cache.Register(config, "SolverA", TestInvoker{1});
+    cache.Register(config, "SolverB", TestInvoker{2});
+    // The first registered invoker is kept.
+    cache.Register(config, "SolverA", TestInvoker{3});
+
+    EXPECT_EQ(GetId(cache.GetInvoker(config, "SolverA")), 1);
+    EXPECT_EQ(GetId(cache.GetInvoker(miopen::NetworkConfig{"1x2x3"}, "SolverB")), 2);
+    EXPECT_FALSE(cache.GetInvoker(miopen::NetworkConfig{"1x2x4"}, "SolverA"));
+}
+
+TEST(CPU_InvokerCache_None, Found1_0)
+{
+    miopen::InvokerCache cache;
+    const miopen::NetworkConfig config{"1x2x3"};
+    const miopen::AlgorithmName algo{"miopenConvolutionFwdAlgoDirect"};
+
+    EXPECT_THROW(cache.SetAsFound1_0(config, algo, "SolverA"), miopen::Exception);
+    EXPECT_FALSE(cache.GetFound1_0(config, algo));
+
+    cache.Register(config, "SolverA", TestInvoker{1});
+    cache.Register(config, "SolverB", TestInvoker{2});
+    cache.SetAsFound1_0(config, algo, "SolverA");
+    EXPECT_EQ(cache.GetFound1_0SolverId(config, algo), "SolverA");
+    EXPECT_EQ(GetId(cache.GetFound1_0(config, algo)), 1);
+
+    cache.SetAsFound1_0(config, algo, "SolverB");
+    EXPECT_EQ(cache.GetFound1_0SolverId(config, algo), "SolverB");
+    EXPECT_EQ(GetId(cache.GetFound1_0(config, algo)), 2);
+}
+
+TEST(CPU_InvokerCache_None, ConcurrentRegisterAndGet)
+{
+    constexpr int writers  = 4;
+    constexpr int readers  = 4;
+    constexpr int problems = 2000;
+
+    miopen::InvokerCache cache;
+    std::vector<miopen::NetworkConfig> configs;
+    for(int i = 0; i < problems; ++i)
+        configs.emplace_back("problem" + std::to_string(i));
+
+    std::atomic<bool> mismatch{false};
+    std::vector<std::thread> threads;
+    for(int w = 0; w < writers; ++w)
+    {
+        threads.emplace_back([&, w] {
+            for(int i = w; i < problems; i += writers)
+            {
+                cache.Register(configs[i], "Solver", TestInvoker{i});
+            }
+        });
+    }
+    for(int r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&] {
+            for(int pass = 0; pass < 10; ++pass)
+            {
+                for(const auto& config : configs)
+                {
+                    const auto invoker = cache.GetInvoker(config, "Solver");
+                    if(invoker && GetId(invoker) != std::stoi(config.ToString().substr(7)))
+                        mismatch = true;
+                }
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_FALSE(mismatch);
+    for(const auto& config : configs)
+    {
+        EXPECT_TRUE(cache.GetInvoker(config, "Solver"));
+        EXPECT_FALSE(cache.GetInvoker(config, "Other"));
+    }
+}
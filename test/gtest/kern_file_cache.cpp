@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/errors.hpp>
+#include <miopen/kern_file_cache.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/write_file.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+miopen::fs::path MakeBinary(const miopen::TmpDir& dir, const std::string& contents)
+{
+    static auto n = 0;
+    auto path     = dir.path / ("binary" + std::to_string(n++));
+    miopen::WriteFile(contents, path);
+    return path;
+}
+
+std::string MakeContents(int i, std::size_t size = 1000)
+{
+    auto contents = std::string(size, 'x');
+    contents.replace(0, std::to_string(i).size(), std::to_string(i));
+    return contents;
+}
+
+std::string Read(const miopen::fs::path& path)
+{
+    const auto contents = miopen::LoadFile(path);
+    return {contents.begin(), contents.end()};
+}
+
+} // namespace
+
+TEST(CPU_KernFileCache_None, StoreFind)
+{
+    const auto dir = miopen::TmpDir{"kern_file_cache"};
+    auto cache     = miopen::KernFileCache{dir.path / "cache", 0};
+
+    EXPECT_TRUE(cache.Find("gfx90a:-O3:a.o").empty());
+
+    const auto binary = MakeBinary(dir, MakeContents(0));
+    const auto path   = cache.Store(binary, "gfx90a:-O3:a.o");
+    EXPECT_FALSE(miopen::fs::exists(binary));
+    EXPECT_EQ(cache.Find("gfx90a:-O3:a.o"), path);
+    EXPECT_EQ(Read(path), MakeContents(0));
+    EXPECT_TRUE(cache.Find("gfx90a:-O2:a.o").empty());
+
+    // Replaces the binary of the key, the previous one is collected.
+    cache.Store(MakeBinary(dir, MakeContents(1)), "gfx90a:-O3:a.o");
+    EXPECT_EQ(Read(cache.Find("gfx90a:-O3:a.o")), MakeContents(1));
+    cache.Gc();
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.keys, 1);
+    EXPECT_EQ(stats.objects, 1);
+    EXPECT_EQ(stats.bytes, MakeContents(1).size());
+}
+
+TEST(CPU_KernFileCache_None, Deduplication)
+{
+    const auto dir = miopen::TmpDir{"kern_file_cache"};
+    auto cache     = miopen::KernFileCache{dir.path / "cache", 0};
+
+    const auto a = cache.Store(MakeBinary(dir, MakeContents(0)), "gfx90a:-O3:a.o");
+    const auto b = cache.Store(MakeBinary(dir, MakeContents(0)), "gfx90a:-O3:b.o");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(Read(a), Read(b));
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.keys, 2);
+    EXPECT_EQ(stats.objects, 1);
+    if(miopen::fs::hard_link_count(a) > 1)
+        EXPECT_EQ(stats.bytes, MakeContents(0).size());
+}
+
+TEST(CPU_KernFileCache_None, LeastRecentlyUsedEviction)
+{
+    const auto dir         = miopen::TmpDir{"kern_file_cache"};
+    const auto binary_size = std::size_t{1000};
+    auto cache             = miopen::KernFileCache{dir.path / "cache", 10 * binary_size};
+
+    const auto key = [](int i) { return "gfx90a:-DN=" + std::to_string(i) + ":a.o"; };
+    // The access times are in milliseconds.
+    const auto tick = [] { std::this_thread::sleep_for(std::chrono::milliseconds{2}); };
+
+    for(auto i = 0; i < 10; ++i)
+    {
+        cache.Store(MakeBinary(dir, MakeContents(i, binary_size)), key(i));
+        tick();
+    }
+    EXPECT_EQ(cache.GetStats().keys, 10);
+
+    EXPECT_FALSE(cache.Find(key(0)).empty());
+    tick();
+
+    // Outgrows the limit and evicts down to 90% of it.
+    cache.Store(MakeBinary(dir, MakeContents(10, binary_size)), key(10));
+
+    EXPECT_FALSE(cache.Find(key(0)).empty());
+    EXPECT_TRUE(cache.Find(key(1)).empty());
+    EXPECT_TRUE(cache.Find(key(2)).empty());
+    for(auto i = 3; i <= 10; ++i)
+        EXPECT_FALSE(cache.Find(key(i)).empty());
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.keys, 9);
+    EXPECT_EQ(stats.bytes, 9 * binary_size);
+}
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace {
+
+// Independent of the scanner used by the build, so that the two check each other.
+std::set<std::string> DirectIncludes(std::string_view text)
+{
+    std::set<std::string> includes;
+    std::istringstream lines{std::string{text}};
+    for(std::string line; std::getline(lines, line);)
+    {
+        std::istringstream words{line};
+        std::string word;
+        words >> word;
+        if(word != "#include")
+            continue;
+        const auto first = line.find_first_of("\"<", word.size());
+        const auto last  = line.find_first_of("\">", first + 1);
+        if(first == std::string::npos || last == std::string::npos)
+            continue;
+        const auto path = miopen::fs::path{line.substr(first + 1, last - first - 1)};
+        includes.insert(path.filename().string());
+    }
+    return includes;
+}
+
+std::string_view GetText(const miopen::fs::path& name)
+{
+    const auto is_header = name.extension() == ".hpp" || name.extension() == ".h";
+    return is_header ? miopen::GetKernelInc(name) : miopen::GetKernelSrc(name);
+}
+
+void CheckClosure(const miopen::fs::path& name)
+{
+    std::set<std::string> headers;
+    for(const auto& header : miopen::GetKernelIncList())
+        headers.insert(header.get().string());
+
+    std::set<std::string> closure;
+    for(const auto& header : miopen::GetKernelIncList(name, GetText(name)))
+        closure.insert(header.get().string());
+
+    auto files = closure;
+    files.insert(name.string());
+    for(const auto& file : files)
+    {
+        for(const auto& include : DirectIncludes(GetText(file)))
+        {
+            if(headers.count(include) != 0)
+                EXPECT_EQ(closure.count(include), 1) << include << " in " << file << " of " << name;
+        }
+    }
+}
+
+} // namespace
+
+TEST(CPU_KernelIncludes_None, HeaderClosures)
+{
+    for(const auto& header : miopen::GetKernelIncList())
+        CheckClosure(header.get());
+}
+
+TEST(CPU_KernelIncludes_None, SourceClosures)
+{
+    for(const auto name : {"MIOpenAdam.cpp",
+                           "MIOpenCat.cpp",
+                           "MIOpenGetitem.cpp",
+                           "MIOpenGroupNorm.cpp",
+                           "MIOpenLayerNorm.cpp",
+                           "MIOpenReduceCalculation.cpp",
+                           "MIOpenReduceExtreme.cpp",
+                           "MIOpenSoftmaxAttn.cpp",
+                           "naive_conv.cpp",
+                           "fp8_naive_conv.cpp",
+                           "batched_transpose.cpp",
+                           "general_tensor_reorder_16x256_dword.cpp"})
+    {
+        CheckClosure(name);
+    }
+
+    const auto name = miopen::fs::path{"MIOpenLayerNorm.cpp"};
+    EXPECT_LT(miopen::GetKernelIncList(name, GetText(name)).size(),
+              miopen::GetKernelIncList().size());
+}
+
+TEST(CPU_KernelIncludes_None, ModifiedSource)
+{
+    const auto name = miopen::fs::path{"MIOpenLayerNorm.cpp"};
+    const auto src  = std::string{GetText(name)} + "\n#include \"hip_atomic.hpp\"\n";
+    EXPECT_EQ(miopen::GetKernelIncList(name, src).size(), miopen::GetKernelIncList().size());
+    EXPECT_EQ(miopen::GetKernelIncList("unknown.cpp", "").size(),
+              miopen::GetKernelIncList().size());
+}
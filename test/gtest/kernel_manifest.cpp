@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/kernel_manifest.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "test.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+miopen::kernel_manifest::Manifest MakeManifest()
+{
+    auto manifest = miopen::kernel_manifest::Manifest{};
+    manifest.programs.emplace("MIOpenBatchNormFwdTrainSpatial.cl", "-DMIO_BN_N=64 -DMIO_BN_C=256");
+    manifest.programs.emplace("naive_conv.cpp", "");
+    manifest.invokers.emplace("1x64x56x56-F-fp32", "ConvDirectNaiveConvFwd");
+    manifest.find_records[{"", "64-56-56-3x3-64-56-56-1-1x1-1x1-1x1-0-NCHW-FP32-F"}] =
+        "ConvBinWinograd3x3U:0.02,0,miopenConvolutionFwdAlgoWinograd";
+    manifest.find_records[{"HIP", "64-56-56-1x1-64-56-56-1-0x0-1x1-1x1-0-NCHW-FP32-F"}] =
+        "ConvOclDirectFwd1x1:0.03,0,miopenConvolutionFwdAlgoDirect;"
+        "GemmFwd1x1_0_1:0.01,0,miopenConvolutionFwdAlgoGEMM";
+    return manifest;
+}
+
+void ExpectEqual(const miopen::kernel_manifest::Manifest& l,
+                 const miopen::kernel_manifest::Manifest& r)
+{
+    EXPECT_EQ(l.programs, r.programs);
+    EXPECT_EQ(l.invokers, r.invokers);
+    EXPECT_EQ(l.find_records, r.find_records);
+}
+
+} // namespace
+
+TEST(CPU_KernelManifest_None, RoundTrip)
+{
+    const auto manifest = MakeManifest();
+
+    auto stream = std::stringstream{};
+    miopen::kernel_manifest::Write(stream, manifest);
+    ExpectEqual(miopen::kernel_manifest::Read(stream), manifest);
+
+    miopen::TempFile temp_file("tmp-kernel-manifest");
+    miopen::kernel_manifest::Write(temp_file.Path(), manifest);
+    ExpectEqual(miopen::kernel_manifest::Read(temp_file.Path()), manifest);
+}
+
+TEST(CPU_KernelManifest_None, Merge)
+{
+    auto older = MakeManifest();
+    older.programs.emplace("MIOpenSoftmax.cl", "-DNUM_BATCH=1");
+    const auto& record_key = older.find_records.begin()->first;
+    older.find_records[record_key] = "ConvDirectNaiveConvFwd:1.5,0,miopenConvolutionFwdAlgoDirect";
+
+    auto newer = MakeManifest();
+    newer.Merge(older);
+
+    EXPECT_EQ(newer.programs.size(), 3);
+    EXPECT_EQ(newer.invokers.size(), 1);
+    ASSERT_EQ(newer.find_records.size(), 2);
+    EXPECT_EQ(newer.find_records[record_key], MakeManifest().find_records[record_key]);
+}
+
+TEST(CPU_KernelManifest_None, InvalidEntries)
+{
+    const auto read = [](const std::string& text) {
+        auto stream = std::istringstream{text};
+        return miopen::kernel_manifest::Read(stream);
+    };
+
+    EXPECT_TRUE(read("# comment\n\n").programs.empty());
+    EXPECT_TRUE(throws([&]() { read("naive_conv.cpp -DNO_TAB\n"); }));
+    EXPECT_TRUE(throws([&]() { read("@invoker\t1x64x56x56-F-fp32\n"); }));
+    EXPECT_TRUE(throws([&]() { read("@find\t\tkey\n"); }));
+    EXPECT_TRUE(throws([&]() { read("@unknown\tnaive_conv.cpp\t\n"); }));
+}
+
+TEST(CPU_KernelManifest_None, ProgramList)
+{
+    const auto manifest = MakeManifest();
+
+    miopen::TempFile temp_file("tmp-kernel-manifest");
+    miopen::kernel_manifest::Write(temp_file.Path(), manifest);
+
+    const auto programs = miopen::ReadProgramList(temp_file.Path());
+    EXPECT_EQ(std::set<miopen::ProgramKey>(programs.begin(), programs.end()), manifest.programs);
+}
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/measurement_policy.hpp>
+
+#include <limits>
+
+using miopen::solver::MeasurementPolicy;
+using miopen::solver::PlateauDetector;
+using miopen::solver::TimingSamples;
+
+TEST(CPU_MeasurementPolicy_None, Median)
+{
+    TimingSamples samples;
+    for(const auto time : {5.0f, 1.0f, 100.0f})
+        samples.Add(time);
+    EXPECT_FLOAT_EQ(samples.Median(), 5.0f);
+
+    samples.Add(2.0f);
+    EXPECT_FLOAT_EQ(samples.Median(), 3.5f);
+}
+
+TEST(CPU_MeasurementPolicy_None, ConfidenceInterval)
+{
+    TimingSamples samples;
+    samples.Add(2.0f);
+    EXPECT_EQ(samples.ConfidenceInterval(), std::make_pair(2.0f, 2.0f));
+
+    for(const auto time : {1.0f, 3.0f, 2.0f, 2.0f})
+        samples.Add(time);
+    // mean 2, stddev sqrt(0.5), t(4) = 2.776
+    const auto ci = samples.ConfidenceInterval();
+    EXPECT_NEAR(ci.first, 2.0f - 0.8779f, 1e-3f);
+    EXPECT_NEAR(ci.second, 2.0f + 0.8779f, 1e-3f);
+}
+
+TEST(CPU_MeasurementPolicy_None, NeedMoreSamples)
+{
+    MeasurementPolicy policy;
+    policy.samples_max = 5;
+
+    const auto first_best = std::numeric_limits<float>::max();
+    TimingSamples samples;
+    EXPECT_TRUE(policy.NeedMoreSamples(samples, first_best));
+    samples.Add(1.0f);
+    EXPECT_TRUE(policy.NeedMoreSamples(samples, first_best));
+
+    // Not within 5% of the best after the first sample.
+    EXPECT_FALSE(policy.NeedMoreSamples(samples, 0.9f));
+    EXPECT_TRUE(policy.NeedMoreSamples(samples, 0.96f));
+
+    // Clearly worse than the best after three samples.
+    samples.Add(1.01f);
+    samples.Add(0.99f);
+    EXPECT_FALSE(policy.NeedMoreSamples(samples, 0.96f));
+    EXPECT_TRUE(policy.NeedMoreSamples(samples, 1.0f));
+
+    samples.Add(1.0f);
+    samples.Add(1.0f);
+    EXPECT_FALSE(policy.NeedMoreSamples(samples, 1.0f));
+}
+
+TEST(CPU_MeasurementPolicy_None, Plateau)
+{
+    MeasurementPolicy policy;
+    policy.plateau_window    = 4;
+    policy.plateau_threshold = 0.01f;
+
+    PlateauDetector detector{policy};
+    EXPECT_FALSE(detector.Update(std::numeric_limits<float>::max()));
+    for(const auto best : {10.0f, 9.0f, 8.0f, 7.0f})
+        EXPECT_FALSE(detector.Update(best));
+    EXPECT_FALSE(detector.Update(6.95f));
+    EXPECT_FALSE(detector.Update(6.95f));
+    EXPECT_FALSE(detector.Update(6.95f));
+    // Improved from 7 by less than 1% over the last 4 candidates.
+    EXPECT_TRUE(detector.Update(6.95f));
+
+    // The candidates failing before the first measurement do not make a plateau.
+    PlateauDetector failing{policy};
+    for(auto i = 0; i < 100; ++i)
+        EXPECT_FALSE(failing.Update(std::numeric_limits<float>::max()));
+    for(const auto best : {10.0f, 9.0f, 8.0f, 7.0f})
+        EXPECT_FALSE(failing.Update(best));
+
+    policy.plateau_window = 0;
+    PlateauDetector disabled{policy};
+    for(auto i = 0; i < 100; ++i)
+        EXPECT_FALSE(disabled.Update(1.0f));
+}
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "tensor_holder.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+float Draw(std::size_t n, std::size_t c, std::size_t h, std::size_t w)
+{
+    return static_cast<float>(n + c + h + w) + prng::gen_canonical<float>();
+}
+
+} // namespace
+
+TEST(CPU_ParGenerate_None, SplitMix64)
+{
+    // The reference sequence for the zero seed.
+    EXPECT_EQ(prng::details::splitmix64(0, 0), 0xe220a8397b1dcdafULL);
+    EXPECT_EQ(prng::details::splitmix64(0, 1), 0x6e789e6aa1b965f4ULL);
+    EXPECT_NE(prng::details::splitmix64(1, 0), prng::details::splitmix64(0, 0));
+}
+
+TEST(CPU_ParGenerate_None, DependsOnSeedAndIndexOnly)
+{
+    constexpr std::size_t n      = 100000;
+    constexpr std::uint64_t seed = 42;
+
+    auto parallel = std::vector<float>(n);
+    prng::par_generate(n, seed, [&](std::size_t i) { parallel[i] = prng::gen_canonical<float>(); });
+    const auto next = prng::gen_canonical<float>();
+
+    // The same numbers regardless of the order and the thread the elements are generated in.
+    auto serial = std::vector<float>(n);
+    for(auto i = n; i-- > 0;)
+    {
+        prng::details::seed_at(seed, i);
+        serial[i] = prng::gen_canonical<float>();
+    }
+    prng::details::seed_at(seed, n);
+
+    EXPECT_EQ(parallel, serial);
+    EXPECT_EQ(next, prng::gen_canonical<float>());
+}
+
+TEST(CPU_ParGenerate_None, Tensor)
+{
+    auto t = tensor<float>{std::vector<std::size_t>{3, 5, 7, 11}}.par_generate(Draw);
+    EXPECT_EQ(t.data, tensor<float>{t.desc.GetLengths()}.par_generate(Draw).data);
+
+    const auto seed = t.generate_seed() + prng::details::get_default_seed();
+    auto i          = std::size_t{0};
+    t.for_each([&](auto n, auto c, auto h, auto w) {
+        prng::details::seed_at(seed, i);
+        EXPECT_EQ(t(n, c, h, w), Draw(n, c, h, w));
+        ++i;
+    });
+}
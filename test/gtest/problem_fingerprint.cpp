@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/problem_fingerprint.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace {
+
+miopen::conv::ProblemDescription MakeConvProblem(miopenTensorLayout_t layout,
+                                                 std::vector<std::size_t> in,
+                                                 std::vector<std::size_t> weights,
+                                                 std::vector<std::size_t> out,
+                                                 std::vector<int> pads,
+                                                 std::vector<int> strides,
+                                                 int group_count)
+{
+    return {miopen::TensorDescriptor{miopenFloat, layout, in},
+            miopen::TensorDescriptor{miopenFloat, layout, weights},
+            miopen::TensorDescriptor{miopenFloat, layout, out},
+            miopen::ConvolutionDescriptor{pads, strides, {1, 1}, {0, 0}, group_count},
+            miopen::conv::Direction::Forward};
+}
+
+std::string ToDbKey(const miopen::conv::ProblemDescription& problem)
+{
+    std::ostringstream ss;
+    problem.Serialize(ss);
+    return ss.str();
+}
+
+} // namespace
+
+TEST(CPU_ProblemFingerprint_None, KeyBuilderFormatsLikeStream)
+{
+    std::string key;
+    auto builder = miopen::KeyBuilder{key};
+    builder << 0 << 'x' << -17 << 'x' << std::numeric_limits<std::int64_t>::min() << 'x'
+            << std::numeric_limits<std::size_t>::max() << "x" << std::string{"NCHW"};
+
+    std::ostringstream ss;
+    ss << 0 << 'x' << -17 << 'x' << std::numeric_limits<std::int64_t>::min() << 'x'
+       << std::numeric_limits<std::size_t>::max() << "x" << std::string{"NCHW"};
+
+    EXPECT_EQ(key, ss.str());
+}
+
+TEST(CPU_ProblemFingerprint_None, BuilderDistinguishesFields)
+{
+    const auto get = [](auto... fields) {
+        auto builder = miopen::FingerprintBuilder{};
+        (builder.Add(fields), ...);
+        return builder.Get();
+    };
+
+    EXPECT_EQ(get(1, 2, 3), get(1, 2, 3));
+    EXPECT_NE(get(1, 2, 3), get(3, 2, 1));
+    EXPECT_NE(get(1, 2), get(1, 2, 0));
+    EXPECT_NE(get(std::string_view{"NCHW"}, std::string_view{"NHWC"}),
+              get(std::string_view{"NCHWN"}, std::string_view{"HWC"}));
+    EXPECT_EQ(get(5).ToString().size(), 32);
+}
+
+TEST(CPU_ProblemFingerprint_None, ConvLegacyKeys)
+{
+    const auto nchw = MakeConvProblem(miopenTensorNCHW,
+                                      {16, 64, 56, 56},
+                                      {128, 64, 3, 3},
+                                      {16, 128, 56, 56},
+                                      {1, 1},
+                                      {1, 1},
+                                      1);
+    EXPECT_EQ(nchw.MakeNetworkConfig().ToString(),
+              "64x56x56x3x3x128x56x56x16xNCHWxFP32x1x1x1x1x1x1x1xFxDefault");
+    EXPECT_EQ(ToDbKey(nchw), "64-56-56-3x3-128-56-56-16-1x1-1x1-1x1-0-NCHW-FP32-F");
+
+    const auto nhwc = MakeConvProblem(miopenTensorNHWC,
+                                      {8, 32, 14, 14},
+                                      {64, 16, 3, 3},
+                                      {8, 64, 6, 6},
+                                      {0, 0},
+                                      {2, 2},
+                                      2);
+    EXPECT_EQ(nhwc.MakeNetworkConfig().ToString(),
+              "32x14x14x3x3x64x6x6x8xNHWCxNHWCxNHWCxFP32x0x0x2x2x1x1x2xFxDefault");
+    EXPECT_EQ(ToDbKey(nhwc), "32-14-14-3x3-64-6-6-8-0x0-2x2-1x1-0-NHWC-NHWC-NHWC-FP32-F_g2");
+}
+
+TEST(CPU_ProblemFingerprint_None, ConvFingerprint)
+{
+    const auto make = [](std::size_t batch, int pad) {
+        return MakeConvProblem(miopenTensorNCHW,
+                               {batch, 64, 56, 56},
+                               {128, 64, 3, 3},
+                               {batch, 128, 56, 56},
+                               {pad, pad},
+                               {1, 1},
+                               1);
+    };
+
+    const auto problem = make(16, 1);
+    EXPECT_EQ(problem.MakeFingerprint(), make(16, 1).MakeFingerprint());
+    EXPECT_NE(problem.MakeFingerprint(), make(32, 1).MakeFingerprint());
+    EXPECT_NE(problem.MakeFingerprint(), make(16, 0).MakeFingerprint());
+
+    // The copies keep the fingerprint computed by the original.
+    const auto copy = problem;
+    EXPECT_EQ(copy.MakeFingerprint(), problem.MakeFingerprint());
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/readonly_bin_db.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+struct StringValue
+{
+    std::string value;
+
+    bool Deserialize(const std::string& str)
+    {
+        value = str;
+        return true;
+    }
+};
+
+std::vector<miopen::bin_db::Entry> TestEntries()
+{
+    auto entries = std::vector<miopen::bin_db::Entry>{};
+    for(auto i = 0; i < 1000; ++i)
+    {
+        const auto n = std::to_string(i);
+        entries.push_back({"key" + n, "solver" + n + ":" + n + "," + n, i + 1});
+    }
+    return entries;
+}
+
+std::string Compile(std::vector<miopen::bin_db::Entry> entries)
+{
+    auto ss = std::ostringstream{};
+    miopen::bin_db::Write(ss, std::move(entries));
+    return ss.str();
+}
+
+} // namespace
+
+TEST(CPU_ReadonlyBinDb_None, RoundTrip)
+{
+    const auto entries = TestEntries();
+    const auto blob    = Compile(entries);
+    const auto view    = miopen::bin_db::View{blob.data(), blob.size()};
+
+    ASSERT_TRUE(view.IsValid());
+    ASSERT_EQ(view.Size(), entries.size());
+
+    for(const auto& entry : entries)
+    {
+        const auto record = view.Find(entry.key);
+        ASSERT_NE(record, nullptr) << entry.key;
+        EXPECT_EQ(view.Key(*record), entry.key);
+        EXPECT_EQ(view.Value(*record), entry.value);
+        EXPECT_EQ(record->line, entry.line);
+    }
+
+    EXPECT_EQ(view.Find("missing"), nullptr);
+    EXPECT_EQ(view.Find(""), nullptr);
+}
+
+TEST(CPU_ReadonlyBinDb_None, FirstDuplicateWins)
+{
+    const auto blob = Compile({{"b", "2", 1}, {"a", "first", 2}, {"a", "second", 3}});
+    const auto view = miopen::bin_db::View{blob.data(), blob.size()};
+
+    ASSERT_TRUE(view.IsValid());
+    EXPECT_EQ(view.Size(), 2);
+    ASSERT_NE(view.Find("a"), nullptr);
+    EXPECT_EQ(view.Value(*view.Find("a")), "first");
+}
+
+TEST(CPU_ReadonlyBinDb_None, RejectsMalformed)
+{
+    const auto blob = Compile(TestEntries());
+
+    EXPECT_FALSE((miopen::bin_db::View{nullptr, 0}.IsValid()));
+    EXPECT_FALSE((miopen::bin_db::View{blob.data(), blob.size() / 2}.IsValid()));
+
+    auto bad_magic = blob;
+    bad_magic[0]   = 'X';
+    EXPECT_FALSE((miopen::bin_db::View{bad_magic.data(), bad_magic.size()}.IsValid()));
+
+    const auto text = std::string{"key0=solver0:0,0\n"};
+    EXPECT_FALSE((miopen::bin_db::View{text.data(), text.size()}.IsValid()));
+}
+
+TEST(CPU_ReadonlyBinDb_None, UsedByReadonlyRamDb)
+{
+    const auto dir      = miopen::TmpDir{"rordb_bin"};
+    const auto txt_path = dir.path / "test.fdb.txt";
+    const auto entries  = TestEntries();
+
+    {
+        auto txt = std::ofstream{txt_path};
+        for(const auto& entry : entries)
+            txt << entry.key << "=" << entry.value << std::endl;
+    }
+    {
+        auto bin = std::ofstream{txt_path + miopen::bin_db::FileSuffix, std::ios::binary};
+        miopen::bin_db::Write(bin, entries);
+    }
+
+    const auto& db = miopen::ReadonlyRamDb::GetCached(miopen::DbKinds::FindDb, txt_path, true);
+    ASSERT_TRUE(db.IsMapped());
+
+    for(const auto& entry : entries)
+    {
+        const auto id = entry.value.substr(0, entry.value.find(':'));
+        StringValue value;
+        ASSERT_TRUE(db.Load(entry.key, id, value)) << entry.key;
+        EXPECT_EQ(value.value, entry.value.substr(entry.value.find(':') + 1));
+    }
+
+    EXPECT_FALSE(db.FindRecord(std::string{"missing"}));
+
+    const auto& map = db.GetCacheMap();
+    ASSERT_EQ(map.size(), entries.size());
+    EXPECT_EQ(map.at("key42").content, "solver42:42,42");
+    EXPECT_EQ(map.at("key42").line, 43);
+}
@@ -0,0 +1,194 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tmp_dir.hpp>
+
+#include <reference_cache.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+reference_cache::Key MakeKey(const std::vector<float>& input)
+{
+    return reference_cache::Key{"test"}.Problem(std::vector<int>{1, 2, 3}).Input(input);
+}
+
+std::vector<float> MakeInput(std::size_t size)
+{
+    auto input = std::vector<float>(size);
+    for(std::size_t i = 0; i < size; ++i)
+        input[i] = 0.25f * static_cast<float>(i % 97) - 3.0f;
+    return input;
+}
+
+} // namespace
+
+TEST(CPU_ReferenceCache_None, KeyDependsOnEverything)
+{
+    const auto input = MakeInput(100);
+    auto other_input = input;
+    other_input[99] += 1.0f;
+
+    EXPECT_EQ(MakeKey(input).Digest(), MakeKey(input).Digest());
+    EXPECT_EQ(MakeKey(input).Digest().size(), 32);
+    EXPECT_NE(MakeKey(input).Digest(), MakeKey(other_input).Digest());
+    EXPECT_NE(reference_cache::Key{"a"}.Input(input).Digest(),
+              reference_cache::Key{"b"}.Input(input).Digest());
+    EXPECT_NE(reference_cache::Key{"a"}.Problem(1.0).Digest(),
+              reference_cache::Key{"a"}.Problem(1.0 + 1e-12).Digest());
+    EXPECT_NE(reference_cache::Key{"a"}.Type<float>().Digest(),
+              reference_cache::Key{"a"}.Type<double>().Digest());
+    // The fields do not run into each other.
+    EXPECT_NE(reference_cache::Key{"a"}.Problem("bc").Digest(),
+              reference_cache::Key{"ab"}.Problem("c").Digest());
+}
+
+TEST(CPU_ReferenceCache_None, RoundTrip)
+{
+    const auto dir   = miopen::TmpDir{"reference_cache"};
+    const auto store = reference_cache::Store{dir.path, 1024 * 1024 * 1024};
+    const auto input = MakeInput(10000);
+
+    auto computed = 0;
+    auto compute  = [&](std::vector<float>& out, std::vector<std::int8_t>& out_i8) {
+        ++computed;
+        out.resize(input.size());
+        out_i8.resize(input.size() / 3 + 1);
+        std::partial_sum(input.begin(), input.end(), out.begin());
+        for(std::size_t i = 0; i < out_i8.size(); ++i)
+            out_i8[i] = static_cast<std::int8_t>(i);
+    };
+
+    auto expected    = std::vector<float>{};
+    auto expected_i8 = std::vector<std::int8_t>{};
+    compute(expected, expected_i8);
+
+    auto out    = std::vector<float>(expected.size());
+    auto out_i8 = std::vector<std::int8_t>(expected_i8.size());
+    store.Run(MakeKey(input), [&] { compute(out, out_i8); }, out, out_i8);
+    EXPECT_EQ(computed, 2);
+
+    auto cached    = std::vector<float>(expected.size());
+    auto cached_i8 = std::vector<std::int8_t>(expected_i8.size());
+    store.Run(MakeKey(input), [&] { compute(cached, cached_i8); }, cached, cached_i8);
+    EXPECT_EQ(computed, 2);
+    EXPECT_EQ(cached, expected);
+    EXPECT_EQ(cached_i8, expected_i8);
+
+    // The entry does not match buffers of another size.
+    auto shorter = std::vector<float>(expected.size() - 1);
+    EXPECT_FALSE(store.Load(MakeKey(input), {reference_cache::Output(shorter)}));
+}
+
+TEST(CPU_ReferenceCache_None, RejectsCorrupted)
+{
+    const auto dir   = miopen::TmpDir{"reference_cache"};
+    const auto store = reference_cache::Store{dir.path, 1024 * 1024 * 1024};
+    const auto key   = MakeKey(MakeInput(10));
+
+    auto data = MakeInput(1000);
+    store.Save(key, {reference_cache::Output(data)});
+    ASSERT_TRUE(store.Load(key, {reference_cache::Output(data)}));
+
+    const auto path = dir.path / (key.Digest() + ".ref");
+    const auto size = miopen::fs::file_size(path);
+    {
+        auto file = std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(size - 1);
+        file.put('\x5a');
+    }
+    EXPECT_FALSE(store.Load(key, {reference_cache::Output(data)}));
+
+    miopen::fs::resize_file(path, size / 2);
+    EXPECT_FALSE(store.Load(key, {reference_cache::Output(data)}));
+}
+
+TEST(CPU_ReferenceCache_None, RejectedLeavesOutputs)
+{
+    const auto dir   = miopen::TmpDir{"reference_cache"};
+    const auto store = reference_cache::Store{dir.path, 1024 * 1024 * 1024};
+    const auto key   = MakeKey(MakeInput(10));
+
+    // Random data is stored uncompressed, so a flipped byte is only caught by the checksum.
+    auto gen    = std::mt19937_64{};
+    auto first  = std::vector<std::uint64_t>(100);
+    auto second = std::vector<std::uint64_t>(100);
+    for(auto& x : first)
+        x = gen();
+    for(auto& x : second)
+        x = gen();
+    store.Save(key, {reference_cache::Output(first), reference_cache::Output(second)});
+
+    const auto path = dir.path / (key.Digest() + ".ref");
+    {
+        auto file = std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekp(miopen::fs::file_size(path) - 1);
+        file.put('\x5a');
+    }
+
+    auto loaded_first  = std::vector<std::uint64_t>(first.size(), 7);
+    auto loaded_second = std::vector<std::uint64_t>(second.size(), 7);
+    EXPECT_FALSE(store.Load(
+        key, {reference_cache::Output(loaded_first), reference_cache::Output(loaded_second)}));
+    EXPECT_EQ(loaded_first, std::vector<std::uint64_t>(first.size(), 7));
+    EXPECT_EQ(loaded_second, std::vector<std::uint64_t>(second.size(), 7));
+}
+
+TEST(CPU_ReferenceCache_None, EvictsLeastRecentlyUsed)
+{
+    const auto dir  = miopen::TmpDir{"reference_cache"};
+    auto data       = std::vector<std::uint64_t>(1000);
+    const auto path = [&](const auto& key) { return dir.path / (key.Digest() + ".ref"); };
+    const auto key  = [](int i) { return reference_cache::Key{"test"}.Problem(i); };
+
+    // Random data does not compress, so each entry is a bit larger than 8000 bytes.
+    auto gen = std::mt19937_64{};
+    for(auto& x : data)
+        x = gen();
+
+    const auto store = reference_cache::Store{dir.path, 20000};
+    const auto now   = miopen::fs::file_time_type::clock::now();
+    store.Save(key(0), {reference_cache::Output(data)});
+    miopen::fs::last_write_time(path(key(0)), now - std::chrono::hours{2});
+    store.Save(key(1), {reference_cache::Output(data)});
+    miopen::fs::last_write_time(path(key(1)), now - std::chrono::hours{1});
+
+    // Using an entry makes it the most recent one.
+    ASSERT_TRUE(store.Load(key(0), {reference_cache::Output(data)}));
+
+    store.Save(key(2), {reference_cache::Output(data)});
+    EXPECT_TRUE(miopen::fs::exists(path(key(0))));
+    EXPECT_FALSE(miopen::fs::exists(path(key(1))));
+    EXPECT_TRUE(miopen::fs::exists(path(key(2))));
+}
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/search_strategy.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+
+namespace {
+
+using miopen::solver::MakeSearchStrategy;
+using miopen::solver::SearchStrategyKind;
+
+/// A 32x32 grid of synthetic "tile sizes" with the optimum at (8, 4).
+struct SyntheticSpace
+{
+    std::vector<std::vector<float>> features;
+    std::vector<float> costs;
+
+    SyntheticSpace()
+    {
+        for(auto a = 1; a <= 32; ++a)
+        {
+            for(auto b = 1; b <= 32; ++b)
+            {
+                const auto config = std::to_string(a) + "," + std::to_string(b);
+                features.emplace_back(miopen::solver::GetSearchFeatures(config));
+                costs.emplace_back(1.0f + std::pow(std::log2(a) - 3.0f, 2.0f) +
+                                   std::pow(std::log2(b) - 2.0f, 2.0f));
+            }
+        }
+    }
+};
+
+std::vector<std::size_t>
+RunSearch(SearchStrategyKind kind, const SyntheticSpace& space, std::size_t budget, int seed)
+{
+    auto strategy = MakeSearchStrategy(kind, space.features, budget, seed);
+    std::vector<std::size_t> picks;
+    while(const auto index = strategy->Next())
+    {
+        picks.push_back(*index);
+        strategy->Report(*index, space.costs[*index]);
+    }
+    return picks;
+}
+
+} // namespace
+
+TEST(CPU_SearchStrategy_None, Features)
+{
+    const auto features = miopen::solver::GetSearchFeatures("3,0,kernel_name<64, 4>");
+    ASSERT_EQ(features.size(), 5);
+    EXPECT_FLOAT_EQ(features[0], 2.0f);
+    EXPECT_FLOAT_EQ(features[1], 0.0f);
+    EXPECT_GE(features[2], 0.0f);
+    EXPECT_LT(features[2], 1.0f);
+    EXPECT_FLOAT_EQ(features[3], std::log2(65.0f));
+}
+
+TEST(CPU_SearchStrategy_None, BudgetAndUniqueness)
+{
+    const SyntheticSpace space;
+    for(const auto kind : {SearchStrategyKind::Random, SearchStrategyKind::Surrogate})
+    {
+        const auto picks = RunSearch(kind, space, 100, 1);
+        EXPECT_EQ(picks.size(), 100);
+        EXPECT_EQ(std::set<std::size_t>(picks.begin(), picks.end()).size(), picks.size());
+
+        const auto all = RunSearch(kind, space, 5000, 1);
+        EXPECT_EQ(all.size(), space.costs.size());
+    }
+}
+
+TEST(CPU_SearchStrategy_None, Deterministic)
+{
+    const SyntheticSpace space;
+    for(const auto kind : {SearchStrategyKind::Random, SearchStrategyKind::Surrogate})
+    {
+        EXPECT_EQ(RunSearch(kind, space, 64, 42), RunSearch(kind, space, 64, 42));
+        EXPECT_NE(RunSearch(kind, space, 64, 42), RunSearch(kind, space, 64, 43));
+    }
+}
+
+TEST(CPU_SearchStrategy_None, SurrogateFindsOptimum)
+{
+    const SyntheticSpace space;
+    const auto best = *std::min_element(space.costs.begin(), space.costs.end());
+    for(auto seed = 1; seed <= 8; ++seed)
+    {
+        const auto picks = RunSearch(SearchStrategyKind::Surrogate, space, 64, seed);
+        auto found       = space.costs[picks.front()];
+        for(const auto pick : picks)
+            found = std::min(found, space.costs[pick]);
+        EXPECT_FLOAT_EQ(found, best) << "seed " << seed;
+    }
+}
+
+TEST(CPU_SearchStrategy_None, SurrogateToleratesFailures)
+{
+    const SyntheticSpace space;
+    auto strategy = MakeSearchStrategy(SearchStrategyKind::Surrogate, space.features, 50, 3);
+    std::size_t issued = 0;
+    while(const auto index = strategy->Next())
+    {
+        ++issued;
+        strategy->Report(*index, std::nullopt);
+    }
+    EXPECT_EQ(issued, 50);
+}
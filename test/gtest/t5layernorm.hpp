@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include "../driver/tensor_driver.hpp"
+#include "cpu_norm.hpp"
 #include "get_handle.hpp"
 #include "random.hpp"
 #include "tensor_holder.hpp"
@@ -50,25 +51,14 @@ void cpu_t5layernorm_forward(tensor<T> x,
         outer_size *= dims[i];
     }
 
-    par_ford(outer_size)([&](int32_t o) {
-        float pvar = 0;
-
-        ford(inner_size)([&](int32_t i) {
-            float tmp = static_cast<float>(x[o * inner_size + i]);
-            pvar += tmp * tmp;
-        });
-
-        pvar        = pvar / inner_size;
-        float prstd = 1 / sqrt(pvar + eps);
-
-        ref_rstd[o] = static_cast<T>(prstd);
-
-        ford(inner_size)([&](int32_t i) {
-            float pweight = mode ? static_cast<float>(weight[i]) : 1;
-            ref_y[o * inner_size + i] =
-                static_cast<T>(static_cast<float>(x[o * inner_size + i]) * prstd * pweight);
-        });
-    });
+    cpu_norm::rmsnorm_forward<float>(outer_size,
+                                     inner_size,
+                                     x.data.data(),
+                                     mode == MIOPEN_ELEMENTWISE_AFFINE_T5 ? nullptr
+                                                                          : weight.data.data(),
+                                     ref_y.data.data(),
+                                     ref_rstd.data.data(),
+                                     eps);
 }
 
 template <class T>
@@ -88,28 +78,14 @@ void cpu_t5layernorm_backward(tensor<T> dy,
         outer_size *= dims[i];
     }
 
-    par_ford(outer_size)([&](int32_t o) {
-        float sum = 0;
-
-        ford(inner_size)([&](int32_t i) {
-            float pweight = mode ? static_cast<float>(weight[i]) : 1;
-            float pdy     = (dy.GetSize() != 0) ? static_cast<float>(dy[o * inner_size + i]) : 0;
-            float px      = static_cast<float>(x[o * inner_size + i]);
-            sum += pdy * px * pweight;
-        });
-
-        float s     = 1 / static_cast<float>(inner_size);
-        float prstd = static_cast<float>(rstd[o]);
-        float a     = sum * prstd * prstd * prstd * s;
-
-        ford(inner_size)([&](int32_t i) {
-            float pweight = mode ? static_cast<float>(weight[i]) : 1;
-            float pdy     = (dy.GetSize() != 0) ? static_cast<float>(dy[o * inner_size + i]) : 0;
-
-            float val = prstd * pdy * pweight - a * static_cast<float>(x[o * inner_size + i]);
-            ref_dx[o * inner_size + i] = static_cast<T>(val);
-        });
-    });
+    cpu_norm::rmsnorm_backward<float>(outer_size,
+                                      inner_size,
+                                      dy.GetSize() != 0 ? dy.data.data() : nullptr,
+                                      x.data.data(),
+                                      mode == MIOPEN_ELEMENTWISE_AFFINE_T5 ? nullptr
+                                                                           : weight.data.data(),
+                                      rstd.data.data(),
+                                      ref_dx.data.data());
 }
 
 template <class T>
@@ -125,19 +101,12 @@ void cpu_t5layernorm_backward_weight(
         outer_size *= dims[i];
     }
 
-    par_ford(inner_size)([&](int32_t o) {
-        float sum = 0;
-
-        ford(outer_size)([&](int32_t i) {
-            float prstd = static_cast<float>(rstd[i]);
-            float pdy   = (dy.GetSize() != 0) ? static_cast<float>(dy[i * inner_size + o]) : 0;
-            float px    = static_cast<float>(x[i * inner_size + o]);
-
-            sum += pdy * px * prstd;
-        });
-
-        ref_dw[o] = sum;
-    });
+    cpu_norm::rmsnorm_backward_weight<float>(outer_size,
+                                             inner_size,
+                                             dy.GetSize() != 0 ? dy.data.data() : nullptr,
+                                             x.data.data(),
+                                             rstd.data.data(),
+                                             ref_dw.data.data());
 }
 
 struct T5LayerNormTestCase
@@ -25,17 +25,33 @@
  *******************************************************************************/
 #pragma once
 
+#include <reference_cache.hpp>
+
 namespace test {
 template <typename DLModule>
 void ComputeCPUBNInference(DLModule& dl_module)
 {
-    batchNormSpatialHostInference(dl_module.input,
-                                  dl_module.ref_out,
-                                  dl_module.scale,
-                                  dl_module.shift,
-                                  dl_module.epsilon,
-                                  dl_module.estMean,
-                                  dl_module.estVariance);
+    reference_cache::Cached(
+        [&] {
+            return reference_cache::Key{"batchNormSpatialHostInference"}
+                .Problem(dl_module.epsilon)
+                .Input(dl_module.input)
+                .Input(dl_module.scale)
+                .Input(dl_module.shift)
+                .Input(dl_module.estMean)
+                .Input(dl_module.estVariance)
+                .Layout(dl_module.ref_out);
+        },
+        [&] {
+            batchNormSpatialHostInference(dl_module.input,
+                                          dl_module.ref_out,
+                                          dl_module.scale,
+                                          dl_module.shift,
+                                          dl_module.epsilon,
+                                          dl_module.estMean,
+                                          dl_module.estVariance);
+        },
+        dl_module.ref_out);
 }
 
 template <typename XDataType,
@@ -48,29 +64,68 @@ template <typename XDataType,
           typename DLModule>
 void ComputeCPUBNBwd(DLModule& dl_module)
 {
-    batchNormSpatialHostBwdTrain(dl_module.input,
-                                 dl_module.dy,
-                                 dl_module.ref_out,
-                                 dl_module.bnScale,
-                                 dl_module.dScale_ref,
-                                 dl_module.dBias_ref,
-                                 dl_module.savedMean,
-                                 dl_module.savedInvVar);
+    reference_cache::Cached(
+        [&] {
+            return reference_cache::Key{"batchNormSpatialHostBwdTrain"}
+                .Input(dl_module.input)
+                .Input(dl_module.dy)
+                .Input(dl_module.bnScale)
+                .Input(dl_module.savedMean)
+                .Input(dl_module.savedInvVar)
+                .Layout(dl_module.ref_out)
+                .Layout(dl_module.dScale_ref)
+                .Layout(dl_module.dBias_ref);
+        },
+        [&] {
+            batchNormSpatialHostBwdTrain(dl_module.input,
+                                         dl_module.dy,
+                                         dl_module.ref_out,
+                                         dl_module.bnScale,
+                                         dl_module.dScale_ref,
+                                         dl_module.dBias_ref,
+                                         dl_module.savedMean,
+                                         dl_module.savedInvVar);
+        },
+        dl_module.ref_out,
+        dl_module.dScale_ref,
+        dl_module.dBias_ref);
 }
 
 template <typename DLModule>
 void ComputeCPUBNFwdTrain(DLModule& dl_module)
 {
-    batchNormSpatialHostFwdTrain(dl_module.input,
-                                 dl_module.ref_out,
-                                 dl_module.scale,
-                                 dl_module.shift,
-                                 dl_module.epsilon,
-                                 dl_module.averageFactor,
-                                 dl_module.saveMean_ref,
-                                 dl_module.saveVariance_ref,
-                                 dl_module.runMean_ref,
-                                 dl_module.runVariance_ref);
+    // The running averages are updated in place, so their initial values are inputs too.
+    reference_cache::Cached(
+        [&] {
+            return reference_cache::Key{"batchNormSpatialHostFwdTrain"}
+                .Problem(dl_module.epsilon)
+                .Problem(dl_module.averageFactor)
+                .Input(dl_module.input)
+                .Input(dl_module.scale)
+                .Input(dl_module.shift)
+                .Input(dl_module.runMean_ref)
+                .Input(dl_module.runVariance_ref)
+                .Layout(dl_module.ref_out)
+                .Layout(dl_module.saveMean_ref)
+                .Layout(dl_module.saveVariance_ref);
+        },
+        [&] {
+            batchNormSpatialHostFwdTrain(dl_module.input,
+                                         dl_module.ref_out,
+                                         dl_module.scale,
+                                         dl_module.shift,
+                                         dl_module.epsilon,
+                                         dl_module.averageFactor,
+                                         dl_module.saveMean_ref,
+                                         dl_module.saveVariance_ref,
+                                         dl_module.runMean_ref,
+                                         dl_module.runVariance_ref);
+        },
+        dl_module.ref_out,
+        dl_module.saveMean_ref,
+        dl_module.saveVariance_ref,
+        dl_module.runMean_ref,
+        dl_module.runVariance_ref);
 }
 
 template <typename T>
@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/mpmc_queue.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(CPU_ThreadPool_None, TaskGroupRunsAllTasks)
+{
+    miopen::ThreadPool pool{4};
+    std::atomic<int> sum{0};
+    {
+        miopen::TaskGroup tasks{pool};
+        for(int i = 1; i <= 1000; ++i)
+            tasks.Run([&sum, i] { sum += i; });
+        tasks.Wait();
+    }
+    EXPECT_EQ(sum, 500500);
+}
+
+TEST(CPU_ThreadPool_None, TaskGroupRethrows)
+{
+    miopen::ThreadPool pool{2};
+    miopen::TaskGroup tasks{pool};
+    std::atomic<int> completed{0};
+    for(int i = 0; i < 16; ++i)
+    {
+        tasks.Run([&completed, i] {
+            if(i == 7)
+                throw std::runtime_error("task failed");
+            ++completed;
+        });
+    }
+    EXPECT_THROW(tasks.Wait(), std::runtime_error);
+    EXPECT_EQ(completed, 15);
+}
+
+TEST(CPU_ThreadPool_None, WaitRunsOnlyOwnTasks)
+{
+    miopen::ThreadPool pool{1};
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+
+    // Keeps the only worker busy, so the tasks below can only run in the waiting thread.
+    miopen::TaskGroup blocker{pool};
+    blocker.Run([&] {
+        started = true;
+        while(!release)
+            std::this_thread::yield();
+    });
+    while(!started)
+        std::this_thread::yield();
+
+    auto own_ran = false;
+    miopen::TaskGroup own{pool};
+    own.Run([&own_ran] { own_ran = true; });
+
+    std::atomic<bool> other_ran{false};
+    miopen::TaskGroup other{pool};
+    other.Run([&other_ran] { other_ran = true; });
+
+    own.Wait();
+
+    EXPECT_TRUE(own_ran);
+    EXPECT_FALSE(other_ran);
+
+    release = true;
+    other.Wait();
+    blocker.Wait();
+    EXPECT_TRUE(other_ran);
+}
+
+TEST(CPU_ThreadPool_None, NestedParFor)
+{
+    // Every outer iteration occupies a pool thread and waits on the inner loop, which must
+    // still complete when the outer loop is wider than the pool.
+    const std::size_t outer = 4 * std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t inner = 64;
+    std::vector<std::atomic<int>> counts(outer);
+    miopen::par_for(outer, 1, [&](auto i) {
+        miopen::par_for(inner, 1, [&](auto) { ++counts[i]; });
+    });
+    for(const auto& count : counts)
+        EXPECT_EQ(count, inner);
+}
+
+TEST(CPU_ThreadPool_None, ParForStridedVisitsEachIndexOnce)
+{
+    const std::size_t n = 1000;
+    std::vector<std::atomic<int>> visits(n);
+    miopen::par_for_strided(n, miopen::max_threads{8}, [&](auto i) { ++visits[i]; });
+    for(const auto& visit : visits)
+        EXPECT_EQ(visit, 1);
+}
+
+TEST(CPU_MpmcQueue_None, MultipleProducersAndConsumers)
+{
+    constexpr int producers      = 4;
+    constexpr int consumers      = 4;
+    constexpr int items_per_prod = 10000;
+
+    miopen::MpmcQueue<int> queue{64};
+    std::atomic<long long> consumed_sum{0};
+    std::atomic<int> consumed{0};
+
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&queue, p] {
+            for(int i = 0; i < items_per_prod; ++i)
+            {
+                auto item = p * items_per_prod + i;
+                while(!queue.try_push(std::move(item)))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for(int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back([&] {
+            while(consumed < producers * items_per_prod)
+            {
+                if(auto item = queue.try_pop())
+                {
+                    consumed_sum += *item;
+                    ++consumed;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    const long long total = producers * items_per_prod;
+    EXPECT_EQ(consumed, total);
+    EXPECT_EQ(consumed_sum, total * (total - 1) / 2);
+    EXPECT_FALSE(queue.try_pop());
+}
+
+TEST(CPU_MpmcQueue_None, FullAndEmpty)
+{
+    miopen::MpmcQueue<int> queue{4};
+    EXPECT_EQ(queue.capacity(), 4);
+    for(int i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.try_push(int{i}));
+    EXPECT_FALSE(queue.try_push(4));
+    for(int i = 0; i < 4; ++i)
+        EXPECT_EQ(queue.try_pop(), i);
+    EXPECT_FALSE(queue.try_pop());
+}
@@ -0,0 +1,215 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "verify.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// Larger than a chunk of the engine, so that several tasks are merged.
+constexpr std::size_t n = 300001;
+
+std::vector<float> Reference()
+{
+    auto v = std::vector<float>(n);
+    for(std::size_t i = 0; i < n; ++i)
+        v[i] = std::sin(static_cast<float>(i)) * 100.0f;
+    return v;
+}
+
+float NextAfter(float x, int ulps)
+{
+    for(; ulps > 0; --ulps)
+        x = std::nextafter(x, std::numeric_limits<float>::infinity());
+    return x;
+}
+
+} // namespace
+
+TEST(CPU_VerifyEngine_None, MatchesElementwiseRms)
+{
+    const auto expected = Reference();
+    auto actual         = expected;
+    for(std::size_t i = 0; i < n; i += 7)
+        actual[i] += 0.001f * static_cast<float>(i % 13);
+
+    auto square_difference = 0.0;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        const auto d = static_cast<double>(actual[i]) - static_cast<double>(expected[i]);
+        square_difference += d * d;
+    }
+    const auto mag = std::max(
+        std::fabs(*std::max_element(expected.begin(), expected.end(), miopen::compare_mag)),
+        std::fabs(*std::max_element(actual.begin(), actual.end(), miopen::compare_mag)));
+    const auto rms = std::sqrt(square_difference) / (std::sqrt(n) * mag);
+
+    EXPECT_NEAR(miopen::rms_range(expected, actual), rms, rms * 1e-12);
+    EXPECT_EQ(miopen::rms_range(expected, expected), 0.0);
+    EXPECT_EQ(miopen::rms_range(expected, std::vector<float>(n - 1)),
+              std::numeric_limits<float>::max());
+
+    // The result does not depend on the scheduling.
+    EXPECT_EQ(miopen::rms_range(expected, actual), miopen::rms_range(expected, actual));
+}
+
+TEST(CPU_VerifyEngine_None, Statistics)
+{
+    auto expected       = Reference();
+    expected[200000]    = 64.0f;
+    auto actual         = expected;
+    actual[10]          = NextAfter(expected[10], 1);
+    actual[200000]      = NextAfter(expected[200000], 3);
+    actual[250000]      = expected[250000] + 5.0f;
+    actual[299999]      = std::numeric_limits<float>::quiet_NaN();
+
+    auto opts          = miopen::verification::options{};
+    opts.max_offenders = 3;
+    const auto r       = miopen::compare_range(expected, actual, opts);
+
+    EXPECT_EQ(r.count, n);
+    EXPECT_EQ(r.max_abs_diff_index, 250000);
+    EXPECT_EQ(r.max_abs_diff, std::fabs(static_cast<double>(actual[250000]) - expected[250000]));
+    EXPECT_EQ(r.non_finite_expected, 0);
+    EXPECT_EQ(r.non_finite_actual, 1);
+    EXPECT_EQ(r.num_offenders, 4);
+    ASSERT_EQ(r.offenders.size(), 3);
+    EXPECT_EQ(r.offenders[0].index, 10);
+    EXPECT_EQ(r.offenders[1].index, 200000);
+    EXPECT_EQ(r.offenders[2].index, 250000);
+    EXPECT_TRUE(std::isnan(r.rms()));
+
+    EXPECT_EQ(r.ulp_histogram[0], n - 4);
+    EXPECT_EQ(r.ulp_histogram[1], 1);
+    EXPECT_EQ(r.ulp_histogram[2], 1);
+    EXPECT_EQ(std::accumulate(r.ulp_histogram.begin(), r.ulp_histogram.end(), std::size_t{0}),
+              n - 1);
+
+    // A relative tolerance of 2.5 epsilon hides the first difference only.
+    opts.rel_tolerance = 2.5 * std::numeric_limits<float>::epsilon();
+    EXPECT_EQ(miopen::compare_range(expected, actual, opts).num_offenders, 3);
+}
+
+TEST(CPU_VerifyEngine_None, MixedTypes)
+{
+    const auto expected = std::vector<double>{1.0, -2.0, 0.1, 1e-3};
+    auto actual         = std::vector<half_float::half>(expected.size());
+    for(std::size_t i = 0; i < expected.size(); ++i)
+        actual[i] = static_cast<half_float::half>(static_cast<float>(expected[i]));
+
+    // The reference rounded to half matches the result, whatever the error of the rounding.
+    const auto r = miopen::compare_range(expected, actual);
+    EXPECT_EQ(r.ulp_histogram[0], expected.size());
+    EXPECT_GT(r.max_abs_diff, 0.0);
+}
+
+TEST(CPU_VerifyEngine_None, TensorCoordinates)
+{
+    // NHWC strides of a 2x3x4x5 tensor.
+    auto expected = tensor<float>{std::vector<std::size_t>{2, 3, 4, 5},
+                                  std::vector<std::size_t>{60, 1, 15, 3}};
+    auto actual   = expected;
+
+    actual(1, 2, 3, 1) = 1.0f;
+
+    const auto r = miopen::compare_range(expected, actual);
+    ASSERT_EQ(r.offenders.size(), 1);
+    EXPECT_EQ(r.offenders[0].index, expected.desc.GetIndex(1, 2, 3, 1));
+    EXPECT_EQ(r.offenders[0].coordinates, (std::vector<std::size_t>{1, 2, 3, 1}));
+    EXPECT_EQ(r.offenders[0].actual, 1.0);
+}
+
+TEST(CPU_VerifyEngine_None, FindFirst)
+{
+    auto data = Reference();
+    EXPECT_EQ(miopen::find_idx(data, miopen::not_finite), -1);
+    EXPECT_EQ(miopen::mismatch_idx(data, data, miopen::float_equal), n);
+
+    data[270000] = std::numeric_limits<float>::infinity();
+    data[140000] = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_EQ(miopen::find_idx(data, miopen::not_finite), 140000);
+
+    auto other    = Reference();
+    other[150000] = NextAfter(other[150000], 2);
+    other[290000] = NextAfter(other[290000], 2);
+    EXPECT_EQ(miopen::mismatch_idx(Reference(), other, miopen::float_equal), 150000);
+}
+
+TEST(CPU_VerifyEngine_None, UlpHistogram)
+{
+    const auto expected = std::vector<float>(7, 1.0f);
+    auto actual         = std::vector<float>{};
+    for(const auto ulps : {0, 1, 2, 3, 4, 100, 1000000})
+        actual.push_back(NextAfter(1.0f, ulps));
+
+    const auto r = miopen::compare_range(expected, actual);
+    auto bins    = std::array<std::size_t, miopen::verification::ulp_bins>{};
+    bins[0]      = 1; // 0
+    bins[1]      = 1; // 1
+    bins[2]      = 2; // 2, 3
+    bins[3]      = 1; // 4
+    bins[7]      = 1; // 100
+    bins[15]     = 1; // 1000000
+    EXPECT_EQ(r.ulp_histogram, bins);
+
+    // The distance between large doubles of opposite signs does not overflow.
+    const auto huge = std::vector<double>{1e300, -1e300, 0.0};
+    const auto opposite =
+        miopen::compare_range(huge, std::vector<double>{-1e300, 1e300, -0.0}).ulp_histogram;
+    EXPECT_EQ(opposite[miopen::verification::ulp_bins - 1], 2);
+    EXPECT_EQ(opposite[0], 1);
+}
+
+TEST(CPU_VerifyEngine_None, MaxDiffNonFinite)
+{
+    constexpr auto inf = std::numeric_limits<float>::infinity();
+    constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+
+    auto expected = Reference();
+    auto actual   = expected;
+    actual[1000] += 0.5f;
+    const auto finite_diff = miopen::max_diff(expected, actual);
+    EXPECT_NEAR(finite_diff, 0.5, 1e-4);
+
+    // Matching infinities do not count as a difference.
+    expected[2000] = actual[2000] = inf;
+    expected[3000] = actual[3000] = -inf;
+    EXPECT_EQ(miopen::max_diff(expected, actual), finite_diff);
+
+    // NaNs are skipped.
+    actual[n - 1] = nan;
+    EXPECT_EQ(miopen::max_diff(expected, actual), finite_diff);
+
+    actual[4000] = inf;
+    EXPECT_EQ(miopen::max_diff(expected, actual), inf);
+}
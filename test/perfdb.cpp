@@ -30,7 +30,9 @@
 #include <miopen/filesystem.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/lock_file.hpp>
+#include <miopen/log_db.hpp>
 #include <miopen/process.hpp>
 #include <miopen/ramdb.hpp>
 #include <miopen/readonlyramdb.hpp>
@@ -39,6 +41,7 @@
 #include <boost/optional.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -103,6 +106,7 @@ struct ArgsHelper
     {
         static constexpr const char* db    = "db";
         static constexpr const char* ramdb = "ramdb";
+        static constexpr const char* logdb = "logdb";
 
         template <class TDb>
         static constexpr std::enable_if_t<std::is_same<TDb, PlainTextDb>::value, const char*> Get()
@@ -115,6 +119,12 @@ struct ArgsHelper
         {
             return ramdb;
         }
+
+        template <class TDb>
+        static constexpr std::enable_if_t<std::is_same<TDb, LogDb>::value, const char*> Get()
+        {
+            return logdb;
+        }
     };
 };
 
@@ -237,6 +247,16 @@ protected:
 
     static void ResetDbFile(TempFile& tmp_file) { tmp_file = TempFile{tmp_file.GetPathInfix()}; }
 
+    /// File which receives the writes of the database.
+    template <class TDb>
+    static fs::path WrittenFilePath(const TempFile& tmp_file)
+    {
+        if constexpr(std::is_same<TDb, LogDb>{})
+            return LogDb::GetLogFilePath(tmp_file.Path());
+        else
+            return tmp_file.Path();
+    }
+
     void ResetDb() { ResetDbFile(temp_file); }
 
     static const TestData& key()
@@ -371,7 +391,7 @@ public:
         }
 
         std::string read;
-        EXPECT(std::getline(std::ifstream(temp_file.Path()), read).good());
+        EXPECT(std::getline(std::ifstream(WrittenFilePath<TDb>(temp_file)), read).good());
 
         TDb db{DbKinds::PerfDb, temp_file};
         ValidateSingleEntry(key(), common_data(), db);
@@ -499,7 +519,7 @@ public:
         }
 
         std::string read;
-        EXPECT(std::getline(std::ifstream(temp_file.Path()), read).good());
+        EXPECT(std::getline(std::ifstream(WrittenFilePath<TDb>(temp_file)), read).good());
 
         TDb db{DbKinds::PerfDb, temp_file};
         ValidateSingleEntry(key(), common_data(), db);
@@ -979,6 +999,7 @@ public:
         DBMultiThreadedTestWork::Initialize();
 
         MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Launching test processes...");
+        const auto start = std::chrono::steady_clock::now();
         {
             auto& file_lock = LockFile::Get(lock_file_path);
             std::shared_lock<LockFile> lock(file_lock);
@@ -1013,6 +1034,19 @@ public:
             EXPECT_EQUAL(child.Wait(), 0);
         }
 
+        // Includes the startup of the processes, thus only comparable between the db classes.
+        const auto end     = std::chrono::steady_clock::now();
+        const auto elapsed = std::chrono::duration<double>(end - start);
+        const auto updates = DBMultiThreadedTestWork::threads_count *
+                             (DBMultiThreadedTestWork::common_part_size +
+                              DBMultiThreadedTestWork::unique_part_size);
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default,
+                          "Test",
+                          ArgsHelper::db_class::Get<TDb>()
+                              << " multiprocess throughput: " << updates << " updates in "
+                              << elapsed.count() * 1000 << " ms, "
+                              << updates / elapsed.count() << " updates/s");
+
         fs::remove(lock_file_path);
 
         const auto c = [this]()
@@ -1118,6 +1152,92 @@ private:
     static fs::path LockFilePath(const fs::path& db_path) { return db_path + ".test.lock"; }
 };
 
+class LogDbCompactionTest : public DbTest
+{
+public:
+    LogDbCompactionTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Testing logdb compaction...");
+
+        const TestData removed_key(100, 200);
+        const auto log_path = LogDb::GetLogFilePath(temp_file.Path());
+
+        LogDb db(DbKinds::PerfDb, temp_file);
+        EXPECT(db.Update(key(), id0(), value2()));
+        EXPECT(db.Update(key(), id1(), value1()));
+        EXPECT(db.Update(key(), id0(), value0()));
+        EXPECT(db.Update(removed_key, id2(), value2()));
+        EXPECT(db.RemoveRecord(removed_key));
+        EXPECT(db.Compact());
+
+        // The snapshot holds the merged records and the log is left with the header only.
+        {
+            std::ifstream snapshot(temp_file.Path());
+            std::string line;
+            EXPECT(std::getline(snapshot, line).good());
+            EXPECT(!std::getline(snapshot, line));
+        }
+        {
+            std::ifstream log(log_path);
+            std::string line;
+            EXPECT(std::getline(log, line).good());
+            EXPECT(!line.empty() && line.front() == '#');
+            EXPECT(!std::getline(log, line));
+        }
+        EXPECT_EQUAL(db.GetLogSize(), fs::file_size(log_path));
+
+        LogDb other(DbKinds::PerfDb, temp_file);
+        ValidateSingleEntry(key(), common_data(), other);
+        EXPECT(!other.FindRecord(removed_key));
+
+        // The instance which has been reading the previous generation of the log picks up the
+        // new snapshot.
+        EXPECT(other.Update(key(), id2(), value2()));
+        EXPECT(other.Compact());
+
+        const std::array<std::pair<const std::string, TestData>, 3> data{{
+            {id0(), value0()},
+            {id1(), value1()},
+            {id2(), value2()},
+        }};
+
+        ValidateSingleEntry(key(), data, db);
+    }
+};
+
+class LogDbTornEntryTest : public DbTest
+{
+public:
+    LogDbTornEntryTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(
+            LoggingLevel::Default, "Test", "Testing logdb for recovery from a torn entry...");
+
+        {
+            LogDb db(DbKinds::PerfDb, temp_file);
+            EXPECT(db.Update(key(), id0(), value0()));
+        }
+
+        // A writer which has crashed in the middle of an entry.
+        std::ofstream(LogDb::GetLogFilePath(temp_file.Path()), std::ios::app)
+            << "U0123456789abcdef " << key().x << 'x' << key().y << '=' << id2() << ":7";
+
+        {
+            LogDb db(DbKinds::PerfDb, temp_file);
+            EXPECT(db.Update(key(), id1(), value1()));
+        }
+
+        LogDb db(DbKinds::PerfDb, temp_file);
+        ValidateSingleEntry(key(), common_data(), db);
+        TestData read(TestData::NoInit{});
+        EXPECT(!db.Load(key(), id2(), read));
+    }
+};
+
 class DbMultiFileTest : public DbTest
 {
 protected:
@@ -1467,6 +1587,10 @@ struct PerfDbDriver : test_driver
             {
                 DbMultiProcessTest<RamDb>::WorkItem(mt_child_id, mt_child_db_path, test_write);
             }
+            else if(mt_child_db_class == ArgsHelper::db_class::logdb)
+            {
+                DbMultiProcessTest<LogDb>::WorkItem(mt_child_id, mt_child_db_path, test_write);
+            }
             return;
         }
 
@@ -1474,6 +1598,7 @@ struct PerfDbDriver : test_driver
 
         DbTests<RamDb>(temp_file);
         DbTests<PlainTextDb>(temp_file);
+        LogDbTests(temp_file);
         MultiFileDbTests(temp_file);
     }
 
@@ -1503,6 +1628,21 @@ private:
         DbMultiProcessTest<TDb>{temp_file}.Run();
     }
 
+    void LogDbTests(TempFile& temp_file) const
+    {
+        // Small enough for the test processes to compact the log in the background many times.
+        // Inherited by the child processes.
+        if(!env::getEnvironmentVariable("MIOPEN_DEBUG_USER_DB_COMPACTION_THRESHOLD"))
+            env::setEnvironmentVariable("MIOPEN_DEBUG_USER_DB_COMPACTION_THRESHOLD", "4096");
+
+        DbTests<LogDb>(temp_file);
+        if(!DisableUserDbFileIO)
+        {
+            LogDbCompactionTest{temp_file}.Run();
+            LogDbTornEntryTest{temp_file}.Run();
+        }
+    }
+
     void MultiFileDbTests(TempFile& temp_file) const
     {
         if(!DisableUserDbFileIO)
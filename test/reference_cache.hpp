@@ -0,0 +1,541 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef MIOPEN_GUARD_TEST_REFERENCE_CACHE_HPP
+#define MIOPEN_GUARD_TEST_REFERENCE_CACHE_HPP
+
+// Content-addressed on-disk cache of the results of the host reference implementations.
+//
+// An entry is keyed by a 128-bit hash of the primitive name, the problem description, the
+// reference data types and the contents of the input buffers, so a changed input or seed
+// never hits a stale entry. The outputs are byte-shuffled by element size and compressed with
+// bzip2, and the least recently used entries are removed when the total size of the cache
+// exceeds the limit. The cache is shared by the tests and MIOpenDriver and is header-only,
+// since the driver may not use the internal symbols of the library.
+//
+// MIOPEN_TEST_REFERENCE_CACHE_DIR enables the cache for all the references using Cached(),
+// MIOPEN_TEST_REFERENCE_CACHE_SIZE_LIMIT sets its size limit in MiB (4096 by default).
+
+#include "tensor_holder.hpp"
+
+#include <miopen/env.hpp>
+#include <miopen/filesystem.hpp>
+#include <miopen/hash128.hpp>
+#include <miopen/logger.hpp>
+
+#include <bzlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_TEST_REFERENCE_CACHE_DIR)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_TEST_REFERENCE_CACHE_SIZE_LIMIT, 4096)
+
+namespace reference_cache {
+
+namespace detail {
+
+template <class T, class = void>
+struct is_range : std::false_type
+{
+};
+
+template <class T>
+struct is_range<T, std::void_t<decltype(std::begin(std::declval<const T&>()))>> : std::true_type
+{
+};
+
+} // namespace detail
+
+/// Identifies a reference result: what is computed, on which problem and from which inputs.
+class Key
+{
+public:
+    explicit Key(std::string_view primitive) { Field(primitive.data(), primitive.size()); }
+
+    /// Adds a problem parameter. Arithmetic values are hashed bitwise, ranges element-wise
+    /// and anything else by its text representation.
+    template <class T>
+    Key& Problem(const T& value)
+    {
+        if constexpr(std::is_arithmetic_v<T> || std::is_enum_v<T>)
+        {
+            Field(&value, sizeof(value));
+        }
+        else if constexpr(detail::is_range<T>{})
+        {
+            auto count = std::size_t{0};
+            for(const auto& item : value)
+            {
+                Problem(item);
+                ++count;
+            }
+            Field(&count, sizeof(count));
+        }
+        else
+        {
+            auto ss = std::ostringstream{};
+            ss << value;
+            const auto str = ss.str();
+            Field(str.data(), str.size());
+        }
+        return *this;
+    }
+
+    /// Adds a data type of the computation, e.g. the accumulator type.
+    template <class T>
+    Key& Type()
+    {
+        const auto name = std::string_view{typeid(T).name()};
+        const auto size = sizeof(T);
+        Field(name.data(), name.size());
+        Field(&size, sizeof(size));
+        return *this;
+    }
+
+    /// Adds the data type, the lengths and the strides of a tensor, but not its contents.
+    /// Used for the outputs.
+    template <class T>
+    Key& Layout(const tensor<T>& t)
+    {
+        return Type<T>().Problem(t.desc.GetLengths()).Problem(t.desc.GetStrides());
+    }
+
+    template <class T>
+    Key& Input(const T* data, std::size_t size)
+    {
+        Type<T>();
+        Field(data, size * sizeof(T));
+        return *this;
+    }
+
+    template <class T>
+    Key& Input(const std::vector<T>& data)
+    {
+        return Input(data.data(), data.size());
+    }
+
+    template <class T>
+    Key& Input(const tensor<T>& t)
+    {
+        return Layout(t).Input(t.data);
+    }
+
+    /// 32 hexadecimal digits, used as the file name of the entry.
+    std::string Digest() const { return hash.Final().ToString(); }
+
+private:
+    miopen::Hash128Stream hash;
+
+    // Each field is hashed together with its size, so the fields cannot run into each other.
+    void Field(const void* data, std::size_t size)
+    {
+        hash.Update(data, size);
+        hash.Update(&size, sizeof(size));
+    }
+};
+
+/// A raw view of an output of the reference.
+struct Buffer
+{
+    void* data;
+    std::size_t size;
+    std::size_t element_size;
+};
+
+template <class T>
+Buffer Output(std::vector<T>& data)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "The outputs are cached as bytes");
+    return {data.data(), data.size() * sizeof(T), sizeof(T)};
+}
+
+template <class T>
+Buffer Output(tensor<T>& t)
+{
+    return Output(t.data);
+}
+
+namespace detail {
+
+constexpr char Magic[8] = {'M', 'I', 'O', 'R', 'E', 'F', 'C', '2'};
+
+struct BufferHeader
+{
+    std::uint64_t size;
+    std::uint64_t element_size;
+    std::uint64_t stored_size;
+    std::uint64_t compressed;
+    std::uint64_t checksum;
+};
+
+inline std::uint64_t Checksum(const void* data, std::size_t size)
+{
+    return miopen::Hash128Stream{}.Update(data, size).Final().lo;
+}
+
+// Groups the bytes of equal significance together. The sign and exponent bytes of
+// the neighbouring values are similar, so the shuffled data compresses much better.
+inline std::vector<char> Shuffle(const char* data, std::size_t size, std::size_t element_size)
+{
+    auto result = std::vector<char>(size);
+    if(element_size <= 1)
+    {
+        std::copy_n(data, size, result.begin());
+        return result;
+    }
+    const auto count = size / element_size;
+    for(std::size_t i = 0; i < count; ++i)
+        for(std::size_t b = 0; b < element_size; ++b)
+            result[b * count + i] = data[i * element_size + b];
+    return result;
+}
+
+inline void Unshuffle(const char* data, std::size_t size, std::size_t element_size, char* result)
+{
+    if(element_size <= 1)
+    {
+        std::copy_n(data, size, result);
+        return;
+    }
+    const auto count = size / element_size;
+    for(std::size_t i = 0; i < count; ++i)
+        for(std::size_t b = 0; b < element_size; ++b)
+            result[i * element_size + b] = data[b * count + i];
+}
+
+// Returns false if the data does not compress, in which case it is stored as is.
+inline bool Compress(std::vector<char>& data)
+{
+    if(data.size() > std::numeric_limits<unsigned int>::max())
+        return false;
+    auto result = std::vector<char>(data.size());
+    auto size   = static_cast<unsigned int>(result.size());
+    if(BZ2_bzBuffToBuffCompress(result.data(),
+                                &size,
+                                data.data(),
+                                static_cast<unsigned int>(data.size()),
+                                1,
+                                0,
+                                0) != BZ_OK)
+        return false;
+    result.resize(size);
+    data = std::move(result);
+    return true;
+}
+
+inline bool Decompress(std::vector<char>& data, std::size_t size)
+{
+    if(size > std::numeric_limits<unsigned int>::max() ||
+       data.size() > std::numeric_limits<unsigned int>::max())
+        return false;
+    auto result    = std::vector<char>(size);
+    auto read_size = static_cast<unsigned int>(size);
+    if(BZ2_bzBuffToBuffDecompress(result.data(),
+                                  &read_size,
+                                  data.data(),
+                                  static_cast<unsigned int>(data.size()),
+                                  0,
+                                  0) != BZ_OK ||
+       read_size != size)
+        return false;
+    data = std::move(result);
+    return true;
+}
+
+} // namespace detail
+
+class Store
+{
+public:
+    Store(miopen::fs::path directory_, std::uint64_t size_limit_)
+        : directory(std::move(directory_)), size_limit(size_limit_)
+    {
+        auto ec = std::error_code{};
+        miopen::fs::create_directories(directory, ec);
+    }
+
+    /// Uses the size limit set by the environment.
+    explicit Store(miopen::fs::path directory_)
+        : Store(std::move(directory_),
+                miopen::env::value(MIOPEN_TEST_REFERENCE_CACHE_SIZE_LIMIT) * 1024 * 1024)
+    {
+    }
+
+    /// The store configured by the environment, nullptr if the cache is disabled.
+    static Store* Default()
+    {
+        static const auto store = []() -> std::unique_ptr<Store> {
+            const auto dir = miopen::env::value(MIOPEN_TEST_REFERENCE_CACHE_DIR);
+            if(dir.empty())
+                return nullptr;
+            return std::make_unique<Store>(dir);
+        }();
+        return store.get();
+    }
+
+    /// Fills the outputs from the cache. The outputs are left untouched if the entry is missing,
+    /// was written for buffers of different sizes or is corrupted.
+    bool Load(const Key& key, const std::vector<Buffer>& outputs) const
+    {
+        const auto path = GetPath(key);
+        auto file       = std::ifstream{path, std::ios::binary};
+        if(!file)
+            return false;
+
+        auto ec         = std::error_code{};
+        const auto size = static_cast<std::uint64_t>(miopen::fs::file_size(path, ec));
+        if(ec)
+            return false;
+
+        char magic[sizeof(detail::Magic)];
+        auto count = std::uint64_t{};
+        if(!Read(file, magic) || std::memcmp(magic, detail::Magic, sizeof(magic)) != 0 ||
+           !Read(file, count) || count != outputs.size())
+            return Reject(path);
+
+        auto headers = std::vector<detail::BufferHeader>(outputs.size());
+        for(std::size_t i = 0; i < outputs.size(); ++i)
+        {
+            if(!Read(file, headers[i]) || headers[i].size != outputs[i].size ||
+               headers[i].element_size != outputs[i].element_size ||
+               headers[i].stored_size > size)
+                return Reject(path);
+        }
+
+        // Decoded aside and copied out only once all the buffers are valid, since the caller
+        // computes into the same buffers on a miss.
+        auto decoded = std::vector<std::vector<char>>(outputs.size());
+        for(std::size_t i = 0; i < outputs.size(); ++i)
+        {
+            const auto& header = headers[i];
+            auto data          = std::vector<char>(header.stored_size);
+            if(!file.read(data.data(), data.size()) ||
+               (header.compressed != 0 && !detail::Decompress(data, header.size)) ||
+               data.size() != header.size)
+                return Reject(path);
+            decoded[i].resize(data.size());
+            detail::Unshuffle(data.data(), data.size(), header.element_size, decoded[i].data());
+            if(detail::Checksum(decoded[i].data(), decoded[i].size()) != header.checksum)
+                return Reject(path);
+        }
+
+        for(std::size_t i = 0; i < outputs.size(); ++i)
+            std::copy(decoded[i].begin(), decoded[i].end(), static_cast<char*>(outputs[i].data));
+
+        // The modification time tracks the last use for the eviction.
+        miopen::fs::last_write_time(path, miopen::fs::file_time_type::clock::now(), ec);
+        MIOPEN_LOG_I2("Reference cache hit: " << path);
+        return true;
+    }
+
+    /// Stores the outputs and evicts the least recently used entries over the size limit.
+    /// Failures are logged and otherwise ignored: the cache is an optimization only.
+    void Save(const Key& key, const std::vector<Buffer>& outputs) const
+    {
+        const auto path = GetPath(key);
+        auto tmp        = path;
+        tmp += ".tmp" + std::to_string(std::random_device{}());
+        auto entry_size = std::uint64_t{0};
+
+        {
+            auto file    = std::ofstream{tmp, std::ios::binary};
+            auto headers = std::vector<detail::BufferHeader>{};
+            auto blobs   = std::vector<std::vector<char>>{};
+            for(const auto& output : outputs)
+            {
+                const auto* data    = static_cast<const char*>(output.data);
+                auto blob           = detail::Shuffle(data, output.size, output.element_size);
+                auto header         = detail::BufferHeader{};
+                header.size         = output.size;
+                header.element_size = output.element_size;
+                header.checksum     = detail::Checksum(data, output.size);
+                header.compressed   = detail::Compress(blob) ? 1 : 0;
+                header.stored_size  = blob.size();
+                headers.push_back(header);
+                blobs.push_back(std::move(blob));
+            }
+
+            const auto count = std::uint64_t{outputs.size()};
+            file.write(detail::Magic, sizeof(detail::Magic));
+            file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+            file.write(reinterpret_cast<const char*>(headers.data()),
+                       headers.size() * sizeof(detail::BufferHeader));
+            for(const auto& blob : blobs)
+                file.write(blob.data(), blob.size());
+            entry_size = static_cast<std::uint64_t>(file.tellp());
+
+            if(!file)
+            {
+                MIOPEN_LOG_W("Unable to write the reference cache entry: " << tmp);
+                file.close();
+                auto ec = std::error_code{};
+                miopen::fs::remove(tmp, ec);
+                return;
+            }
+        }
+
+        // Renaming is atomic, so concurrent readers never see a partially written entry.
+        auto ec = std::error_code{};
+        miopen::fs::rename(tmp, path, ec);
+        if(ec)
+        {
+            MIOPEN_LOG_W("Unable to save the reference cache entry: " << path << ", "
+                                                                      << ec.message());
+            miopen::fs::remove(tmp, ec);
+            return;
+        }
+        Evict(entry_size);
+    }
+
+    /// Runs compute() unless the outputs are found in the store, saves them otherwise.
+    template <class Compute, class... Outputs>
+    void Run(const Key& key, Compute compute, Outputs&... outputs) const
+    {
+        const auto buffers = std::vector<Buffer>{Output(outputs)...};
+        if(Load(key, buffers))
+            return;
+        compute();
+        Save(key, buffers);
+    }
+
+private:
+    miopen::fs::path directory;
+    std::uint64_t size_limit;
+
+    mutable std::mutex mutex;
+    // The size of the entries at the last scan of the directory plus the sizes of the entries
+    // saved since then, none before the first scan.
+    mutable std::optional<std::uint64_t> estimated_size;
+
+    static constexpr std::string_view Extension = ".ref";
+
+    miopen::fs::path GetPath(const Key& key) const
+    {
+        return directory / (key.Digest() + std::string{Extension});
+    }
+
+    template <class T>
+    static bool Read(std::istream& stream, T& value)
+    {
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    static bool Reject(const miopen::fs::path& path)
+    {
+        MIOPEN_LOG_W("Ignoring the invalid reference cache entry: " << path);
+        return false;
+    }
+
+    /// Only rescans the directory once the estimated size exceeds the limit, not on every
+    /// Save(). Other processes sharing the directory may overshoot the limit until one of them
+    /// rescans it.
+    void Evict(std::uint64_t added) const
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        if(estimated_size && (*estimated_size += added) <= size_limit)
+            return;
+        estimated_size = Scan();
+    }
+
+    /// Removes the least recently used entries over the size limit and returns the size of the
+    /// remaining ones.
+    std::uint64_t Scan() const
+    {
+        struct Entry
+        {
+            miopen::fs::path path;
+            miopen::fs::file_time_type time;
+            std::uint64_t size;
+        };
+
+        auto entries = std::vector<Entry>{};
+        auto total   = std::uint64_t{0};
+        auto ec      = std::error_code{};
+        for(auto it = miopen::fs::directory_iterator{directory, ec};
+            !ec && it != miopen::fs::directory_iterator{};
+            it.increment(ec))
+        {
+            if(it->path().extension() != Extension)
+                continue;
+            auto entry_ec = std::error_code{};
+            auto entry    = Entry{it->path(),
+                               miopen::fs::last_write_time(it->path(), entry_ec),
+                               miopen::fs::file_size(it->path(), entry_ec)};
+            if(entry_ec)
+                continue; // Removed concurrently.
+            total += entry.size;
+            entries.push_back(std::move(entry));
+        }
+
+        if(total <= size_limit)
+            return total;
+
+        std::sort(entries.begin(), entries.end(), [](const auto& l, const auto& r) {
+            return l.time < r.time;
+        });
+        for(const auto& entry : entries)
+        {
+            if(total <= size_limit)
+                break;
+            if(miopen::fs::remove(entry.path, ec))
+                MIOPEN_LOG_I2("Reference cache eviction: " << entry.path);
+            total -= entry.size;
+        }
+        return total;
+    }
+};
+
+/// Runs compute() unless the outputs are found in the store configured by the environment.
+/// make_key() is called only if the cache is enabled, because hashing the inputs is not free.
+template <class MakeKey, class Compute, class... Outputs>
+void Cached(MakeKey make_key, Compute compute, Outputs&... outputs)
+{
+    if(auto* const store = Store::Default())
+        store->Run(make_key(), std::move(compute), outputs...);
+    else
+        compute();
+}
+
+} // namespace reference_cache
+
+#endif
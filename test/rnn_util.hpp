@@ -33,13 +33,13 @@
 #include <set>
 #include <vector>
 #include <cstdlib>
+#include "gemm.hpp"
 #include "random.hpp"
 #include <numeric>
 
 #include <miopen/tensor.hpp>
 
 #define RNN_MM_TRANSPOSE 1
-#define RNN_MM_USEPARAGEMM 0
 
 // complexity O(NlogN)
 inline std::vector<int> GetReverseOrderIndex(const std::vector<int>& base_index)
@@ -294,102 +294,7 @@ void RNN_mm_cpu(const Dtype* a_ptr,
     }
 
     size_t inner_loop = (!(a_flags & RNN_MM_TRANSPOSE)) ? a_cols : a_rows;
-#if(!RNN_MM_USEPARAGEMM)
-    if(!(a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                double mm_e = 0;
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += static_cast<double>(a_ptr[n * a_stride + m]) *
-                            static_cast<double>(b_ptr[m * b_stride + k]);
-                }
-                c_ptr[n * c_stride + k] = static_cast<Dtype>(
-                    beta * static_cast<double>(c_ptr[n * c_stride + k]) + alpha * mm_e);
-            }
-        }
-    }
-    else if((a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                double mm_e = 0;
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += static_cast<double>(a_ptr[m * a_stride + n]) *
-                            static_cast<double>(b_ptr[m * b_stride + k]);
-#if 0
-					if (
-						(n == 0 && k == 33
-						|| n == 1 && k == 32
-						|| n == 3 && k == 1
-						|| n == 4 && k == 0
-
-						)
-						&& a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-						)
-					{
-                        std::cout << "C:mm: " << n << ", " << k << ", " << m << ", " <<
-							mm_e, a_ptr[m*a_stride + n] << ", " <<
-                                b_ptr[m*b_stride + k] << ", " <<
-                                a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] << std::endl;
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = static_cast<Dtype>(
-                    beta * static_cast<double>(c_ptr[n * c_stride + k]) + alpha * mm_e);
-            }
-        }
-    }
-    else if(!(a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                double mm_e = 0;
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += static_cast<double>(a_ptr[n * a_stride + m]) *
-                            static_cast<double>(b_ptr[k * b_stride + m]);
-#if 0
-					if (n == 0 && k == 6 && static_cast<double>(a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-					{
-                        std::cout << m << ", " << mm_e << ", " << ", " << static_cast<double>(a_ptr[n*a_stride + m] << ", " << b_ptr[k*b_stride + m] << std::endl;
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = static_cast<Dtype>(
-                    beta * static_cast<double>(c_ptr[n * c_stride + k]) + alpha * mm_e);
-            }
-        }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                double mm_e = 0;
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] +=
-                        static_cast<Dtype>(static_cast<double>(a_ptr[m * a_stride + n]) *
-                                           static_cast<double>(b_ptr[k * b_stride + m]));
-                }
-                c_ptr[n * c_stride + k] = static_cast<Dtype>(
-                    beta * static_cast<double>(c_ptr[n * c_stride + k]) + alpha * mm_e);
-            }
-        }
-#else
-    auto c_out = [&](int i, int j, double x) {
+    auto c_out = [&](std::size_t i, std::size_t j, double x) {
         c_ptr[i * c_stride + j] =
             static_cast<Dtype>(beta * static_cast<double>(c_ptr[i * c_stride + j]) + alpha * x);
     };
@@ -429,7 +334,6 @@ void RNN_mm_cpu(const Dtype* a_ptr,
              miopen::flip(with_stride(a_ptr, a_stride)),
              miopen::flip(with_stride(b_ptr, b_stride)),
              c_out);
-#endif
     }
 }
 
@@ -163,11 +163,17 @@ struct ProblemData : SQLiteSerializable<ProblemData>
     }
 
     static std::string table_name() { return "config"; }
+    void Serialize(std::ostream& stream) const { prob.Serialize(stream); }
     template <class Self, class F>
     static void Visit(Self&& self, F f)
     {
         conv::ProblemDescription::Visit(self.prob, f);
     }
+    template <class Self, class F>
+    static void VisitAll(Self&& self, const F& f)
+    {
+        conv::ProblemDescription::VisitAll(self.prob, f);
+    }
 };
 
 struct SolverData
@@ -400,6 +406,70 @@ public:
     }
 };
 
+class DbBatchedFindTest : public DbTest
+{
+public:
+    void Run() const
+    {
+        std::cout << "Testing batched find and prefetch..." << std::endl;
+
+        // More problems than fit into a single query.
+        constexpr auto count = 100;
+        std::vector<ProblemData> problems;
+        for(auto i = 0; i < count; ++i)
+            problems.emplace_back(i);
+
+        TempFile batched_file("miopen.tests.perfdb.batched");
+        {
+            SQLitePerfDb db(DbKinds::PerfDb, batched_file, false);
+            for(auto i = 0; i < count; i += 2)
+            {
+                EXPECT(db.Update(problems[i], id0(), value0()));
+                EXPECT(db.Update(problems[i], id1(), SolverData(i, -i)));
+            }
+
+            const auto records = db.FindRecords(problems);
+            EXPECT_EQUAL(records.size(), problems.size());
+            for(auto i = 0; i < count; ++i)
+            {
+                if(i % 2 != 0)
+                {
+                    EXPECT(!records[i]);
+                    continue;
+                }
+
+                SolverData read0, read1;
+                EXPECT(records[i]);
+                EXPECT(records[i]->GetValues(id0(), read0));
+                EXPECT(records[i]->GetValues(id1(), read1));
+                EXPECT_EQUAL(read0, value0());
+                EXPECT_EQUAL(read1, SolverData(i, -i));
+            }
+        }
+
+        // Goes through fresh MultiFileDb instances the same way GetDb(ctx) does, so the records
+        // only survive if the underlying system db instance is shared.
+        TempFile user_file("miopen.tests.perfdb.batched.user");
+        const auto get_db = [&]() {
+            return MultiFileDb<SQLitePerfDb, SQLitePerfDb, true>(
+                DbKinds::PerfDb, batched_file, user_file);
+        };
+        get_db().Prefetch(problems);
+
+        {
+            // Only the prefetched records carry the key of the problem.
+            const auto record = get_db().FindRecord(problems[2]);
+            EXPECT(record);
+            EXPECT_EQUAL(record->GetKey(), DbRecord(DbKinds::PerfDb, problems[2]).GetKey());
+        }
+
+        SolverData read;
+        EXPECT(get_db().Load(problems[2], id1(), read));
+        EXPECT_EQUAL(read, SolverData(2, -2));
+        EXPECT(!get_db().Load(problems[3], id0(), read));
+    }
+};
+
 class DbOperationsTest : public DbTest
 {
 public:
@@ -1287,6 +1357,7 @@ struct PerfDbDriver : test_driver
             return;
         }
         DbFindTest().Run();
+        DbBatchedFindTest().Run();
         DbOperationsTest().Run();
         DbParallelTest().Run();
         DbMultiThreadedTest().Run();
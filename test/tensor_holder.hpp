@@ -47,6 +47,15 @@ using bfloat8 = miopen_f8::hip_f8<miopen_f8::hip_f8_type::bf8>;
 #include <iomanip>
 #include <fstream>
 
+template <class F, class Seq>
+struct is_invocable_with_indices;
+
+template <class F, std::size_t... Ns>
+struct is_invocable_with_indices<F, std::index_sequence<Ns...>>
+    : std::is_invocable<F, decltype(static_cast<void>(Ns), std::size_t{})...>
+{
+};
+
 template <class F>
 void visit_tensor_size(std::size_t n, F f)
 {
@@ -231,8 +240,24 @@ struct tensor
         return std::move(*this);
     }
 
+    /// Same as generate(), but runs on the shared thread pool. The numbers drawn by g for an
+    /// element depend only on its index (see prng::par_generate), thus the result does not depend
+    /// on the number of threads, but it differs from the result of generate().
     template <class G>
-    void generate_impl(G g)
+    tensor& par_generate(G g) &
+    {
+        this->par_generate_impl(g);
+        return *this;
+    }
+
+    template <class G>
+    tensor&& par_generate(G g) &&
+    {
+        this->par_generate_impl(g);
+        return std::move(*this);
+    }
+
+    std::size_t generate_seed() const
     {
         auto seed = std::accumulate(desc.GetLengths().begin(),
                                     desc.GetLengths().end(),
@@ -243,7 +268,13 @@ struct tensor
                                     });
         seed ^= data.size();
         seed ^= desc.GetLengths().size();
-        prng::reset_seed(seed);
+        return seed;
+    }
+
+    template <class G>
+    void generate_impl(G g)
+    {
+        prng::reset_seed(generate_seed());
         auto iterator = data.begin();
         auto assign   = [&](T x) {
             *iterator = x;
@@ -256,16 +287,7 @@ struct tensor
     template <class G>
     void generate_vect_impl(G g)
     {
-        auto seed = std::accumulate(desc.GetLengths().begin(),
-                                    desc.GetLengths().end(),
-                                    std::size_t{521288629},
-                                    [](auto x, auto y) {
-                                        x ^= x << 1U;
-                                        return x ^ y;
-                                    });
-        seed ^= data.size();
-        seed ^= desc.GetLengths().size();
-        prng::reset_seed(seed);
+        prng::reset_seed(generate_seed());
         auto iterator     = data.begin();
         auto vectorLength = desc.GetVectorLength();
         auto assign       = [&](T x) {
@@ -281,6 +303,44 @@ struct tensor
             miopen::compose(miopen::compose(assign, miopen::cast_to<T>()), std::move(g)));
     }
 
+    // Like generate_impl() and generate_vect_impl(), fills the beginning of the data in the order
+    // of the packed layout and repeats the value over the vector components.
+    template <class G>
+    void par_generate_impl(G g)
+    {
+        const auto seed          = generate_seed() + prng::details::get_default_seed();
+        const auto vector_length = static_cast<std::size_t>(desc.GetVectorLength());
+        visit_tensor_size(desc.GetLengths().size(), [&](auto size) {
+            constexpr auto dims = decltype(size)::value;
+            if constexpr(!is_invocable_with_indices<const G&, std::make_index_sequence<dims>>{})
+            {
+                throw std::runtime_error(
+                    "Arguments to par_generate do not match tensor size or the function " +
+                    miopen::get_type_name<G>() + " can not be called.");
+            }
+            else
+            {
+                std::array<std::size_t, dims> lens;
+                std::copy_n(desc.GetLengths().begin(), dims, lens.begin());
+                const auto count = std::accumulate(
+                    lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+                assert(count * vector_length <= data.size());
+
+                prng::par_generate(count, seed, [&](std::size_t i) {
+                    auto indices = lens;
+                    auto rest    = i;
+                    for(auto d = dims; d-- > 0;)
+                    {
+                        indices[d] = rest % lens[d];
+                        rest /= lens[d];
+                    }
+                    const auto x = miopen::cast_to<T>{}(miopen::unpack(std::cref(g), indices));
+                    std::fill_n(data.begin() + i * vector_length, vector_length, x);
+                });
+            }
+        });
+    }
+
     template <class Loop, class F>
     struct for_each_unpacked
     {
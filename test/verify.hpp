@@ -38,6 +38,7 @@ using half         = half_float::half;
 using hip_bfloat16 = bfloat16;
 #include <hip_float8.hpp>
 #include "tensor_holder.hpp"
+#include "verify_engine.hpp"
 
 namespace miopen {
 
@@ -118,6 +119,43 @@ struct square_diff_fn
 };
 static constexpr square_diff_fn square_diff{};
 
+// Ranges stored contiguously with a value type the comparison engine supports are compared by
+// it (verify_engine.hpp), other ranges element by element.
+template <class T>
+const T* contiguous_data(const std::vector<T>& v)
+{
+    return v.data();
+}
+
+template <class T>
+const T* contiguous_data(const tensor<T>& t)
+{
+    return t.data.data();
+}
+
+template <class T>
+struct is_verifiable : std::integral_constant<bool,
+                                              std::is_arithmetic<T>{} || std::is_same<T, half>{} ||
+                                                  std::is_same<T, bfloat16>{} ||
+                                                  std::is_same<T, float8>{} ||
+                                                  std::is_same<T, bfloat8>{}>
+{
+};
+
+template <class R, class = void>
+struct is_contiguous_range : std::false_type
+{
+};
+
+template <class R>
+struct is_contiguous_range<R, std::void_t<decltype(contiguous_data(std::declval<const R&>()))>>
+    : is_verifiable<range_value<R>>
+{
+};
+
+template <class R>
+constexpr bool is_contiguous_range_v = is_contiguous_range<std::decay_t<R>>{};
+
 template <class R1>
 bool range_empty(R1&& r1)
 {
@@ -127,6 +165,34 @@ bool range_empty(R1&& r1)
 template <class R1>
 auto range_distance(R1&& r1) MIOPEN_RETURNS(std::distance(r1.begin(), r1.end()));
 
+/// The options of the comparisons which only need the statistics, not the offenders.
+inline verification::options statistics_only()
+{
+    auto opts          = verification::options{};
+    opts.max_offenders = 0;
+    opts.ulp_histogram = false;
+    return opts;
+}
+
+/// Single pass comparison of contiguous ranges, see verification::report. The offenders of a
+/// tensor also get their coordinates.
+template <class R1, class R2>
+verification::report
+compare_range(const R1& r1, const R2& r2, const verification::options& opts = {})
+{
+    static_assert(is_contiguous_range_v<R1> && is_contiguous_range_v<R2>,
+                  "The ranges must be stored contiguously");
+    const auto n = static_cast<std::size_t>(std::min(range_distance(r1), range_distance(r2)));
+    auto result = verification::compare(contiguous_data(r1), contiguous_data(r2), n, opts);
+    if constexpr(std::is_same<R1, tensor<range_value<R1>>>{})
+    {
+        for(auto& o : result.offenders)
+            o.coordinates =
+                verification::coordinates(o.index, r1.desc.GetLengths(), r1.desc.GetStrides());
+    }
+    return result;
+}
+
 template <class R>
 bool f8_range_zero(R& r);
 
@@ -163,24 +229,72 @@ T range_product(R1&& r1, R2&& r2, T state, Reducer r, Product p)
 template <class R1, class R2, class Compare>
 std::size_t mismatch_idx(R1&& r1, R2&& r2, Compare compare)
 {
-    auto p = std::mismatch(r1.begin(), r1.end(), r2.begin(), compare);
-    return std::distance(r1.begin(), p.first);
+    // The chunks are searched in parallel only with the stateless comparisons of this header.
+    if constexpr(is_contiguous_range_v<R1> && is_contiguous_range_v<R2> &&
+                 std::is_same<Compare, float_equal_fn>{})
+    {
+        const auto* p1 = contiguous_data(r1);
+        const auto* p2 = contiguous_data(r2);
+        const auto n  = static_cast<std::size_t>(std::min(range_distance(r1), range_distance(r2)));
+        return verification::find_first(n, [&](std::size_t i) { return !compare(p1[i], p2[i]); });
+    }
+    else
+    {
+        auto p = std::mismatch(r1.begin(), r1.end(), r2.begin(), compare);
+        return std::distance(r1.begin(), p.first);
+    }
 }
 
 template <class R1, class Predicate>
 int64_t find_idx(R1&& r1, Predicate p)
 {
-    auto it = std::find_if(r1.begin(), r1.end(), p);
-    if(it == r1.end())
-        return -1;
+    if constexpr(is_contiguous_range_v<R1> && std::is_same<Predicate, not_finite_fn>{})
+    {
+        const auto* data = contiguous_data(r1);
+        const auto n     = static_cast<std::size_t>(range_distance(r1));
+        const auto idx   = verification::find_first(n, [&](std::size_t i) { return p(data[i]); });
+        return idx == n ? -1 : static_cast<int64_t>(idx);
+    }
     else
-        return std::distance(r1.begin(), it);
+    {
+        auto it = std::find_if(r1.begin(), r1.end(), p);
+        if(it == r1.end())
+            return -1;
+        else
+            return std::distance(r1.begin(), it);
+    }
 }
 
+/// The largest absolute difference of the elements. Equal values, including matching
+/// infinities, differ by 0. NaN differences are skipped, find_idx(r, not_finite) catches them.
 template <class R1, class R2>
 double max_diff(R1&& r1, R2&& r2)
 {
-    return range_product(r1, r2, 0.0, max, abs_diff);
+    if constexpr(is_contiguous_range_v<R1> && is_contiguous_range_v<R2>)
+    {
+        const auto result = compare_range(r1, r2, statistics_only());
+        if(!result.has_non_finite())
+            return result.max_abs_diff;
+
+        // The engine reports non-finite differences only as counts, the rare ranges with
+        // non-finite values are reduced element by element.
+        const auto* p1 = contiguous_data(r1);
+        const auto* p2 = contiguous_data(r2);
+        const auto n   = static_cast<std::size_t>(std::min(range_distance(r1), range_distance(r2)));
+        auto diff      = 0.0;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            const auto x = verification::detail::to_double(p1[i]);
+            const auto y = verification::detail::to_double(p2[i]);
+            if(x != y && !std::isnan(x - y))
+                diff = std::max(diff, std::fabs(x - y));
+        }
+        return diff;
+    }
+    else
+    {
+        return range_product(r1, r2, 0.0, max, abs_diff);
+    }
 }
 
 template <class R1, class R2, class T>
@@ -199,6 +313,10 @@ double rms_range(R1&& r1, R2&& r2)
     std::size_t n = range_distance(r1);
     if(n == range_distance(r2))
     {
+        // The engine squares the differences in double rather than in the common type of the
+        // ranges, which may only make the result more accurate.
+        if constexpr(is_contiguous_range_v<R1> && is_contiguous_range_v<R2>)
+            return compare_range(r1, r2, statistics_only()).rms();
         if(n == 0)
             return 0;
         double square_difference = range_product(r1, r2, 0.0, sum_fn{}, square_diff);
@@ -0,0 +1,605 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_VERIFY_ENGINE_HPP
+#define GUARD_VERIFY_ENGINE_HPP
+
+// Single pass comparison of a result with its reference, used by rms_range, max_diff and the
+// reporting of the test drivers.
+//
+// The buffers are split in fixed-size chunks which are compared on the shared thread pool. A
+// chunk is converted to double in small blocks, the statistics of a block are accumulated in
+// independent lanes by a kernel which is free to vectorize, and the partial results are merged
+// in the order of the chunks. Hence the result does not depend on the number of threads nor on
+// the instruction set the kernel has been dispatched to.
+//
+// The comparison computes at once:
+//  - the sum of the squared differences and the magnitudes of both buffers (see rms()),
+//  - the maximum absolute and relative differences of the finite pairs and their positions,
+//  - the histogram of the distances in units in the last place of the checked type,
+//  - the number of non-finite values in each buffer,
+//  - the number of elements exceeding the tolerance and the first ones of them.
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MIOPEN_VERIFY_X86_DISPATCH 1
+#else
+#define MIOPEN_VERIFY_X86_DISPATCH 0
+#endif
+
+namespace miopen {
+namespace verification {
+
+/// Bin 0 counts the equal values, bin b > 0 the distances in [2^(b-1), 2^b), the last bin
+/// also counts all the larger distances.
+constexpr std::size_t ulp_bins = 16;
+
+struct options
+{
+    /// An element is offending when |actual - expected| > abs_tolerance + rel_tolerance *
+    /// |expected|, or when one of the values is not finite and the values are not equal.
+    double abs_tolerance = 0;
+    double rel_tolerance = 0;
+    /// Number of offending elements to be recorded in report::offenders.
+    std::size_t max_offenders = 16;
+    /// Computing the histogram takes about as long as the rest of the comparison.
+    bool ulp_histogram = true;
+};
+
+struct offender
+{
+    /// Offset of the element in the buffers.
+    std::size_t index = 0;
+    /// Coordinates of the element, filled by the comparisons of tensors only.
+    std::vector<std::size_t> coordinates;
+    double expected = 0;
+    double actual   = 0;
+};
+
+struct report
+{
+    std::size_t count               = 0;
+    double sum_square_diff          = 0;
+    double expected_magnitude       = 0;
+    double actual_magnitude         = 0;
+    double max_abs_diff             = 0;
+    std::size_t max_abs_diff_index  = 0;
+    /// Relative to max(|expected|, smallest normal double).
+    double max_rel_diff             = 0;
+    std::size_t max_rel_diff_index  = 0;
+    std::size_t non_finite_expected = 0;
+    std::size_t non_finite_actual   = 0;
+    std::size_t num_offenders       = 0;
+    std::array<std::size_t, ulp_bins> ulp_histogram{};
+    /// The first options::max_offenders offending elements, by increasing index.
+    std::vector<offender> offenders;
+
+    /// Root mean square of the differences normalized by the largest magnitude, the metric of
+    /// rms_range(). Not finite if any of the values is not finite.
+    double rms() const
+    {
+        if(count == 0)
+            return 0;
+        const auto mag = std::max(
+            {expected_magnitude, actual_magnitude, std::numeric_limits<double>::min()});
+        return std::sqrt(sum_square_diff) / (std::sqrt(static_cast<double>(count)) * mag);
+    }
+
+    bool has_non_finite() const { return non_finite_expected != 0 || non_finite_actual != 0; }
+
+    friend std::ostream& operator<<(std::ostream& os, const report& r)
+    {
+        os << "Elements: " << r.count << ", RMS: " << r.rms() << ", max abs diff: "
+           << r.max_abs_diff << " at " << r.max_abs_diff_index
+           << ", max rel diff: " << r.max_rel_diff << " at " << r.max_rel_diff_index
+           << ", non finite: " << r.non_finite_expected << " (expected) "
+           << r.non_finite_actual << " (actual), offending: " << r.num_offenders << std::endl;
+
+        os << "ULP histogram:";
+        for(std::size_t b = 0; b < ulp_bins; ++b)
+        {
+            if(r.ulp_histogram[b] == 0)
+                continue;
+            os << ' ';
+            if(b == 0)
+                os << "0";
+            else if(b == ulp_bins - 1)
+                os << ">=" << (std::uint64_t{1} << (b - 1));
+            else
+                os << "[" << (std::uint64_t{1} << (b - 1)) << "," << (std::uint64_t{1} << b)
+                   << ")";
+            os << ":" << r.ulp_histogram[b];
+        }
+        os << std::endl;
+
+        for(const auto& o : r.offenders)
+        {
+            os << "Mismatch at " << o.index;
+            if(!o.coordinates.empty())
+            {
+                os << " {";
+                for(std::size_t i = 0; i < o.coordinates.size(); ++i)
+                    os << (i == 0 ? "" : ",") << o.coordinates[i];
+                os << "}";
+            }
+            os << ": " << o.expected << " != " << o.actual << std::endl;
+        }
+        return os;
+    }
+};
+
+/// Coordinates of the element at the offset in a tensor with these lengths and strides. The
+/// dimensions are visited by decreasing stride, which is exact for any non-overlapping layout.
+inline std::vector<std::size_t> coordinates(std::size_t offset,
+                                            const std::vector<std::size_t>& lengths,
+                                            const std::vector<std::size_t>& strides)
+{
+    auto order = std::vector<std::size_t>(lengths.size());
+    for(std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](auto l, auto r) {
+        return strides[l] > strides[r];
+    });
+
+    auto ids = std::vector<std::size_t>(lengths.size());
+    for(const auto d : order)
+    {
+        if(strides[d] == 0 || lengths[d] <= 1)
+            continue;
+        ids[d] = std::min(offset / strides[d], lengths[d] - 1);
+        offset -= ids[d] * strides[d];
+    }
+    return ids;
+}
+
+namespace detail {
+
+/// Elements converted to double and compared by the kernel at once.
+constexpr std::size_t block_size = 512;
+/// Independent accumulators of the kernel, an AVX2 register of doubles.
+constexpr std::size_t lanes = 4;
+/// Elements compared by a task of the thread pool. Fixed to make the result deterministic.
+constexpr std::size_t chunk_size = std::size_t{1} << 16;
+
+static_assert(block_size % lanes == 0, "Blocks must consist of whole lanes");
+
+struct block_stats
+{
+    double sum_square_diff;
+    double expected_magnitude;
+    double actual_magnitude;
+    double max_abs_diff;
+    double max_rel_diff;
+    std::size_t non_finite_expected;
+    std::size_t non_finite_actual;
+    std::size_t num_offenders;
+};
+
+/// Histograms of the lanes, the non-finite pairs are counted in the extra bin. Successive
+/// elements usually fall in the same bin: with a single histogram, every increment would wait
+/// for the previous one.
+using lane_histograms = std::size_t[lanes][ulp_bins + 1];
+
+/// A vector of lanes, the compiler splits the operations according to the target ISA.
+typedef double vdouble __attribute__((vector_size(lanes * sizeof(double))));
+typedef std::int64_t vmask __attribute__((vector_size(lanes * sizeof(std::int64_t))));
+typedef std::uint64_t vuint __attribute__((vector_size(lanes * sizeof(std::uint64_t))));
+
+/// n shall be a multiple of lanes. Every lane accumulates the elements i with i % lanes equal
+/// to the lane, and the lanes are reduced in a fixed order: the result does not depend on the
+/// width of the vector registers. The differences are squared and added without fused
+/// multiply-adds. The histogram is updated only if the ordinals are given.
+[[gnu::always_inline]] inline void compare_kernel_impl(const double* e,
+                                                       const double* a,
+                                                       const std::int64_t* oe,
+                                                       const std::int64_t* oa,
+                                                       std::size_t n,
+                                                       double abs_tolerance,
+                                                       double rel_tolerance,
+                                                       block_stats& stats,
+                                                       lane_histograms& histograms)
+{
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+    constexpr auto min = std::numeric_limits<double>::min();
+
+    vdouble sum     = {};
+    vdouble mag_e   = {};
+    vdouble mag_a   = {};
+    vdouble max_abs = {};
+    vdouble max_rel = {};
+    vmask nf_e      = {};
+    vmask nf_a      = {};
+    vmask off       = {};
+
+    for(std::size_t i = 0; i < n; i += lanes)
+    {
+        vdouble x;
+        vdouble y;
+        std::memcpy(&x, e + i, sizeof(vdouble));
+        std::memcpy(&y, a + i, sizeof(vdouble));
+
+        const auto d    = y - x;
+        const auto sq   = d * d;
+        const auto ad   = d < 0 ? -d : d;
+        const auto ax   = x < 0 ? -x : x;
+        const auto ay   = y < 0 ? -y : y;
+        const auto fx   = ax < inf;
+        const auto fy   = ay < inf;
+        const auto both = fx & fy;
+        const auto rel  = ad / (ax > min ? ax : min);
+        const auto tol  = abs_tolerance + rel_tolerance * ax;
+
+        sum += sq;
+        // NaN magnitudes are ignored, as by max_element in rms_range.
+        mag_e   = ax > mag_e ? ax : mag_e;
+        mag_a   = ay > mag_a ? ay : mag_a;
+        max_abs = (both & (ad > max_abs)) != 0 ? ad : max_abs;
+        max_rel = (both & (rel > max_rel)) != 0 ? rel : max_rel;
+        nf_e += ~fx & 1;
+        nf_a += ~fy & 1;
+        off += ((both & (ad > tol)) | (~both & ~(x == y))) & 1;
+
+        if(oe != nullptr)
+        {
+            // Bins of the distances between the ordinals, see ordinal(). A distance is clamped
+            // to the lower bound of the last bin and converted to double exactly by placing it
+            // in the mantissa of 2^52, the bin is then the unbiased exponent plus one.
+            constexpr auto last  = std::uint64_t{1} << (ulp_bins - 2);
+            constexpr auto two52 = std::uint64_t{0x4330000000000000};
+
+            vuint p;
+            vuint q;
+            std::memcpy(&p, oe + i, sizeof(vuint));
+            std::memcpy(&q, oa + i, sizeof(vuint));
+            // The unsigned differences are exact, even between the ordinals of large doubles
+            // of opposite signs.
+            const auto dist  = reinterpret_cast<vmask>(p) > reinterpret_cast<vmask>(q) ? p - q
+                                                                                       : q - p;
+            const auto exact = reinterpret_cast<vdouble>((dist < last ? dist : last) | two52);
+            const auto exp   = reinterpret_cast<vmask>(exact - 0x1p52) >> 52;
+            const auto bin   = both != 0 ? (exp > 1022 ? exp - 1022 : 0) : std::int64_t{ulp_bins};
+            for(std::size_t l = 0; l < lanes; ++l)
+                ++histograms[l][bin[l]];
+        }
+    }
+
+    stats = block_stats{};
+    for(std::size_t l = 0; l < lanes; ++l)
+    {
+        stats.sum_square_diff += sum[l];
+        stats.expected_magnitude = std::max(stats.expected_magnitude, mag_e[l]);
+        stats.actual_magnitude   = std::max(stats.actual_magnitude, mag_a[l]);
+        stats.max_abs_diff       = std::max(stats.max_abs_diff, max_abs[l]);
+        stats.max_rel_diff       = std::max(stats.max_rel_diff, max_rel[l]);
+        stats.non_finite_expected += nf_e[l];
+        stats.non_finite_actual += nf_a[l];
+        stats.num_offenders += off[l];
+    }
+}
+
+using compare_kernel = void (*)(const double*,
+                                const double*,
+                                const std::int64_t*,
+                                const std::int64_t*,
+                                std::size_t,
+                                double,
+                                double,
+                                block_stats&,
+                                lane_histograms&);
+
+#define MIOPEN_VERIFY_KERNEL_ARGS                                                             \
+    const double *e, const double *a, const std::int64_t *oe, const std::int64_t *oa,           \
+        std::size_t n, double abs_tolerance, double rel_tolerance, block_stats &stats,          \
+        lane_histograms &histograms
+
+inline void compare_kernel_default(MIOPEN_VERIFY_KERNEL_ARGS)
+{
+    compare_kernel_impl(e, a, oe, oa, n, abs_tolerance, rel_tolerance, stats, histograms);
+}
+
+#if MIOPEN_VERIFY_X86_DISPATCH
+// No FMA and no AVX-512 (which implies FMA): the sums are rounded as by the default kernel.
+__attribute__((target("avx2"))) inline void compare_kernel_avx2(MIOPEN_VERIFY_KERNEL_ARGS)
+{
+    compare_kernel_impl(e, a, oe, oa, n, abs_tolerance, rel_tolerance, stats, histograms);
+}
+#endif
+
+#undef MIOPEN_VERIFY_KERNEL_ARGS
+
+inline compare_kernel select_compare_kernel()
+{
+#if MIOPEN_VERIFY_X86_DISPATCH
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+        return &compare_kernel_avx2;
+#endif
+    return &compare_kernel_default;
+}
+
+template <class T>
+double to_double(T x)
+{
+    return static_cast<double>(x);
+}
+
+/// Position of the value on a line where the neighboring representable values of T are
+/// neighboring integers. Assumes a sign-magnitude encoding, which holds for the IEEE types,
+/// half, bfloat16 and the fp8 types.
+template <class T>
+std::int64_t ordinal(T x)
+{
+    static_assert(std::is_trivially_copyable<T>{}, "The bits of the type must be accessible");
+    static_assert(sizeof(T) <= sizeof(std::uint64_t), "Unsupported floating point type");
+
+    std::uint64_t bits = 0;
+    // The types are little-endian on all the supported hosts.
+    std::memcpy(&bits, &x, sizeof(T));
+    const auto sign      = std::uint64_t{1} << (8 * sizeof(T) - 1);
+    const auto magnitude = static_cast<std::int64_t>(bits & (sign - 1));
+    // Branchless, the signs of the values are usually random.
+    const auto negative = -static_cast<std::int64_t>((bits & sign) != 0);
+    return (magnitude ^ negative) - negative;
+}
+
+/// Ordinal of the value rounded to U, the type of the checked values. The distances in ULPs
+/// of integer types are the differences of the values.
+template <class U, class T>
+std::int64_t ordinal_as(T x)
+{
+    if constexpr(std::is_integral<U>{})
+    {
+        const auto d = to_double(x);
+        return d > -9.2e18 && d < 9.2e18 ? static_cast<std::int64_t>(d) : 0;
+    }
+    else if constexpr(std::is_same<T, U>{})
+        return ordinal(x);
+    else if constexpr(std::is_arithmetic<U>{})
+        return ordinal(static_cast<U>(to_double(x)));
+    else
+        return ordinal(static_cast<U>(static_cast<float>(to_double(x))));
+}
+
+inline bool is_finite(double x) { return std::fabs(x) < std::numeric_limits<double>::infinity(); }
+
+/// Partial report of a chunk. Only the first max_offenders offenders are kept, the merged
+/// report needs no more of any chunk.
+template <class T, class U>
+report compare_chunk(const T* expected,
+                     const U* actual,
+                     std::size_t first,
+                     std::size_t last,
+                     const options& opts,
+                     compare_kernel kernel)
+{
+    auto r  = report{};
+    r.count = last - first;
+
+    alignas(64) double e[block_size];
+    alignas(64) double a[block_size];
+    alignas(64) std::int64_t oe[block_size];
+    alignas(64) std::int64_t oa[block_size];
+    lane_histograms histograms = {};
+
+    for(std::size_t begin = first; begin < last; begin += block_size)
+    {
+        const auto n = std::min(block_size, last - begin);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            e[i] = to_double(expected[begin + i]);
+            a[i] = to_double(actual[begin + i]);
+        }
+        if(opts.ulp_histogram)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                oe[i] = ordinal_as<U>(expected[begin + i]);
+                oa[i] = ordinal_as<U>(actual[begin + i]);
+            }
+        }
+        // The padding compares equal zeros, which changes none of the statistics but the
+        // histogram, corrected below.
+        const auto padded = (n + lanes - 1) / lanes * lanes;
+        std::fill(e + n, e + padded, 0.0);
+        std::fill(a + n, a + padded, 0.0);
+        std::fill(oe + n, oe + padded, 0);
+        std::fill(oa + n, oa + padded, 0);
+        for(std::size_t i = n; i < padded && opts.ulp_histogram; ++i)
+            --histograms[i % lanes][0];
+
+        auto stats = block_stats{};
+        kernel(e,
+               a,
+               opts.ulp_histogram ? oe : nullptr,
+               opts.ulp_histogram ? oa : nullptr,
+               padded,
+               opts.abs_tolerance,
+               opts.rel_tolerance,
+               stats,
+               histograms);
+
+        r.sum_square_diff += stats.sum_square_diff;
+        r.expected_magnitude = std::max(r.expected_magnitude, stats.expected_magnitude);
+        r.actual_magnitude   = std::max(r.actual_magnitude, stats.actual_magnitude);
+        r.non_finite_expected += stats.non_finite_expected;
+        r.non_finite_actual += stats.non_finite_actual;
+        r.num_offenders += stats.num_offenders;
+
+        // The positions are searched only when the block holds something new, which is rare
+        // after the first blocks.
+        const auto find = [&](auto&& pred) {
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                if(is_finite(e[i]) && is_finite(a[i]) && pred(i))
+                    return begin + i;
+            }
+            return begin;
+        };
+        if(stats.max_abs_diff > r.max_abs_diff)
+        {
+            r.max_abs_diff       = stats.max_abs_diff;
+            r.max_abs_diff_index =
+                find([&](auto i) { return std::fabs(a[i] - e[i]) == r.max_abs_diff; });
+        }
+        if(stats.max_rel_diff > r.max_rel_diff)
+        {
+            r.max_rel_diff       = stats.max_rel_diff;
+            r.max_rel_diff_index = find([&](auto i) {
+                const auto ax = std::fabs(e[i]);
+                const auto d  = std::fabs(a[i] - e[i]);
+                return d / std::max(ax, std::numeric_limits<double>::min()) == r.max_rel_diff;
+            });
+        }
+
+        if(stats.num_offenders > 0 && r.offenders.size() < opts.max_offenders)
+        {
+            for(std::size_t i = 0; i < n && r.offenders.size() < opts.max_offenders; ++i)
+            {
+                const bool offending =
+                    is_finite(e[i]) && is_finite(a[i])
+                        ? std::fabs(a[i] - e[i]) >
+                              opts.abs_tolerance + opts.rel_tolerance * std::fabs(e[i])
+                        : !(e[i] == a[i]);
+                if(offending)
+                    r.offenders.push_back({begin + i, {}, e[i], a[i]});
+            }
+        }
+    }
+
+    for(std::size_t l = 0; l < lanes; ++l)
+    {
+        for(std::size_t b = 0; b < ulp_bins; ++b)
+            r.ulp_histogram[b] += histograms[l][b];
+    }
+    return r;
+}
+
+/// Merges the report of the following chunk.
+inline void merge(report& r, const report& next, std::size_t max_offenders)
+{
+    r.count += next.count;
+    r.sum_square_diff += next.sum_square_diff;
+    r.expected_magnitude = std::max(r.expected_magnitude, next.expected_magnitude);
+    r.actual_magnitude   = std::max(r.actual_magnitude, next.actual_magnitude);
+    if(next.max_abs_diff > r.max_abs_diff)
+    {
+        r.max_abs_diff       = next.max_abs_diff;
+        r.max_abs_diff_index = next.max_abs_diff_index;
+    }
+    if(next.max_rel_diff > r.max_rel_diff)
+    {
+        r.max_rel_diff       = next.max_rel_diff;
+        r.max_rel_diff_index = next.max_rel_diff_index;
+    }
+    r.non_finite_expected += next.non_finite_expected;
+    r.non_finite_actual += next.non_finite_actual;
+    r.num_offenders += next.num_offenders;
+    for(std::size_t b = 0; b < ulp_bins; ++b)
+        r.ulp_histogram[b] += next.ulp_histogram[b];
+    for(const auto& o : next.offenders)
+    {
+        if(r.offenders.size() >= max_offenders)
+            break;
+        r.offenders.push_back(o);
+    }
+}
+
+} // namespace detail
+
+/// Compares n elements of the result (actual) with the reference (expected). The types may
+/// differ, e.g. a double reference of a half result; the distances in ULPs are measured in the
+/// type of the result.
+template <class T, class U>
+report compare(const T* expected, const U* actual, std::size_t n, const options& opts = {})
+{
+    static const auto kernel = detail::select_compare_kernel();
+
+    const auto num_chunks = (n + detail::chunk_size - 1) / detail::chunk_size;
+    auto partial          = std::vector<report>(num_chunks);
+    miopen::par_for(num_chunks, miopen::min_grain{1}, [&](std::size_t c) {
+        const auto first = c * detail::chunk_size;
+        const auto last  = std::min(n, first + detail::chunk_size);
+        partial[c]       = detail::compare_chunk(expected, actual, first, last, opts, kernel);
+    });
+
+    auto result = report{};
+    for(const auto& p : partial)
+        detail::merge(result, p, opts.max_offenders);
+    return result;
+}
+
+template <class T, class U>
+report
+compare(const std::vector<T>& expected, const std::vector<U>& actual, const options& opts = {})
+{
+    return compare(expected.data(), actual.data(), std::min(expected.size(), actual.size()), opts);
+}
+
+/// Index of the first element for which pred(i) holds, or n. The chunks are searched in
+/// parallel, pred shall be safe to call from several threads.
+template <class Predicate>
+std::size_t find_first(std::size_t n, Predicate pred)
+{
+    const auto num_chunks = (n + detail::chunk_size - 1) / detail::chunk_size;
+    auto found            = std::vector<std::size_t>(num_chunks, n);
+    // Chunks after the first one with a match cannot change the result and are skipped.
+    auto first_match = std::atomic<std::size_t>{num_chunks};
+    miopen::par_for(num_chunks, miopen::min_grain{1}, [&](std::size_t c) {
+        if(c > first_match.load(std::memory_order_relaxed))
+            return;
+        const auto first = c * detail::chunk_size;
+        const auto last  = std::min(n, first + detail::chunk_size);
+        for(std::size_t i = first; i < last; ++i)
+        {
+            if(pred(i))
+            {
+                found[c]     = i;
+                auto current = first_match.load(std::memory_order_relaxed);
+                while(c < current && !first_match.compare_exchange_weak(current, c)) {}
+                return;
+            }
+        }
+    });
+    const auto it = std::find_if(found.begin(), found.end(), [n](auto i) { return i != n; });
+    return it == found.end() ? n : *it;
+}
+
+} // namespace verification
+} // namespace miopen
+
+#endif
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+// Runs the offline compiler commands of the MIOpen processes of the node which have
+// MIOPEN_COMPILE_SERVER set to the socket of the server, see
+// src/include/miopen/compile_server.hpp.
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/compile_server.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/kern_file_cache.hpp>
+
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+
+namespace {
+
+void Usage(const char* name)
+{
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << name << " [--socket path] [-j jobs] [--cache path | --no-cache] [--max-size MiB]"
+              << std::endl;
+    std::cerr << "--socket - the socket to listen on. Defaults to MIOPEN_COMPILE_SERVER."
+              << std::endl;
+    std::cerr << "jobs - the number of commands to run at once. Defaults to the number of hardware "
+                 "threads."
+              << std::endl;
+    std::cerr << "--cache - the kernel cache directory for the results. Defaults to the kcache "
+                 "subdirectory of the user cache."
+              << std::endl;
+    std::cerr << "MiB - the size limit of the cache. Defaults to MIOPEN_KERN_CACHE_MAX_SIZE."
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argn, char** args)
+{
+    auto socket   = miopen::compile_server::GetSocketPath();
+    auto jobs     = std::size_t{0};
+    auto cache    = miopen::fs::path{};
+    auto no_cache = miopen::IsCacheDisabled() || miopen::GetCachePath(false).empty();
+    auto max_size = miopen::GetKernFileCacheMaxSize();
+
+    for(auto i = 1; i < argn; ++i)
+    {
+        const std::string arg = args[i];
+        if(arg == "--socket" && i + 1 < argn)
+        {
+            socket = args[++i];
+        }
+        else if(arg == "-j" && i + 1 < argn)
+        {
+            jobs = std::strtoull(args[++i], nullptr, 10);
+        }
+        else if(arg == "--cache" && i + 1 < argn)
+        {
+            cache    = args[++i];
+            no_cache = false;
+        }
+        else if(arg == "--no-cache")
+        {
+            no_cache = true;
+        }
+        else if(arg == "--max-size" && i + 1 < argn)
+        {
+            max_size = std::strtoull(args[++i], nullptr, 10) * 1024 * 1024;
+        }
+        else
+        {
+            Usage(args[0]);
+            return 1;
+        }
+    }
+
+    if(socket.empty())
+    {
+        Usage(args[0]);
+        return 1;
+    }
+    if(no_cache)
+        cache.clear();
+    else if(cache.empty())
+        cache = miopen::GetCachePath(false) / miopen::KernFileCache::DirName;
+
+    // Handled by a thread, which can stop the server, unlike a signal handler.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    try
+    {
+        auto server = miopen::compile_server::Server{socket, jobs, cache, max_size};
+        std::cout << "Listening on " << socket.string() << std::endl;
+
+        auto signal_handler = std::thread{[&] {
+            auto signal = 0;
+            sigwait(&signals, &signal);
+            server.Stop();
+        }};
+        server.Run();
+        signal_handler.join();
+
+        const auto stats = server.GetStats();
+        std::cout << stats.requests << " requests, " << stats.builds << " builds, "
+                  << stats.deduplicated << " deduplicated, " << stats.cache_hits << " cache hits"
+                  << std::endl;
+        return 0;
+    }
+    catch(const miopen::Exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    catch(const miopen::fs::filesystem_error& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
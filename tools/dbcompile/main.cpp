@@ -0,0 +1,115 @@
+// Compiles a text (*.fdb.txt, *.db.txt) or SQLite (*.db) system database into the binary form
+// which ReadonlyRamDb maps instead of parsing the text database at startup.
+// See src/include/miopen/readonly_bin_db.hpp for the format description.
+
+#include <miopen/readonly_bin_db.hpp>
+
+#if DBCOMPILE_WITH_SQLITE
+#include "sqlite_perf_db.hpp"
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+static bool IsSqliteFile(const std::string& filename)
+{
+    constexpr char sqlite_magic[]     = "SQLite format 3";
+    char buffer[sizeof(sqlite_magic)] = {};
+    auto in                           = std::ifstream{filename, std::ios::binary};
+    return in.read(buffer, sizeof(buffer)) &&
+           std::memcmp(buffer, sqlite_magic, sizeof(buffer)) == 0;
+}
+
+static bool ReadTextDb(const std::string& filename, std::vector<miopen::bin_db::Entry>& entries)
+{
+    auto in = std::ifstream{filename};
+    if(!in)
+    {
+        std::cerr << "Unable to open " << filename << std::endl;
+        return false;
+    }
+
+    auto line   = std::string{};
+    auto n_line = 0;
+
+    while(std::getline(in, line))
+    {
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            std::cerr << "Ill-formed record: key not found: " << filename << "#" << n_line
+                      << std::endl;
+            continue;
+        }
+
+        entries.push_back({line.substr(0, key_size), line.substr(key_size + 1), n_line});
+    }
+
+    return true;
+}
+
+int main(int argn, char** args)
+{
+    if(argn < 2 || argn > 3)
+    {
+        std::cerr << "Usage:" << std::endl;
+        std::cerr << args[0] << " input_path [output_path]" << std::endl;
+        std::cerr << "input_path - path to the input file, a text db or a sqlite3 perf db."
+                  << std::endl;
+        std::cerr << "output_path - optional path to the output file. Existing file would be "
+                     "replaced. Defaults to the input_path with "
+                  << miopen::bin_db::FileSuffix << " appended to the end" << std::endl;
+        return 1;
+    }
+
+    const std::string in_filename  = args[1];
+    const std::string out_filename = argn > 2 ? args[2] : (in_filename + ".bin");
+    auto entries                   = std::vector<miopen::bin_db::Entry>{};
+
+    if(IsSqliteFile(in_filename))
+    {
+#if DBCOMPILE_WITH_SQLITE
+        for(auto& record : ReadSqlitePerfDb(in_filename))
+            entries.push_back({record.first, std::move(record.second), 0});
+#else
+        std::cerr << "SQLite input is not supported by this build." << std::endl;
+        return 1;
+#endif
+    }
+    else if(!ReadTextDb(in_filename, entries))
+    {
+        return 1;
+    }
+
+    // Write to a temporary file first so that readers never map a partially written database.
+    const auto tmp_filename = out_filename + ".tmp";
+    {
+        auto out = std::ofstream{tmp_filename, std::ios::binary | std::ios::trunc};
+        miopen::bin_db::Write(out, std::move(entries));
+        if(!out.flush())
+        {
+            std::cerr << "Error writing " << tmp_filename << std::endl;
+            return 1;
+        }
+    }
+
+    if(std::rename(tmp_filename.c_str(), out_filename.c_str()) != 0)
+    {
+        std::remove(out_filename.c_str());
+        if(std::rename(tmp_filename.c_str(), out_filename.c_str()) != 0)
+        {
+            std::cerr << "Unable to replace " << out_filename << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
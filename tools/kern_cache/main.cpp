@@ -0,0 +1,93 @@
+// Maintains the kernel cache of the builds without the SQLite kernel cache, see
+// src/include/miopen/kern_file_cache.hpp for the layout.
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/kern_file_cache.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+
+namespace {
+
+void Usage(const char* name)
+{
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << name << " stats [cache_path]" << std::endl;
+    std::cerr << name << " gc [--max-size MiB] [cache_path]" << std::endl;
+    std::cerr << "cache_path - the kernel cache directory. Defaults to the user kernel cache."
+              << std::endl;
+    std::cerr << "MiB - the size limit to collect the cache to. Defaults to "
+                 "MIOPEN_KERN_CACHE_MAX_SIZE."
+              << std::endl;
+}
+
+void Print(const miopen::KernFileCacheStats& stats)
+{
+    std::cout << stats.keys << " kernels, " << stats.objects << " distinct binaries, "
+              << stats.bytes / 1024 / 1024 << " MiB, index " << stats.index_bytes / 1024
+              << " KiB" << std::endl;
+}
+
+} // namespace
+
+int main(int argn, char** args)
+{
+    if(argn < 2)
+    {
+        Usage(args[0]);
+        return 1;
+    }
+
+    auto command  = std::string{args[1]};
+    auto max_size = std::uint64_t{0};
+    auto path     = std::optional<miopen::fs::path>{};
+
+    for(auto i = 2; i < argn; ++i)
+    {
+        const std::string arg = args[i];
+        if(command == "gc" && arg == "--max-size" && i + 1 < argn)
+            max_size = std::strtoull(args[++i], nullptr, 10) * 1024 * 1024;
+        else if(!path && !arg.empty() && arg.front() != '-')
+            path = arg;
+        else
+            command.clear();
+    }
+
+    if(command != "stats" && command != "gc")
+    {
+        Usage(args[0]);
+        return 1;
+    }
+
+    try
+    {
+        auto custom_cache = std::optional<miopen::KernFileCache>{};
+        if(path)
+            custom_cache.emplace(*path, miopen::GetKernFileCacheMaxSize());
+        auto& cache = custom_cache ? *custom_cache : miopen::GetKernFileCache();
+
+        if(command == "gc")
+        {
+            const auto result = cache.Gc(max_size);
+            std::cout << "Evicted " << result.evicted_keys << " kernels, removed "
+                      << result.removed_objects << " binaries, freed "
+                      << result.freed_bytes / 1024 / 1024 << " MiB" << std::endl;
+        }
+        Print(cache.GetStats());
+        return 0;
+    }
+    catch(const miopen::Exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    catch(const miopen::fs::filesystem_error& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,96 @@
+// Shows or replays a kernel manifest recorded with MIOPEN_KERNEL_MANIFEST, see
+// src/include/miopen/kernel_manifest.hpp for the format description.
+//
+// Replaying compiles the programs of the manifest into the user kernel cache and stores its
+// find-db records into the user find-db, so that the recorded workload starts warm.
+
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_manifest.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+void Usage(const char* name)
+{
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << name << " show manifest_path" << std::endl;
+    std::cerr << name << " replay manifest_path [-j jobs]" << std::endl;
+    std::cerr << "jobs - the number of programs compiled at a time. Defaults to the number of "
+                 "hardware threads."
+              << std::endl;
+}
+
+void Show(const miopen::kernel_manifest::Manifest& manifest)
+{
+    std::cout << manifest.programs.size() << " programs" << std::endl;
+    for(const auto& [name, options] : manifest.programs)
+        std::cout << "  " << name.string() << " " << options << std::endl;
+
+    std::cout << manifest.invokers.size() << " invokers" << std::endl;
+    for(const auto& [network_config, solver_id] : manifest.invokers)
+        std::cout << "  " << solver_id << " " << network_config << std::endl;
+
+    std::cout << manifest.find_records.size() << " find-db records" << std::endl;
+    for(const auto& [db_key, contents] : manifest.find_records)
+    {
+        std::cout << "  " << (db_key.first.empty() ? "" : db_key.first + " ") << db_key.second
+                  << "=" << contents << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argn, char** args)
+{
+    if(argn != 3 && !(argn == 5 && std::string{args[3]} == "-j"))
+    {
+        Usage(args[0]);
+        return 1;
+    }
+
+    const std::string command = args[1];
+    if(command != "show" && command != "replay")
+    {
+        Usage(args[0]);
+        return 1;
+    }
+
+    try
+    {
+        const auto manifest = miopen::kernel_manifest::Read(miopen::fs::path{args[2]});
+
+        if(command == "show")
+        {
+            Show(manifest);
+            return 0;
+        }
+
+        const auto jobs = argn == 5 ? std::strtoul(args[4], nullptr, 10)
+                                    : std::thread::hardware_concurrency();
+        if(jobs == 0)
+        {
+            Usage(args[0]);
+            return 1;
+        }
+
+        auto handle       = miopen::Handle{};
+        const auto result = miopen::kernel_manifest::Replay(handle, manifest, jobs);
+
+        std::cout << "Built " << result.programs << " of " << manifest.programs.size()
+                  << " programs, stored " << result.find_records << " of "
+                  << manifest.find_records.size() << " find-db records" << std::endl;
+        if(!manifest.invokers.empty())
+            std::cout << "Skipped " << manifest.invokers.size() << " invokers" << std::endl;
+        return result.failures == 0 ? 0 : 2;
+    }
+    catch(const miopen::Exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+}